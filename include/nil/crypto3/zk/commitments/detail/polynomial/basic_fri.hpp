@@ -30,6 +30,20 @@
 #ifndef CRYPTO3_ZK_COMMITMENTS_BASIC_FRI_HPP
 #define CRYPTO3_ZK_COMMITMENTS_BASIC_FRI_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <boost/assert.hpp>
+
 #include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
@@ -41,7 +55,12 @@
 #include <nil/crypto3/container/merkle/tree.hpp>
 #include <nil/crypto3/container/merkle/proof.hpp>
 
+#include <nil/crypto3/zk/detail/batch_inversion.hpp>
+#include <nil/crypto3/zk/detail/batched_merkle_tree.hpp>
+#include <nil/crypto3/zk/detail/field_merkle_tree.hpp>
+#include <nil/crypto3/zk/detail/poseidon_hash.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+#include <nil/crypto3/zk/transcript/poseidon_transcript.hpp>
 
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/fold_polynomial.hpp>
@@ -85,8 +104,22 @@ namespace nil {
                         // For initial proof only, size of all values are similar
                         typedef std::vector<polynomial_values_type> polynomials_values_type;
 
-                        typedef typename containers::merkle_tree<MerkleTreeHashType, 2> merkle_tree_type;
-                        typedef typename containers::merkle_proof<MerkleTreeHashType, 2> merkle_proof_type;
+                        // Field-native tree hashes take the field elements of a leaf as they are, other hashes
+                        // their marshalled bytes
+                        constexpr static const bool field_native_merkle_tree =
+                            zk::detail::is_field_native_hash<MerkleTreeHashType>::value;
+                        BOOST_STATIC_ASSERT_MSG(!field_native_merkle_tree ||
+                                                    zk::detail::is_field_native_hash<TranscriptHashType>::value,
+                                                "field-native Merkle roots need a field-native transcript");
+
+                        typedef typename std::conditional<field_native_merkle_tree,
+                                                          zk::detail::field_merkle_tree<MerkleTreeHashType, 2>,
+                                                          containers::merkle_tree<MerkleTreeHashType, 2>>::type
+                            merkle_tree_type;
+                        typedef typename std::conditional<field_native_merkle_tree,
+                                                          zk::detail::field_merkle_proof<MerkleTreeHashType, 2>,
+                                                          containers::merkle_proof<MerkleTreeHashType, 2>>::type
+                            merkle_proof_type;
 
                         using Endianness = nil::marshalling::option::big_endian;
                         using field_element_type = nil::crypto3::marshalling::types::field_element<
@@ -94,6 +127,15 @@ namespace nil {
                                 typename FieldType::value_type
                         >;
 
+                        typedef typename std::conditional<field_native_merkle_tree, typename FieldType::value_type,
+                                                          std::uint8_t>::type leaf_element_type;
+                        typedef std::vector<leaf_element_type> leaf_type;
+
+                        /// Leaf elements taken by one field element.
+                        static std::size_t leaf_value_size() {
+                            return field_native_merkle_tree ? 1 : field_element_type::length();
+                        }
+
                         using precommitment_type = merkle_tree_type;
                         using commitment_type = typename precommitment_type::value_type;
                         using transcript_type = transcript::fiat_shamir_heuristic_sequential<TranscriptHashType>;
@@ -101,7 +143,7 @@ namespace nil {
                         struct params_type {
                             bool operator==(const params_type &rhs) const {
                                 return r == rhs.r && max_degree == rhs.max_degree && D == rhs.D &&
-                                       batches_num == rhs.batches_num;
+                                       batches_num == rhs.batches_num && grinding_bits == rhs.grinding_bits;
                             }
 
                             bool operator!=(const params_type &rhs) const {
@@ -116,15 +158,33 @@ namespace nil {
                                 D = obj.D;
                                 step_list = obj.step_list;
                                 batches_num = obj.batches_num;
+                                grinding_bits = obj.grinding_bits;
                             }
 
                             params_type() {};
 
+                            /// Throws std::invalid_argument unless grinding_bits < 64.
+                            explicit params_type(std::size_t grinding_bits) :
+                                grinding_bits(check_grinding_bits(grinding_bits)) {
+                            }
+
+                            /// The proof of work is checked on a 64-bit challenge, so with 64 or more bits no nonce
+                            /// could ever be found.
+                            static std::size_t check_grinding_bits(std::size_t grinding_bits) {
+                                if (grinding_bits >= 64) {
+                                    throw std::invalid_argument("FRI grinding_bits must be less than 64");
+                                }
+                                return grinding_bits;
+                            }
+
                             std::size_t batches_num;
                             std::size_t r;
                             std::size_t max_degree;
                             std::vector<std::shared_ptr<math::evaluation_domain<FieldType>>> D;
                             std::vector<std::size_t> step_list;
+                            // Leading zero bits of the proof of work required before the query phase. Each bit
+                            // adds about one bit of soundness, so lambda can be lowered accordingly.
+                            std::size_t grinding_bits = 0;
                         };
 
                         struct round_proof_type {
@@ -171,7 +231,8 @@ namespace nil {
                             bool operator==(const proof_type &rhs) const {
                                 return fri_roots == rhs.fri_roots &&
                                        query_proofs == rhs.query_proofs &&
-                                       final_polynomial == rhs.final_polynomial;
+                                       final_polynomial == rhs.final_polynomial &&
+                                       proof_of_work == rhs.proof_of_work;
                             }
 
                             bool operator!=(const proof_type &rhs) const {
@@ -181,12 +242,165 @@ namespace nil {
                             std::vector<commitment_type> fri_roots;        // 0,..step_list.size()
                             math::polynomial<typename field_type::value_type> final_polynomial;
                             std::array<query_proof_type, lambda> query_proofs;     // 0...lambda - 1
+                            // Grinding nonce, 0 if params_type::grinding_bits == 0. It is part of the proof: a
+                            // serialized proof carries it as the 8 big-endian bytes of proof_of_work_bytes().
+                            std::uint64_t proof_of_work = 0;
+                        };
+                    };
+
+                    /// Appends v to a Merkle leaf of FRI at iter, see basic_batched_fri::leaf_type.
+                    template<typename FRI, typename OutputIterator>
+                    void write_leaf_value(OutputIterator &iter, const typename FRI::field_type::value_type &v) {
+                        if constexpr (FRI::field_native_merkle_tree) {
+                            *iter++ = v;
+                        } else {
+                            typename FRI::field_element_type y_val(v);
+                            y_val.write(iter, FRI::field_element_type::length());
+                        }
+                    }
+
+                    // Forward iterator over the Merkle leaves of a list of columns kept in a column storage.
+                    //
+                    // Leaves are produced chunk by chunk: for leaves [begin, end) the rows
+                    // [begin + t * leafs_number, end + t * leafs_number) of every column are read for each coset
+                    // position t and serialized in the same order as the in-memory precommit. All copies of the
+                    // iterator share one chunk, so at most chunk_leaves leaves are resident at a time.
+                    template<typename FRI, typename StorageType>
+                    class storage_leaf_iterator {
+                        struct chunk_type {
+                            const StorageType &storage;
+                            std::size_t leafs_number;
+                            std::size_t chunk_leaves;
+                            // coset_order[k] is t of the k-th value in a leaf, the leaf x holds x + t * leafs_number
+                            std::vector<std::size_t> coset_order;
+                            std::size_t begin;
+                            std::size_t end;
+                            std::vector<typename FRI::leaf_type> leaves;
+
+                            void load(std::size_t leaf) {
+                                if (leaf >= begin && leaf < end) {
+                                    return;
+                                }
+                                begin = leaf - leaf % chunk_leaves;
+                                end = std::min(begin + chunk_leaves, leafs_number);
+
+                                const std::size_t length = FRI::leaf_value_size();
+                                const std::size_t coset_size = coset_order.size();
+                                leaves.assign(end - begin,
+                                              typename FRI::leaf_type(storage.columns() * coset_size * length));
+
+                                std::vector<typename FRI::field_type::value_type> values(end - begin);
+                                for (std::size_t column = 0; column < storage.columns(); column++) {
+                                    for (std::size_t k = 0; k < coset_size; k++) {
+                                        storage.read(column, begin + coset_order[k] * leafs_number, values);
+                                        for (std::size_t x = 0; x < values.size(); x++) {
+                                            auto write_iter =
+                                                leaves[x].begin() + (column * coset_size + k) * length;
+                                            write_leaf_value<FRI>(write_iter, values[x]);
+                                        }
+                                    }
+                                }
+                            }
                         };
+
+                    public:
+                        typedef std::forward_iterator_tag iterator_category;
+                        typedef typename FRI::leaf_type value_type;
+                        typedef std::ptrdiff_t difference_type;
+                        typedef const value_type *pointer;
+                        typedef const value_type &reference;
+
+                        storage_leaf_iterator(const StorageType &storage, std::size_t fri_step,
+                                              std::size_t chunk_leaves, std::size_t leaf) :
+                            chunk(std::make_shared<chunk_type>(chunk_type {storage, 0, 0, {}, 0, 0, {}})),
+                            leaf(leaf) {
+                            const std::size_t domain_size = storage.rows();
+                            const std::size_t coset_size = std::size_t(1) << fri_step;
+                            chunk->leafs_number = domain_size / coset_size;
+                            chunk->chunk_leaves = std::max<std::size_t>(1, chunk_leaves);
+
+                            // Same index walk as precommit, for the leaf 0
+                            std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
+                            s_indices[0][0] = 0;
+                            s_indices[0][1] = domain_size / FRI::m;
+                            std::size_t base_index = domain_size / (FRI::m * FRI::m);
+                            std::size_t prev_half_size = 1;
+                            std::size_t i = 1;
+                            while (i < coset_size / FRI::m) {
+                                for (std::size_t j = 0; j < prev_half_size; j++) {
+                                    s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
+                                    s_indices[i][1] = (s_indices[i][0] + domain_size / FRI::m) % domain_size;
+                                    i++;
+                                }
+                                base_index /= FRI::m;
+                                prev_half_size <<= 1;
+                            }
+                            for (const auto &pair : s_indices) {
+                                chunk->coset_order.push_back(pair[0] / chunk->leafs_number);
+                                chunk->coset_order.push_back(pair[1] / chunk->leafs_number);
+                            }
+                        }
+
+                        reference operator*() const {
+                            chunk->load(leaf);
+                            return chunk->leaves[leaf - chunk->begin];
+                        }
+
+                        pointer operator->() const {
+                            return &**this;
+                        }
+
+                        storage_leaf_iterator &operator++() {
+                            ++leaf;
+                            return *this;
+                        }
+
+                        storage_leaf_iterator operator++(int) {
+                            storage_leaf_iterator tmp = *this;
+                            ++leaf;
+                            return tmp;
+                        }
+
+                        difference_type operator-(const storage_leaf_iterator &other) const {
+                            return difference_type(leaf) - difference_type(other.leaf);
+                        }
+
+                        bool operator==(const storage_leaf_iterator &other) const {
+                            return leaf == other.leaf;
+                        }
+
+                        bool operator!=(const storage_leaf_iterator &other) const {
+                            return leaf != other.leaf;
+                        }
+
+                        // Iterator to another leaf sharing the same chunk
+                        storage_leaf_iterator at(std::size_t other_leaf) const {
+                            return storage_leaf_iterator(chunk, other_leaf);
+                        }
+
+                    private:
+                        storage_leaf_iterator(std::shared_ptr<chunk_type> chunk, std::size_t leaf) :
+                            chunk(chunk), leaf(leaf) {
+                        }
+
+                        std::shared_ptr<chunk_type> chunk;
+                        std::size_t leaf;
                     };
                 }    // namespace detail
             }        // namespace commitments
 
             namespace algorithms {
+                /// Merkle tree of the leaves [first, last), field-native or over the marshalled leaves.
+                template<typename FRI, typename LeafIterator>
+                static typename FRI::merkle_tree_type build_merkle_tree(LeafIterator first, LeafIterator last) {
+                    if constexpr (FRI::field_native_merkle_tree) {
+                        return typename FRI::merkle_tree_type(first, last);
+                    } else {
+                        return zk::detail::make_batched_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(
+                            first, last);
+                    }
+                }
+
                 template<typename FRI,
                         typename std::enable_if<
                                 std::is_base_of<
@@ -243,8 +457,8 @@ namespace nil {
                     std::size_t domain_size = D->size();
                     std::size_t coset_size = 1 << fri_step;
                     std::size_t leafs_number = domain_size / coset_size;
-                    std::size_t leaf_bytes = coset_size * FRI::field_element_type::length();
-                    std::vector<std::vector<std::uint8_t>> y_data(leafs_number, std::vector<std::uint8_t>(leaf_bytes));
+                    std::size_t leaf_size = coset_size * FRI::leaf_value_size();
+                    std::vector<typename FRI::leaf_type> y_data(leafs_number, typename FRI::leaf_type(leaf_size));
 
                     for (std::size_t x_index = 0; x_index < leafs_number; x_index++) {
                         std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
@@ -252,10 +466,8 @@ namespace nil {
                         s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
 
                         auto write_iter = y_data[x_index].begin();
-                        typename FRI::field_element_type y_val0(f[s_indices[0][0]]);
-                        y_val0.write(write_iter, FRI::field_element_type::length());
-                        typename FRI::field_element_type y_val1(f[s_indices[0][1]]);
-                        y_val1.write(write_iter, FRI::field_element_type::length());
+                        commitments::detail::write_leaf_value<FRI>(write_iter, f[s_indices[0][0]]);
+                        commitments::detail::write_leaf_value<FRI>(write_iter, f[s_indices[0][1]]);
 
                         std::size_t base_index = domain_size / (FRI::m * FRI::m);
                         std::size_t prev_half_size = 1;
@@ -265,10 +477,8 @@ namespace nil {
                                 s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
                                 s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
 
-                                typename FRI::field_element_type y_val0(f[s_indices[i][0]]);
-                                y_val0.write(write_iter, FRI::field_element_type::length());
-                                typename FRI::field_element_type y_val1(f[s_indices[i][1]]);
-                                y_val1.write(write_iter, FRI::field_element_type::length());
+                                commitments::detail::write_leaf_value<FRI>(write_iter, f[s_indices[i][0]]);
+                                commitments::detail::write_leaf_value<FRI>(write_iter, f[s_indices[i][1]]);
 
                                 i++;
                             }
@@ -277,8 +487,7 @@ namespace nil {
                         }
                     }
 
-                    return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
-                                                                                                     y_data.end());
+                    return build_merkle_tree<FRI>(y_data.begin(), y_data.end());
                 }
 
                 template<typename FRI,
@@ -334,9 +543,9 @@ namespace nil {
                     std::size_t list_size = poly.size();
                     std::size_t coset_size = 1 << fri_step;
                     std::size_t leafs_number = domain_size / coset_size;
-                    std::vector<std::vector<std::uint8_t>> y_data(
+                    std::vector<typename FRI::leaf_type> y_data(
                             leafs_number,
-                            std::vector<std::uint8_t>(coset_size * FRI::field_element_type::length() * list_size));
+                            typename FRI::leaf_type(coset_size * FRI::leaf_value_size() * list_size));
 
                     for (std::size_t x_index = 0; x_index < leafs_number; x_index++) {
                         auto write_iter = y_data[x_index].begin();
@@ -345,10 +554,10 @@ namespace nil {
                             s_indices[0][0] = x_index;
                             s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
 
-                            typename FRI::field_element_type y_val0(poly[polynom_index][s_indices[0][0]]);
-                            y_val0.write(write_iter, FRI::field_element_type::length());
-                            typename FRI::field_element_type y_val1(poly[polynom_index][s_indices[0][1]]);
-                            y_val1.write(write_iter, FRI::field_element_type::length());
+                            commitments::detail::write_leaf_value<FRI>(write_iter,
+                                poly[polynom_index][s_indices[0][0]]);
+                            commitments::detail::write_leaf_value<FRI>(write_iter,
+                                poly[polynom_index][s_indices[0][1]]);
 
                             std::size_t base_index = domain_size / (FRI::m * FRI::m);
                             std::size_t prev_half_size = 1;
@@ -357,10 +566,10 @@ namespace nil {
                                 for (std::size_t j = 0; j < prev_half_size; j++) {
                                     s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
                                     s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-                                    typename FRI::field_element_type y_val0(poly[polynom_index][s_indices[i][0]]);
-                                    y_val0.write(write_iter, FRI::field_element_type::length());
-                                    typename FRI::field_element_type y_val1(poly[polynom_index][s_indices[i][1]]);
-                                    y_val1.write(write_iter, FRI::field_element_type::length());
+                                    commitments::detail::write_leaf_value<FRI>(write_iter,
+                                        poly[polynom_index][s_indices[i][0]]);
+                                    commitments::detail::write_leaf_value<FRI>(write_iter,
+                                        poly[polynom_index][s_indices[i][1]]);
 
                                     i++;
                                 }
@@ -370,8 +579,7 @@ namespace nil {
                         }
                     }
 
-                    return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
-                                                                                                     y_data.end());
+                    return build_merkle_tree<FRI>(y_data.begin(), y_data.end());
                 }
 
                 template<typename FRI, typename ContainerType,
@@ -402,6 +610,59 @@ namespace nil {
                     return precommit<FRI>(poly_dfs, D, fri_step);
                 }
 
+                /// Extends f to D and writes it into the column of the storage in chunks of chunk_rows rows.
+                /// Used to fill a column storage one polynomial at a time before precommit_storage.
+                template<typename FRI, typename StorageType,
+                        typename std::enable_if<
+                                std::is_base_of<
+                                        commitments::detail::basic_batched_fri<
+                                                typename FRI::field_type, typename FRI::merkle_tree_hash_type,
+                                                typename FRI::transcript_hash_type,
+                                                FRI::lambda, FRI::m, FRI::batches_num>,
+                                        FRI>::value,
+                                bool>::type = true>
+                static void store_column(StorageType &storage, std::size_t column,
+                                         math::polynomial_dfs<typename FRI::field_type::value_type> f,
+                                         std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> D,
+                                         std::size_t chunk_rows) {
+                    BOOST_ASSERT(storage.rows() == D->size());
+                    if (f.size() != D->size()) {
+                        f.resize(D->size());
+                    }
+                    chunk_rows = std::max<std::size_t>(1, std::min(chunk_rows, f.size()));
+
+                    std::vector<typename FRI::field_type::value_type> chunk;
+                    for (std::size_t offset = 0; offset < f.size(); offset += chunk_rows) {
+                        chunk.assign(f.begin() + offset, f.begin() + std::min(offset + chunk_rows, f.size()));
+                        storage.write(column, offset, chunk);
+                    }
+                }
+
+                /// Builds the same Merkle tree as precommit of the list of the storage columns,
+                /// reading the columns in chunks of chunk_leaves leaves instead of holding them in memory.
+                template<typename FRI, typename StorageType,
+                        typename std::enable_if<
+                                std::is_base_of<
+                                        commitments::detail::basic_batched_fri<
+                                                typename FRI::field_type, typename FRI::merkle_tree_hash_type,
+                                                typename FRI::transcript_hash_type,
+                                                FRI::lambda, FRI::m, FRI::batches_num>,
+                                        FRI>::value,
+                                bool>::type = true>
+                static typename FRI::precommitment_type
+                precommit_storage(const StorageType &storage,
+                                  std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> D,
+                                  const std::size_t fri_step,
+                                  const std::size_t chunk_leaves) {
+                    BOOST_ASSERT(storage.rows() == D->size());
+
+                    std::size_t leafs_number = D->size() >> fri_step;
+                    commitments::detail::storage_leaf_iterator<FRI, StorageType> first(storage, fri_step,
+                                                                                       chunk_leaves, 0);
+
+                    return build_merkle_tree<FRI>(first, first.at(leafs_number));
+                }
+
                 template<typename FRI>
                 static inline typename FRI::merkle_proof_type
                 make_proof_specialized(const std::size_t x_index, const std::size_t domain_size,
@@ -542,6 +803,55 @@ namespace nil {
                     return correct_order_idx;
                 }
 
+                static inline std::array<std::uint8_t, 8> proof_of_work_bytes(std::uint64_t nonce) {
+                    std::array<std::uint8_t, 8> result;
+                    for (std::size_t i = 0; i < result.size(); i++) {
+                        result[i] = std::uint8_t(nonce >> (8 * (result.size() - 1 - i)));
+                    }
+                    return result;
+                }
+
+                /// True if the transcript, after absorbing the nonce, yields a 64-bit challenge with the given
+                /// number of leading zero bits. The transcript itself is left unchanged. Always false for 64 or
+                /// more bits.
+                template<typename FRI>
+                static bool check_proof_of_work(const typename FRI::transcript_type &transcript, std::uint64_t nonce,
+                                                std::size_t grinding_bits) {
+                    if (grinding_bits == 0) {
+                        return true;
+                    }
+                    if (grinding_bits >= 64) {
+                        return false;
+                    }
+                    typename FRI::transcript_type nonce_transcript = transcript;
+                    nonce_transcript(proof_of_work_bytes(nonce));
+                    return (nonce_transcript.template int_challenge<std::uint64_t>() >> (64 - grinding_bits)) == 0;
+                }
+
+                /**
+                 * Smallest nonce passing check_proof_of_work. Nonces are tested in batches, each batch in
+                 * parallel, so the result does not depend on the number of threads.
+                 */
+                template<typename FRI>
+                static std::uint64_t find_proof_of_work(const typename FRI::transcript_type &transcript,
+                                                        std::size_t grinding_bits) {
+                    const std::uint64_t batch_size = std::uint64_t(1) << std::min<std::size_t>(grinding_bits, 16);
+                    for (std::uint64_t batch_begin = 0;; batch_begin += batch_size) {
+                        std::uint64_t found = std::numeric_limits<std::uint64_t>::max();
+#ifdef MULTICORE
+#pragma omp parallel for reduction(min : found)
+#endif
+                        for (std::uint64_t nonce = batch_begin; nonce < batch_begin + batch_size; nonce++) {
+                            if (nonce < found && check_proof_of_work<FRI>(transcript, nonce, grinding_bits)) {
+                                found = nonce;
+                            }
+                        }
+                        if (found != std::numeric_limits<std::uint64_t>::max()) {
+                            return found;
+                        }
+                    }
+                }
+
                 template<typename FRI, typename PolynomialType>
                 static typename FRI::proof_type proof_eval(
                         std::array<std::vector<PolynomialType>, FRI::batches_num> &g,
@@ -551,6 +861,8 @@ namespace nil {
                         const typename FRI::params_type &fri_params,
                         typename FRI::transcript_type &transcript
                 ) {
+                    // grinding_bits may have been assigned after construction; the nonce search must terminate
+                    FRI::params_type::check_grinding_bits(fri_params.grinding_bits);
                     BOOST_ASSERT(check_step_list<FRI>(fri_params));
                     // TODO: add necessary checks
                     //BOOST_ASSERT(check_initial_precommitment<FRI>(precommitments, fri_params));
@@ -604,6 +916,12 @@ namespace nil {
                         final_polynomial = f;
                     }
 
+                    std::uint64_t proof_of_work = 0;
+                    if (fri_params.grinding_bits != 0) {
+                        proof_of_work = find_proof_of_work<FRI>(transcript, fri_params.grinding_bits);
+                        transcript(proof_of_work_bytes(proof_of_work));
+                    }
+
                     // Query phase
                     std::array<typename FRI::query_proof_type, FRI::lambda> query_proofs;
                     for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
@@ -699,22 +1017,37 @@ namespace nil {
                         query_proofs[query_id] = query_proof;
                     }
 
-                    return typename FRI::proof_type{fri_roots, final_polynomial, query_proofs};
+                    return typename FRI::proof_type{fri_roots, final_polynomial, query_proofs, proof_of_work};
                 }
 
+                /**
+                 * Verifies the FRI proof of sum_e (Q_e - U_e) / D_e, where Q_e is the theta-combination of
+                 * the committed polynomials mapped to e by evals_map, D_e = prod_i (X - eval_points[e][i])
+                 * and U_e interpolates combined_values[e][i] at eval_points[e][i]. An empty set of points
+                 * stands for U_e = 0, D_e = 1.
+                 *
+                 * U_e / D_e is evaluated in the barycentric form sum_i combined_values[e][i] * w_i / (s - p_i)
+                 * with w_i = 1 / prod_{k != i} (p_i - p_k). The differences s - p_i for the cosets of all
+                 * queries, together with the barycentric weights, are inverted in one batch.
+                 */
                 template<typename FRI>
-                static bool verify_eval(const typename FRI::proof_type &proof,
-                                        const typename FRI::params_type &fri_params,
-                                        const std::array<typename FRI::commitment_type, FRI::batches_num> &commitments,
-                                        const typename FRI::field_type::value_type theta,
-                                        const std::vector<std::size_t> &evals_map,
-                                        const std::vector<math::polynomial<typename FRI::field_type::value_type>> &combined_U,
-                                        const std::vector<math::polynomial<typename FRI::field_type::value_type>> &denominators,
-                                        typename FRI::transcript_type &transcript
+                static bool verify_eval(
+                        const typename FRI::proof_type &proof,
+                        const typename FRI::params_type &fri_params,
+                        const std::array<typename FRI::commitment_type, FRI::batches_num> &commitments,
+                        const typename FRI::field_type::value_type theta,
+                        const std::vector<std::size_t> &evals_map,
+                        const std::vector<std::vector<typename FRI::field_type::value_type>> &eval_points,
+                        const std::vector<std::vector<typename FRI::field_type::value_type>> &combined_values,
+                        typename FRI::transcript_type &transcript
                 ) {
-                    BOOST_ASSERT(check_step_list<FRI>(fri_params));
-                    BOOST_ASSERT(combined_U.size() == denominators.size());
-                    std::size_t evals_num = combined_U.size();
+                    typedef typename FRI::field_type::value_type value_type;
+
+                    if (!check_step_list<FRI>(fri_params)) {
+                        return false;
+                    }
+                    BOOST_ASSERT(eval_points.size() == combined_values.size());
+                    std::size_t evals_num = eval_points.size();
 
                     // Parameters correctness checks
                     std::size_t polynomials_number = 0;
@@ -741,49 +1074,130 @@ namespace nil {
                         }
                     }
 
-                    for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
-                        const typename FRI::query_proof_type &query_proof = proof.query_proofs[query_id];
-
-                        std::size_t domain_size = fri_params.D[0]->size();
-                        std::size_t coset_size = 1 << fri_params.step_list[0];
-                        std::uint64_t x_index = (transcript.template int_challenge<std::uint64_t>()) % domain_size;
-                        typename FRI::field_type::value_type x = fri_params.D[0]->get_domain_element(x_index);
+                    if (fri_params.grinding_bits != 0) {
+                        if (!check_proof_of_work<FRI>(transcript, proof.proof_of_work, fri_params.grinding_bits)) {
+                            return false;
+                        }
+                        transcript(proof_of_work_bytes(proof.proof_of_work));
+                    }
 
-                        std::vector<std::array<typename FRI::field_type::value_type, FRI::m>> s;
-                        std::vector<std::array<std::size_t, FRI::m>> s_indices;
-                        std::tie(s, s_indices) = calculate_s<FRI>(x, x_index, fri_params.step_list[0], fri_params.D[0]);
-                        auto correct_order_idx = get_correct_order<FRI>(x_index, domain_size, fri_params.step_list[0],
-                                                                        s_indices);
+                    // The query positions are the only transcript challenges drawn from here on
+                    const std::size_t first_coset_size = std::size_t(1) << fri_params.step_list[0];
+                    std::vector<std::uint64_t> x_indices(FRI::lambda);
+                    std::vector<std::vector<std::array<value_type, FRI::m>>> first_s(FRI::lambda);
+                    std::vector<std::vector<std::array<std::size_t, FRI::m>>> first_s_indices(FRI::lambda);
+                    for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
+                        x_indices[query_id] =
+                            (transcript.template int_challenge<std::uint64_t>()) % fri_params.D[0]->size();
+                        std::tie(first_s[query_id], first_s_indices[query_id]) =
+                            calculate_s<FRI>(fri_params.D[0]->get_domain_element(x_indices[query_id]),
+                                             x_indices[query_id], fri_params.step_list[0], fri_params.D[0]);
+                    }
 
+                    // inverses = [barycentric weights of all point sets | (s - p) for all queries, s and p]
+                    std::vector<std::size_t> point_offsets(evals_num + 1, 0);
+                    for (std::size_t eval_ind = 0; eval_ind < evals_num; eval_ind++) {
+                        BOOST_ASSERT(eval_points[eval_ind].size() == combined_values[eval_ind].size());
+                        point_offsets[eval_ind + 1] = point_offsets[eval_ind] + eval_points[eval_ind].size();
+                    }
+                    const std::size_t points_num = point_offsets[evals_num];
+                    const std::size_t query_stride = first_coset_size * points_num;
+
+                    std::vector<value_type> inverses(points_num + FRI::lambda * query_stride);
+                    for (std::size_t eval_ind = 0; eval_ind < evals_num; eval_ind++) {
+                        const std::vector<value_type> &points = eval_points[eval_ind];
+                        for (std::size_t i = 0; i < points.size(); i++) {
+                            value_type product = value_type::one();
+                            for (std::size_t k = 0; k < points.size(); k++) {
+                                if (k != i) {
+                                    product *= points[i] - points[k];
+                                }
+                            }
+                            inverses[point_offsets[eval_ind] + i] = product;
+                        }
+                    }
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                    for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
+                        for (std::size_t j = 0; j < first_coset_size / FRI::m; j++) {
+                            for (std::size_t b = 0; b < FRI::m; b++) {
+                                const std::size_t offset =
+                                    points_num + query_id * query_stride + (j * FRI::m + b) * points_num;
+                                for (std::size_t eval_ind = 0; eval_ind < evals_num; eval_ind++) {
+                                    for (std::size_t i = 0; i < eval_points[eval_ind].size(); i++) {
+                                        inverses[offset + point_offsets[eval_ind] + i] =
+                                            first_s[query_id][j][b] - eval_points[eval_ind][i];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    zk::detail::batch_invert(inverses);
+
+                    // combined_values[e][i] * w_i
+                    std::vector<value_type> weighted_values(points_num);
+                    for (std::size_t eval_ind = 0; eval_ind < evals_num; eval_ind++) {
+                        for (std::size_t i = 0; i < eval_points[eval_ind].size(); i++) {
+                            weighted_values[point_offsets[eval_ind] + i] =
+                                combined_values[eval_ind][i] * inverses[point_offsets[eval_ind] + i];
+                        }
+                    }
 
-                        // Check initial proof.
+                    // The Merkle paths of all queries, batches and rounds are checked together once the
+                    // other checks pass, see zk::detail::batch_validate_merkle_proofs. The leaves of the
+                    // initial proofs do not depend on the folding and are built up front.
+                    std::vector<const typename FRI::merkle_proof_type *> merkle_proofs;
+                    std::vector<typename FRI::leaf_type> merkle_leaves;
+                    std::vector<std::pair<std::size_t, const typename FRI::initial_proof_type *>> initial_proofs;
+                    for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
                         for (std::size_t k = 0; k < FRI::batches_num; k++) {
-                            if (query_proof.initial_proof[k].values.size() == 0)
-                                continue; // For the case when some of the batches is zero
-                            if (query_proof.initial_proof[k].p.root() != commitments[k]) {
+                            const auto &initial_proof = proof.query_proofs[query_id].initial_proof[k];
+                            if (initial_proof.values.size() == 0) {
+                                continue;    // For the case when some of the batches is zero
+                            }
+                            if (initial_proof.p.root() != commitments[k]) {
                                 return false;
                             }
+                            merkle_proofs.emplace_back(&initial_proof.p);
+                            initial_proofs.emplace_back(query_id, &initial_proof);
+                        }
+                    }
 
-                            std::vector<std::uint8_t> leaf_data(coset_size * FRI::field_element_type::length() *
-                                                                query_proof.initial_proof[k].values.size());
-                            auto write_iter = leaf_data.begin();
-
-                            for (std::size_t i = 0; i < query_proof.initial_proof[k].values.size(); i++) {
-                                for (auto [idx, pair_idx]: correct_order_idx) {
-                                    typename FRI::field_element_type leaf_val0(
-                                            query_proof.initial_proof[k].values[i][idx][pair_idx]
-                                    );
-                                    leaf_val0.write(write_iter, FRI::field_element_type::length());
-                                    typename FRI::field_element_type leaf_val1(
-                                            query_proof.initial_proof[k].values[i][idx][1 - pair_idx]
-                                    );
-                                    leaf_val1.write(write_iter, FRI::field_element_type::length());
-                                }
-                            }
-                            if (!query_proof.initial_proof[k].p.validate(leaf_data)) {
-                                return false;
+                    merkle_leaves.resize(initial_proofs.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                    for (std::size_t task = 0; task < initial_proofs.size(); task++) {
+                        const std::size_t query_id = initial_proofs[task].first;
+                        const typename FRI::initial_proof_type &initial_proof = *initial_proofs[task].second;
+
+                        auto correct_order_idx =
+                            get_correct_order<FRI>(x_indices[query_id], fri_params.D[0]->size(),
+                                                   fri_params.step_list[0], first_s_indices[query_id]);
+                        typename FRI::leaf_type &leaf_data = merkle_leaves[task];
+                        leaf_data.resize(first_coset_size * FRI::leaf_value_size() * initial_proof.values.size());
+                        auto write_iter = leaf_data.begin();
+                        for (std::size_t i = 0; i < initial_proof.values.size(); i++) {
+                            for (auto [idx, pair_idx] : correct_order_idx) {
+                                commitments::detail::write_leaf_value<FRI>(write_iter,
+                                    initial_proof.values[i][idx][pair_idx]);
+                                commitments::detail::write_leaf_value<FRI>(write_iter,
+                                    initial_proof.values[i][idx][1 - pair_idx]);
                             }
                         }
+                    }
+
+                    for (std::size_t query_id = 0; query_id < FRI::lambda; query_id++) {
+                        const typename FRI::query_proof_type &query_proof = proof.query_proofs[query_id];
+
+                        std::size_t domain_size = fri_params.D[0]->size();
+                        std::size_t coset_size = first_coset_size;
+                        std::uint64_t x_index = x_indices[query_id];
+                        typename FRI::field_type::value_type x = fri_params.D[0]->get_domain_element(x_index);
+
+                        std::vector<std::array<typename FRI::field_type::value_type, FRI::m>> s = first_s[query_id];
+                        std::vector<std::array<std::size_t, FRI::m>> s_indices = first_s_indices[query_id];
 
                         //Calculate combinedQ values
                         typename FRI::polynomial_values_type y;
@@ -812,14 +1226,21 @@ namespace nil {
                                     }
                                 }
                             }
+                            // (Q(s) - U(s)) / D(s) = Q(s) * prod_i 1 / (s - p_i) - sum_i c_i w_i / (s - p_i)
                             for (size_t j = 0; j < coset_size / FRI::m; j++) {
-                                combined_eval_values[j][0] -= combined_U[eval_ind].evaluate(s[j][0]);
-                                combined_eval_values[j][1] -= combined_U[eval_ind].evaluate(s[j][1]);
-                                combined_eval_values[j][0] /= denominators[eval_ind].evaluate(s[j][0]);
-                                combined_eval_values[j][1] /= denominators[eval_ind].evaluate(s[j][1]);
-
-                                y[j][0] += combined_eval_values[j][0];
-                                y[j][1] += combined_eval_values[j][1];
+                                for (std::size_t b = 0; b < FRI::m; b++) {
+                                    const value_type *s_minus_p_inv = inverses.data() + points_num +
+                                                                      query_id * query_stride +
+                                                                      (j * FRI::m + b) * points_num;
+                                    value_type denominator_inv = value_type::one();
+                                    value_type interpolant = value_type::zero();
+                                    for (std::size_t i = point_offsets[eval_ind]; i < point_offsets[eval_ind + 1];
+                                         i++) {
+                                        denominator_inv *= s_minus_p_inv[i];
+                                        interpolant += weighted_values[i] * s_minus_p_inv[i];
+                                    }
+                                    y[j][b] += combined_eval_values[j][b] * denominator_inv - interpolant;
+                                }
                             }
                         }
 
@@ -832,19 +1253,16 @@ namespace nil {
 
                             std::tie(s, s_indices) = calculate_s<FRI>(x, x_index, fri_params.step_list[i],
                                                                       fri_params.D[t]);
-                            std::vector<std::uint8_t> leaf_data(coset_size * FRI::field_element_type::length());
+                            typename FRI::leaf_type leaf_data(coset_size * FRI::leaf_value_size());
                             auto write_iter = leaf_data.begin();
                             auto correct_order_idx =
                                     get_correct_order<FRI>(x_index, domain_size, fri_params.step_list[i], s_indices);
                             for (auto [idx, pair_idx]: correct_order_idx) {
-                                typename FRI::field_element_type leaf_val0(y[idx][pair_idx]);
-                                leaf_val0.write(write_iter, FRI::field_element_type::length());
-                                typename FRI::field_element_type leaf_val1(y[idx][1 - pair_idx]);
-                                leaf_val1.write(write_iter, FRI::field_element_type::length());
-                            }
-                            if (!query_proof.round_proofs[i].p.validate(leaf_data)) {
-                                return false;
+                                commitments::detail::write_leaf_value<FRI>(write_iter, y[idx][pair_idx]);
+                                commitments::detail::write_leaf_value<FRI>(write_iter, y[idx][1 - pair_idx]);
                             }
+                            merkle_proofs.emplace_back(&query_proof.round_proofs[i].p);
+                            merkle_leaves.emplace_back(std::move(leaf_data));
 
                             // colinear check
                             for (std::size_t step_i = 0; step_i < fri_params.step_list[i] - 1; step_i++, t++) {
@@ -908,7 +1326,8 @@ namespace nil {
                         }
                     }
 
-                    return true;
+                    return zk::detail::batch_validate_merkle_proofs<typename FRI::merkle_tree_hash_type, FRI::m>(
+                        merkle_proofs, merkle_leaves);
                 }
             }    // namespace algorithms
         }        // namespace zk
@@ -0,0 +1,176 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_COMMITMENTS_COLUMN_STORAGE_HPP
+#define CRYPTO3_ZK_COMMITMENTS_COLUMN_STORAGE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/marshalling/field_type.hpp>
+#include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+                    // Column-major storage of polynomial values over an evaluation domain.
+                    //
+                    // Streaming commitment code only accesses columns through read/write of
+                    // [offset, offset + chunk.size()) of one column, so a file-backed storage
+                    // providing the same members lets the prover commit to tables whose
+                    // extended columns do not fit in memory.
+                    template<typename FieldType>
+                    struct memory_column_storage {
+                        typedef FieldType field_type;
+                        typedef typename FieldType::value_type value_type;
+
+                        memory_column_storage(std::size_t columns, std::size_t rows) :
+                            data(columns, std::vector<value_type>(rows)) {
+                        }
+
+                        std::size_t columns() const {
+                            return data.size();
+                        }
+
+                        std::size_t rows() const {
+                            return data.empty() ? 0 : data.front().size();
+                        }
+
+                        void read(std::size_t column, std::size_t offset, std::vector<value_type> &chunk) const {
+                            BOOST_ASSERT(column < columns() && offset + chunk.size() <= rows());
+                            std::copy(data[column].begin() + offset, data[column].begin() + offset + chunk.size(),
+                                      chunk.begin());
+                        }
+
+                        void write(std::size_t column, std::size_t offset, const std::vector<value_type> &chunk) {
+                            BOOST_ASSERT(column < columns() && offset + chunk.size() <= rows());
+                            std::copy(chunk.begin(), chunk.end(), data[column].begin() + offset);
+                        }
+
+                    private:
+                        std::vector<std::vector<value_type>> data;
+                    };
+
+                    // Same interface backed by a file of fixed-size serialized field elements.
+                    // Only the chunks being read or written are resident in memory. The file is
+                    // created (or truncated) on construction and removed on destruction; use
+                    // zk::detail::create_temporary_file for a name no other storage uses. I/O
+                    // errors throw std::runtime_error.
+                    template<typename FieldType>
+                    struct file_column_storage {
+                        typedef FieldType field_type;
+                        typedef typename FieldType::value_type value_type;
+                        typedef nil::crypto3::marshalling::types::field_element<
+                            nil::marshalling::field_type<nil::marshalling::option::big_endian>, value_type>
+                            field_element_type;
+
+                        file_column_storage(const std::string &path, std::size_t columns, std::size_t rows) :
+                            path(path), columns_amount(columns), rows_amount(rows),
+                            file(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc) {
+                            if (!file.is_open()) {
+                                std::remove(path.c_str());
+                                throw std::runtime_error("cannot create column storage file " + path);
+                            }
+                        }
+
+                        file_column_storage(const file_column_storage &) = delete;
+                        file_column_storage &operator=(const file_column_storage &) = delete;
+
+                        ~file_column_storage() {
+                            file.close();
+                            std::remove(path.c_str());
+                        }
+
+                        std::size_t columns() const {
+                            return columns_amount;
+                        }
+
+                        std::size_t rows() const {
+                            return rows_amount;
+                        }
+
+                        void read(std::size_t column, std::size_t offset, std::vector<value_type> &chunk) const {
+                            BOOST_ASSERT(column < columns() && offset + chunk.size() <= rows());
+                            const std::size_t length = field_element_type::length();
+
+                            buffer.resize(chunk.size() * length);
+                            file.seekg(position(column, offset));
+                            file.read(reinterpret_cast<char *>(buffer.data()), buffer.size());
+                            if (!file.good()) {
+                                throw std::runtime_error("cannot read column storage file " + path);
+                            }
+
+                            auto read_iter = buffer.cbegin();
+                            for (std::size_t i = 0; i < chunk.size(); i++) {
+                                field_element_type element;
+                                element.read(read_iter, length);
+                                chunk[i] = element.value();
+                            }
+                        }
+
+                        void write(std::size_t column, std::size_t offset, const std::vector<value_type> &chunk) {
+                            BOOST_ASSERT(column < columns() && offset + chunk.size() <= rows());
+                            const std::size_t length = field_element_type::length();
+
+                            buffer.resize(chunk.size() * length);
+                            auto write_iter = buffer.begin();
+                            for (const value_type &value : chunk) {
+                                field_element_type element(value);
+                                element.write(write_iter, length);
+                            }
+
+                            file.seekp(position(column, offset));
+                            file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+                            file.flush();
+                            if (!file.good()) {
+                                throw std::runtime_error("cannot write column storage file " + path);
+                            }
+                        }
+
+                    private:
+                        std::streamoff position(std::size_t column, std::size_t offset) const {
+                            return static_cast<std::streamoff>((column * rows_amount + offset) *
+                                                               field_element_type::length());
+                        }
+
+                        std::string path;
+                        std::size_t columns_amount;
+                        std::size_t rows_amount;
+                        mutable std::fstream file;
+                        mutable std::vector<std::uint8_t> buffer;
+                    };
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_COMMITMENTS_COLUMN_STORAGE_HPP
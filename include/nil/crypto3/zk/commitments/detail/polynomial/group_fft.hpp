@@ -0,0 +1,153 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Radix-2 FFT over vectors of group elements.
+//
+// Converting powers of tau [tau^i]G into Lagrange coefficients [L_i(tau)]G is an
+// inverse FFT whose butterflies multiply group elements by field twiddles. Every
+// butterfly costs a scalar multiplication, so all butterflies of a level run in
+// parallel.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_COMMITMENTS_GROUP_FFT_HPP
+#define CRYPTO3_ZK_COMMITMENTS_GROUP_FFT_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+                    /// True if omega generates a multiplicative subgroup of the given power of two size,
+                    /// i.e. the group FFT below computes evaluations over a domain with this omega.
+                    template<typename FieldType>
+                    bool is_group_fft_root(std::size_t size, const typename FieldType::value_type &omega) {
+                        if (size < 2 || (size & (size - 1)) != 0) {
+                            return false;
+                        }
+                        return omega.pow(size / 2) == -FieldType::value_type::one();
+                    }
+
+                    /// In-place a_k <- sum_j a_j * omega^{jk}. The size of a must be a power of two and
+                    /// omega a primitive root of unity of that order.
+                    template<typename FieldType, typename GroupValueType>
+                    void group_fft(std::vector<GroupValueType> &a, const typename FieldType::value_type &omega) {
+                        typedef typename FieldType::value_type field_value_type;
+
+                        const std::size_t n = a.size();
+                        BOOST_ASSERT(n != 0 && (n & (n - 1)) == 0);
+                        if (n == 1) {
+                            return;
+                        }
+
+                        std::size_t log_n = 0;
+                        while ((std::size_t(1) << log_n) < n) {
+                            ++log_n;
+                        }
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t i = 0; i < n; ++i) {
+                            std::size_t r = 0;
+                            for (std::size_t b = 0; b < log_n; ++b) {
+                                r |= ((i >> b) & 1) << (log_n - 1 - b);
+                            }
+                            if (i < r) {
+                                std::swap(a[i], a[r]);
+                            }
+                        }
+
+                        // twiddles[j] = omega^j for j < n / 2, filled in parallel chunks
+                        const std::size_t half_n = n / 2;
+                        std::vector<field_value_type> twiddles(half_n);
+#ifdef MULTICORE
+                        const std::size_t chunks =
+                            std::max<std::size_t>(1, std::min<std::size_t>(omp_get_max_threads(), half_n));
+#else
+                        const std::size_t chunks = 1;
+#endif
+                        const std::size_t chunk_size = (half_n + chunks - 1) / chunks;
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 0; c < chunks; ++c) {
+                            const std::size_t begin = c * chunk_size;
+                            const std::size_t end = std::min(half_n, begin + chunk_size);
+                            if (begin >= end) {
+                                continue;
+                            }
+                            field_value_type power = omega.pow(begin);
+                            for (std::size_t j = begin; j < end; ++j) {
+                                twiddles[j] = power;
+                                power *= omega;
+                            }
+                        }
+
+                        for (std::size_t len = 2; len <= n; len <<= 1) {
+                            const std::size_t half = len / 2;
+                            const std::size_t stride = n / len;
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t b = 0; b < half_n; ++b) {
+                                const std::size_t k = (b / half) * len;
+                                const std::size_t j = b % half;
+                                const GroupValueType t =
+                                    j == 0 ? a[k + j + half] : twiddles[j * stride] * a[k + j + half];
+                                a[k + j + half] = a[k + j] - t;
+                                a[k + j] = a[k + j] + t;
+                            }
+                        }
+                    }
+
+                    /// In-place inverse of group_fft: a_j <- n^{-1} * sum_k a_k * omega^{-jk}.
+                    template<typename FieldType, typename GroupValueType>
+                    void group_inverse_fft(std::vector<GroupValueType> &a,
+                                           const typename FieldType::value_type &omega) {
+                        typedef typename FieldType::value_type field_value_type;
+
+                        group_fft<FieldType>(a, omega.inversed());
+
+                        const field_value_type size_inv = field_value_type(a.size()).inversed();
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t i = 0; i < a.size(); ++i) {
+                            a[i] = size_inv * a[i];
+                        }
+                    }
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_COMMITMENTS_GROUP_FFT_HPP
@@ -25,6 +25,13 @@
 #ifndef CRYPTO3_ZK_POWERS_OF_TAU_ACCUMULATOR_HPP
 #define CRYPTO3_ZK_POWERS_OF_TAU_ACCUMULATOR_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <vector>
 
 #include <nil/crypto3/zk/commitments/detail/polynomial/powers_of_tau/private_key.hpp>
@@ -41,7 +48,8 @@ namespace nil {
                         using g2_type = typename CurveType::template g2_type<>;
                         using g1_value_type = typename g1_type::value_type;
                         using g2_value_type = typename g2_type::value_type;
-                        using field_value_type = typename curve_type::scalar_field_type::value_type;
+                        using scalar_field_type = typename curve_type::scalar_field_type;
+                        using field_value_type = typename scalar_field_type::value_type;
                         using private_key_type = powers_of_tau_private_key<curve_type>;
 
                         // The maximum number of multiplication gates supported
@@ -87,71 +95,87 @@ namespace nil {
                         }
 
                         void transform(const private_key_type &key) {
-                            std::vector<field_value_type> taupowers;
-
-                            // Construct exponents
-                            // This could be parallelized
-                            auto acc = field_value_type::one();
-                            for (std::size_t i = 0; i < tau_powers_g1_length; ++i) {
-                                // taupowers[i] = tau^i
-                                taupowers.emplace_back(acc);
-                                acc *= key.tau;
-                            }
-
-                            // naive exp, could be parallelized
-                            naive_batch_exp(
-                                    tau_powers_g1.begin(), tau_powers_g1.end(), taupowers.begin(), taupowers.end());
-
-                            naive_batch_exp(
-                                    tau_powers_g2.begin(), tau_powers_g2.end(), taupowers.begin(), taupowers.end());
-
-                            naive_batch_exp_with_coeff(alpha_tau_powers_g1.begin(),
-                                                       alpha_tau_powers_g1.end(),
-                                                       taupowers.begin(),
-                                                       taupowers.end(),
-                                                       key.alpha);
-
-                            naive_batch_exp_with_coeff(beta_tau_powers_g1.begin(),
-                                                       beta_tau_powers_g1.end(),
-                                                       taupowers.begin(),
-                                                       taupowers.end(),
-                                                       key.beta);
+                            transform_range(tau_powers_g1.begin(), tau_powers_g1.end(), 0, key.tau,
+                                            field_value_type::one());
+                            transform_range(tau_powers_g2.begin(), tau_powers_g2.end(), 0, key.tau,
+                                            field_value_type::one());
+                            transform_range(alpha_tau_powers_g1.begin(), alpha_tau_powers_g1.end(), 0, key.tau,
+                                            key.alpha);
+                            transform_range(beta_tau_powers_g1.begin(), beta_tau_powers_g1.end(), 0, key.tau,
+                                            key.beta);
 
                             beta_g2 = beta_g2 * key.beta;
                         }
 
-                    private:
-                        template<typename PointIterator, typename ScalarIterator>
-                        void naive_batch_exp(const PointIterator &bases_begin,
-                                             const PointIterator &bases_end,
-                                             const ScalarIterator &pow_begin,
-                                             const ScalarIterator &pow_end) {
-                            BOOST_ASSERT(std::distance(bases_begin, bases_end) <= std::distance(pow_begin, pow_end));
-
-                            auto base_iter = bases_begin;
-                            auto pow_iter = pow_begin;
-                            while (base_iter < bases_end) {
-                                *base_iter = *pow_iter * *base_iter;
-                                ++base_iter;
-                                ++pow_iter;
+                        // Multiplies the elements [offset, offset + n) of an accumulator vector, given by the
+                        // range [bases_begin, bases_end), by coeff * tau^i. The range is split into independent
+                        // chunks, each of which starts from its own power of tau, so that a contribution can be
+                        // applied to a vector in parallel or one chunk at a time.
+                        template<typename PointIterator>
+                        static void transform_range(PointIterator bases_begin,
+                                                    PointIterator bases_end,
+                                                    std::size_t offset,
+                                                    const field_value_type &tau,
+                                                    const field_value_type &coeff) {
+                            const std::size_t size = std::distance(bases_begin, bases_end);
+#ifdef MULTICORE
+                            const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                                                 // var or call omp_set_num_threads()
+#else
+                            const std::size_t chunks = 1;
+#endif
+                            const std::size_t chunk_size = (size + chunks - 1) / chunks;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < chunks; ++i) {
+                                const std::size_t chunk_begin = std::min(size, i * chunk_size);
+                                const std::size_t chunk_end = std::min(size, chunk_begin + chunk_size);
+
+                                field_value_type power = coeff * tau.pow(offset + chunk_begin);
+                                for (PointIterator base_iter = bases_begin + chunk_begin;
+                                     base_iter != bases_begin + chunk_end;
+                                     ++base_iter) {
+                                    *base_iter = windowed_mul(*base_iter, power);
+                                    power *= tau;
+                                }
                             }
                         }
 
-                        template<typename PointIterator, typename ScalarIterator>
-                        void naive_batch_exp_with_coeff(const PointIterator &bases_begin,
-                                                        const PointIterator &bases_end,
-                                                        const ScalarIterator &pow_begin,
-                                                        const ScalarIterator &pow_end,
-                                                        const field_value_type &coeff) {
-                            BOOST_ASSERT(std::distance(bases_begin, bases_end) <= std::distance(pow_begin, pow_end));
-
-                            auto base_iter = bases_begin;
-                            auto pow_iter = pow_begin;
-                            while (base_iter < bases_end) {
-                                *base_iter = (coeff * *pow_iter) * *base_iter;
-                                ++base_iter;
-                                ++pow_iter;
+                        // Fixed-window scalar multiplication. Each point of an accumulator vector has its own
+                        // scalar, so the table of small multiples is built per point; with 4-bit windows it
+                        // still replaces about half of the additions of double-and-add.
+                        template<typename ValueType>
+                        static ValueType windowed_mul(const ValueType &base, const field_value_type &scalar) {
+                            constexpr std::size_t window = 4;
+                            constexpr std::size_t num_windows = (scalar_field_type::modulus_bits + window - 1) / window;
+                            const typename scalar_field_type::integral_type k(scalar.data);
+
+                            std::array<ValueType, (std::size_t(1) << window)> table;
+                            table[0] = ValueType::zero();
+                            for (std::size_t d = 1; d < table.size(); ++d) {
+                                table[d] = table[d - 1] + base;
+                            }
+
+                            ValueType result = ValueType::zero();
+                            for (std::size_t w = num_windows; w-- > 0;) {
+                                for (std::size_t j = 0; j < window; ++j) {
+                                    result = result.doubled();
+                                }
+
+                                std::size_t digit = 0;
+                                for (std::size_t j = 0; j < window && w * window + j < scalar_field_type::modulus_bits;
+                                     ++j) {
+                                    if (multiprecision::bit_test(k, w * window + j)) {
+                                        digit |= std::size_t(1) << j;
+                                    }
+                                }
+                                if (digit != 0) {
+                                    result = result + table[digit];
+                                }
                             }
+                            return result;
                         }
                     };
 
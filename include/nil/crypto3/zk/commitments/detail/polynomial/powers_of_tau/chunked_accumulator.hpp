@@ -0,0 +1,484 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_POWERS_OF_TAU_CHUNKED_ACCUMULATOR_HPP
+#define CRYPTO3_ZK_POWERS_OF_TAU_CHUNKED_ACCUMULATOR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/status_type.hpp>
+#include <nil/crypto3/marshalling/algebra/types/fast_curve_element.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/blake2b.hpp>
+
+#include <nil/crypto3/zk/commitments/detail/polynomial/powers_of_tau/accumulator.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/vector_pairs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace commitments {
+                namespace detail {
+                    enum class powers_of_tau_vector { tau_g1, tau_g2, alpha_tau_g1, beta_tau_g1 };
+
+                    // Chunk storage backed by an in-memory accumulator.
+                    //
+                    // Chunked ceremony operations only access an accumulator through
+                    // read/write of [offset, offset + chunk.size()) of one of its vectors
+                    // and through read_beta_g2/write_beta_g2. powers_of_tau_file_storage
+                    // provides the same members for accumulators which do not fit in memory.
+                    template<typename AccumulatorType>
+                    struct powers_of_tau_memory_storage {
+                        typedef typename std::remove_const<AccumulatorType>::type accumulator_type;
+                        typedef typename accumulator_type::g1_value_type g1_value_type;
+                        typedef typename accumulator_type::g2_value_type g2_value_type;
+
+                        explicit powers_of_tau_memory_storage(AccumulatorType &acc) : acc(acc) {
+                        }
+
+                        void read(powers_of_tau_vector v, std::size_t offset, std::vector<g1_value_type> &chunk) const {
+                            const std::vector<g1_value_type> &src = g1_vector(v);
+                            BOOST_ASSERT(offset + chunk.size() <= src.size());
+                            std::copy(src.begin() + offset, src.begin() + offset + chunk.size(), chunk.begin());
+                        }
+
+                        void read(powers_of_tau_vector v, std::size_t offset, std::vector<g2_value_type> &chunk) const {
+                            BOOST_ASSERT(v == powers_of_tau_vector::tau_g2);
+                            BOOST_ASSERT(offset + chunk.size() <= acc.tau_powers_g2.size());
+                            std::copy(acc.tau_powers_g2.begin() + offset,
+                                      acc.tau_powers_g2.begin() + offset + chunk.size(),
+                                      chunk.begin());
+                        }
+
+                        void write(powers_of_tau_vector v, std::size_t offset,
+                                   const std::vector<g1_value_type> &chunk) {
+                            std::vector<g1_value_type> &dst = g1_vector(v);
+                            BOOST_ASSERT(offset + chunk.size() <= dst.size());
+                            std::copy(chunk.begin(), chunk.end(), dst.begin() + offset);
+                        }
+
+                        void write(powers_of_tau_vector v, std::size_t offset,
+                                   const std::vector<g2_value_type> &chunk) {
+                            BOOST_ASSERT(v == powers_of_tau_vector::tau_g2);
+                            BOOST_ASSERT(offset + chunk.size() <= acc.tau_powers_g2.size());
+                            std::copy(chunk.begin(), chunk.end(), acc.tau_powers_g2.begin() + offset);
+                        }
+
+                        g2_value_type read_beta_g2() const {
+                            return acc.beta_g2;
+                        }
+
+                        void write_beta_g2(const g2_value_type &beta_g2) {
+                            acc.beta_g2 = beta_g2;
+                        }
+
+                    private:
+                        const std::vector<g1_value_type> &g1_vector(powers_of_tau_vector v) const {
+                            switch (v) {
+                                case powers_of_tau_vector::alpha_tau_g1:
+                                    return acc.alpha_tau_powers_g1;
+                                case powers_of_tau_vector::beta_tau_g1:
+                                    return acc.beta_tau_powers_g1;
+                                default:
+                                    BOOST_ASSERT(v == powers_of_tau_vector::tau_g1);
+                                    return acc.tau_powers_g1;
+                            }
+                        }
+
+                        std::vector<g1_value_type> &g1_vector(powers_of_tau_vector v) {
+                            switch (v) {
+                                case powers_of_tau_vector::alpha_tau_g1:
+                                    return acc.alpha_tau_powers_g1;
+                                case powers_of_tau_vector::beta_tau_g1:
+                                    return acc.beta_tau_powers_g1;
+                                default:
+                                    BOOST_ASSERT(v == powers_of_tau_vector::tau_g1);
+                                    return acc.tau_powers_g1;
+                            }
+                        }
+
+                        AccumulatorType &acc;
+                    };
+
+                    template<typename AccumulatorType>
+                    powers_of_tau_memory_storage<AccumulatorType> make_powers_of_tau_memory_storage(
+                        AccumulatorType &acc) {
+                        return powers_of_tau_memory_storage<AccumulatorType>(acc);
+                    }
+
+                    // Same interface backed by a file holding tau_g1, tau_g2, alpha_tau_g1 and beta_tau_g1
+                    // followed by beta_g2, every point serialized uncompressed with a fixed size. Only the
+                    // chunks being read or written are resident in memory. I/O errors throw
+                    // std::runtime_error.
+                    template<typename AccumulatorType>
+                    struct powers_of_tau_file_storage {
+                        typedef AccumulatorType accumulator_type;
+                        typedef typename accumulator_type::g1_type g1_type;
+                        typedef typename accumulator_type::g2_type g2_type;
+                        typedef typename accumulator_type::g1_value_type g1_value_type;
+                        typedef typename accumulator_type::g2_value_type g2_value_type;
+                        typedef nil::marshalling::field_type<nil::marshalling::option::little_endian> field_base_type;
+                        typedef nil::crypto3::marshalling::types::fast_curve_element<field_base_type, g1_type>
+                            g1_element_type;
+                        typedef nil::crypto3::marshalling::types::fast_curve_element<field_base_type, g2_type>
+                            g2_element_type;
+
+                        // Opens an existing accumulator file, e.g. one written by create.
+                        explicit powers_of_tau_file_storage(const std::string &path) :
+                            file(path, std::ios::in | std::ios::out | std::ios::binary) {
+                            if (!file.is_open()) {
+                                throw std::runtime_error("cannot open powers of tau accumulator file " + path);
+                            }
+                        }
+
+                        // Writes the initial accumulator, all of whose points are the generators, to path.
+                        static void create(const std::string &path, std::size_t chunk_size) {
+                            BOOST_ASSERT(chunk_size > 0);
+                            std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+                            if (!out.is_open()) {
+                                throw std::runtime_error("cannot create powers of tau accumulator file " + path);
+                            }
+
+                            std::vector<std::uint8_t> buffer;
+                            write_ones<g1_element_type>(out, buffer, accumulator_type::tau_powers_g1_length,
+                                                        chunk_size, g1_value_type::one());
+                            write_ones<g2_element_type>(out, buffer, accumulator_type::tau_powers_length,
+                                                        chunk_size, g2_value_type::one());
+                            write_ones<g1_element_type>(out, buffer, accumulator_type::tau_powers_length,
+                                                        chunk_size, g1_value_type::one());
+                            write_ones<g1_element_type>(out, buffer, accumulator_type::tau_powers_length,
+                                                        chunk_size, g1_value_type::one());
+                            write_ones<g2_element_type>(out, buffer, 1, chunk_size, g2_value_type::one());
+                            out.flush();
+                            if (!out.good()) {
+                                throw std::runtime_error("cannot write powers of tau accumulator file " + path);
+                            }
+                        }
+
+                        void read(powers_of_tau_vector v, std::size_t offset, std::vector<g1_value_type> &chunk) const {
+                            BOOST_ASSERT(v != powers_of_tau_vector::tau_g2);
+                            BOOST_ASSERT(offset + chunk.size() <= vector_length(v));
+                            read_points<g1_element_type>(position(v, offset), chunk);
+                        }
+
+                        void read(powers_of_tau_vector v, std::size_t offset, std::vector<g2_value_type> &chunk) const {
+                            BOOST_ASSERT(v == powers_of_tau_vector::tau_g2);
+                            BOOST_ASSERT(offset + chunk.size() <= vector_length(v));
+                            read_points<g2_element_type>(position(v, offset), chunk);
+                        }
+
+                        void write(powers_of_tau_vector v, std::size_t offset,
+                                   const std::vector<g1_value_type> &chunk) {
+                            BOOST_ASSERT(v != powers_of_tau_vector::tau_g2);
+                            BOOST_ASSERT(offset + chunk.size() <= vector_length(v));
+                            write_points<g1_element_type>(position(v, offset), chunk);
+                        }
+
+                        void write(powers_of_tau_vector v, std::size_t offset,
+                                   const std::vector<g2_value_type> &chunk) {
+                            BOOST_ASSERT(v == powers_of_tau_vector::tau_g2);
+                            BOOST_ASSERT(offset + chunk.size() <= vector_length(v));
+                            write_points<g2_element_type>(position(v, offset), chunk);
+                        }
+
+                        // Serializes points as they are laid out in the file.
+                        template<typename ElementType, typename ValueType>
+                        static void serialize(const std::vector<ValueType> &points, std::vector<std::uint8_t> &buffer) {
+                            const std::size_t length = ElementType(ValueType::one()).length();
+                            buffer.resize(points.size() * length);
+                            auto write_iter = buffer.begin();
+                            for (const ValueType &point : points) {
+                                ElementType element(point);
+                                if (element.write(write_iter, length) != nil::marshalling::status_type::success) {
+                                    throw std::runtime_error("cannot serialize a powers of tau point");
+                                }
+                            }
+                        }
+
+                        g2_value_type read_beta_g2() const {
+                            std::vector<g2_value_type> beta_g2(1);
+                            read_points<g2_element_type>(beta_g2_position(), beta_g2);
+                            return beta_g2.front();
+                        }
+
+                        void write_beta_g2(const g2_value_type &beta_g2) {
+                            write_points<g2_element_type>(beta_g2_position(), std::vector<g2_value_type>(1, beta_g2));
+                        }
+
+                    private:
+                        static std::size_t g1_size() {
+                            return g1_element_type(g1_value_type::one()).length();
+                        }
+
+                        static std::size_t g2_size() {
+                            return g2_element_type(g2_value_type::one()).length();
+                        }
+
+                        static std::size_t vector_length(powers_of_tau_vector v) {
+                            return v == powers_of_tau_vector::tau_g1 ? accumulator_type::tau_powers_g1_length :
+                                                                       accumulator_type::tau_powers_length;
+                        }
+
+                        static std::streamoff position(powers_of_tau_vector v, std::size_t offset) {
+                            const std::size_t tau_g1_bytes = accumulator_type::tau_powers_g1_length * g1_size();
+                            const std::size_t tau_g2_bytes = accumulator_type::tau_powers_length * g2_size();
+                            const std::size_t alpha_bytes = accumulator_type::tau_powers_length * g1_size();
+
+                            std::size_t result;
+                            switch (v) {
+                                case powers_of_tau_vector::tau_g2:
+                                    result = tau_g1_bytes + offset * g2_size();
+                                    break;
+                                case powers_of_tau_vector::alpha_tau_g1:
+                                    result = tau_g1_bytes + tau_g2_bytes + offset * g1_size();
+                                    break;
+                                case powers_of_tau_vector::beta_tau_g1:
+                                    result = tau_g1_bytes + tau_g2_bytes + alpha_bytes + offset * g1_size();
+                                    break;
+                                default:
+                                    result = offset * g1_size();
+                                    break;
+                            }
+                            return static_cast<std::streamoff>(result);
+                        }
+
+                        static std::streamoff beta_g2_position() {
+                            return static_cast<std::streamoff>(
+                                (accumulator_type::tau_powers_g1_length + 2 * accumulator_type::tau_powers_length) *
+                                    g1_size() +
+                                accumulator_type::tau_powers_length * g2_size());
+                        }
+
+                        template<typename ElementType, typename ValueType>
+                        static void write_ones(std::ofstream &out, std::vector<std::uint8_t> &buffer,
+                                               std::size_t length, std::size_t chunk_size, const ValueType &one) {
+                            for (std::size_t offset = 0; offset < length; offset += chunk_size) {
+                                const std::vector<ValueType> ones(std::min(chunk_size, length - offset), one);
+                                serialize<ElementType>(ones, buffer);
+                                out.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+                            }
+                        }
+
+                        template<typename ElementType, typename ValueType>
+                        void read_points(std::streamoff pos, std::vector<ValueType> &chunk) const {
+                            const std::size_t length = ElementType(ValueType::one()).length();
+                            buffer.resize(chunk.size() * length);
+                            file.seekg(pos);
+                            file.read(reinterpret_cast<char *>(buffer.data()), buffer.size());
+                            if (!file.good()) {
+                                throw std::runtime_error("cannot read powers of tau accumulator file");
+                            }
+
+                            auto read_iter = buffer.cbegin();
+                            for (ValueType &point : chunk) {
+                                ElementType element;
+                                if (element.read(read_iter, length) != nil::marshalling::status_type::success) {
+                                    throw std::runtime_error("malformed point in powers of tau accumulator file");
+                                }
+                                point = element.value();
+                            }
+                        }
+
+                        template<typename ElementType, typename ValueType>
+                        void write_points(std::streamoff pos, const std::vector<ValueType> &chunk) {
+                            serialize<ElementType>(chunk, buffer);
+                            file.seekp(pos);
+                            file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+                            file.flush();
+                            if (!file.good()) {
+                                throw std::runtime_error("cannot write powers of tau accumulator file");
+                            }
+                        }
+
+                        mutable std::fstream file;
+                        mutable std::vector<std::uint8_t> buffer;
+                    };
+
+                    // Applies and checks ceremony contributions one chunk of the accumulator at a time,
+                    // so that at most chunk_size (+1) points of one vector are resident in memory.
+                    template<typename CurveType, unsigned TauPowersLength>
+                    struct powers_of_tau_chunked_accumulator {
+                        typedef powers_of_tau_accumulator<CurveType, TauPowersLength> accumulator_type;
+                        typedef typename accumulator_type::g1_value_type g1_value_type;
+                        typedef typename accumulator_type::g2_value_type g2_value_type;
+                        typedef typename accumulator_type::field_value_type field_value_type;
+                        typedef typename accumulator_type::private_key_type private_key_type;
+                        typedef typename CurveType::scalar_field_type scalar_field_type;
+                        typedef powers_of_tau_file_storage<accumulator_type> file_storage_type;
+                        typedef hashes::blake2b<512> transcript_hash_type;
+
+                        template<typename StorageType>
+                        static void transform(const private_key_type &key, StorageType &storage,
+                                              std::size_t chunk_size) {
+                            BOOST_ASSERT(chunk_size > 0);
+
+                            transform_vector<g1_value_type>(storage, powers_of_tau_vector::tau_g1,
+                                                            accumulator_type::tau_powers_g1_length, chunk_size,
+                                                            key.tau, field_value_type::one());
+                            transform_vector<g2_value_type>(storage, powers_of_tau_vector::tau_g2,
+                                                            accumulator_type::tau_powers_length, chunk_size, key.tau,
+                                                            field_value_type::one());
+                            transform_vector<g1_value_type>(storage, powers_of_tau_vector::alpha_tau_g1,
+                                                            accumulator_type::tau_powers_length, chunk_size, key.tau,
+                                                            key.alpha);
+                            transform_vector<g1_value_type>(storage, powers_of_tau_vector::beta_tau_g1,
+                                                            accumulator_type::tau_powers_length, chunk_size, key.tau,
+                                                            key.beta);
+
+                            storage.write_beta_g2(storage.read_beta_g2() * key.beta);
+                        }
+
+                        // Adds a random linear combination of the pairs (v[i], v[i + 1]) of the given vector
+                        // to acc. Feeding several vectors which share the same ratio into one accumulator
+                        // yields a single pair to check.
+                        template<typename ValueType, typename StorageType>
+                        static void accumulate_power_pairs(const StorageType &storage,
+                                                           powers_of_tau_vector v,
+                                                           std::size_t length,
+                                                           std::size_t chunk_size,
+                                                           merge_pairs_accumulator<scalar_field_type, ValueType> &acc) {
+                            BOOST_ASSERT(chunk_size > 0);
+
+                            std::vector<ValueType> chunk;
+                            for (std::size_t offset = 0; offset + 1 < length; offset += chunk_size) {
+                                // Neighbouring chunks overlap by one element so that no pair is skipped
+                                chunk.resize(std::min(chunk_size, length - 1 - offset) + 1);
+                                storage.read(v, offset, chunk);
+                                acc.update(chunk.begin(), chunk.end() - 1, chunk.begin() + 1, chunk.end());
+                            }
+                        }
+
+                        // Copies all vectors and beta_g2 from one storage to another, e.g. to import an
+                        // in-memory accumulator into a file.
+                        template<typename SourceStorageType, typename TargetStorageType>
+                        static void copy(const SourceStorageType &source, TargetStorageType &target,
+                                         std::size_t chunk_size) {
+                            BOOST_ASSERT(chunk_size > 0);
+
+                            copy_vector<g1_value_type>(source, target, powers_of_tau_vector::tau_g1,
+                                                       accumulator_type::tau_powers_g1_length, chunk_size);
+                            copy_vector<g2_value_type>(source, target, powers_of_tau_vector::tau_g2,
+                                                       accumulator_type::tau_powers_length, chunk_size);
+                            copy_vector<g1_value_type>(source, target, powers_of_tau_vector::alpha_tau_g1,
+                                                       accumulator_type::tau_powers_length, chunk_size);
+                            copy_vector<g1_value_type>(source, target, powers_of_tau_vector::beta_tau_g1,
+                                                       accumulator_type::tau_powers_length, chunk_size);
+                            target.write_beta_g2(source.read_beta_g2());
+                        }
+
+                        // BLAKE2b-512 of the accumulator serialized as in powers_of_tau_file_storage, i.e. of
+                        // the contents of its file, hashed one chunk at a time.
+                        template<typename StorageType>
+                        static std::vector<std::uint8_t> compute_transcript(const StorageType &storage,
+                                                                            std::size_t chunk_size) {
+                            typedef typename file_storage_type::g1_element_type g1_element_type;
+                            typedef typename file_storage_type::g2_element_type g2_element_type;
+                            BOOST_ASSERT(chunk_size > 0);
+
+                            accumulator_set<transcript_hash_type> acc;
+                            std::vector<std::uint8_t> buffer;
+                            hash_vector<g1_element_type, g1_value_type>(storage, powers_of_tau_vector::tau_g1,
+                                                                        accumulator_type::tau_powers_g1_length,
+                                                                        chunk_size, buffer, acc);
+                            hash_vector<g2_element_type, g2_value_type>(storage, powers_of_tau_vector::tau_g2,
+                                                                        accumulator_type::tau_powers_length,
+                                                                        chunk_size, buffer, acc);
+                            hash_vector<g1_element_type, g1_value_type>(storage, powers_of_tau_vector::alpha_tau_g1,
+                                                                        accumulator_type::tau_powers_length,
+                                                                        chunk_size, buffer, acc);
+                            hash_vector<g1_element_type, g1_value_type>(storage, powers_of_tau_vector::beta_tau_g1,
+                                                                        accumulator_type::tau_powers_length,
+                                                                        chunk_size, buffer, acc);
+                            file_storage_type::template serialize<g2_element_type>(
+                                std::vector<g2_value_type>(1, storage.read_beta_g2()), buffer);
+                            nil::crypto3::hash<transcript_hash_type>(buffer.begin(), buffer.end(), acc);
+
+                            typename transcript_hash_type::digest_type digest =
+                                accumulators::extract::hash<transcript_hash_type>(acc);
+                            return std::vector<std::uint8_t>(digest.begin(), digest.end());
+                        }
+
+                        template<typename ValueType, typename StorageType>
+                        static std::vector<ValueType> read_prefix(const StorageType &storage,
+                                                                  powers_of_tau_vector v,
+                                                                  std::size_t size) {
+                            std::vector<ValueType> prefix(size);
+                            storage.read(v, 0, prefix);
+                            return prefix;
+                        }
+
+                    private:
+                        template<typename ValueType, typename StorageType>
+                        static void transform_vector(StorageType &storage,
+                                                     powers_of_tau_vector v,
+                                                     std::size_t length,
+                                                     std::size_t chunk_size,
+                                                     const field_value_type &tau,
+                                                     const field_value_type &coeff) {
+                            std::vector<ValueType> chunk;
+                            for (std::size_t offset = 0; offset < length; offset += chunk_size) {
+                                chunk.resize(std::min(chunk_size, length - offset));
+                                storage.read(v, offset, chunk);
+                                accumulator_type::transform_range(chunk.begin(), chunk.end(), offset, tau, coeff);
+                                storage.write(v, offset, chunk);
+                            }
+                        }
+
+                        template<typename ElementType, typename ValueType, typename StorageType>
+                        static void hash_vector(const StorageType &storage, powers_of_tau_vector v, std::size_t length,
+                                                std::size_t chunk_size, std::vector<std::uint8_t> &buffer,
+                                                accumulator_set<transcript_hash_type> &acc) {
+                            std::vector<ValueType> chunk;
+                            for (std::size_t offset = 0; offset < length; offset += chunk_size) {
+                                chunk.resize(std::min(chunk_size, length - offset));
+                                storage.read(v, offset, chunk);
+                                file_storage_type::template serialize<ElementType>(chunk, buffer);
+                                nil::crypto3::hash<transcript_hash_type>(buffer.begin(), buffer.end(), acc);
+                            }
+                        }
+
+                        template<typename ValueType, typename SourceStorageType, typename TargetStorageType>
+                        static void copy_vector(const SourceStorageType &source, TargetStorageType &target,
+                                                powers_of_tau_vector v, std::size_t length, std::size_t chunk_size) {
+                            std::vector<ValueType> chunk;
+                            for (std::size_t offset = 0; offset < length; offset += chunk_size) {
+                                chunk.resize(std::min(chunk_size, length - offset));
+                                source.read(v, offset, chunk);
+                                target.write(v, offset, chunk);
+                            }
+                        }
+                    };
+                }    // namespace detail
+            }        // namespace commitments
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_POWERS_OF_TAU_CHUNKED_ACCUMULATOR_HPP
@@ -25,8 +25,14 @@
 #ifndef CRYPTO3_ZK_POWERS_OF_TAU_RESULT_HPP
 #define CRYPTO3_ZK_POWERS_OF_TAU_RESULT_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <utility>
 #include <vector>
 
+#include <nil/crypto3/zk/commitments/detail/polynomial/group_fft.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/powers_of_tau/accumulator.hpp>
 
 #include <nil/crypto3/math/polynomial/basic_operations.hpp>
@@ -83,28 +89,47 @@ namespace nil {
 
                             BOOST_ASSERT(domain_g1->m <= TauPowersLength);
 
-                            std::vector<g1_value_type> coeffs_g1 = domain_g1->evaluate_all_lagrange_polynomials(
-                                    acc.tau_powers_g1.begin(), acc.tau_powers_g1.end());
-
-                            std::vector<g2_value_type> coeffs_g2 = domain_g2->evaluate_all_lagrange_polynomials(
-                                    acc.tau_powers_g2.begin(), acc.tau_powers_g2.end());
-
-                            std::vector<g1_value_type> alpha_coeffs_g1 = domain_g1->evaluate_all_lagrange_polynomials(
+                            std::vector<g1_value_type> coeffs_g1, alpha_coeffs_g1, beta_coeffs_g1;
+                            std::vector<g2_value_type> coeffs_g2;
+
+                            // Over a multiplicative subgroup the Lagrange coefficients are the inverse
+                            // FFT of the powers, computed with the parallel group FFT
+                            const scalar_field_value_type omega = domain_g1->get_domain_element(1);
+                            if (is_group_fft_root<scalar_field_type>(domain_g1->m, omega)) {
+                                coeffs_g1 = lagrange_coefficients(acc.tau_powers_g1, domain_g1->m, omega);
+                                coeffs_g2 = lagrange_coefficients(acc.tau_powers_g2, domain_g1->m, omega);
+                                alpha_coeffs_g1 = lagrange_coefficients(acc.alpha_tau_powers_g1, domain_g1->m, omega);
+                                beta_coeffs_g1 = lagrange_coefficients(acc.beta_tau_powers_g1, domain_g1->m, omega);
+                            } else {
+                                coeffs_g1 = domain_g1->evaluate_all_lagrange_polynomials(acc.tau_powers_g1.begin(),
+                                                                                         acc.tau_powers_g1.end());
+                                coeffs_g2 = domain_g2->evaluate_all_lagrange_polynomials(acc.tau_powers_g2.begin(),
+                                                                                         acc.tau_powers_g2.end());
+                                alpha_coeffs_g1 = domain_g1->evaluate_all_lagrange_polynomials(
                                     acc.alpha_tau_powers_g1.begin(), acc.alpha_tau_powers_g1.end());
-
-                            std::vector<g1_value_type> beta_coeffs_g1 = domain_g1->evaluate_all_lagrange_polynomials(
+                                beta_coeffs_g1 = domain_g1->evaluate_all_lagrange_polynomials(
                                     acc.beta_tau_powers_g1.begin(), acc.beta_tau_powers_g1.end());
+                            }
 
                             std::vector<g1_value_type> h(m - 1, g1_value_type::zero());
 
                             math::polynomial<scalar_field_value_type> Z = domain_g1->get_vanishing_polynomial();
 
+                            // Z is sparse (x^m - 1 for a subgroup), only its nonzero coefficients are visited
+                            std::vector<std::pair<std::size_t, scalar_field_value_type>> Z_terms;
+                            for (std::size_t j = 0; j < Z.size(); ++j) {
+                                if (!Z[j].is_zero()) {
+                                    Z_terms.emplace_back(j, Z[j]);
+                                }
+                            }
+
                             // H[i] = t**i * Z(t)
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
                             for (std::size_t i = 0; i < m - 1; ++i) {
-                                for (std::size_t j = 0; j < Z.size(); ++j) {
-                                    if (!Z[j].is_zero()) {
-                                        h[i] = h[i] + Z[j] * acc.tau_powers_g1[i + j];
-                                    }
+                                for (const auto &term : Z_terms) {
+                                    h[i] = h[i] + term.second * acc.tau_powers_g1[i + term.first];
                                 }
                             }
 
@@ -117,6 +142,18 @@ namespace nil {
                                                         std::move(beta_coeffs_g1),
                                                         std::move(h));
                         }
+
+                    private:
+                        template<typename GroupValueType>
+                        static std::vector<GroupValueType>
+                            lagrange_coefficients(const std::vector<GroupValueType> &powers,
+                                                  std::size_t size,
+                                                  const scalar_field_value_type &omega) {
+                            BOOST_ASSERT(powers.size() >= size);
+                            std::vector<GroupValueType> result(powers.begin(), powers.begin() + size);
+                            group_inverse_fft<scalar_field_type>(result, omega);
+                            return result;
+                        }
                     };
                 }    // namespace detail
             }        // namespace commitments
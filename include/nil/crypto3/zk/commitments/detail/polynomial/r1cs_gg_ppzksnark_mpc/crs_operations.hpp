@@ -1,8 +1,16 @@
 #ifndef CRYPTO3_ZK_R1CS_GG_PPZKSNARK_CRS_OPERATIONS_HPP
 #define CRYPTO3_ZK_R1CS_GG_PPZKSNARK_CRS_OPERATIONS_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <map>
 #include <vector>
 
+#include <nil/crypto3/algebra/multiexp/multiexp.hpp>
+#include <nil/crypto3/algebra/multiexp/policies.hpp>
+
 #include <nil/crypto3/zk/snark/reductions/r1cs_to_qap.hpp>
 #include <nil/crypto3/container/accumulation_vector.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/knowledge_commitment.hpp>
@@ -15,6 +23,46 @@ namespace nil {
         namespace zk {
             namespace commitments {
                 namespace detail {
+                    // Appends the terms coeff * basis[lag] of one variable in the Lagrange basis.
+                    template<typename GroupValueType, typename FieldValueType>
+                    void gather_lagrange_terms(const std::map<std::size_t, FieldValueType> &terms,
+                                               const std::vector<GroupValueType> &basis,
+                                               std::vector<GroupValueType> &bases,
+                                               std::vector<FieldValueType> &scalars) {
+                        for (const auto &[lag, coeff] : terms) {
+                            bases.push_back(basis[lag]);
+                            scalars.push_back(coeff);
+                        }
+                    }
+
+                    // Appends only the bases basis[lag], for a second group whose scalars were already gathered.
+                    template<typename GroupValueType, typename FieldValueType>
+                    void gather_lagrange_terms(const std::map<std::size_t, FieldValueType> &terms,
+                                               const std::vector<GroupValueType> &basis,
+                                               std::vector<GroupValueType> &bases) {
+                        for (const auto &term : terms) {
+                            bases.push_back(basis[term.first]);
+                        }
+                    }
+
+                    // sum_k scalars[k] * bases[k]. Most variables have a handful of terms which are
+                    // added directly; variables used by many constraints go through a multiexponentiation.
+                    template<typename GroupValueType, typename FieldValueType>
+                    GroupValueType lagrange_combination(const std::vector<GroupValueType> &bases,
+                                                        const std::vector<FieldValueType> &scalars) {
+                        constexpr static const std::size_t multiexp_threshold = 32;
+
+                        if (bases.size() < multiexp_threshold) {
+                            GroupValueType result = GroupValueType::zero();
+                            for (std::size_t k = 0; k < bases.size(); ++k) {
+                                result = result + scalars[k] * bases[k];
+                            }
+                            return result;
+                        }
+                        return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                            bases.begin(), bases.end(), scalars.begin(), scalars.end(), 1);
+                    }
+
                     template<typename CurveType>
                     typename snark::r1cs_gg_ppzksnark<CurveType>::keypair_type
                     make_r1cs_gg_ppzksnark_keypair_from_powers_of_tau(
@@ -55,21 +103,41 @@ namespace nil {
                         std::vector<g1_value_type> a_g1(qap.num_variables + 1, g1_value_type::zero());
                         std::vector<kc_value_type> b_kc(qap.num_variables + 1, kc_value_type::zero());
 
+                        // Every variable is an independent sparse combination of the Lagrange coefficients.
+                        // Term counts differ a lot between variables, so they are scheduled dynamically.
+#ifdef MULTICORE
+#pragma omp parallel for schedule(dynamic)
+#endif
                         for (std::size_t i = 0; i < qap.num_variables + 1; ++i) {
-                            for (auto [lag, coeff]: qap.A_in_Lagrange_basis[i]) {
-                                a_g1[i] = a_g1[i] + coeff * powers_of_tau_result.coeffs_g1[lag];
-                                beta_a_alpha_b_c[i] =
-                                        beta_a_alpha_b_c[i] + coeff * powers_of_tau_result.beta_coeffs_g1[lag];
-                            }
-                            for (auto [lag, coeff]: qap.B_in_Lagrange_basis[i]) {
-                                b_kc[i] = b_kc[i] + coeff * kc_value_type(powers_of_tau_result.coeffs_g2[lag],
-                                                                          powers_of_tau_result.coeffs_g1[lag]);
-                                beta_a_alpha_b_c[i] =
-                                        beta_a_alpha_b_c[i] + coeff * powers_of_tau_result.alpha_coeffs_g1[lag];
-                            }
-                            for (auto [lag, coeff]: qap.C_in_Lagrange_basis[i]) {
-                                beta_a_alpha_b_c[i] = beta_a_alpha_b_c[i] + coeff * powers_of_tau_result.coeffs_g1[lag];
-                            }
+                            using field_value_type = typename scalar_field_type::value_type;
+
+                            std::vector<g1_value_type> bases_g1;
+                            std::vector<g2_value_type> bases_g2;
+                            std::vector<field_value_type> scalars;
+
+                            gather_lagrange_terms(qap.A_in_Lagrange_basis[i], powers_of_tau_result.coeffs_g1,
+                                                  bases_g1, scalars);
+                            a_g1[i] = lagrange_combination(bases_g1, scalars);
+
+                            // B is a knowledge commitment, its G2 and G1 parts share the scalars
+                            bases_g1.clear();
+                            scalars.clear();
+                            gather_lagrange_terms(qap.B_in_Lagrange_basis[i], powers_of_tau_result.coeffs_g2,
+                                                  bases_g2, scalars);
+                            gather_lagrange_terms(qap.B_in_Lagrange_basis[i], powers_of_tau_result.coeffs_g1,
+                                                  bases_g1);
+                            b_kc[i] = kc_value_type(lagrange_combination(bases_g2, scalars),
+                                                    lagrange_combination(bases_g1, scalars));
+
+                            bases_g1.clear();
+                            scalars.clear();
+                            gather_lagrange_terms(qap.A_in_Lagrange_basis[i], powers_of_tau_result.beta_coeffs_g1,
+                                                  bases_g1, scalars);
+                            gather_lagrange_terms(qap.B_in_Lagrange_basis[i], powers_of_tau_result.alpha_coeffs_g1,
+                                                  bases_g1, scalars);
+                            gather_lagrange_terms(qap.C_in_Lagrange_basis[i], powers_of_tau_result.coeffs_g1,
+                                                  bases_g1, scalars);
+                            beta_a_alpha_b_c[i] = lagrange_combination(bases_g1, scalars);
                         }
 
                         auto alpha_g1 = powers_of_tau_result.alpha_g1;
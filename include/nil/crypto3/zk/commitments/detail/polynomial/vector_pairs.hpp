@@ -1,8 +1,17 @@
 #ifndef CRYPTO3_ZK_VECTOR_PAIRS_HPP
 #define CRYPTO3_ZK_VECTOR_PAIRS_HPP
 
-#include<vector>
-#include <nil/crypto3/algebra/multiexp/multiexp.hpp>
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <nil/crypto3/multiprecision/number.hpp>
+
 #include <nil/crypto3/algebra/random_element.hpp>
 
 namespace nil {
@@ -24,41 +33,156 @@ namespace nil {
                     // e(g, (as)*r1 + (bs)*r2 + (cs)*r3) = e(g^s, a*r1 + b*r2 + c*r3)
                     //
                     // ... with high probability.
+                    //
+                    // Instead of full-size scalars, every element gets a random 128-bit
+                    // challenge, which halves the number of MSM windows and keeps the
+                    // soundness error of the check below 2^-128.
+                    //
+                    // Both linear combinations are computed in one bucket pass: the
+                    // window digit of r_i selects a pair of buckets, to which v1[i] and
+                    // v2[i] are added. v1 and v2 may thus be shifted views of the same
+                    // base vector (see power_pairs).
+                    //
+                    // The accumulator can be updated chunk by chunk, so that the vectors
+                    // can be streamed instead of being kept in memory as a whole.
+                    template<typename FieldType, typename GroupValueType>
+                    class merge_pairs_accumulator {
+                        typedef typename FieldType::integral_type integral_type;
+
+                    public:
+                        typedef GroupValueType group_value_type;
+
+                        constexpr static const std::size_t challenge_bits = 128;
+
+                        merge_pairs_accumulator() :
+                            acc1(group_value_type::zero()), acc2(group_value_type::zero()) {
+                        }
+
+                        template<typename PointIterator1, typename PointIterator2>
+                        void update(PointIterator1 v1_begin,
+                                    PointIterator1 v1_end,
+                                    PointIterator2 v2_begin,
+                                    PointIterator2 v2_end) {
+                            BOOST_ASSERT(std::distance(v1_begin, v1_end) == std::distance(v2_begin, v2_end));
+
+                            const std::size_t size = std::distance(v1_begin, v1_end);
+                            if (size == 0) {
+                                return;
+                            }
+
+                            // Only the low challenge_bits bits of each element are used
+                            std::vector<integral_type> r;
+                            r.reserve(size);
+                            for (std::size_t i = 0; i < size; ++i) {
+                                r.emplace_back(integral_type(algebra::random_element<FieldType>().data));
+                            }
+
+#ifdef MULTICORE
+                            const std::size_t chunks = std::min<std::size_t>(omp_get_max_threads(), size);
+#else
+                            const std::size_t chunks = 1;
+#endif
+                            const std::size_t chunk_size = (size + chunks - 1) / chunks;
+                            std::vector<std::pair<group_value_type, group_value_type>> partial(
+                                chunks, std::make_pair(group_value_type::zero(), group_value_type::zero()));
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < chunks; ++i) {
+                                const std::size_t chunk_begin = std::min(size, i * chunk_size);
+                                const std::size_t chunk_end = std::min(size, chunk_begin + chunk_size);
+                                partial[i] = bucket_pass(v1_begin + chunk_begin, v2_begin + chunk_begin,
+                                                         r.cbegin() + chunk_begin, chunk_end - chunk_begin);
+                            }
+
+                            for (const auto &p : partial) {
+                                acc1 = acc1 + p.first;
+                                acc2 = acc2 + p.second;
+                            }
+                        }
+
+                        std::pair<group_value_type, group_value_type> result() const {
+                            return std::make_pair(acc1, acc2);
+                        }
+
+                    private:
+                        static std::size_t window_size(std::size_t size) {
+                            std::size_t c = 1;
+                            while (c < 16 && (std::size_t(4) << c) < size) {
+                                ++c;
+                            }
+                            return c;
+                        }
+
+                        template<typename PointIterator1, typename PointIterator2, typename ScalarIterator>
+                        static std::pair<group_value_type, group_value_type> bucket_pass(PointIterator1 v1,
+                                                                                         PointIterator2 v2,
+                                                                                         ScalarIterator r,
+                                                                                         std::size_t size) {
+                            const std::size_t c = window_size(size);
+                            const std::size_t num_windows = (challenge_bits + c - 1) / c;
+                            // Bucket d - 1 collects the elements with window digit d
+                            const std::size_t num_buckets = (std::size_t(1) << c) - 1;
+
+                            std::vector<group_value_type> buckets1(num_buckets);
+                            std::vector<group_value_type> buckets2(num_buckets);
+
+                            group_value_type res1 = group_value_type::zero();
+                            group_value_type res2 = group_value_type::zero();
+
+                            for (std::size_t w = num_windows; w-- > 0;) {
+                                for (std::size_t j = 0; j < c; ++j) {
+                                    res1 = res1.doubled();
+                                    res2 = res2.doubled();
+                                }
+
+                                std::fill(buckets1.begin(), buckets1.end(), group_value_type::zero());
+                                std::fill(buckets2.begin(), buckets2.end(), group_value_type::zero());
+
+                                for (std::size_t i = 0; i < size; ++i) {
+                                    std::size_t digit = 0;
+                                    for (std::size_t j = 0; j < c && w * c + j < challenge_bits; ++j) {
+                                        if (multiprecision::bit_test(r[i], w * c + j)) {
+                                            digit |= std::size_t(1) << j;
+                                        }
+                                    }
+                                    if (digit != 0) {
+                                        buckets1[digit - 1] = buckets1[digit - 1] + v1[i];
+                                        buckets2[digit - 1] = buckets2[digit - 1] + v2[i];
+                                    }
+                                }
+
+                                // sum_d d * bucket_d via running sums
+                                group_value_type running1 = group_value_type::zero();
+                                group_value_type running2 = group_value_type::zero();
+                                for (std::size_t d = num_buckets; d-- > 0;) {
+                                    running1 = running1 + buckets1[d];
+                                    running2 = running2 + buckets2[d];
+                                    res1 = res1 + running1;
+                                    res2 = res2 + running2;
+                                }
+                            }
+
+                            return std::make_pair(res1, res2);
+                        }
+
+                        group_value_type acc1;
+                        group_value_type acc2;
+                    };
 
                     template<typename FieldType, typename PointIterator>
-                    std::pair<typename PointIterator::value_type, typename PointIterator::value_type>
+                    std::pair<typename std::iterator_traits<PointIterator>::value_type,
+                              typename std::iterator_traits<PointIterator>::value_type>
                         merge_pairs(
                             const PointIterator &v1_begin,
                             const PointIterator &v1_end,
                             const PointIterator &v2_begin,
                             const PointIterator &v2_end) {
-                        using scalar_field_type = FieldType;
-                        using scalar_field_value_type = typename scalar_field_type::value_type;
-                        BOOST_ASSERT(std::distance(v1_begin, v1_end) == std::distance(v2_begin, v2_end));
-
-                        std::size_t size = std::distance(v1_begin, v1_end);
-                        std::vector<scalar_field_value_type> r;
-                        for(std::size_t i = 0; i < size; ++i) {
-                            r.emplace_back(algebra::random_element<scalar_field_type>());
-                        }
-
-                        typename PointIterator::value_type res1 =
-                            algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
-                                v1_begin,
-                                v1_end,
-                                r.begin(),
-                                r.end(),
-                                1);
-
-                        typename PointIterator::value_type res2 =
-                                algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
-                                    v2_begin,
-                                    v2_end,
-                                    r.begin(),
-                                    r.end(),
-                                    1);
-
-                        return std::make_pair(res1, res2);
+                        merge_pairs_accumulator<FieldType, typename std::iterator_traits<PointIterator>::value_type>
+                            acc;
+                        acc.update(v1_begin, v1_end, v2_begin, v2_end);
+                        return acc.result();
                     }
 
                     // Construct a single pair (s, s^x) for a vector of
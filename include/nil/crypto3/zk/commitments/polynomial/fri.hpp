@@ -132,13 +132,14 @@ namespace nil {
                     std::array<typename FRI::basic_fri::commitment_type, 1> t_roots = {t_root};
                     std::vector<std::size_t> evals_map = {0};
 
-                    const std::vector<math::polynomial<typename FRI::field_type::value_type>> combined_U = {{0}};
-                    const std::vector<math::polynomial<typename FRI::field_type::value_type>> combined_V = {{1}};
+                    // a single batch with no evaluation points: U = 0, D = 1
+                    const std::vector<std::vector<typename FRI::field_type::value_type>> eval_points(1);
+                    const std::vector<std::vector<typename FRI::field_type::value_type>> combined_values(1);
 
                     return verify_eval<typename FRI::basic_fri>(
                             proof, fri_params, t_roots,
                             FRI::basic_fri::field_type::value_type::one(),
-                            evals_map, combined_U, combined_V,
+                            evals_map, eval_points, combined_values,
                             transcript
                     );
                 }
@@ -26,9 +26,18 @@
 #ifndef CRYPTO3_ZK_KIMCHI_PEDERSEN_COMMITMENT_SCHEME_HPP
 #define CRYPTO3_ZK_KIMCHI_PEDERSEN_COMMITMENT_SCHEME_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
@@ -38,6 +47,9 @@
 #include <nil/crypto3/algebra/multiexp/policies.hpp>
 #include <nil/crypto3/algebra/multiexp/inner_product.hpp>
 
+#include <nil/marshalling/field_type.hpp>
+#include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
+
 #include <nil/crypto3/zk/transcript/kimchi_transcript.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/pickles/detail/mapping.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/pickles/detail/kimchi_functions.hpp>
@@ -60,6 +72,15 @@ namespace nil {
                     typedef snark::kimchi_functions<CurveType> functions;
                     // using multiexp = algebra::multiexp_with_mixed_addition<multiexp_method>;
 
+                    static std::size_t multiexp_chunks() {
+#ifdef MULTICORE
+                        return omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                         // var or call omp_set_num_threads()
+#else
+                        return 1;
+#endif
+                    }
+
                     struct params_type {
                         // vector of n distinct curve points of unknown discrete logarithm
                         std::vector<typename group_type::value_type> g;
@@ -90,19 +111,182 @@ namespace nil {
                         params_type() = default;
 
                         void add_lagrange_basis(math::basic_radix2_domain<scalar_field_type> &domain) {
-                            std::size_t n = domain.size();
-                            BOOST_ASSERT_MSG(n <= g.size(),
-                                             "add lagrange basis: Domain size {} larger than SRS size {}");
+                            lagrange_basis(domain);
+                        }
 
-                            if (lagrange_bases.contains(n)) {
-                                return;
+                        // Commitments to the Lagrange basis polynomials of the domain, i.e. the inverse FFT
+                        // of the SRS over the domain. They are computed once per domain size and kept in
+                        // lagrange_bases. Safe to call from several verifiers sharing the SRS; the returned
+                        // reference stays valid as long as lagrange_bases is not modified directly.
+                        //
+                        // If the domain is larger than the SRS, every Lagrange polynomial is committed in
+                        // chunks of g.size() coefficients: chunk j of the i-th polynomial is stored at
+                        // i * chunks + j, where chunks = lagrange_bases[n].size() / n.
+                        const std::vector<typename group_type::value_type> &
+                            lagrange_basis(math::basic_radix2_domain<scalar_field_type> &domain) {
+                            const std::size_t n = domain.size();
+
+                            std::lock_guard<std::mutex> lock(lagrange_bases_mutex.mutex);
+                            auto it = lagrange_bases.find(n);
+                            if (it != lagrange_bases.end()) {
+                                return it->second;
                             }
 
-                            // std::vector<typename group_type::value_type> lg(g.begin(), g.begin() + n);
-                            lagrange_bases[n] = std::vector<typename group_type::value_type>(g.begin(), g.begin() + n);
+                            if (n <= g.size()) {
+                                std::vector<typename group_type::value_type> basis(g.begin(), g.begin() + n);
+                                domain.inverse_fft(basis);
+                                return lagrange_bases.emplace(n, std::move(basis)).first->second;
+                            }
 
-                            domain.inverse_fft(lagrange_bases[n]);
+                            // Chunk j of L_i is sum_k L_i[j * m + k] * g[k], which is the i-th element of the
+                            // inverse FFT of the SRS placed at offset j * m of an otherwise zero vector
+                            const std::size_t m = g.size();
+                            const std::size_t chunks = (n + m - 1) / m;
+                            std::vector<typename group_type::value_type> basis(n * chunks);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t j = 0; j < chunks; ++j) {
+                                math::basic_radix2_domain<scalar_field_type> chunk_domain(n);
+                                std::vector<typename group_type::value_type> shifted(
+                                    n, group_type::value_type::zero());
+                                std::copy(g.begin(), g.begin() + std::min(m, n - j * m), shifted.begin() + j * m);
+
+                                chunk_domain.inverse_fft(shifted);
+                                for (std::size_t i = 0; i < n; ++i) {
+                                    basis[i * chunks + j] = shifted[i];
+                                }
+                            }
+
+                            return lagrange_bases.emplace(n, std::move(basis)).first->second;
+                        }
+
+                        // Writes all computed Lagrange bases, so that later runs can load them instead of
+                        // recomputing the inverse FFTs. Every point is stored as its affine coordinates.
+                        // Throws std::runtime_error if the stream fails.
+                        void save_lagrange_bases(std::ostream &out) const {
+                            std::lock_guard<std::mutex> lock(lagrange_bases_mutex.mutex);
+                            std::vector<std::uint8_t> buffer;
+                            write_size(buffer, lagrange_bases.size());
+                            for (const auto &[n, basis] : lagrange_bases) {
+                                write_size(buffer, n);
+                                write_size(buffer, basis.size());
+                                for (const auto &point : basis) {
+                                    write_coordinate(buffer, point.X);
+                                    write_coordinate(buffer, point.Y);
+                                }
+                            }
+
+                            out.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+                            if (!out.good()) {
+                                throw std::runtime_error("cannot write Lagrange bases");
+                            }
                         }
+
+                        // Reads bases written by save_lagrange_bases and adds them to lagrange_bases. Domain
+                        // sizes already present are kept, so references returned by lagrange_basis stay valid
+                        // and unchanged. Returns false, leaving lagrange_bases unchanged, on truncated or
+                        // malformed input.
+                        bool load_lagrange_bases(std::istream &in) {
+                            const std::vector<std::uint8_t> buffer((std::istreambuf_iterator<char>(in)),
+                                                                   std::istreambuf_iterator<char>());
+                            auto iter = buffer.cbegin();
+                            std::size_t count;
+                            if (!read_size(iter, buffer.cend(), count)) {
+                                return false;
+                            }
+
+                            std::unordered_map<std::size_t, std::vector<typename group_type::value_type>> loaded;
+                            for (std::size_t k = 0; k < count; ++k) {
+                                std::size_t n, size;
+                                if (!read_size(iter, buffer.cend(), n) || !read_size(iter, buffer.cend(), size) ||
+                                    n == 0 || size % n != 0 ||
+                                    std::size_t(buffer.cend() - iter) / (2 * coordinate_length()) < size) {
+                                    return false;
+                                }
+
+                                std::vector<typename group_type::value_type> basis(size);
+                                for (auto &point : basis) {
+                                    typename base_field_type::value_type x, y;
+                                    if (!read_coordinate(iter, x) || !read_coordinate(iter, y)) {
+                                        return false;
+                                    }
+                                    point = typename group_type::value_type(x, y);
+                                }
+                                loaded[n] = std::move(basis);
+                            }
+                            if (iter != buffer.cend()) {
+                                return false;
+                            }
+
+                            std::lock_guard<std::mutex> lock(lagrange_bases_mutex.mutex);
+                            for (auto &[n, basis] : loaded) {
+                                lagrange_bases.emplace(n, std::move(basis));
+                            }
+                            return true;
+                        }
+
+                    private:
+                        typedef nil::crypto3::marshalling::types::field_element<
+                            nil::marshalling::field_type<nil::marshalling::option::big_endian>,
+                            typename base_field_type::value_type>
+                            coordinate_marshalling_type;
+
+                        // Copies of the parameters get their own mutex
+                        struct copyable_mutex {
+                            copyable_mutex() = default;
+                            copyable_mutex(const copyable_mutex &) {
+                            }
+                            copyable_mutex &operator=(const copyable_mutex &) {
+                                return *this;
+                            }
+
+                            mutable std::mutex mutex;
+                        };
+
+                        static std::size_t coordinate_length() {
+                            return coordinate_marshalling_type::length();
+                        }
+
+                        static void write_size(std::vector<std::uint8_t> &buffer, std::size_t value) {
+                            for (std::size_t i = 8; i-- > 0;) {
+                                buffer.push_back(static_cast<std::uint8_t>(std::uint64_t(value) >> (8 * i)));
+                            }
+                        }
+
+                        static void write_coordinate(std::vector<std::uint8_t> &buffer,
+                                                     const typename base_field_type::value_type &value) {
+                            const std::size_t offset = buffer.size();
+                            buffer.resize(offset + coordinate_length());
+                            auto iter = buffer.begin() + offset;
+                            coordinate_marshalling_type(value).write(iter, coordinate_length());
+                        }
+
+                        template<typename Iterator>
+                        static bool read_size(Iterator &iter, Iterator end, std::size_t &value) {
+                            if (end - iter < 8) {
+                                return false;
+                            }
+                            std::uint64_t result = 0;
+                            for (std::size_t i = 0; i < 8; ++i, ++iter) {
+                                result = (result << 8) | *iter;
+                            }
+                            value = static_cast<std::size_t>(result);
+                            return true;
+                        }
+
+                        template<typename Iterator>
+                        static bool read_coordinate(Iterator &iter, typename base_field_type::value_type &value) {
+                            coordinate_marshalling_type element;
+                            if (element.read(iter, coordinate_length()) != nil::marshalling::status_type::success) {
+                                return false;
+                            }
+                            value = element.value();
+                            return true;
+                        }
+
+                        copyable_mutex lagrange_bases_mutex;
                     };
 
                     template<typename value_type>
@@ -127,7 +311,7 @@ namespace nil {
                                 points.push_back(commit.shifted);
                             }
                             value_type shifted = algebra::multiexp_with_mixed_addition<multiexp_method>(
-                                    points.begin(), points.end(), elm.begin(), elm.end(), 1);
+                                    points.begin(), points.end(), elm.begin(), elm.end(), multiexp_chunks());
 
                             std::vector<value_type> unshifted;
                             std::size_t n = commits.front().unshifted.size();
@@ -152,7 +336,8 @@ namespace nil {
 
                                 unshifted.push_back(algebra::multiexp_with_mixed_addition<multiexp_method>(
                                         points_for_unshifted.begin(), points_for_unshifted.end(),
-                                        scalars_for_unshifted.begin(), scalars_for_unshifted.end(), 1));
+                                        scalars_for_unshifted.begin(), scalars_for_unshifted.end(),
+                                        multiexp_chunks()));
                             }
 
                             return poly_comm<value_type>(unshifted, shifted);
@@ -344,13 +529,13 @@ namespace nil {
                         std::size_t len = poly.size();
                         while (len > g_len) {
                             res.unshifted.push_back(algebra::multiexp_with_mixed_addition<multiexp_method>(
-                                    params.g.begin(), params.g.end(), left, left + g_len, 1));
+                                    params.g.begin(), params.g.end(), left, left + g_len, multiexp_chunks()));
                             left += g_len;
                             len -= g_len;
                         }
                         if (len > 0) {
                             res.unshifted.push_back(algebra::multiexp_with_mixed_addition<multiexp_method>(
-                                    params.g.begin(), params.g.begin() + len, left, left + len, 1));
+                                    params.g.begin(), params.g.begin() + len, left, left + len, multiexp_chunks()));
                         }
 
                         if (bound >= 0) {
@@ -359,7 +544,7 @@ namespace nil {
                                 res.shifted = algebra::multiexp_with_mixed_addition<multiexp_method>(
                                         params.g.end() - bound % g_len, params.g.end(), poly.begin() + start,
                                         poly.end(),
-                                        1);
+                                        multiexp_chunks());
                             }
                         }
 
@@ -459,16 +644,30 @@ namespace nil {
                         // computing b
                         std::vector<typename scalar_field_type::value_type> b(
                                 power_of_two, scalar_field_type::value_type::zero());
+                        std::vector<typename scalar_field_type::value_type> scales;
                         scale = scalar_field_type::value_type::one();
-                        for (auto e: elm) {
-                            auto spare = scalar_field_type::value_type::one();
-                            for (int i = 0; i < power_of_two; ++i) {
-                                b[i] += scale * spare;
-                                spare *= e;
-                            }
+                        for (std::size_t j = 0; j < elm.size(); ++j) {
+                            scales.push_back(scale);
                             scale *= evalscale;
                         }
 
+                        const std::size_t chunks = multiexp_chunks();
+                        const std::size_t b_chunk_size = (power_of_two + chunks - 1) / chunks;
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                            const std::size_t begin = std::min(power_of_two, chunk * b_chunk_size);
+                            const std::size_t end = std::min(power_of_two, begin + b_chunk_size);
+                            for (std::size_t j = 0; j < elm.size(); ++j) {
+                                typename scalar_field_type::value_type spare = scales[j] * elm[j].pow(begin);
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    b[i] += spare;
+                                    spare *= elm[j];
+                                }
+                            }
+                        }
+
                         typename scalar_field_type::value_type inner_product_in_vec = algebra::inner_product(a.begin(),
                                                                                                              a.end(),
                                                                                                              b.begin(),
@@ -479,31 +678,29 @@ namespace nil {
                         std::vector<typename scalar_field_type::value_type> chals;
                         std::vector<typename scalar_field_type::value_type> chal_invs;
 
-                        std::vector<typename group_type::value_type> g_low, g_high;
-                        std::vector<typename scalar_field_type::value_type> a_low, a_high, b_low, b_high;
-
+                        // a, b and g are folded in place, the low halves of the vectors hold the next round
                         while (power_of_two > 1) {
                             power_of_two >>= 1;
-                            g_low.assign(g.begin(), g.begin() + power_of_two);
-                            g_high.assign(g.begin() + power_of_two, g.end());
-                            a_low.assign(a.begin(), a.begin() + power_of_two);
-                            a_high.assign(a.begin() + power_of_two, a.end());
-                            b_low.assign(b.begin(), b.begin() + power_of_two);
-                            b_high.assign(b.begin() + power_of_two, b.end());
+                            auto g_low = g.begin();
+                            auto g_high = g.begin() + power_of_two;
+                            auto a_low = a.begin();
+                            auto a_high = a.begin() + power_of_two;
+                            auto b_low = b.begin();
+                            auto b_high = b.begin() + power_of_two;
 
                             typename scalar_field_type::value_type rand_l = algebra::random_element<scalar_field_type>();
                             typename scalar_field_type::value_type rand_r = algebra::random_element<scalar_field_type>();
 
                             typename group_type::value_type l = algebra::multiexp_with_mixed_addition<multiexp_method>(
-                                    g_low.begin(), g_low.end(), a_high.begin(), a_high.end(), 1) +
+                                    g_low, g_high, a_high, a_high + power_of_two, chunks) +
                                                                 rand_l * params.h +
-                                                                algebra::inner_product(a_high.begin(), a_high.end(),
-                                                                                       b_low.begin(), b_low.end()) * u;
+                                                                algebra::inner_product(a_high, a_high + power_of_two,
+                                                                                       b_low, b_high) * u;
                             typename group_type::value_type r = algebra::multiexp_with_mixed_addition<multiexp_method>(
-                                    g_high.begin(), g_high.end(), a_low.begin(), a_low.end(), 1) +
+                                    g_high, g_high + power_of_two, a_low, a_high, chunks) +
                                                                 rand_r * params.h +
-                                                                algebra::inner_product(a_low.begin(), a_low.end(),
-                                                                                       b_high.begin(), b_high.end()) *
+                                                                algebra::inner_product(a_low, a_high,
+                                                                                       b_high, b_high + power_of_two) *
                                                                 u;
 
                             res.lr.emplace_back(l, r);
@@ -517,21 +714,18 @@ namespace nil {
                             chals.push_back(u_scalar);
                             chal_invs.push_back(u_scalar_inv);
 
-                            auto compress_function_u_inv = [&u_scalar_inv](auto &first, auto &second) {
-                                return first * u_scalar_inv + second;
-                            };
-
-                            auto compress_function_u = [&u_scalar](auto &first, auto &second) {
-                                return first * u_scalar + second;
-                            };
-
-                            a.resize(a_high.size());
-                            std::transform(a_high.begin(), a_high.end(), a_low.begin(), a.begin(),
-                                           compress_function_u_inv);
-                            b.resize(b_high.size());
-                            std::transform(b_high.begin(), b_high.end(), b_low.begin(), b.begin(), compress_function_u);
-                            g.resize(g_high.size());
-                            std::transform(g_high.begin(), g_high.end(), g_low.begin(), g.begin(), compress_function_u);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < power_of_two; ++i) {
+                                a[i] = a[i + power_of_two] * u_scalar_inv + a[i];
+                                b[i] = b[i + power_of_two] * u_scalar + b[i];
+                                g[i] = g[i + power_of_two] * u_scalar + g[i];
+                            }
+
+                            a.resize(power_of_two);
+                            b.resize(power_of_two);
+                            g.resize(power_of_two);
                         }
                         typename scalar_field_type::value_type a0 = a[0];
                         typename scalar_field_type::value_type b0 = b[0];
@@ -628,16 +822,22 @@ namespace nil {
 
                     static std::vector<typename scalar_field_type::value_type>
                     b_poly_coefficents(const std::vector<typename scalar_field_type::value_type> &chals) {
-                        auto rounds = chals.size();
-                        auto s_len = 1 << rounds;
+                        const std::size_t rounds = chals.size();
+                        const std::size_t s_len = std::size_t(1) << rounds;
                         std::vector<typename scalar_field_type::value_type> s(
                                 s_len, scalar_field_type::value_type::one());
-                        int k = 0;
-                        int pow = 1;
-                        for (int i = 1; i < s_len; ++i) {
-                            (i == pow) ? (k += 1) : (k += 0);
-                            (i == pow) ? (pow <<= 1) : (pow <<= 0);
-                            s[i] = s[i - (pow >> 1)] * chals[rounds - 1 - (k - 1)];
+                        // s[i] is the product of chals[rounds - 1 - k] over the bits k set in i,
+                        // so the upper half of each prefix of length 2^(k + 1) is its lower half
+                        // multiplied by chals[rounds - 1 - k]
+                        for (std::size_t k = 0; k < rounds; ++k) {
+                            const std::size_t half = std::size_t(1) << k;
+                            const typename scalar_field_type::value_type &chal = chals[rounds - 1 - k];
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < half; ++i) {
+                                s[half + i] = s[i] * chal;
+                            }
                         }
                         return s;
                     }
@@ -699,12 +899,11 @@ namespace nil {
                             points.push_back(batch.opening.sg);
                             scalars.push_back(neg_rand_base_i * batch.opening.z1 - sg_rand_base_i);
 
-                            std::transform(s.begin(), s.end(), s.begin(), [&sg_rand_base_i](auto &iter_s) {
-                                return iter_s * sg_rand_base_i;
-                            });
-
-                            for (int i = 0; i < s.size(); ++i) {
-                                scalars[i + 1] += s[i];
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < s.size(); ++i) {
+                                scalars[i + 1] += s[i] * sg_rand_base_i;
                             }
 
                             scalars[0] -= rand_base_i * batch.opening.z2;
@@ -750,7 +949,7 @@ namespace nil {
                         }
 
                         return (algebra::multiexp_with_mixed_addition<multiexp_method>(
-                                points.begin(), points.end(), scalars.begin(), scalars.end(), 1) ==
+                                points.begin(), points.end(), scalars.begin(), scalars.end(), multiexp_chunks()) ==
                                 group_type::value_type::zero());
                     }
                 };
@@ -28,6 +28,11 @@
 #ifndef CRYPTO3_ZK_COMMITMENTS_KZG_HPP
 #define CRYPTO3_ZK_COMMITMENTS_KZG_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
 #include <tuple>
 #include <vector>
 #include <type_traits>
@@ -39,6 +44,9 @@
 #include <nil/crypto3/algebra/type_traits.hpp>
 #include <nil/crypto3/algebra/algorithms/pair.hpp>
 #include <nil/crypto3/algebra/pairing/pairing_policy.hpp>
+#include <nil/crypto3/algebra/multiexp/multiexp.hpp>
+#include <nil/crypto3/algebra/multiexp/policies.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
@@ -57,6 +65,7 @@ namespace nil {
                     typedef typename curve_type::gt_type::value_type gt_value_type;
 
                     using base_field_value_type = typename curve_type::base_field_type::value_type;
+                    using scalar_value_type = typename curve_type::scalar_field_type::value_type;
                     using commitment_key_type = std::vector<typename curve_type::template g1_type<>::value_type>;
                     using verification_key_type = typename curve_type::template g2_type<>::value_type;
                     using commitment_type = typename curve_type::template g1_type<>::value_type;
@@ -66,6 +75,18 @@ namespace nil {
                         std::size_t a;
                     };
 
+                    /**
+                     * Opening of several polynomials at several points: one witness per point, for the
+                     * gamma-combination of the polynomials opened at that point [GWC19, section 3].
+                     */
+                    struct batched_proof_type {
+                        std::vector<proof_type> witnesses;
+
+                        bool operator==(const batched_proof_type &other) const {
+                            return witnesses == other.witnesses;
+                        }
+                    };
+
                     static std::pair<commitment_key_type, verification_key_type> setup(const std::size_t n,
                                                                                        params_type params) {
 
@@ -85,13 +106,12 @@ namespace nil {
                     static commitment_type commit(const commitment_key_type &commitment_key,
                                                   const polynomial<base_field_value_type> &f) {
 
-                        commitment_type commitment = f[0] * commitment_key[0];
-
+                        std::vector<base_field_value_type> coefficients(f.size());
                         for (std::size_t i = 0; i < f.size(); i++) {
-                            commitment = commitment + commitment_key[i] * f[i];
+                            coefficients[i] = f[i];
                         }
 
-                        return commitment;
+                        return commit_coefficients(commitment_key, coefficients);
                     }
 
                     static proof_type proof_eval(commitment_key_type commitment_key,
@@ -104,7 +124,7 @@ namespace nil {
                         const polynomial<base_field_value_type> q =
                             (f + polynomial<base_field_value_type> {-y}) / denominator_polynom;
 
-                        proof_type p = kzg_commitment::commit(commitment_key, q);
+                        proof_type p = commit(commitment_key, q);
                         return p;
                     }
 
@@ -123,6 +143,160 @@ namespace nil {
 
                         return gt1 == gt2;
                     }
+
+                    /**
+                     * Commits to every polynomial with one multiexponentiation over the commitment key.
+                     */
+                    static std::vector<commitment_type>
+                        batch_commit(const commitment_key_type &commitment_key,
+                                     const std::vector<polynomial<scalar_value_type>> &polynomials) {
+                        std::vector<commitment_type> commitments;
+                        commitments.reserve(polynomials.size());
+                        for (const polynomial<scalar_value_type> &f : polynomials) {
+                            std::vector<scalar_value_type> coefficients(f.size());
+                            for (std::size_t i = 0; i < f.size(); i++) {
+                                coefficients[i] = f[i];
+                            }
+                            commitments.emplace_back(commit_coefficients(commitment_key, coefficients));
+                        }
+                        return commitments;
+                    }
+
+                    /**
+                     * Opens polynomials[j][k] at points[j] for all j and k. gamma must be chosen after the
+                     * commitments to the polynomials are fixed, e.g. drawn from the transcript.
+                     */
+                    static batched_proof_type
+                        batch_proof_eval(const commitment_key_type &commitment_key,
+                                         const std::vector<std::vector<polynomial<scalar_value_type>>> &polynomials,
+                                         const std::vector<scalar_value_type> &points,
+                                         const scalar_value_type &gamma) {
+                        BOOST_ASSERT(polynomials.size() == points.size());
+
+                        batched_proof_type proof;
+                        proof.witnesses.resize(points.size());
+
+                        for (std::size_t j = 0; j < points.size(); j++) {
+                            std::size_t size = 0;
+                            for (const polynomial<scalar_value_type> &f : polynomials[j]) {
+                                size = std::max(size, f.size());
+                            }
+
+                            // h = sum_k gamma^k f_k
+                            std::vector<scalar_value_type> h(size, scalar_value_type::zero());
+                            scalar_value_type gamma_power = scalar_value_type::one();
+                            for (const polynomial<scalar_value_type> &f : polynomials[j]) {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                                for (std::size_t i = 0; i < f.size(); i++) {
+                                    h[i] += gamma_power * f[i];
+                                }
+                                gamma_power *= gamma;
+                            }
+
+                            // (h - h(z)) / (X - z) by synthetic division
+                            std::vector<scalar_value_type> q(size > 1 ? size - 1 : 0);
+                            scalar_value_type carry = scalar_value_type::zero();
+                            for (std::size_t i = size; i-- > 1;) {
+                                carry = h[i] + points[j] * carry;
+                                q[i - 1] = carry;
+                            }
+
+                            proof.witnesses[j] = commit_coefficients(commitment_key, q);
+                        }
+
+                        return proof;
+                    }
+
+                    /**
+                     * Verifies a batch_proof_eval opening, where evaluations[j][k] is the claimed value of
+                     * the polynomial committed in commitments[j][k] at points[j].
+                     *
+                     * The per-point checks e(C_j - y_j G + z_j W_j, H) == e(W_j, tau H), with C_j and y_j
+                     * the gamma-combinations of the commitments and evaluations, are merged with random
+                     * weights r_j into one product of two pairings sharing a final exponentiation. The two
+                     * G1 arguments are each computed with one multiexponentiation.
+                     */
+                    static bool batch_verify_eval(const verification_key_type &verification_key,
+                                                  const std::vector<std::vector<commitment_type>> &commitments,
+                                                  const std::vector<scalar_value_type> &points,
+                                                  const std::vector<std::vector<scalar_value_type>> &evaluations,
+                                                  const batched_proof_type &proof,
+                                                  const scalar_value_type &gamma) {
+                        typedef typename curve_type::template g1_type<>::value_type g1_value_type;
+                        typedef typename curve_type::template g2_type<>::value_type g2_value_type;
+
+                        if (commitments.size() != points.size() || evaluations.size() != points.size() ||
+                            proof.witnesses.size() != points.size()) {
+                            return false;
+                        }
+
+                        // lhs = sum_j r_j (C_j + z_j W_j) - (sum_j r_j y_j) G,  rhs = sum_j r_j W_j
+                        std::vector<g1_value_type> lhs_bases, rhs_bases;
+                        std::vector<scalar_value_type> lhs_scalars, rhs_scalars;
+                        scalar_value_type y_sum = scalar_value_type::zero();
+
+                        for (std::size_t j = 0; j < points.size(); j++) {
+                            if (commitments[j].size() != evaluations[j].size()) {
+                                return false;
+                            }
+
+                            scalar_value_type r = algebra::random_element<typename curve_type::scalar_field_type>();
+                            while (r.is_zero()) {
+                                r = algebra::random_element<typename curve_type::scalar_field_type>();
+                            }
+
+                            scalar_value_type weight = r;
+                            for (std::size_t k = 0; k < commitments[j].size(); k++) {
+                                lhs_bases.emplace_back(commitments[j][k]);
+                                lhs_scalars.emplace_back(weight);
+                                y_sum += weight * evaluations[j][k];
+                                weight *= gamma;
+                            }
+
+                            lhs_bases.emplace_back(proof.witnesses[j]);
+                            lhs_scalars.emplace_back(r * points[j]);
+                            rhs_bases.emplace_back(proof.witnesses[j]);
+                            rhs_scalars.emplace_back(r);
+                        }
+
+                        lhs_bases.emplace_back(g1_value_type::one());
+                        lhs_scalars.emplace_back(-y_sum);
+
+                        const g1_value_type lhs = algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                            lhs_bases.begin(), lhs_bases.end(), lhs_scalars.begin(), lhs_scalars.end(),
+                            multiexp_chunks());
+                        const g1_value_type rhs = algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                            rhs_bases.begin(), rhs_bases.end(), rhs_scalars.begin(), rhs_scalars.end(),
+                            multiexp_chunks());
+
+                        return algebra::final_exponentiation<curve_type>(
+                                   algebra::pair<curve_type>(lhs, g2_value_type::one()) *
+                                   algebra::pair<curve_type>(-rhs, verification_key)) == gt_value_type::one();
+                    }
+
+                private:
+                    static std::size_t multiexp_chunks() {
+#ifdef MULTICORE
+                        return omp_get_max_threads();
+#else
+                        return 1;
+#endif
+                    }
+
+                    template<typename ScalarValueType>
+                    static commitment_type commit_coefficients(const commitment_key_type &commitment_key,
+                                                               const std::vector<ScalarValueType> &coefficients) {
+                        BOOST_ASSERT(coefficients.size() <= commitment_key.size());
+
+                        if (coefficients.empty()) {
+                            return commitment_type::zero();
+                        }
+                        return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                            commitment_key.begin(), commitment_key.begin() + coefficients.size(),
+                            coefficients.begin(), coefficients.end(), multiexp_chunks());
+                    }
                 };
             };    // namespace commitments
         }         // namespace zk
@@ -36,6 +36,7 @@
 #include <nil/crypto3/container/merkle/tree.hpp>
 #include <nil/crypto3/container/merkle/proof.hpp>
 
+#include <nil/crypto3/zk/detail/buffer_pool.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 //#include <nil/crypto3/zk/commitments/polynomial/fri.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/basic_fri.hpp>
@@ -91,12 +92,12 @@ namespace nil {
 
                     typedef LPCParams lpc_params;
 
-                    typedef typename containers::merkle_proof<merkle_hash_type, 2> merkle_proof_type;
-
                     using basic_fri = detail::basic_batched_fri<FieldType, typename LPCParams::merkle_hash_type,
                             typename LPCParams::transcript_hash_type,
                             LPCParams::lambda, LPCParams::m, LPCParams::batches_num>;
 
+                    typedef typename basic_fri::merkle_proof_type merkle_proof_type;
+
                     using precommitment_type = typename basic_fri::precommitment_type;
                     using commitment_type = typename basic_fri::commitment_type;
                     using field_type = FieldType;
@@ -234,16 +235,40 @@ namespace nil {
                         std::array<std::vector<math::polynomial_dfs<typename LPC::field_type::value_type>>, LPC::basic_fri::batches_num> &g,
                         const typename LPC::basic_fri::params_type &fri_params,
                         typename LPC::basic_fri::transcript_type &transcript) {
+                    zk::detail::buffer_pool<typename LPC::field_type::value_type,
+                                            math::polynomial_dfs<typename LPC::field_type::value_type>> buffers;
+                    return proof_eval<LPC>(evaluation_points, precommitments, g, fri_params, transcript, buffers);
+                }
+
+                /// Same as above with combined_Q and the per-polynomial Q scratch drawn from the caller's
+                /// buffer pool and returned to it once the FRI proof is built.
+                template<typename LPC, typename std::enable_if<
+                        std::is_base_of<commitments::batched_list_polynomial_commitment<
+                                typename LPC::field_type, typename LPC::lpc_params>,
+                                LPC>::value,
+                        bool>::type = true>
+                static typename LPC::proof_type proof_eval(
+                        std::array<std::vector<std::vector<typename LPC::field_type::value_type>>, LPC::basic_fri::batches_num> &evaluation_points,
+                        const std::array<typename LPC::precommitment_type, LPC::basic_fri::batches_num> &precommitments,
+                        std::array<std::vector<math::polynomial_dfs<typename LPC::field_type::value_type>>, LPC::basic_fri::batches_num> &g,
+                        const typename LPC::basic_fri::params_type &fri_params,
+                        typename LPC::basic_fri::transcript_type &transcript,
+                        zk::detail::buffer_pool<typename LPC::field_type::value_type,
+                                                math::polynomial_dfs<typename LPC::field_type::value_type>> &buffers) {
                     for (std::size_t i = 0; i < LPC::basic_fri::batches_num; i++) {
                         transcript(commit<typename LPC::basic_fri>(precommitments[i]));
                     }
 
                     // Prepare z-s and combined_Q;
                     typename LPC::field_type::value_type theta = transcript.template challenge<typename LPC::field_type>();
-                    math::polynomial_dfs<typename LPC::field_type::value_type> combined_Q_dfs(
+                    const math::polynomial_dfs<typename LPC::field_type::value_type> zero_Q_dfs(
                             0, fri_params.D[0]->size(),
                             LPC::field_type::value_type::zero()
                     );
+                    math::polynomial_dfs<typename LPC::field_type::value_type> combined_Q_dfs =
+                            buffers.acquire_like(zero_Q_dfs);
+                    math::polynomial_dfs<typename LPC::field_type::value_type> Q_dfs =
+                            buffers.acquire_like(zero_Q_dfs);
 
 
                     std::array<typename LPC::proof_type::z_type, LPC::basic_fri::batches_num> z;
@@ -281,16 +306,9 @@ namespace nil {
                             }
                             math::polynomial<typename LPC::field_type::value_type> U =
                                     math::lagrange_interpolation(U_interpolation_points);
-                            math::polynomial_dfs<typename LPC::field_type::value_type> U_dfs(0,
-                                                                                             fri_params.D[0]->size());
-                            U_dfs.from_coefficients(U);
-                            math::polynomial_dfs<typename LPC::field_type::value_type> denominator_dfs(0,
-                                                                                                       fri_params.D[0]->size());
 
                             math::polynomial<typename LPC::field_type::value_type> Q = g_normal - U;
                             Q = Q / V;
-                            math::polynomial_dfs<typename LPC::field_type::value_type> Q_dfs(0,
-                                                                                             fri_params.D[0]->size());
                             Q_dfs.from_coefficients(Q);
 
                             if (k == 0 && polynom_index == 0) {
@@ -317,6 +335,8 @@ namespace nil {
                             fri_params,
                             transcript
                     );
+                    buffers.release(std::move(Q_dfs));
+                    buffers.release(std::move(combined_Q_dfs));
                     return typename LPC::proof_type({z, fri_proof});
                 }
 
@@ -334,8 +354,6 @@ namespace nil {
 
                     typename std::vector<std::size_t> evals_map;
                     typename std::vector<std::vector<typename LPC::field_type::value_type>> unique_eval_points;
-                    typename std::vector<math::polynomial<typename LPC::field_type::value_type>> combined_U;
-                    typename std::vector<math::polynomial<typename LPC::field_type::value_type>> denominators;
                     typename LPC::field_type::value_type theta = transcript.template challenge<typename LPC::field_type>();
 
                     std::size_t batch_size = 0;
@@ -389,48 +407,33 @@ namespace nil {
                         }
                     }
 
-                    combined_U.resize(unique_eval_points.size());
-                    denominators.resize(unique_eval_points.size());
+                    // theta-combination of the opened values, in the order the FRI verifier combines
+                    // the polynomials; U of each point set is the interpolant of these values
+                    std::vector<std::vector<typename LPC::field_type::value_type>> combined_values(
+                            unique_eval_points.size());
                     for (std::size_t point_index = 0; point_index < unique_eval_points.size(); point_index++) {
-                        combined_U[point_index] = {0};
-                        denominators[point_index] = {1};
-                        std::vector<
-                                std::pair<typename LPC::field_type::value_type, typename LPC::field_type::value_type>
-                        > U_interpolation_points;
-
-                        U_interpolation_points.resize(unique_eval_points[point_index].size());
-                        for (std::size_t xi_index = 0; xi_index < unique_eval_points[point_index].size(); xi_index++) {
-                            denominators[point_index] =
-                                    denominators[point_index] *
-                                    math::polynomial<typename LPC::field_type::value_type>(
-                                            {-unique_eval_points[point_index][xi_index], 1});
-                        }
-
-                        std::size_t ind = 0;
-                        for (std::size_t k = 0; k < LPC::basic_fri::batches_num; k++) {
-                            for (std::size_t i = 0; i < proof.z[k].size(); i++) {
-                                combined_U[point_index] = combined_U[point_index] * theta;
-                                if (evals_map[ind] == point_index) {
-                                    BOOST_ASSERT(proof.z[k][i].size() == unique_eval_points[point_index].size());
-                                    for (std::size_t xi_index = 0;
-                                         xi_index < unique_eval_points[point_index].size(); xi_index++) {
-                                        U_interpolation_points[xi_index] = std::make_pair(
-                                                unique_eval_points[point_index][xi_index],
-                                                proof.z[k][i][xi_index]
-                                        );
-                                    }
-                                    math::polynomial<typename LPC::field_type::value_type> U = math::lagrange_interpolation(
-                                            U_interpolation_points);
-                                    combined_U[point_index] = combined_U[point_index] +
-                                                              math::lagrange_interpolation(U_interpolation_points);
+                        combined_values[point_index].assign(unique_eval_points[point_index].size(),
+                                                            LPC::field_type::value_type::zero());
+                    }
+                    ind = 0;
+                    for (std::size_t k = 0; k < LPC::basic_fri::batches_num; k++) {
+                        for (std::size_t i = 0; i < proof.z[k].size(); i++, ind++) {
+                            for (auto &values : combined_values) {
+                                for (auto &value : values) {
+                                    value *= theta;
                                 }
-                                ind++;
+                            }
+                            std::vector<typename LPC::field_type::value_type> &values = combined_values[evals_map[ind]];
+                            BOOST_ASSERT(proof.z[k][i].size() == values.size());
+                            for (std::size_t xi_index = 0; xi_index < values.size(); xi_index++) {
+                                values[xi_index] += proof.z[k][i][xi_index];
                             }
                         }
                     }
 
                     return verify_eval<typename LPC::basic_fri>(proof.fri_proof, fri_params, commitments, theta,
-                                                                evals_map, combined_U, denominators, transcript);
+                                                                evals_map, unique_eval_points, combined_values,
+                                                                transcript);
                 }
 
             }    // namespace algorithms
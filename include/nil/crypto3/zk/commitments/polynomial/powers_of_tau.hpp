@@ -4,6 +4,7 @@
 #include <nil/crypto3/zk/commitments/detail/polynomial/powers_of_tau/private_key.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/powers_of_tau/public_key.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/powers_of_tau/accumulator.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/powers_of_tau/chunked_accumulator.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/powers_of_tau/result.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/proof_of_knowledge.hpp>
 #include <nil/crypto3/zk/commitments/detail/polynomial/vector_pairs.hpp>
@@ -26,11 +27,14 @@ namespace nil {
                     typedef typename g1_type::value_type g1_value_type;
                     typedef typename CurveType::template g2_type<> g2_type;
                     typedef typename g2_type::value_type g2_value_type;
+                    typedef typename CurveType::gt_type::value_type gt_value_type;
 
                 public:
                     typedef detail::powers_of_tau_private_key<curve_type> private_key_type;
                     typedef detail::powers_of_tau_public_key<curve_type> public_key_type;
                     typedef detail::powers_of_tau_accumulator<curve_type, TauPowersLength> accumulator_type;
+                    typedef detail::powers_of_tau_chunked_accumulator<curve_type, TauPowersLength>
+                        chunked_accumulator_type;
                     typedef detail::powers_of_tau_result<curve_type> result_type;
                     typedef proof_of_knowledge<curve_type> proof_of_knowledge_scheme_type;
 
@@ -68,21 +72,48 @@ namespace nil {
                     static public_key_type proof_eval(const private_key_type &private_key,
                                                       const accumulator_type &before,
                                                       RNG &&rng = boost::random_device()) {
-                        std::vector<std::uint8_t> transcript = compute_transcript(before);
-                        auto tau_pok = proof_of_knowledge_scheme_type::proof_eval(
-                                private_key.tau, transcript, tau_personalization, rng);
-                        auto alpha_pok = proof_of_knowledge_scheme_type::proof_eval(
-                                private_key.alpha, transcript, alpha_personalization, rng);
-                        auto beta_pok = proof_of_knowledge_scheme_type::proof_eval(
-                                private_key.beta, transcript, beta_personalization, rng);
+                        return prove_knowledge(private_key, compute_transcript(before), rng);
+                    }
 
-                        return public_key_type{std::move(tau_pok), std::move(alpha_pok), std::move(beta_pok)};
+                    // Same as above for an accumulator accessed through a chunk storage, whose transcript
+                    // is hashed chunk_size points at a time.
+                    template<typename StorageType, typename RNG = boost::random_device>
+                    static public_key_type proof_eval(const private_key_type &private_key,
+                                                      const StorageType &before,
+                                                      std::size_t chunk_size,
+                                                      RNG &&rng = boost::random_device()) {
+                        return prove_knowledge(private_key, compute_transcript(before, chunk_size), rng);
                     }
 
                     static bool verify_eval(const public_key_type &public_key,
                                             const accumulator_type &before,
                                             const accumulator_type &after) {
-                        std::vector<std::uint8_t> transcript = compute_transcript(before);
+                        return verify_eval(public_key, compute_transcript(before),
+                                           detail::make_powers_of_tau_memory_storage(before),
+                                           detail::make_powers_of_tau_memory_storage(after),
+                                           accumulator_type::tau_powers_g1_length);
+                    }
+
+                    // Verifies a contribution reading both accumulators through chunk storages,
+                    // see detail::powers_of_tau_memory_storage.
+                    template<typename BeforeStorageType, typename AfterStorageType>
+                    static bool verify_eval(const public_key_type &public_key,
+                                            const BeforeStorageType &before,
+                                            const AfterStorageType &after,
+                                            std::size_t chunk_size) {
+                        return verify_eval(public_key, compute_transcript(before, chunk_size), before, after,
+                                           chunk_size);
+                    }
+
+                    // Same as above with the transcript of the accumulator before the contribution,
+                    // i.e. compute_transcript(before, chunk_size), already computed.
+                    template<typename BeforeStorageType, typename AfterStorageType>
+                    static bool verify_eval(const public_key_type &public_key,
+                                            const std::vector<std::uint8_t> &transcript,
+                                            const BeforeStorageType &before,
+                                            const AfterStorageType &after,
+                                            std::size_t chunk_size) {
+                        typedef detail::powers_of_tau_vector vector_kind;
 
                         auto tau_g2_s = proof_of_knowledge_scheme_type::compute_g2_s(
                                 public_key.tau_pok.g1_s, public_key.tau_pok.g1_s_x, transcript, tau_personalization);
@@ -103,68 +134,108 @@ namespace nil {
                             return false;
                         }
 
+                        auto before_tau_g1 =
+                            chunked_accumulator_type::template read_prefix<g1_value_type>(before, vector_kind::tau_g1, 2);
+                        auto before_alpha_g1 = chunked_accumulator_type::template read_prefix<g1_value_type>(
+                            before, vector_kind::alpha_tau_g1, 1);
+                        auto before_beta_g1 = chunked_accumulator_type::template read_prefix<g1_value_type>(
+                            before, vector_kind::beta_tau_g1, 1);
+                        auto after_tau_g1 =
+                            chunked_accumulator_type::template read_prefix<g1_value_type>(after, vector_kind::tau_g1, 2);
+                        auto after_tau_g2 =
+                            chunked_accumulator_type::template read_prefix<g2_value_type>(after, vector_kind::tau_g2, 2);
+                        auto after_alpha_g1 = chunked_accumulator_type::template read_prefix<g1_value_type>(
+                            after, vector_kind::alpha_tau_g1, 1);
+                        auto after_beta_g1 = chunked_accumulator_type::template read_prefix<g1_value_type>(
+                            after, vector_kind::beta_tau_g1, 1);
+
                         // Check the correctness of the generators fot tau powers
-                        if (after.tau_powers_g1[0] != g1_value_type::one()) {
+                        if (after_tau_g1[0] != g1_value_type::one()) {
                             return false;
                         }
-                        if (after.tau_powers_g2[0] != g2_value_type::one()) {
+                        if (after_tau_g2[0] != g2_value_type::one()) {
                             return false;
                         }
 
                         // Did the participant multiply the previous tau by the new one?
-                        if (!is_same_ratio(std::make_pair(before.tau_powers_g1[1], after.tau_powers_g1[1]),
+                        if (!is_same_ratio(std::make_pair(before_tau_g1[1], after_tau_g1[1]),
                                            std::make_pair(tau_g2_s, public_key.tau_pok.g2_s_x))) {
                             return false;
                         }
 
                         // Did the participant multiply the previous alpha by the new one?
-                        if (!is_same_ratio(std::make_pair(before.alpha_tau_powers_g1[0], after.alpha_tau_powers_g1[0]),
+                        if (!is_same_ratio(std::make_pair(before_alpha_g1[0], after_alpha_g1[0]),
                                            std::make_pair(alpha_g2_s, public_key.alpha_pok.g2_s_x))) {
                             return false;
                         }
 
                         // Did the participant multiply the previous beta by the new one?
-                        if (!is_same_ratio(std::make_pair(before.beta_tau_powers_g1[0], after.beta_tau_powers_g1[0]),
+                        if (!is_same_ratio(std::make_pair(before_beta_g1[0], after_beta_g1[0]),
                                            std::make_pair(beta_g2_s, public_key.beta_pok.g2_s_x))) {
                             return false;
                         }
 
-                        if (!is_same_ratio(std::make_pair(before.beta_tau_powers_g1[0], after.beta_tau_powers_g1[0]),
-                                           std::make_pair(before.beta_g2, after.beta_g2))) {
+                        if (!is_same_ratio(std::make_pair(before_beta_g1[0], after_beta_g1[0]),
+                                           std::make_pair(before.read_beta_g2(), after.read_beta_g2()))) {
                             return false;
                         }
 
-                        // Are the powers of tau correct?
-                        if (!is_same_ratio(detail::power_pairs<scalar_field_type>(after.tau_powers_g1),
-                                           std::make_pair(after.tau_powers_g2[0], after.tau_powers_g2[1]))) {
-                            return false;
-                        }
-                        if (!is_same_ratio(std::make_pair(after.tau_powers_g1[0], after.tau_powers_g1[1]),
-                                           commitments::detail::power_pairs<scalar_field_type>(after.tau_powers_g2))) {
-                            return false;
-                        }
-                        if (!is_same_ratio(detail::power_pairs<scalar_field_type>(after.alpha_tau_powers_g1),
-                                           std::make_pair(after.tau_powers_g2[0], after.tau_powers_g2[1]))) {
+                        // Are the powers of tau correct? All G1 vectors share the ratio
+                        // (tau_powers_g2[0], tau_powers_g2[1]), so their random linear
+                        // combinations are merged into a single pair check.
+                        detail::merge_pairs_accumulator<scalar_field_type, g1_value_type> g1_pairs;
+                        chunked_accumulator_type::accumulate_power_pairs(
+                            after, vector_kind::tau_g1, accumulator_type::tau_powers_g1_length, chunk_size, g1_pairs);
+                        chunked_accumulator_type::accumulate_power_pairs(
+                            after, vector_kind::alpha_tau_g1, accumulator_type::tau_powers_length, chunk_size,
+                            g1_pairs);
+                        chunked_accumulator_type::accumulate_power_pairs(
+                            after, vector_kind::beta_tau_g1, accumulator_type::tau_powers_length, chunk_size,
+                            g1_pairs);
+                        if (!is_same_ratio(g1_pairs.result(), std::make_pair(after_tau_g2[0], after_tau_g2[1]))) {
                             return false;
                         }
-                        if (!is_same_ratio(detail::power_pairs<scalar_field_type>(after.beta_tau_powers_g1),
-                                           std::make_pair(after.tau_powers_g2[0], after.tau_powers_g2[1]))) {
+
+                        detail::merge_pairs_accumulator<scalar_field_type, g2_value_type> g2_pairs;
+                        chunked_accumulator_type::accumulate_power_pairs(
+                            after, vector_kind::tau_g2, accumulator_type::tau_powers_length, chunk_size, g2_pairs);
+                        if (!is_same_ratio(std::make_pair(after_tau_g1[0], after_tau_g1[1]), g2_pairs.result())) {
                             return false;
                         }
 
                         return true;
                     }
 
+                    // Applies a contribution to an accumulator accessed through a chunk storage,
+                    // processing at most chunk_size points of a vector at a time.
+                    template<typename StorageType>
+                    static void transform(const private_key_type &private_key, StorageType &storage,
+                                          std::size_t chunk_size) {
+                        chunked_accumulator_type::transform(private_key, storage, chunk_size);
+                    }
+
+                    // Checks e(g1.first, g2.second) == e(g1.second, g2.first) with a single
+                    // multi-pairing, i.e. two Miller loops and one final exponentiation.
                     static bool is_same_ratio(const std::pair<g1_value_type, g1_value_type> &g1_pair,
                                               const std::pair<g2_value_type, g2_value_type> &g2_pair) {
 
-                        return algebra::pair_reduced<CurveType>(g1_pair.first, g2_pair.second) ==
-                               algebra::pair_reduced<CurveType>(g1_pair.second, g2_pair.first);
+                        return algebra::final_exponentiation<CurveType>(
+                                   algebra::pair<CurveType>(g1_pair.first, g2_pair.second) *
+                                   algebra::pair<CurveType>(-g1_pair.second, g2_pair.first)) ==
+                               gt_value_type::one();
                     }
 
                     static std::vector<std::uint8_t> compute_transcript(const accumulator_type &acc) {
-                        auto acc_blob = serialize_accumulator(acc);
-                        return nil::crypto3::hash<hashes::blake2b<512>>(acc_blob);
+                        return compute_transcript(detail::make_powers_of_tau_memory_storage(acc),
+                                                  accumulator_type::tau_powers_g1_length);
+                    }
+
+                    // The transcript does not depend on the storage nor on chunk_size, so contributions
+                    // made to an accumulator file verify against the same accumulator in memory.
+                    template<typename StorageType>
+                    static std::vector<std::uint8_t> compute_transcript(const StorageType &storage,
+                                                                        std::size_t chunk_size) {
+                        return chunked_accumulator_type::compute_transcript(storage, chunk_size);
                     }
 
                     static std::vector<std::uint8_t> serialize_accumulator(const accumulator_type &acc) {
@@ -181,6 +252,21 @@ namespace nil {
                             return blob;
                         }
                     }
+
+                private:
+                    template<typename RNG>
+                    static public_key_type prove_knowledge(const private_key_type &private_key,
+                                                           const std::vector<std::uint8_t> &transcript,
+                                                           RNG &&rng) {
+                        auto tau_pok = proof_of_knowledge_scheme_type::proof_eval(
+                                private_key.tau, transcript, tau_personalization, rng);
+                        auto alpha_pok = proof_of_knowledge_scheme_type::proof_eval(
+                                private_key.alpha, transcript, alpha_personalization, rng);
+                        auto beta_pok = proof_of_knowledge_scheme_type::proof_eval(
+                                private_key.beta, transcript, beta_personalization, rng);
+
+                        return public_key_type{std::move(tau_pok), std::move(alpha_pok), std::move(beta_pok)};
+                    }
                 };
             }    // namespace commitments
         }        // namespace zk
@@ -100,40 +100,7 @@ namespace nil {
                             return false;
                         }
 
-                        // alpha/beta do not change
-                        if (initial_keypair.first.alpha_g1 != mpc_keypair.first.alpha_g1) {
-                            return false;
-                        }
-                        if (initial_keypair.first.beta_g1 != mpc_keypair.first.beta_g1) {
-                            return false;
-                        }
-                        if (initial_keypair.first.beta_g2 != mpc_keypair.first.beta_g2) {
-                            return false;
-                        }
-
-                        // A/B do not change
-                        if (initial_keypair.first.A_query != mpc_keypair.first.A_query) {
-                            return false;
-                        }
-                        if (!(initial_keypair.first.B_query == mpc_keypair.first.B_query)) {
-                            return false;
-                        }
-
-                        // the constraint system doesn't change
-                        if (!(initial_keypair.first.constraint_system == mpc_keypair.first.constraint_system)) {
-                            return false;
-                        }
-
-                        // alpha_beta/gamma do not change
-                        if (initial_keypair.second.alpha_g1_beta_g2 != mpc_keypair.second.alpha_g1_beta_g2) {
-                            return false;
-                        }
-                        if (initial_keypair.second.gamma_g2 != mpc_keypair.second.gamma_g2) {
-                            return false;
-                        }
-
-                        // gamma_ABC_g1 doesn't change
-                        if (!(initial_keypair.second.gamma_ABC_g1 == mpc_keypair.second.gamma_ABC_g1)) {
+                        if (!same_invariants(initial_keypair, mpc_keypair)) {
                             return false;
                         }
 
@@ -169,21 +136,58 @@ namespace nil {
                             return false;
                         }
 
-                        if (!is_same_ratio(
-                                detail::merge_pairs<scalar_field_type>(initial_keypair.first.H_query.cbegin(),
-                                                                       initial_keypair.first.H_query.cend(),
-                                                                       mpc_keypair.first.H_query.cbegin(),
-                                                                       mpc_keypair.first.H_query.cend()),
-                                std::make_pair(mpc_keypair.first.delta_g2, g2_value_type::one()))) {
+                        // H and L are both divided by delta, one randomized check covers them
+                        detail::merge_pairs_accumulator<scalar_field_type, g1_value_type> acc;
+                        acc.update(initial_keypair.first.H_query.cbegin(), initial_keypair.first.H_query.cend(),
+                                   mpc_keypair.first.H_query.cbegin(), mpc_keypair.first.H_query.cend());
+                        acc.update(initial_keypair.first.L_query.cbegin(), initial_keypair.first.L_query.cend(),
+                                   mpc_keypair.first.L_query.cbegin(), mpc_keypair.first.L_query.cend());
+                        if (!is_same_ratio(acc.result(),
+                                           std::make_pair(mpc_keypair.first.delta_g2, g2_value_type::one()))) {
                             return false;
                         }
 
-                        if (!is_same_ratio(
-                                detail::merge_pairs<scalar_field_type>(initial_keypair.first.L_query.cbegin(),
-                                                                       initial_keypair.first.L_query.cend(),
-                                                                       mpc_keypair.first.L_query.cbegin(),
-                                                                       mpc_keypair.first.L_query.cend()),
-                                std::make_pair(mpc_keypair.first.delta_g2, g2_value_type::one()))) {
+                        return true;
+                    }
+
+                    /// Checks the parts of the keypair which contributions must not change: alpha, beta,
+                    /// A, B, gamma, gamma_ABC and the constraint system.
+                    static bool same_invariants(const proving_scheme_keypair_type &expected,
+                                                const proving_scheme_keypair_type &keypair) {
+                        // alpha/beta do not change
+                        if (expected.first.alpha_g1 != keypair.first.alpha_g1) {
+                            return false;
+                        }
+                        if (expected.first.beta_g1 != keypair.first.beta_g1) {
+                            return false;
+                        }
+                        if (expected.first.beta_g2 != keypair.first.beta_g2) {
+                            return false;
+                        }
+
+                        // A/B do not change
+                        if (!same_points(expected.first.A_query, keypair.first.A_query)) {
+                            return false;
+                        }
+                        if (!(expected.first.B_query == keypair.first.B_query)) {
+                            return false;
+                        }
+
+                        // the constraint system doesn't change
+                        if (!(expected.first.constraint_system == keypair.first.constraint_system)) {
+                            return false;
+                        }
+
+                        // alpha_beta/gamma do not change
+                        if (expected.second.alpha_g1_beta_g2 != keypair.second.alpha_g1_beta_g2) {
+                            return false;
+                        }
+                        if (expected.second.gamma_g2 != keypair.second.gamma_g2) {
+                            return false;
+                        }
+
+                        // gamma_ABC_g1 doesn't change
+                        if (!(expected.second.gamma_ABC_g1 == keypair.second.gamma_ABC_g1)) {
                             return false;
                         }
 
@@ -200,7 +204,12 @@ namespace nil {
                     static std::vector<std::uint8_t>
                     compute_transcript(const constraint_system_type &constraint_system,
                                        const boost::optional<public_key_type> &pubkey) {
-                        std::vector<uint8_t> cs_blob = serialize_constraint_system(constraint_system);
+                        return compute_transcript(serialize_constraint_system(constraint_system), pubkey);
+                    }
+
+                    static std::vector<std::uint8_t>
+                    compute_transcript(const std::vector<std::uint8_t> &cs_blob,
+                                       const boost::optional<public_key_type> &pubkey) {
                         std::vector<std::uint8_t> cs_pk_blob;
                         std::copy(std::cbegin(cs_blob), std::cend(cs_blob), std::back_inserter(cs_pk_blob));
                         if (pubkey) {
@@ -241,6 +250,111 @@ namespace nil {
                             return blob;
                         }
                     }
+
+                    /// Stateful verifier of a running ceremony.
+                    ///
+                    /// verify_eval rebuilds the initial keypair from the powers of tau and replays the
+                    /// whole chain of contributions on every call. The ceremony verifier builds the initial
+                    /// keypair once and keeps the last accepted keypair together with the transcript, so
+                    /// a new contribution is checked against its predecessor only: the invariant parts are
+                    /// compared element by element and H and L are covered by a single randomized ratio
+                    /// check between the previous and the new keypair.
+                    class ceremony_verifier {
+                    public:
+                        ceremony_verifier(const constraint_system_type &constraint_system,
+                                          const detail::powers_of_tau_result<curve_type> &powers_of_tau_result) :
+                            current_keypair(detail::make_r1cs_gg_ppzksnark_keypair_from_powers_of_tau(
+                                constraint_system, powers_of_tau_result)),
+                            cs_blob(serialize_constraint_system(current_keypair.first.constraint_system)),
+                            transcript(compute_transcript(cs_blob, boost::none)), contributions_amount(0) {
+                        }
+
+                        /// Verifies that next is the last accepted keypair transformed by the contribution
+                        /// proven by pubkey. On success next becomes the last accepted keypair.
+                        bool verify_contribution(proving_scheme_keypair_type next, const public_key_type &pubkey) {
+                            const proving_scheme_keypair_type &previous = current_keypair;
+
+                            if (previous.first.H_query.size() != next.first.H_query.size()) {
+                                return false;
+                            }
+                            if (previous.first.L_query.size() != next.first.L_query.size()) {
+                                return false;
+                            }
+
+                            // The previous keypair has already been checked against the initial one
+                            if (!same_invariants(previous, next)) {
+                                return false;
+                            }
+
+                            auto g2_s = proof_of_knowledge_scheme_type::compute_g2_s(
+                                pubkey.delta_pok.g1_s, pubkey.delta_pok.g1_s_x, transcript, 0);
+                            if (!proof_of_knowledge_scheme_type::verify_eval(pubkey.delta_pok, g2_s)) {
+                                return false;
+                            }
+                            if (!is_same_ratio(std::make_pair(previous.first.delta_g1, pubkey.delta_after),
+                                               std::make_pair(g2_s, pubkey.delta_pok.g2_s_x))) {
+                                return false;
+                            }
+
+                            if (pubkey.delta_after != next.first.delta_g1) {
+                                return false;
+                            }
+                            if (!is_same_ratio(std::make_pair(g1_value_type::one(), next.first.delta_g1),
+                                               std::make_pair(g2_value_type::one(), next.first.delta_g2))) {
+                                return false;
+                            }
+                            if (next.first.delta_g2 != next.second.delta_g2) {
+                                return false;
+                            }
+
+                            // H and L are divided by the same delta as the previous ones
+                            detail::merge_pairs_accumulator<scalar_field_type, g1_value_type> acc;
+                            acc.update(previous.first.H_query.cbegin(), previous.first.H_query.cend(),
+                                       next.first.H_query.cbegin(), next.first.H_query.cend());
+                            acc.update(previous.first.L_query.cbegin(), previous.first.L_query.cend(),
+                                       next.first.L_query.cbegin(), next.first.L_query.cend());
+                            if (!is_same_ratio(acc.result(),
+                                               std::make_pair(next.first.delta_g2, previous.first.delta_g2))) {
+                                return false;
+                            }
+
+                            current_keypair = std::move(next);
+                            transcript = compute_transcript(cs_blob, pubkey);
+                            ++contributions_amount;
+                            return true;
+                        }
+
+                        /// The last accepted keypair, the initial one before any contribution.
+                        const proving_scheme_keypair_type &keypair() const {
+                            return current_keypair;
+                        }
+
+                        std::size_t contributions() const {
+                            return contributions_amount;
+                        }
+
+                    private:
+                        proving_scheme_keypair_type current_keypair;
+                        std::vector<std::uint8_t> cs_blob;
+                        std::vector<std::uint8_t> transcript;
+                        std::size_t contributions_amount;
+                    };
+
+                private:
+                    static bool same_points(const std::vector<g1_value_type> &a, const std::vector<g1_value_type> &b) {
+                        if (a.size() != b.size()) {
+                            return false;
+                        }
+
+                        bool equal = true;
+#ifdef MULTICORE
+#pragma omp parallel for reduction(&& : equal)
+#endif
+                        for (std::size_t i = 0; i < a.size(); ++i) {
+                            equal = equal && a[i] == b[i];
+                        }
+                        return equal;
+                    }
                 };
             }    // namespace commitments
         }        // namespace zk
@@ -0,0 +1,92 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_BATCH_INVERSION_HPP
+#define CRYPTO3_ZK_DETAIL_BATCH_INVERSION_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /// Replaces every nonzero element of values by its inverse; zero elements stay zero.
+                ///
+                /// Montgomery's trick: the elements are split into chunks, and each chunk costs one
+                /// field inversion and three multiplications per element. Chunks run in parallel.
+                template<typename ValueType>
+                void batch_invert(std::vector<ValueType> &values) {
+                    const std::size_t size = values.size();
+                    if (size == 0) {
+                        return;
+                    }
+
+#ifdef MULTICORE
+                    const std::size_t chunks =
+                        std::max<std::size_t>(1, std::min<std::size_t>(omp_get_max_threads(), size));
+#else
+                    const std::size_t chunks = 1;
+#endif
+                    const std::size_t chunk_size = (size + chunks - 1) / chunks;
+                    std::vector<ValueType> prefix(size);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                    for (std::size_t c = 0; c < chunks; ++c) {
+                        const std::size_t begin = c * chunk_size;
+                        const std::size_t end = std::min(size, begin + chunk_size);
+                        if (begin >= end) {
+                            continue;
+                        }
+
+                        // prefix[j] is the product of the nonzero elements of the chunk before j
+                        ValueType acc = ValueType::one();
+                        for (std::size_t j = begin; j < end; ++j) {
+                            prefix[j] = acc;
+                            if (!values[j].is_zero()) {
+                                acc *= values[j];
+                            }
+                        }
+
+                        ValueType inv = acc.inversed();
+                        for (std::size_t j = end; j-- > begin;) {
+                            if (values[j].is_zero()) {
+                                continue;
+                            }
+                            const ValueType value = values[j];
+                            values[j] = inv * prefix[j];
+                            inv *= value;
+                        }
+                    }
+                }
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_BATCH_INVERSION_HPP
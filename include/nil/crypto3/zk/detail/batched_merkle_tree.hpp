@@ -0,0 +1,258 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Merkle tree construction with batched node hashing.
+//
+// Builds the same tree as containers::make_merkle_tree. For hashes with a
+// multi-buffer implementation the leaves are hashed in batches and every row of
+// inner nodes is hashed at once; other hashes use make_merkle_tree unchanged.
+// batch_validate_merkle_proofs checks many authentication paths the same way.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_BATCHED_MERKLE_TREE_HPP
+#define CRYPTO3_ZK_DETAIL_BATCHED_MERKLE_TREE_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/container/merkle/tree.hpp>
+
+#include <nil/crypto3/zk/detail/multi_buffer_hash.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                namespace batched_merkle_tree_impl {
+                    /// Leaves copied and hashed together while streaming the input.
+                    constexpr static const std::size_t leaves_per_batch = 4096;
+
+                    /// digests[i] = hash of messages[i], hashing each run of equal-length messages in one call.
+                    template<typename Hash>
+                    void hash_runs(const std::vector<const std::uint8_t *> &messages,
+                                   const std::vector<std::size_t> &lengths, typename Hash::digest_type *digests) {
+                        std::size_t run = 0;
+                        while (run < messages.size()) {
+                            std::size_t run_end = run + 1;
+                            while (run_end < messages.size() && lengths[run_end] == lengths[run]) {
+                                ++run_end;
+                            }
+                            multi_buffer_hash<Hash>::hash(messages.data() + run, run_end - run, lengths[run],
+                                                          digests + run);
+                            run = run_end;
+                        }
+                    }
+
+                    /// Appends the digests of the messages.
+                    template<typename Hash>
+                    void hash_messages(const std::vector<std::vector<std::uint8_t>> &messages,
+                                       std::vector<typename Hash::digest_type> &digests) {
+                        std::vector<const std::uint8_t *> pointers(messages.size());
+                        std::vector<std::size_t> lengths(messages.size());
+                        for (std::size_t i = 0; i < messages.size(); ++i) {
+                            pointers[i] = messages[i].data();
+                            lengths[i] = messages[i].size();
+                        }
+
+                        const std::size_t offset = digests.size();
+                        digests.resize(offset + messages.size());
+                        hash_runs<Hash>(pointers, lengths, digests.data() + offset);
+                    }
+                }    // namespace batched_merkle_tree_impl
+
+                template<typename Hash, std::size_t Arity, typename LeafIterator>
+                typename std::enable_if<!multi_buffer_hash<Hash>::value, containers::merkle_tree<Hash, Arity>>::type
+                    make_batched_merkle_tree(LeafIterator first, LeafIterator last) {
+                    return containers::make_merkle_tree<Hash, Arity>(first, last);
+                }
+
+                /// Leaves are byte ranges; a leaf node is the hash of the leaf and an inner node the hash of
+                /// the concatenated digests of its children, as in containers::make_merkle_tree.
+                template<typename Hash, std::size_t Arity, typename LeafIterator>
+                typename std::enable_if<multi_buffer_hash<Hash>::value, containers::merkle_tree<Hash, Arity>>::type
+                    make_batched_merkle_tree(LeafIterator first, LeafIterator last) {
+                    typedef typename Hash::digest_type digest_type;
+                    constexpr std::size_t digest_bytes = multi_buffer_hash<Hash>::digest_bytes;
+
+                    std::vector<digest_type> nodes;
+                    std::vector<std::vector<std::uint8_t>> batch;
+                    batch.reserve(batched_merkle_tree_impl::leaves_per_batch);
+                    while (first != last) {
+                        const auto &leaf = *first;
+                        batch.emplace_back(std::begin(leaf), std::end(leaf));
+                        ++first;
+                        if (batch.size() == batched_merkle_tree_impl::leaves_per_batch || first == last) {
+                            batched_merkle_tree_impl::hash_messages<Hash>(batch, nodes);
+                            batch.clear();
+                        }
+                    }
+
+                    const std::size_t leaves_number = nodes.size();
+                    BOOST_ASSERT(leaves_number != 0);
+
+                    std::vector<std::uint8_t> row;
+                    std::vector<const std::uint8_t *> children;
+                    std::size_t row_begin = 0;
+                    for (std::size_t row_size = leaves_number / Arity; row_size != 0; row_size /= Arity) {
+                        row.resize(row_size * Arity * digest_bytes);
+                        children.resize(row_size);
+                        for (std::size_t i = 0; i < row_size * Arity; ++i) {
+                            std::copy(nodes[row_begin + i].begin(), nodes[row_begin + i].end(),
+                                      row.begin() + i * digest_bytes);
+                        }
+                        for (std::size_t i = 0; i < row_size; ++i) {
+                            children[i] = row.data() + i * Arity * digest_bytes;
+                        }
+
+                        row_begin = nodes.size();
+                        nodes.resize(row_begin + row_size);
+                        multi_buffer_hash<Hash>::hash(children.data(), row_size, Arity * digest_bytes,
+                                                      nodes.data() + row_begin);
+                    }
+
+                    containers::merkle_tree<Hash, Arity> result(leaves_number);
+                    result.reserve(result.complete_size());
+                    for (const digest_type &node : nodes) {
+                        result.emplace_back(node);
+                    }
+                    return result;
+                }
+
+                /// True if proofs[i]->validate(leaves[i]) holds for every i.
+                template<typename Hash, std::size_t Arity, typename Proof, typename Leaf>
+                typename std::enable_if<!multi_buffer_hash<Hash>::value, bool>::type
+                    batch_validate_merkle_proofs(const std::vector<const Proof *> &proofs,
+                                                 const std::vector<Leaf> &leaves) {
+                    BOOST_ASSERT(proofs.size() == leaves.size());
+
+                    bool result = true;
+#ifdef MULTICORE
+#pragma omp parallel for reduction(&& : result)
+#endif
+                    for (std::size_t i = 0; i < proofs.size(); ++i) {
+                        if (result && !proofs[i]->validate(leaves[i])) {
+                            result = false;
+                        }
+                    }
+                    return result;
+                }
+
+                /// True if proofs[i]->validate(leaves[i]) holds for every i. The leaves, and then every level
+                /// of all paths, are hashed together. A proof whose recomputed root differs from root() is
+                /// checked again with validate(), so the result is the one of validating proof by proof.
+                template<typename Hash, std::size_t Arity, typename Proof, typename Leaf>
+                typename std::enable_if<multi_buffer_hash<Hash>::value, bool>::type
+                    batch_validate_merkle_proofs(const std::vector<const Proof *> &proofs,
+                                                 const std::vector<Leaf> &leaves) {
+                    typedef typename Hash::digest_type digest_type;
+                    constexpr std::size_t digest_bytes = multi_buffer_hash<Hash>::digest_bytes;
+                    constexpr std::size_t node_bytes = Arity * digest_bytes;
+                    BOOST_ASSERT(proofs.size() == leaves.size());
+
+                    // leaves of equal length are hashed together
+                    std::vector<std::size_t> order(leaves.size());
+                    for (std::size_t i = 0; i < order.size(); ++i) {
+                        order[i] = i;
+                    }
+                    std::stable_sort(order.begin(), order.end(), [&leaves](std::size_t a, std::size_t b) {
+                        return leaves[a].size() < leaves[b].size();
+                    });
+
+                    std::vector<const std::uint8_t *> messages(order.size());
+                    std::vector<std::size_t> lengths(order.size());
+                    std::size_t depth = 0;
+                    for (std::size_t j = 0; j < order.size(); ++j) {
+                        messages[j] = leaves[order[j]].data();
+                        lengths[j] = leaves[order[j]].size();
+                        depth = std::max(depth, proofs[order[j]]->path().size());
+                    }
+                    std::vector<digest_type> digests(order.size());
+                    batched_merkle_tree_impl::hash_runs<Hash>(messages, lengths, digests.data());
+
+                    std::vector<digest_type> nodes(proofs.size());
+                    for (std::size_t j = 0; j < order.size(); ++j) {
+                        nodes[order[j]] = digests[j];
+                    }
+
+                    // the parent of a node is the hash of the siblings before it, the node and the siblings after
+                    // it, as in merkle_proof::validate
+                    std::vector<std::size_t> active;
+                    std::vector<std::uint8_t> row;
+                    for (std::size_t level = 0; level < depth; ++level) {
+                        active.clear();
+                        for (std::size_t i = 0; i < proofs.size(); ++i) {
+                            if (level < proofs[i]->path().size()) {
+                                active.emplace_back(i);
+                            }
+                        }
+
+                        row.resize(active.size() * node_bytes);
+                        messages.resize(active.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t j = 0; j < active.size(); ++j) {
+                            const auto &layer = proofs[active[j]]->path()[level];
+                            std::uint8_t *out = row.data() + j * node_bytes;
+                            std::size_t k = 0;
+                            for (; k < Arity - 1 && k == layer[k].position(); ++k) {
+                                out = std::copy(layer[k].hash().begin(), layer[k].hash().end(), out);
+                            }
+                            out = std::copy(nodes[active[j]].begin(), nodes[active[j]].end(), out);
+                            for (; k < Arity - 1; ++k) {
+                                out = std::copy(layer[k].hash().begin(), layer[k].hash().end(), out);
+                            }
+                            messages[j] = row.data() + j * node_bytes;
+                        }
+
+                        digests.resize(active.size());
+                        multi_buffer_hash<Hash>::hash(messages.data(), active.size(), node_bytes, digests.data());
+                        for (std::size_t j = 0; j < active.size(); ++j) {
+                            nodes[active[j]] = digests[j];
+                        }
+                    }
+
+                    bool result = true;
+#ifdef MULTICORE
+#pragma omp parallel for reduction(&& : result)
+#endif
+                    for (std::size_t i = 0; i < proofs.size(); ++i) {
+                        if (result && nodes[i] != proofs[i]->root() && !proofs[i]->validate(leaves[i])) {
+                            result = false;
+                        }
+                    }
+                    return result;
+                }
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_BATCHED_MERKLE_TREE_HPP
@@ -0,0 +1,229 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_BUFFER_POOL_HPP
+#define CRYPTO3_ZK_DETAIL_BUFFER_POOL_HPP
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /// Pool of scratch buffers keyed by their size.
+                ///
+                /// Witness maps and prover rounds request domain-sized buffers of a few distinct sizes.
+                /// Returning them to a pool lets the next call reuse the same allocations instead of
+                /// freeing and allocating them in arbitrary order. The pool is safe to share between
+                /// threads; at most max_cached buffers of every size and at most max_cached_elements
+                /// elements in total are kept. A released buffer that does not fit evicts cached buffers
+                /// of other sizes, largest first, and is dropped if it still does not fit.
+                ///
+                /// BufferType is std::vector by default. Any sized container with a copy assignment that
+                /// reuses the storage of an equally sized buffer, such as math::polynomial_dfs, can be
+                /// pooled through acquire_like.
+                template<typename ValueType, typename BufferType = std::vector<ValueType>>
+                class buffer_pool {
+                public:
+                    typedef ValueType value_type;
+                    typedef BufferType buffer_type;
+
+                    /// Buffer returned to the pool on destruction.
+                    class scoped_buffer {
+                    public:
+                        scoped_buffer(buffer_pool &pool, buffer_type &&data) : pool(&pool), data(std::move(data)) {
+                        }
+
+                        scoped_buffer(scoped_buffer &&other) : pool(other.pool), data(std::move(other.data)) {
+                            other.pool = nullptr;
+                        }
+
+                        scoped_buffer(const scoped_buffer &) = delete;
+                        scoped_buffer &operator=(const scoped_buffer &) = delete;
+
+                        ~scoped_buffer() {
+                            if (pool != nullptr) {
+                                pool->release(std::move(data));
+                            }
+                        }
+
+                        buffer_type &operator*() {
+                            return data;
+                        }
+
+                        const buffer_type &operator*() const {
+                            return data;
+                        }
+
+                        buffer_type *operator->() {
+                            return &data;
+                        }
+
+                        const buffer_type *operator->() const {
+                            return &data;
+                        }
+
+                    private:
+                        buffer_pool *pool;
+                        buffer_type data;
+                    };
+
+                    explicit buffer_pool(std::size_t max_cached = 8,
+                                         std::size_t max_cached_elements = std::numeric_limits<std::size_t>::max()) :
+                        max_cached(max_cached),
+                        max_cached_elements(max_cached_elements), cached_elements(0) {
+                    }
+
+                    buffer_pool(const buffer_pool &) = delete;
+                    buffer_pool &operator=(const buffer_pool &) = delete;
+
+                    /// Buffer of size elements, all set to value. Only for std::vector-like buffers.
+                    buffer_type acquire(std::size_t size, const value_type &value = value_type()) {
+                        buffer_type buffer;
+                        if (take(size, buffer)) {
+                            std::fill(buffer.begin(), buffer.end(), value);
+                        } else {
+                            buffer.assign(size, value);
+                        }
+                        return buffer;
+                    }
+
+                    /// Buffer equal to shape. A cached buffer of the same size is assigned from shape, so
+                    /// state besides the elements, e.g. the degree of a math::polynomial_dfs, is copied too.
+                    buffer_type acquire_like(const buffer_type &shape) {
+                        buffer_type buffer;
+                        if (!take(shape.size(), buffer)) {
+                            return buffer_type(shape);
+                        }
+                        buffer = shape;
+                        return buffer;
+                    }
+
+                    scoped_buffer acquire_scoped(std::size_t size, const value_type &value = value_type()) {
+                        return scoped_buffer(*this, acquire(size, value));
+                    }
+
+                    void release(buffer_type &&buffer) {
+                        const std::size_t size = buffer.size();
+                        if (size == 0) {
+                            return;
+                        }
+
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (size > max_cached_elements) {
+                            return;
+                        }
+                        std::vector<buffer_type> &buffers = free_buffers[size];
+                        if (buffers.size() >= max_cached) {
+                            return;
+                        }
+
+                        for (auto it = free_buffers.rbegin();
+                             it != free_buffers.rend() && cached_elements > max_cached_elements - size;) {
+                            if (it->first == size || it->second.empty()) {
+                                ++it;
+                                continue;
+                            }
+                            it->second.pop_back();
+                            cached_elements -= it->first;
+                        }
+                        if (cached_elements > max_cached_elements - size) {
+                            return;
+                        }
+
+                        buffers.push_back(std::move(buffer));
+                        cached_elements += size;
+                    }
+
+                    /// Total number of elements in the buffers currently held by the pool.
+                    std::size_t cached_size() const {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        return cached_elements;
+                    }
+
+                    /// Upper bound on the total number of elements kept by the pool.
+                    std::size_t max_cached_size() const {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        return max_cached_elements;
+                    }
+
+                    /// Changes the bound on the total number of elements. Lowering it evicts cached buffers,
+                    /// largest first, until the remaining ones fit.
+                    void set_max_cached_size(std::size_t elements) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        max_cached_elements = elements;
+                        for (auto it = free_buffers.rbegin(); it != free_buffers.rend() && cached_elements > elements;) {
+                            if (it->second.empty()) {
+                                ++it;
+                                continue;
+                            }
+                            it->second.pop_back();
+                            cached_elements -= it->first;
+                        }
+                    }
+
+                    /// Number of buffers currently held by the pool.
+                    std::size_t cached() const {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        std::size_t result = 0;
+                        for (const auto &it : free_buffers) {
+                            result += it.second.size();
+                        }
+                        return result;
+                    }
+
+                    void clear() {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        free_buffers.clear();
+                        cached_elements = 0;
+                    }
+
+                private:
+                    bool take(std::size_t size, buffer_type &buffer) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        auto it = free_buffers.find(size);
+                        if (it == free_buffers.end() || it->second.empty()) {
+                            return false;
+                        }
+                        buffer = std::move(it->second.back());
+                        it->second.pop_back();
+                        cached_elements -= size;
+                        return true;
+                    }
+
+                    std::size_t max_cached;
+                    std::size_t max_cached_elements;
+                    std::size_t cached_elements;
+                    mutable std::mutex mutex;
+                    std::map<std::size_t, std::vector<buffer_type>> free_buffers;
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_BUFFER_POOL_HPP
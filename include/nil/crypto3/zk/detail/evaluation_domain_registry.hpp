@@ -0,0 +1,233 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_EVALUATION_DOMAIN_REGISTRY_HPP
+#define CRYPTO3_ZK_DETAIL_EVALUATION_DOMAIN_REGISTRY_HPP
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+
+#include <nil/crypto3/zk/detail/field_powers.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /// Process-wide cache of evaluation domains and coset power tables.
+                ///
+                /// Reductions and provers request the same few domain sizes for every proof. The
+                /// registry builds each domain once per (FieldType, ValueType, size) and hands out the
+                /// same instance afterwards. A domain runs one transform before it is published, so
+                /// domains which complete their precomputation lazily are not modified once shared
+                /// and may be used from several threads. At most capacity() domains and capacity() coset
+                /// tables are kept; beyond that the least recently requested ones are dropped. Instances
+                /// already handed out stay valid. All members are thread-safe. The registry lock only
+                /// guards the lookup; an entry is built outside of it by the first caller, and concurrent
+                /// callers for the same entry wait for that build alone.
+                template<typename FieldType, typename ValueType = typename FieldType::value_type>
+                struct evaluation_domain_registry {
+                    typedef typename FieldType::value_type field_value_type;
+                    typedef math::evaluation_domain<FieldType, ValueType> domain_type;
+
+                    /// Powers shift^i and shift^{-i} for i < size, used to move evaluations to and
+                    /// from the coset shift * S.
+                    struct coset_type {
+                        field_value_type shift;
+                        std::vector<field_value_type> powers;
+                        std::vector<field_value_type> inverse_powers;
+                    };
+
+                    constexpr static const std::size_t default_capacity = 32;
+
+                    static std::shared_ptr<domain_type> domain(std::size_t size) {
+                        state_type &s = state();
+                        std::promise<std::shared_ptr<domain_type>> promise;
+                        std::shared_future<std::shared_ptr<domain_type>> result;
+                        std::size_t id = 0;
+                        {
+                            std::lock_guard<std::mutex> lock(s.mutex);
+                            domain_entry &entry = s.domains[size];
+                            entry.last_use = ++s.tick;
+                            if (!entry.domain.valid()) {
+                                entry.domain = promise.get_future().share();
+                                entry.id = id = entry.last_use;
+                            }
+                            result = entry.domain;
+                            evict_domains(s);
+                        }
+                        if (id == 0) {
+                            return result.get();
+                        }
+
+                        try {
+                            std::shared_ptr<domain_type> domain =
+                                math::make_evaluation_domain<FieldType, ValueType>(size);
+                            std::vector<ValueType> warm_up(domain->m, ValueType::zero());
+                            domain->fft(warm_up);
+                            promise.set_value(domain);
+                            return domain;
+                        } catch (...) {
+                            promise.set_exception(std::current_exception());
+                            std::lock_guard<std::mutex> lock(s.mutex);
+                            auto it = s.domains.find(size);
+                            if (it != s.domains.end() && it->second.id == id) {
+                                s.domains.erase(it);
+                            }
+                            throw;
+                        }
+                    }
+
+                    /// Domains of sizes 2^max_domain_degree, 2^{max_domain_degree - 1}, ... as used by FRI.
+                    static std::vector<std::shared_ptr<domain_type>> domain_set(std::size_t max_domain_degree,
+                                                                                std::size_t set_size) {
+                        std::vector<std::shared_ptr<domain_type>> result(set_size);
+                        for (std::size_t i = 0; i < set_size; ++i) {
+                            result[i] = domain(std::size_t(1) << (max_domain_degree - i));
+                        }
+                        return result;
+                    }
+
+                    static std::shared_ptr<const coset_type> coset(std::size_t size, const field_value_type &shift) {
+                        state_type &s = state();
+                        std::promise<std::shared_ptr<const coset_type>> promise;
+                        std::shared_future<std::shared_ptr<const coset_type>> result;
+                        std::size_t id = 0;
+                        {
+                            std::lock_guard<std::mutex> lock(s.mutex);
+                            for (coset_entry &entry : s.cosets) {
+                                if (entry.size == size && entry.shift == shift) {
+                                    entry.last_use = ++s.tick;
+                                    result = entry.coset;
+                                    break;
+                                }
+                            }
+                            if (!result.valid()) {
+                                result = promise.get_future().share();
+                                id = ++s.tick;
+                                s.cosets.push_back({size, shift, result, id, id});
+                                evict_cosets(s);
+                            }
+                        }
+                        if (id == 0) {
+                            return result.get();
+                        }
+
+                        try {
+                            std::shared_ptr<coset_type> coset = std::make_shared<coset_type>();
+                            coset->shift = shift;
+                            fill_powers(coset->powers, shift, size);
+                            fill_powers(coset->inverse_powers, shift.inversed(), size);
+                            promise.set_value(coset);
+                            return coset;
+                        } catch (...) {
+                            promise.set_exception(std::current_exception());
+                            std::lock_guard<std::mutex> lock(s.mutex);
+                            s.cosets.erase(std::remove_if(s.cosets.begin(), s.cosets.end(),
+                                                          [id](const coset_entry &entry) { return entry.id == id; }),
+                                           s.cosets.end());
+                            throw;
+                        }
+                    }
+
+                    /// Maximum number of cached domains, and separately of cached coset tables.
+                    static std::size_t capacity() {
+                        std::lock_guard<std::mutex> lock(state().mutex);
+                        return state().capacity;
+                    }
+
+                    /// Sets the maximum number of cached entries, dropping the least recently used ones if needed.
+                    static void set_capacity(std::size_t capacity) {
+                        state_type &s = state();
+                        std::lock_guard<std::mutex> lock(s.mutex);
+                        s.capacity = capacity;
+                        evict_domains(s);
+                        evict_cosets(s);
+                    }
+
+                    /// Drops all cached domains and tables. Instances already handed out stay valid.
+                    static void clear() {
+                        std::lock_guard<std::mutex> lock(state().mutex);
+                        state().domains.clear();
+                        state().cosets.clear();
+                    }
+
+                private:
+                    // id is the tick at which the entry was created; a failed build only drops its own entry.
+                    struct domain_entry {
+                        std::shared_future<std::shared_ptr<domain_type>> domain;
+                        std::size_t last_use = 0;
+                        std::size_t id = 0;
+                    };
+
+                    struct coset_entry {
+                        std::size_t size;
+                        field_value_type shift;
+                        std::shared_future<std::shared_ptr<const coset_type>> coset;
+                        std::size_t last_use;
+                        std::size_t id;
+                    };
+
+                    struct state_type {
+                        std::mutex mutex;
+                        std::size_t capacity = default_capacity;
+                        std::size_t tick = 0;
+                        std::map<std::size_t, domain_entry> domains;
+                        std::vector<coset_entry> cosets;
+                    };
+
+                    static void evict_domains(state_type &s) {
+                        while (s.domains.size() > s.capacity) {
+                            s.domains.erase(std::min_element(s.domains.begin(), s.domains.end(),
+                                                             [](const auto &a, const auto &b) {
+                                                                 return a.second.last_use < b.second.last_use;
+                                                             }));
+                        }
+                    }
+
+                    static void evict_cosets(state_type &s) {
+                        while (s.cosets.size() > s.capacity) {
+                            s.cosets.erase(std::min_element(s.cosets.begin(), s.cosets.end(),
+                                                            [](const coset_entry &a, const coset_entry &b) {
+                                                                return a.last_use < b.last_use;
+                                                            }));
+                        }
+                    }
+
+                    static state_type &state() {
+                        static state_type instance;
+                        return instance;
+                    }
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_EVALUATION_DOMAIN_REGISTRY_HPP
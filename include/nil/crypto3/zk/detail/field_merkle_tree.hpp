@@ -0,0 +1,224 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Merkle tree over leaves of field elements.
+//
+// Counterpart of containers::merkle_tree and containers::merkle_proof for
+// field-native hashes such as poseidon_hash: leaves are sequences of field
+// elements and nodes are field elements, so nothing is marshalled to bytes.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_FIELD_MERKLE_TREE_HPP
+#define CRYPTO3_ZK_DETAIL_FIELD_MERKLE_TREE_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /**
+                 * Complete Arity-ary tree, stored row by row from the leaves to the root. The number of
+                 * leaves must be a power of Arity. Leaf nodes are Hash::hash of the leaf elements,
+                 * inner nodes Hash::hash_nodes of their children.
+                 */
+                template<typename Hash, std::size_t Arity = 2>
+                class field_merkle_tree {
+                public:
+                    typedef Hash hash_type;
+                    typedef typename Hash::digest_type value_type;
+
+                    constexpr static const std::size_t arity = Arity;
+
+                    field_merkle_tree() : leaves_number(0) {
+                    }
+
+                    /// Builds the tree of the leaves [first, last), each a range of field elements.
+                    template<typename LeafIterator>
+                    field_merkle_tree(LeafIterator first, LeafIterator last) {
+                        typedef typename std::iterator_traits<LeafIterator>::value_type leaf_type;
+                        constexpr std::size_t leaves_per_batch = 4096;
+
+                        std::vector<std::vector<typename Hash::value_type>> batch;
+                        while (first != last) {
+                            const leaf_type &leaf = *first;
+                            batch.emplace_back(std::begin(leaf), std::end(leaf));
+                            ++first;
+                            if (batch.size() == leaves_per_batch || first == last) {
+                                const std::size_t offset = nodes.size();
+                                nodes.resize(offset + batch.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                                for (std::size_t i = 0; i < batch.size(); ++i) {
+                                    nodes[offset + i] = Hash::hash(batch[i].begin(), batch[i].end());
+                                }
+                                batch.clear();
+                            }
+                        }
+
+                        leaves_number = nodes.size();
+                        BOOST_ASSERT(leaves_number != 0);
+                        for (std::size_t n = leaves_number; n > 1; n /= Arity) {
+                            BOOST_ASSERT(n % Arity == 0);
+                        }
+
+                        std::size_t row_begin = 0;
+                        for (std::size_t row_size = leaves_number / Arity; row_size != 0; row_size /= Arity) {
+                            const std::size_t children_begin = row_begin;
+                            row_begin = nodes.size();
+                            nodes.resize(row_begin + row_size);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < row_size; ++i) {
+                                const auto children = nodes.begin() + children_begin + i * Arity;
+                                nodes[row_begin + i] = Hash::hash_nodes(children, children + Arity);
+                            }
+                        }
+                    }
+
+                    value_type root() const {
+                        return nodes.back();
+                    }
+
+                    std::size_t leaves() const {
+                        return leaves_number;
+                    }
+
+                    std::size_t size() const {
+                        return nodes.size();
+                    }
+
+                    const value_type &operator[](std::size_t i) const {
+                        return nodes[i];
+                    }
+
+                    bool operator==(const field_merkle_tree &other) const {
+                        return nodes == other.nodes;
+                    }
+
+                    bool operator!=(const field_merkle_tree &other) const {
+                        return !(*this == other);
+                    }
+
+                private:
+                    std::size_t leaves_number;
+                    std::vector<value_type> nodes;
+                };
+
+                /**
+                 * Authentication path of one leaf of a field_merkle_tree. path()[l] holds the siblings of
+                 * the node on level l, in order with the node itself left out.
+                 */
+                template<typename Hash, std::size_t Arity = 2>
+                class field_merkle_proof {
+                public:
+                    typedef Hash hash_type;
+                    typedef typename Hash::digest_type value_type;
+                    typedef std::array<value_type, Arity - 1> siblings_type;
+
+                    field_merkle_proof() : leaf_idx(0) {
+                    }
+
+                    field_merkle_proof(const field_merkle_tree<Hash, Arity> &tree, std::size_t leaf_idx) :
+                        leaf_idx(leaf_idx), root_value(tree.root()) {
+                        BOOST_ASSERT(leaf_idx < tree.leaves());
+
+                        std::size_t row_begin = 0;
+                        std::size_t idx = leaf_idx;
+                        for (std::size_t row_size = tree.leaves(); row_size > 1; row_size /= Arity) {
+                            const std::size_t group = idx - idx % Arity;
+                            siblings_type siblings;
+                            for (std::size_t i = 0, k = 0; i < Arity; ++i) {
+                                if (group + i != idx) {
+                                    siblings[k++] = tree[row_begin + group + i];
+                                }
+                            }
+                            path_elements.push_back(siblings);
+                            row_begin += row_size;
+                            idx /= Arity;
+                        }
+                    }
+
+                    field_merkle_proof(std::size_t leaf_idx, const value_type &root,
+                                       const std::vector<siblings_type> &path) :
+                        leaf_idx(leaf_idx), root_value(root), path_elements(path) {
+                    }
+
+                    /// True if the leaf, a range of field elements, is at leaf_index() of the tree with root().
+                    template<typename LeafRange>
+                    bool validate(const LeafRange &leaf) const {
+                        value_type node = Hash::hash(std::begin(leaf), std::end(leaf));
+                        std::size_t idx = leaf_idx;
+                        for (const siblings_type &siblings : path_elements) {
+                            const std::size_t position = idx % Arity;
+                            std::array<value_type, Arity> children;
+                            for (std::size_t i = 0, k = 0; i < Arity; ++i) {
+                                children[i] = i == position ? node : siblings[k++];
+                            }
+                            node = Hash::hash_nodes(children.begin(), children.end());
+                            idx /= Arity;
+                        }
+                        return node == root_value;
+                    }
+
+                    value_type root() const {
+                        return root_value;
+                    }
+
+                    std::size_t leaf_index() const {
+                        return leaf_idx;
+                    }
+
+                    const std::vector<siblings_type> &path() const {
+                        return path_elements;
+                    }
+
+                    bool operator==(const field_merkle_proof &other) const {
+                        return leaf_idx == other.leaf_idx && root_value == other.root_value &&
+                               path_elements == other.path_elements;
+                    }
+
+                    bool operator!=(const field_merkle_proof &other) const {
+                        return !(*this == other);
+                    }
+
+                private:
+                    std::size_t leaf_idx;
+                    value_type root_value;
+                    std::vector<siblings_type> path_elements;
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_FIELD_MERKLE_TREE_HPP
@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_FIELD_POWERS_HPP
+#define CRYPTO3_ZK_DETAIL_FIELD_POWERS_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /// Sets powers to base^i for i < size.
+                ///
+                /// The range is split into chunks which run in parallel. Each chunk starts from one
+                /// exponentiation and continues with one multiplication per element.
+                template<typename ValueType>
+                void fill_powers(std::vector<ValueType> &powers, const ValueType &base, std::size_t size) {
+                    powers.resize(size);
+#ifdef MULTICORE
+                    const std::size_t chunks =
+                        std::max<std::size_t>(1, std::min<std::size_t>(omp_get_max_threads(), size));
+#else
+                    const std::size_t chunks = 1;
+#endif
+                    const std::size_t chunk_size = (size + chunks - 1) / chunks;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                    for (std::size_t c = 0; c < chunks; ++c) {
+                        const std::size_t begin = c * chunk_size;
+                        const std::size_t end = std::min(size, begin + chunk_size);
+                        if (begin >= end) {
+                            continue;
+                        }
+
+                        ValueType power = base.pow(begin);
+                        for (std::size_t i = begin; i < end; ++i) {
+                            powers[i] = power;
+                            power *= base;
+                        }
+                    }
+                }
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_FIELD_POWERS_HPP
@@ -0,0 +1,248 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Multi-buffer Keccak-f[1600] sponge.
+//
+// Hashes 8 (AVX-512) or 4 (AVX2) equal-length messages at once by keeping lane i
+// of every message in one vector register, selected at run time. Other targets
+// and CPUs use a one-message version of the same code.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_KECCAK_MULTI_BUFFER_HPP
+#define CRYPTO3_ZK_DETAIL_KECCAK_MULTI_BUFFER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRYPTO3_ZK_KECCAK_MULTI_BUFFER_X86
+#endif
+
+#ifdef CRYPTO3_ZK_KECCAK_MULTI_BUFFER_X86
+#define CRYPTO3_ZK_KECCAK_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define CRYPTO3_ZK_KECCAK_ALWAYS_INLINE inline
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                namespace keccak_multi_buffer_impl {
+                    constexpr static const std::uint64_t round_constants[24] = {
+                        0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+                        0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+                        0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+                        0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+                        0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+                        0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+
+                    // rotation offset of lane x + 5 * y
+                    constexpr static const unsigned rotations[25] = {0,  1,  62, 28, 27, 36, 44, 6,  55, 20, 3,  10, 43,
+                                                                     25, 39, 41, 45, 15, 21, 8,  18, 2,  61, 56, 14};
+
+                    // out = v rotated left by n; vectors are passed by reference to keep them out of the ABI
+                    template<typename Vector>
+                    CRYPTO3_ZK_KECCAK_ALWAYS_INLINE void rotl(Vector &out, const Vector &v, unsigned n) {
+                        out = n == 0 ? v : (v << n) | (v >> (64 - n));
+                    }
+
+                    template<typename Vector>
+                    CRYPTO3_ZK_KECCAK_ALWAYS_INLINE void permute(Vector *a) {
+                        Vector b[25];
+                        Vector c[5];
+                        for (std::size_t round = 0; round < 24; ++round) {
+                            for (std::size_t x = 0; x < 5; ++x) {
+                                c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+                            }
+                            for (std::size_t x = 0; x < 5; ++x) {
+                                Vector d;
+                                rotl(d, c[(x + 1) % 5], 1);
+                                d ^= c[(x + 4) % 5];
+                                for (std::size_t y = 0; y < 25; y += 5) {
+                                    a[x + y] ^= d;
+                                }
+                            }
+                            for (std::size_t x = 0; x < 5; ++x) {
+                                for (std::size_t y = 0; y < 5; ++y) {
+                                    rotl(b[y + 5 * ((2 * x + 3 * y) % 5)], a[x + 5 * y], rotations[x + 5 * y]);
+                                }
+                            }
+                            for (std::size_t y = 0; y < 25; y += 5) {
+                                for (std::size_t x = 0; x < 5; ++x) {
+                                    a[x + y] = b[x + y] ^ (~b[(x + 1) % 5 + y] & b[(x + 2) % 5 + y]);
+                                }
+                            }
+                            a[0] ^= round_constants[round];
+                        }
+                    }
+
+                    CRYPTO3_ZK_KECCAK_ALWAYS_INLINE std::uint64_t load_le64(const std::uint8_t *p) {
+                        std::uint64_t r = 0;
+                        for (std::size_t i = 0; i < 8; ++i) {
+                            r |= std::uint64_t(p[i]) << (8 * i);
+                        }
+                        return r;
+                    }
+
+                    /*
+                     * Keccak sponge with the original padding (0x01 ... 0x80) over Lanes messages of equal
+                     * length. Vector holds one 64-bit word per message.
+                     */
+                    template<typename Vector, std::size_t Lanes>
+                    CRYPTO3_ZK_KECCAK_ALWAYS_INLINE void sponge(std::size_t rate, std::size_t digest_bytes,
+                                                                const std::uint8_t *const *messages,
+                                                                std::size_t length, std::uint8_t *const *digests) {
+                        Vector a[25];
+                        std::uint64_t words[Lanes];
+                        std::memset(words, 0, sizeof(words));
+                        for (std::size_t i = 0; i < 25; ++i) {
+                            std::memcpy(&a[i], words, sizeof(Vector));
+                        }
+
+                        const std::size_t rate_words = rate / 8;
+                        std::size_t offset = 0;
+                        for (; offset + rate <= length; offset += rate) {
+                            for (std::size_t w = 0; w < rate_words; ++w) {
+                                for (std::size_t l = 0; l < Lanes; ++l) {
+                                    words[l] = load_le64(messages[l] + offset + 8 * w);
+                                }
+                                Vector v;
+                                std::memcpy(&v, words, sizeof(Vector));
+                                a[w] ^= v;
+                            }
+                            permute(a);
+                        }
+
+                        std::uint8_t last[Lanes][200];
+                        const std::size_t tail = length - offset;
+                        for (std::size_t l = 0; l < Lanes; ++l) {
+                            std::memset(last[l], 0, rate);
+                            std::memcpy(last[l], messages[l] + offset, tail);
+                            last[l][tail] ^= 0x01;
+                            last[l][rate - 1] ^= 0x80;
+                        }
+                        for (std::size_t w = 0; w < rate_words; ++w) {
+                            for (std::size_t l = 0; l < Lanes; ++l) {
+                                words[l] = load_le64(last[l] + 8 * w);
+                            }
+                            Vector v;
+                            std::memcpy(&v, words, sizeof(Vector));
+                            a[w] ^= v;
+                        }
+                        permute(a);
+
+                        for (std::size_t b = 0; b < digest_bytes; b += 8) {
+                            std::memcpy(words, &a[b / 8], sizeof(Vector));
+                            for (std::size_t l = 0; l < Lanes; ++l) {
+                                for (std::size_t i = 0; i < 8 && b + i < digest_bytes; ++i) {
+                                    digests[l][b + i] = std::uint8_t(words[l] >> (8 * i));
+                                }
+                            }
+                        }
+                    }
+
+#ifdef CRYPTO3_ZK_KECCAK_MULTI_BUFFER_X86
+                    typedef std::uint64_t vector4_type __attribute__((vector_size(32)));
+                    typedef std::uint64_t vector8_type __attribute__((vector_size(64)));
+
+                    __attribute__((target("avx2"))) inline void
+                        sponge_x4(std::size_t rate, std::size_t digest_bytes, const std::uint8_t *const *messages,
+                                  std::size_t length, std::uint8_t *const *digests) {
+                        sponge<vector4_type, 4>(rate, digest_bytes, messages, length, digests);
+                    }
+
+                    __attribute__((target("avx512f"))) inline void
+                        sponge_x8(std::size_t rate, std::size_t digest_bytes, const std::uint8_t *const *messages,
+                                  std::size_t length, std::uint8_t *const *digests) {
+                        sponge<vector8_type, 8>(rate, digest_bytes, messages, length, digests);
+                    }
+#endif
+
+                    inline void sponge_x1(std::size_t rate, std::size_t digest_bytes,
+                                          const std::uint8_t *const *messages, std::size_t length,
+                                          std::uint8_t *const *digests) {
+                        sponge<std::uint64_t, 1>(rate, digest_bytes, messages, length, digests);
+                    }
+                }    // namespace keccak_multi_buffer_impl
+
+                /// Keccak with a capacity of twice the digest size, as keccak_1600<DigestBits>, over several
+                /// messages of equal length per call.
+                struct keccak_multi_buffer {
+                    constexpr static const std::size_t max_lanes = 8;
+
+                    /// Messages hashed together on this CPU: 8 with AVX-512F, 4 with AVX2, 1 otherwise.
+                    static std::size_t lanes() {
+#ifdef CRYPTO3_ZK_KECCAK_MULTI_BUFFER_X86
+                        static const std::size_t result =
+                            __builtin_cpu_supports("avx512f") ? 8 : (__builtin_cpu_supports("avx2") ? 4 : 1);
+                        return result;
+#else
+                        return 1;
+#endif
+                    }
+
+                    /// Hashes count <= lanes() messages of the given length into digests of digest_bytes each.
+                    static void hash(std::size_t digest_bytes, const std::uint8_t *const *messages, std::size_t count,
+                                     std::size_t length, std::uint8_t *const *digests) {
+                        const std::size_t rate = 200 - 2 * digest_bytes;
+                        const std::size_t width = lanes();
+
+                        if (count == 0) {
+                            return;
+                        }
+                        if (width == 1 || count == 1) {
+                            for (std::size_t i = 0; i < count; ++i) {
+                                keccak_multi_buffer_impl::sponge_x1(rate, digest_bytes, messages + i, length,
+                                                                    digests + i);
+                            }
+                            return;
+                        }
+
+                        // unused lanes repeat the first message into a scratch digest
+                        std::uint8_t scratch[max_lanes][100];
+                        const std::uint8_t *lane_messages[max_lanes];
+                        std::uint8_t *lane_digests[max_lanes];
+                        for (std::size_t l = 0; l < width; ++l) {
+                            lane_messages[l] = l < count ? messages[l] : messages[0];
+                            lane_digests[l] = l < count ? digests[l] : scratch[l];
+                        }
+
+#ifdef CRYPTO3_ZK_KECCAK_MULTI_BUFFER_X86
+                        if (width == 8) {
+                            keccak_multi_buffer_impl::sponge_x8(rate, digest_bytes, lane_messages, length,
+                                                                lane_digests);
+                        } else {
+                            keccak_multi_buffer_impl::sponge_x4(rate, digest_bytes, lane_messages, length,
+                                                                lane_digests);
+                        }
+#endif
+                    }
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#undef CRYPTO3_ZK_KECCAK_ALWAYS_INLINE
+
+#endif    // CRYPTO3_ZK_DETAIL_KECCAK_MULTI_BUFFER_HPP
@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Hashing of many equal-length messages at once.
+//
+// multi_buffer_hash<Hash> is specialized for hashes with a multi-buffer
+// implementation. The Keccak specialization compares the multi-buffer sponge with
+// crypto3's Keccak once before first use and falls back to the latter if they differ.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_MULTI_BUFFER_HASH_HPP
+#define CRYPTO3_ZK_DETAIL_MULTI_BUFFER_HASH_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/keccak.hpp>
+
+#include <nil/crypto3/zk/detail/keccak_multi_buffer.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /// Hashes without a multi-buffer implementation.
+                template<typename Hash>
+                struct multi_buffer_hash {
+                    constexpr static const bool value = false;
+                };
+
+                template<std::size_t DigestBits>
+                struct multi_buffer_hash<hashes::keccak_1600<DigestBits>> {
+                    typedef hashes::keccak_1600<DigestBits> hash_type;
+                    typedef typename hash_type::digest_type digest_type;
+
+                    constexpr static const bool value = true;
+                    constexpr static const std::size_t digest_bytes = DigestBits / 8;
+
+                    /// digests[i] = hash<hash_type>(messages[i], messages[i] + length) for i < count.
+                    static void hash(const std::uint8_t *const *messages, std::size_t count, std::size_t length,
+                                     digest_type *digests) {
+                        const std::size_t width = lanes();
+                        if (width == 0) {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < count; ++i) {
+                                digests[i] = crypto3::hash<hash_type>(messages[i], messages[i] + length);
+                            }
+                            return;
+                        }
+
+                        const std::size_t groups = (count + width - 1) / width;
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t g = 0; g < groups; ++g) {
+                            const std::size_t first = g * width;
+                            const std::size_t n = std::min(width, count - first);
+                            std::uint8_t *outputs[keccak_multi_buffer::max_lanes];
+                            for (std::size_t l = 0; l < n; ++l) {
+                                outputs[l] = digests[first + l].data();
+                            }
+                            keccak_multi_buffer::hash(digest_bytes, messages + first, n, length, outputs);
+                        }
+                    }
+
+                private:
+                    /// Messages per sponge call, or 0 if the multi-buffer sponge is not used.
+                    static std::size_t lanes() {
+                        static const std::size_t result = self_check() ? keccak_multi_buffer::lanes() : 0;
+                        return result;
+                    }
+
+                    /// Compares both implementations on messages spanning several blocks.
+                    static bool self_check() {
+                        const std::size_t width = keccak_multi_buffer::lanes();
+                        const std::size_t length = 2 * (200 - 2 * digest_bytes) + 3;
+
+                        std::vector<std::vector<std::uint8_t>> messages(width, std::vector<std::uint8_t>(length));
+                        std::vector<const std::uint8_t *> message_ptrs(width);
+                        std::vector<digest_type> digests(width);
+                        std::vector<std::uint8_t *> digest_ptrs(width);
+                        for (std::size_t l = 0; l < width; ++l) {
+                            for (std::size_t i = 0; i < length; ++i) {
+                                messages[l][i] = std::uint8_t(31 * l + 7 * i + 1);
+                            }
+                            message_ptrs[l] = messages[l].data();
+                            digest_ptrs[l] = digests[l].data();
+                        }
+                        keccak_multi_buffer::hash(digest_bytes, message_ptrs.data(), width, length,
+                                                  digest_ptrs.data());
+
+                        for (std::size_t l = 0; l < width; ++l) {
+                            const digest_type expected =
+                                crypto3::hash<hash_type>(messages[l].begin(), messages[l].end());
+                            if (!std::equal(expected.begin(), expected.end(), digests[l].begin())) {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_MULTI_BUFFER_HASH_HPP
@@ -0,0 +1,105 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Field-native Poseidon sponge for Merkle trees and transcripts.
+//
+// poseidon_hash<FieldType> hashes sequences of field elements without marshalling
+// them to bytes. Used as the Merkle tree or transcript hash of FRI and Placeholder,
+// it selects the field-native Merkle tree and transcript, whose checks are cheap to
+// express in a circuit verifying a proof recursively.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_POSEIDON_HASH_HPP
+#define CRYPTO3_ZK_DETAIL_POSEIDON_HASH_HPP
+
+#include <iterator>
+#include <type_traits>
+
+#include <nil/crypto3/zk/detail/poseidon_permutation.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /**
+                 * Sponge over poseidon_permutation with a capacity of one element, state[0], and a
+                 * rate of Width - 1 elements. The capacity is initialized with the input length, and
+                 * with a separate domain tag for Merkle inner nodes, so inputs need no padding.
+                 */
+                template<typename FieldType, std::size_t Width = 3, std::size_t FullRounds = 8,
+                         std::size_t PartialRounds = 57, std::size_t Alpha = 5>
+                struct poseidon_hash {
+                    typedef poseidon_permutation<FieldType, Width, FullRounds, PartialRounds, Alpha> permutation_type;
+                    typedef typename permutation_type::state_type state_type;
+
+                    typedef FieldType field_type;
+                    typedef typename FieldType::value_type value_type;
+                    typedef value_type digest_type;
+
+                    constexpr static const std::size_t rate = Width - 1;
+
+                    /// Hash of the field elements [first, last), a Merkle leaf.
+                    template<typename InputIterator>
+                    static digest_type hash(InputIterator first, InputIterator last) {
+                        return absorb(first, last, value_type::zero());
+                    }
+
+                    /// Hash of the children [first, last) of a Merkle inner node.
+                    template<typename InputIterator>
+                    static digest_type hash_nodes(InputIterator first, InputIterator last) {
+                        return absorb(first, last, value_type(2).pow(64));
+                    }
+
+                    static void permute(state_type &state) {
+                        permutation_type::instance().permute(state);
+                    }
+
+                private:
+                    template<typename InputIterator>
+                    static digest_type absorb(InputIterator first, InputIterator last, const value_type &domain) {
+                        const permutation_type &permutation = permutation_type::instance();
+
+                        state_type state;
+                        state.fill(value_type::zero());
+                        state[0] = domain + value_type(std::size_t(std::distance(first, last)));
+                        do {
+                            for (std::size_t i = 1; i < Width && first != last; ++i, ++first) {
+                                state[i] += *first;
+                            }
+                            permutation.permute(state);
+                        } while (first != last);
+                        return state[1];
+                    }
+                };
+
+                template<typename Hash>
+                struct is_field_native_hash : std::false_type { };
+
+                template<typename FieldType, std::size_t Width, std::size_t FullRounds, std::size_t PartialRounds,
+                         std::size_t Alpha>
+                struct is_field_native_hash<poseidon_hash<FieldType, Width, FullRounds, PartialRounds, Alpha>>
+                    : std::true_type { };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_POSEIDON_HASH_HPP
@@ -0,0 +1,410 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Poseidon permutation with precomputed round schedule.
+//
+// Round constants and the Cauchy MDS matrix are derived with the Grain LFSR of the
+// Poseidon reference implementation and match the reference parameters for the same
+// field and round numbers. The reference additionally rejects MDS candidates failing
+// its invariant subspace checks, which are not repeated here.
+//
+// The partial rounds are evaluated in the optimized form of the Poseidon paper
+// (Appendix B): their round constants are moved forward so that one field addition
+// per partial round remains, and the MDS matrix of all but the last partial round is
+// replaced by a sparse matrix, so a partial round costs O(Width) instead of
+// O(Width^2) multiplications.
+//
+// References:
+// "Poseidon: A New Hash Function for Zero-Knowledge Proof Systems",
+// Lorenzo Grassi, Dmitry Khovratovich, Christian Rechberger, Arnab Roy, Markus Schofnegger,
+// <https://eprint.iacr.org/2019/458.pdf>
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_POSEIDON_PERMUTATION_HPP
+#define CRYPTO3_ZK_DETAIL_POSEIDON_PERMUTATION_HPP
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /**
+                 * Poseidon permutation of Width elements of FieldType with the x^Alpha S-box,
+                 * FullRounds full rounds split around PartialRounds partial rounds.
+                 *
+                 * Alpha must be coprime to the multiplicative group order of the field. The
+                 * default round numbers are those of the reference instance for ~255-bit fields
+                 * with Width = 3.
+                 */
+                template<typename FieldType, std::size_t Width = 3, std::size_t FullRounds = 8,
+                         std::size_t PartialRounds = 57, std::size_t Alpha = 5>
+                class poseidon_permutation {
+                    static_assert(Width >= 2, "Poseidon needs at least two state elements");
+                    static_assert(FullRounds % 2 == 0, "full rounds are split evenly around the partial rounds");
+                    static_assert(PartialRounds >= 1, "at least one partial round is required");
+
+                public:
+                    typedef FieldType field_type;
+                    typedef typename FieldType::value_type value_type;
+                    typedef std::array<value_type, Width> state_type;
+                    typedef std::array<state_type, Width> matrix_type;
+
+                    constexpr static const std::size_t width = Width;
+                    constexpr static const std::size_t full_rounds = FullRounds;
+                    constexpr static const std::size_t partial_rounds = PartialRounds;
+                    constexpr static const std::size_t alpha = Alpha;
+
+                    /// Permutation with the reference parameters, generated once per process.
+                    static const poseidon_permutation &instance() {
+                        static const poseidon_permutation result(generate_parameters());
+                        return result;
+                    }
+
+                    /// round_constants[r] is added to the state at the beginning of round r.
+                    poseidon_permutation(const std::vector<state_type> &round_constants, const matrix_type &mds) :
+                        constants(round_constants), mds_matrix(mds) {
+                        BOOST_ASSERT(constants.size() == FullRounds + PartialRounds);
+                        precompute_partial_rounds();
+                    }
+
+                    const std::vector<state_type> &round_constants() const {
+                        return constants;
+                    }
+
+                    const matrix_type &mds() const {
+                        return mds_matrix;
+                    }
+
+                    void permute(state_type &state) const {
+                        constexpr std::size_t half = FullRounds / 2;
+
+                        for (std::size_t r = 0; r < half; ++r) {
+                            full_round(state, constants[r]);
+                        }
+
+                        add(state, first_partial_constants);
+                        for (std::size_t j = 0; j + 1 < PartialRounds; ++j) {
+                            state[0] = sbox(state[0]) + partial_constants[j];
+
+                            // sparse matrix [[m_00, v_j], [w_j, I]]
+                            const value_type x0 = state[0];
+                            value_type y0 = mds_matrix[0][0] * x0;
+                            for (std::size_t i = 1; i < Width; ++i) {
+                                y0 += sparse_rows[j][i - 1] * state[i];
+                                state[i] += sparse_columns[j][i - 1] * x0;
+                            }
+                            state[0] = y0;
+                        }
+                        state[0] = sbox(state[0]);
+                        multiply(state, last_partial_matrix);
+
+                        for (std::size_t r = half + PartialRounds; r < FullRounds + PartialRounds; ++r) {
+                            full_round(state, constants[r]);
+                        }
+                    }
+
+                    /// Round-by-round evaluation as in the specification, used to check the optimized schedule.
+                    void permute_reference(state_type &state) const {
+                        constexpr std::size_t half = FullRounds / 2;
+                        for (std::size_t r = 0; r < FullRounds + PartialRounds; ++r) {
+                            add(state, constants[r]);
+                            if (r < half || r >= half + PartialRounds) {
+                                for (value_type &x : state) {
+                                    x = sbox(x);
+                                }
+                            } else {
+                                state[0] = sbox(state[0]);
+                            }
+                            multiply(state, mds_matrix);
+                        }
+                    }
+
+                private:
+                    typedef std::array<value_type, Width - 1> reduced_type;
+
+                    static value_type sbox(const value_type &x) {
+                        if constexpr (Alpha == 5) {
+                            const value_type x2 = x * x;
+                            return x2 * x2 * x;
+                        } else {
+                            return x.pow(Alpha);
+                        }
+                    }
+
+                    static void add(state_type &state, const state_type &c) {
+                        for (std::size_t i = 0; i < Width; ++i) {
+                            state[i] += c[i];
+                        }
+                    }
+
+                    static void multiply(state_type &state, const matrix_type &m) {
+                        state_type result;
+                        for (std::size_t i = 0; i < Width; ++i) {
+                            result[i] = m[i][0] * state[0];
+                            for (std::size_t j = 1; j < Width; ++j) {
+                                result[i] += m[i][j] * state[j];
+                            }
+                        }
+                        state = result;
+                    }
+
+                    void full_round(state_type &state, const state_type &c) const {
+                        for (std::size_t i = 0; i < Width; ++i) {
+                            state[i] = sbox(state[i] + c[i]);
+                        }
+                        multiply(state, mds_matrix);
+                    }
+
+                    /// Inverse of a square matrix of size n over the field by Gauss-Jordan elimination.
+                    static std::vector<std::vector<value_type>> inverse(std::vector<std::vector<value_type>> a) {
+                        const std::size_t n = a.size();
+                        std::vector<std::vector<value_type>> result(n, std::vector<value_type>(n, value_type::zero()));
+                        for (std::size_t i = 0; i < n; ++i) {
+                            result[i][i] = value_type::one();
+                        }
+                        for (std::size_t col = 0; col < n; ++col) {
+                            std::size_t pivot = col;
+                            while (pivot < n && a[pivot][col] == value_type::zero()) {
+                                ++pivot;
+                            }
+                            BOOST_ASSERT(pivot < n);
+                            std::swap(a[col], a[pivot]);
+                            std::swap(result[col], result[pivot]);
+
+                            const value_type pivot_inv = a[col][col].inversed();
+                            for (std::size_t j = 0; j < n; ++j) {
+                                a[col][j] *= pivot_inv;
+                                result[col][j] *= pivot_inv;
+                            }
+                            for (std::size_t i = 0; i < n; ++i) {
+                                if (i == col || a[i][col] == value_type::zero()) {
+                                    continue;
+                                }
+                                const value_type factor = a[i][col];
+                                for (std::size_t j = 0; j < n; ++j) {
+                                    a[i][j] -= factor * a[col][j];
+                                    result[i][j] -= factor * result[col][j];
+                                }
+                            }
+                        }
+                        return result;
+                    }
+
+                    /*
+                     * Constants: the constant c of partial round j + 1 is added after the MDS matrix M of
+                     * round j, which equals adding d = M^{-1} c before M. The S-box of round j touches the
+                     * first element only, so d[1..] joins the constant of round j and d[0] remains as a
+                     * single addition after the S-box. Applied from the last partial round backwards, the
+                     * first partial round keeps a full constant vector.
+                     *
+                     * Matrices: a dense D = [[d_00, v], [w, D']] factors as diag(1, D') * [[d_00, v],
+                     * [D'^{-1} w, I]]. diag(1, D') commutes with the S-box of the next partial round and
+                     * is merged into its matrix, D <- M * diag(1, D'). Only the last partial round keeps
+                     * a dense matrix.
+                     */
+                    void precompute_partial_rounds() {
+                        constexpr std::size_t half = FullRounds / 2;
+
+                        std::vector<std::vector<value_type>> m(Width, std::vector<value_type>(Width));
+                        for (std::size_t i = 0; i < Width; ++i) {
+                            for (std::size_t j = 0; j < Width; ++j) {
+                                m[i][j] = mds_matrix[i][j];
+                            }
+                        }
+                        const std::vector<std::vector<value_type>> m_inv = inverse(m);
+
+                        std::vector<state_type> c(constants.begin() + half, constants.begin() + half + PartialRounds);
+                        partial_constants.assign(PartialRounds - 1, value_type::zero());
+                        for (std::size_t j = PartialRounds - 1; j > 0; --j) {
+                            for (std::size_t i = 0; i < Width; ++i) {
+                                value_type d = value_type::zero();
+                                for (std::size_t k = 0; k < Width; ++k) {
+                                    d += m_inv[i][k] * c[j][k];
+                                }
+                                if (i == 0) {
+                                    partial_constants[j - 1] = d;
+                                } else {
+                                    c[j - 1][i] += d;
+                                }
+                            }
+                        }
+                        first_partial_constants = c[0];
+
+                        matrix_type dense = mds_matrix;
+                        sparse_rows.resize(PartialRounds - 1);
+                        sparse_columns.resize(PartialRounds - 1);
+                        for (std::size_t j = 0; j + 1 < PartialRounds; ++j) {
+                            std::vector<std::vector<value_type>> block(Width - 1, std::vector<value_type>(Width - 1));
+                            for (std::size_t i = 1; i < Width; ++i) {
+                                for (std::size_t k = 1; k < Width; ++k) {
+                                    block[i - 1][k - 1] = dense[i][k];
+                                }
+                            }
+                            const std::vector<std::vector<value_type>> block_inv = inverse(block);
+
+                            for (std::size_t i = 1; i < Width; ++i) {
+                                sparse_rows[j][i - 1] = dense[0][i];
+                                value_type w = value_type::zero();
+                                for (std::size_t k = 1; k < Width; ++k) {
+                                    w += block_inv[i - 1][k - 1] * dense[k][0];
+                                }
+                                sparse_columns[j][i - 1] = w;
+                            }
+
+                            // dense <- M * diag(1, block)
+                            matrix_type next;
+                            for (std::size_t i = 0; i < Width; ++i) {
+                                next[i][0] = mds_matrix[i][0];
+                                for (std::size_t k = 1; k < Width; ++k) {
+                                    next[i][k] = value_type::zero();
+                                    for (std::size_t l = 1; l < Width; ++l) {
+                                        next[i][k] += mds_matrix[i][l] * block[l - 1][k - 1];
+                                    }
+                                }
+                            }
+                            dense = next;
+                        }
+                        last_partial_matrix = dense;
+                    }
+
+                    /// Self-shrinking Grain LFSR seeded with the instance description, as in the reference.
+                    class grain_generator {
+                    public:
+                        grain_generator() {
+                            const std::size_t field_bits = FieldType::modulus_bits;
+                            append(1, 2);    // prime field
+                            append(0, 4);    // x^alpha S-box
+                            append(field_bits, 12);
+                            append(Width, 12);
+                            append(FullRounds, 10);
+                            append(PartialRounds, 10);
+                            append((std::size_t(1) << 30) - 1, 30);
+                            for (std::size_t i = 0; i < 160; ++i) {
+                                step();
+                            }
+                        }
+
+                        bool next_bit() {
+                            while (!step()) {
+                                step();
+                            }
+                            return step();
+                        }
+
+                        /// Integer of the next n bits, most significant first.
+                        typename FieldType::integral_type next_integral(std::size_t n) {
+                            typename FieldType::integral_type result = 0;
+                            for (std::size_t i = 0; i < n; ++i) {
+                                result <<= 1;
+                                if (next_bit()) {
+                                    result |= 1;
+                                }
+                            }
+                            return result;
+                        }
+
+                    private:
+                        void append(std::size_t value, std::size_t bits) {
+                            for (std::size_t i = bits; i > 0; --i) {
+                                state.push_back((value >> (i - 1)) & 1);
+                            }
+                        }
+
+                        bool step() {
+                            const bool bit = state[62] ^ state[51] ^ state[38] ^ state[23] ^ state[13] ^ state[0];
+                            state.pop_front();
+                            state.push_back(bit);
+                            return bit;
+                        }
+
+                        std::deque<bool> state;
+                    };
+
+                    static poseidon_permutation generate_parameters() {
+                        typedef typename FieldType::integral_type integral_type;
+                        const std::size_t field_bits = FieldType::modulus_bits;
+
+                        grain_generator grain;
+                        std::vector<state_type> round_constants(FullRounds + PartialRounds);
+                        for (state_type &round : round_constants) {
+                            for (value_type &c : round) {
+                                integral_type x = grain.next_integral(field_bits);
+                                while (x >= FieldType::modulus) {
+                                    x = grain.next_integral(field_bits);
+                                }
+                                c = value_type(x);
+                            }
+                        }
+
+                        // Cauchy matrix 1 / (x_i + y_j) over distinct x_i, y_j with no x_i + y_j = 0
+                        matrix_type mds;
+                        while (true) {
+                            std::array<value_type, 2 * Width> xy;
+                            for (value_type &e : xy) {
+                                e = value_type(grain.next_integral(field_bits));
+                            }
+
+                            bool valid = true;
+                            for (std::size_t i = 0; i < 2 * Width && valid; ++i) {
+                                for (std::size_t j = i + 1; j < 2 * Width && valid; ++j) {
+                                    valid = xy[i] != xy[j];
+                                }
+                            }
+                            for (std::size_t i = 0; i < Width && valid; ++i) {
+                                for (std::size_t j = 0; j < Width && valid; ++j) {
+                                    valid = xy[i] + xy[Width + j] != value_type::zero();
+                                }
+                            }
+                            if (!valid) {
+                                continue;
+                            }
+
+                            for (std::size_t i = 0; i < Width; ++i) {
+                                for (std::size_t j = 0; j < Width; ++j) {
+                                    mds[i][j] = (xy[i] + xy[Width + j]).inversed();
+                                }
+                            }
+                            return poseidon_permutation(round_constants, mds);
+                        }
+                    }
+
+                    std::vector<state_type> constants;
+                    matrix_type mds_matrix;
+
+                    state_type first_partial_constants;
+                    std::vector<value_type> partial_constants;
+                    std::vector<reduced_type> sparse_rows;
+                    std::vector<reduced_type> sparse_columns;
+                    matrix_type last_partial_matrix;
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_POSEIDON_PERMUTATION_HPP
@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_DETAIL_TEMPORARY_FILE_HPP
+#define CRYPTO3_ZK_DETAIL_TEMPORARY_FILE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace detail {
+                /// The system directory for temporary files.
+                inline std::string temporary_directory() {
+                    return std::filesystem::temp_directory_path().string();
+                }
+
+                /// Creates a new empty file with a unique name in the given directory and returns its path.
+                /// The file is created exclusively, so concurrent callers sharing a directory never get the
+                /// same file. Throws std::runtime_error if no file can be created.
+                inline std::string create_temporary_file(const std::string &directory, const std::string &prefix) {
+                    static const char digits[] = "0123456789abcdef";
+                    std::random_device device;
+
+                    for (std::size_t attempt = 0; attempt < 64; ++attempt) {
+                        std::uint64_t suffix = (std::uint64_t(device()) << 32) ^ device();
+                        std::string name = prefix;
+                        for (std::size_t i = 0; i < 16; ++i, suffix >>= 4) {
+                            name.push_back(digits[suffix & 0xF]);
+                        }
+
+                        const std::string path = directory + "/" + name + ".bin";
+                        if (std::FILE *file = std::fopen(path.c_str(), "wbx")) {
+                            std::fclose(file);
+                            return path;
+                        }
+                    }
+                    throw std::runtime_error("cannot create a temporary file in " + directory);
+                }
+
+                /// Removes the file on destruction.
+                class temporary_file {
+                public:
+                    temporary_file(const std::string &directory, const std::string &prefix) :
+                        file_path(create_temporary_file(directory, prefix)) {
+                    }
+
+                    temporary_file(const temporary_file &) = delete;
+                    temporary_file &operator=(const temporary_file &) = delete;
+
+                    ~temporary_file() {
+                        std::remove(file_path.c_str());
+                    }
+
+                    const std::string &path() const {
+                        return file_path;
+                    }
+
+                private:
+                    std::string file_path;
+                };
+            }    // namespace detail
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_DETAIL_TEMPORARY_FILE_HPP
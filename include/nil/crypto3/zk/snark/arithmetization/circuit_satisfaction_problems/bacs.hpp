@@ -35,10 +35,17 @@
 #ifndef CRYPTO3_ZK_BACS_HPP
 #define CRYPTO3_ZK_BACS_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
 #include <vector>
 
 #include <nil/crypto3/zk/math/linear_combination.hpp>
 
+#include <nil/crypto3/zk/snark/arithmetization/circuit_satisfaction_problems/circuit_levels.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -155,6 +162,30 @@ namespace nil {
                         return *(std::max_element(all_depths.begin(), all_depths.end()));
                     }
 
+                    /**
+                     * Groups the gates by level, see circuit_levels. The circuit must be valid.
+                     */
+                    circuit_levels levels() const {
+                        // wire_levels[w] is 0 for the constant and input wires, and 1 + the level of the gate
+                        // computing w otherwise
+                        std::vector<std::size_t> wire_levels(1 + num_wires(), 0);
+                        std::vector<std::size_t> gate_levels(num_gates());
+
+                        for (std::size_t i = 0; i < num_gates(); ++i) {
+                            std::size_t level = 0;
+                            for (auto &t : gates[i].lhs) {
+                                level = std::max(level, wire_levels[t.index]);
+                            }
+                            for (auto &t : gates[i].rhs) {
+                                level = std::max(level, wire_levels[t.index]);
+                            }
+                            gate_levels[i] = level;
+                            wire_levels[gates[i].output.index] = level + 1;
+                        }
+
+                        return circuit_levels(gate_levels);
+                    }
+
                     bool is_valid() const {
                         for (std::size_t i = 0; i < num_gates(); ++i) {
                             /**
@@ -179,16 +210,26 @@ namespace nil {
 
                     bool is_satisfied(const bacs_primary_input<FieldType> &primary_input,
                                       const bacs_auxiliary_input<FieldType> &auxiliary_input) const {
-                        const bacs_variable_assignment<FieldType> all_outputs =
-                            get_all_outputs(primary_input, auxiliary_input);
+                        return is_satisfied(levels(), primary_input, auxiliary_input);
+                    }
 
-                        for (std::size_t i = 0; i < all_outputs.size(); ++i) {
-                            if (!all_outputs[i].is_zero()) {
-                                return false;
+                    bool is_satisfied(const circuit_levels &levels,
+                                      const bacs_primary_input<FieldType> &primary_input,
+                                      const bacs_auxiliary_input<FieldType> &auxiliary_input) const {
+                        const bacs_variable_assignment<FieldType> all_wires =
+                            get_all_wires(levels, primary_input, auxiliary_input);
+
+                        bool result = true;
+#ifdef MULTICORE
+#pragma omp parallel for reduction(&& : result)
+#endif
+                        for (std::size_t i = 0; i < num_gates(); ++i) {
+                            if (gates[i].is_circuit_output && !all_wires[gates[i].output.index - 1].is_zero()) {
+                                result = false;
                             }
                         }
 
-                        return true;
+                        return result;
                     }
 
                     bacs_variable_assignment<FieldType>
@@ -211,19 +252,29 @@ namespace nil {
                     bacs_variable_assignment<FieldType>
                         get_all_wires(const bacs_primary_input<FieldType> &primary_input,
                                       const bacs_auxiliary_input<FieldType> &auxiliary_input) const {
+                        return get_all_wires(levels(), primary_input, auxiliary_input);
+                    }
+
+                    /**
+                     * Evaluates the circuit level by level, the gates of each level in parallel. The levels
+                     * must be the ones of this circuit; callers evaluating the circuit repeatedly compute
+                     * them once.
+                     */
+                    bacs_variable_assignment<FieldType>
+                        get_all_wires(const circuit_levels &levels,
+                                      const bacs_primary_input<FieldType> &primary_input,
+                                      const bacs_auxiliary_input<FieldType> &auxiliary_input) const {
                         assert(primary_input.size() == primary_input_size);
                         assert(auxiliary_input.size() == auxiliary_input_size);
+                        assert(levels.num_gates() == num_gates());
 
-                        bacs_variable_assignment<FieldType> result;
-                        result.insert(result.end(), primary_input.begin(), primary_input.end());
-                        result.insert(result.end(), auxiliary_input.begin(), auxiliary_input.end());
+                        bacs_variable_assignment<FieldType> result(num_wires());
+                        std::copy(primary_input.begin(), primary_input.end(), result.begin());
+                        std::copy(auxiliary_input.begin(), auxiliary_input.end(),
+                                  result.begin() + primary_input_size);
 
-                        assert(result.size() == num_inputs());
-
-                        for (auto &g : gates) {
-                            const typename FieldType::value_type gate_output = g.evaluate(result);
-                            result.emplace_back(gate_output);
-                        }
+                        levels.for_each_gate(
+                            [&](std::size_t i) { result[num_inputs() + i] = gates[i].evaluate(result); });
 
                         return result;
                     }
@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Declaration of a levelized view of a circuit, used to evaluate BACS and
+// TBCS circuits level by level.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_CIRCUIT_LEVELS_HPP
+#define CRYPTO3_ZK_CIRCUIT_LEVELS_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+
+                /**
+                 * The gates of a circuit grouped by level.
+                 *
+                 * Gates of level 0 read only input wires; a gate of level l > 0 reads at least one
+                 * output of a gate of level l - 1 and no output of a gate of level l or above. Once
+                 * all lower levels are evaluated, the gates of a level are independent.
+                 *
+                 * The indices of the gates of level l are gates[level_offsets[l]], ...,
+                 * gates[level_offsets[l + 1] - 1], in increasing order.
+                 */
+                struct circuit_levels {
+                    std::vector<std::size_t> gates;
+                    std::vector<std::size_t> level_offsets;
+
+                    circuit_levels() : level_offsets(1, 0) {
+                    }
+
+                    /**
+                     * Builds the levels from the level of every gate.
+                     */
+                    explicit circuit_levels(const std::vector<std::size_t> &gate_levels) : level_offsets(1, 0) {
+                        for (std::size_t level : gate_levels) {
+                            if (level + 2 > level_offsets.size()) {
+                                level_offsets.resize(level + 2, 0);
+                            }
+                            ++level_offsets[level + 1];
+                        }
+                        for (std::size_t l = 1; l < level_offsets.size(); ++l) {
+                            level_offsets[l] += level_offsets[l - 1];
+                        }
+
+                        std::vector<std::size_t> next(level_offsets.begin(), level_offsets.end() - 1);
+                        gates.resize(gate_levels.size());
+                        for (std::size_t i = 0; i < gate_levels.size(); ++i) {
+                            gates[next[gate_levels[i]]++] = i;
+                        }
+                    }
+
+                    std::size_t num_levels() const {
+                        return level_offsets.size() - 1;
+                    }
+
+                    std::size_t num_gates() const {
+                        return gates.size();
+                    }
+
+                    /**
+                     * Calls f(gate_index) for every gate, level by level. Calls for the gates of one level
+                     * run concurrently, so f may only write state owned by its gate.
+                     */
+                    template<typename Function>
+                    void for_each_gate(Function f) const {
+                        for (std::size_t l = 0; l < num_levels(); ++l) {
+                            const std::size_t begin = level_offsets[l];
+                            const std::size_t end = level_offsets[l + 1];
+#ifdef MULTICORE
+#pragma omp parallel for if (end - begin >= parallel_threshold)
+#endif
+                            for (std::size_t i = begin; i < end; ++i) {
+                                f(gates[i]);
+                            }
+                        }
+                    }
+
+                    bool operator==(const circuit_levels &other) const {
+                        return (this->gates == other.gates && this->level_offsets == other.level_offsets);
+                    }
+
+                private:
+                    // narrower levels are cheaper to evaluate sequentially than to hand out to threads
+                    constexpr static const std::size_t parallel_threshold = 64;
+                };
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_CIRCUIT_LEVELS_HPP
@@ -33,7 +33,15 @@
 #ifndef CRYPTO3_ZK_TBCS_HPP
 #define CRYPTO3_ZK_TBCS_HPP
 
-#include <nil/crypto3/zk/snark/arithmetization/variable.hpp>
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <nil/crypto3/zk/snark/arithmetization/circuit_satisfaction_problems/circuit_levels.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -112,14 +120,18 @@ namespace nil {
                     bool is_circuit_output;
 
                     bool evaluate(const tbcs_variable_assignment &input) const {
+                        const bool X = (left_wire == 0 ? true : input[left_wire - 1]);
+                        const bool Y = (right_wire == 0 ? true : input[right_wire - 1]);
+
+                        return evaluate(X, Y);
+                    }
+
+                    bool evaluate(bool X, bool Y) const {
                         /**
                          * This function is very tricky.
                          * See comment in tbcs.hpp .
                          */
 
-                        const bool X = (left_wire == 0 ? true : input[left_wire - 1]);
-                        const bool Y = (right_wire == 0 ? true : input[right_wire - 1]);
-
                         const std::size_t pos = 3 - ((X ? 2 : 0) + (Y ? 1 : 0)); /* 3 - ... inverts position */
 
                         return (((int)type) & (1u << pos));
@@ -192,6 +204,24 @@ namespace nil {
                         return *(std::max_element(all_depths.begin(), all_depths.end()));
                     }
 
+                    /**
+                     * Groups the gates by level, see circuit_levels. The circuit must be valid.
+                     */
+                    circuit_levels levels() const {
+                        // wire_levels[w] is 0 for the constant and input wires, and 1 + the level of the gate
+                        // computing w otherwise
+                        std::vector<std::size_t> wire_levels(1 + num_wires(), 0);
+                        std::vector<std::size_t> gate_levels(num_gates());
+
+                        for (std::size_t i = 0; i < num_gates(); ++i) {
+                            gate_levels[i] =
+                                std::max(wire_levels[gates[i].left_wire], wire_levels[gates[i].right_wire]);
+                            wire_levels[gates[i].output] = gate_levels[i] + 1;
+                        }
+
+                        return circuit_levels(gate_levels);
+                    }
+
                     bool is_valid() const {
                         for (std::size_t i = 0; i < num_gates(); ++i) {
                             /**
@@ -215,33 +245,42 @@ namespace nil {
 
                     bool is_satisfied(const tbcs_primary_input &primary_input,
                                       const tbcs_auxiliary_input &auxiliary_input) const {
-                        const tbcs_variable_assignment all_outputs = get_all_outputs(primary_input, auxiliary_input);
-                        for (size_t i = 0; i < all_outputs.size(); ++i) {
-                            if (all_outputs[i]) {
-                                return false;
+                        return is_satisfied(levels(), primary_input, auxiliary_input);
+                    }
+
+                    bool is_satisfied(const circuit_levels &levels,
+                                      const tbcs_primary_input &primary_input,
+                                      const tbcs_auxiliary_input &auxiliary_input) const {
+                        const std::vector<std::uint8_t> wires = evaluate_wires(levels, primary_input, auxiliary_input);
+
+                        bool result = true;
+#ifdef MULTICORE
+#pragma omp parallel for reduction(&& : result)
+#endif
+                        for (std::size_t i = 0; i < num_gates(); ++i) {
+                            if (gates[i].is_circuit_output && wires[gates[i].output]) {
+                                result = false;
                             }
                         }
 
-                        return true;
+                        return result;
                     }
 
                     tbcs_variable_assignment get_all_wires(const tbcs_primary_input &primary_input,
                                                            const tbcs_auxiliary_input &auxiliary_input) const {
-                        assert(primary_input.size() == primary_input_size);
-                        assert(auxiliary_input.size() == auxiliary_input_size);
-
-                        tbcs_variable_assignment result;
-                        result.insert(result.end(), primary_input.begin(), primary_input.end());
-                        result.insert(result.end(), auxiliary_input.begin(), auxiliary_input.end());
-
-                        assert(result.size() == num_inputs());
-
-                        for (auto &g : gates) {
-                            const bool gate_output = g.evaluate(result);
-                            result.push_back(gate_output);
-                        }
+                        return get_all_wires(levels(), primary_input, auxiliary_input);
+                    }
 
-                        return result;
+                    /**
+                     * Evaluates the circuit level by level, the gates of each level in parallel. The levels
+                     * must be the ones of this circuit; callers evaluating the circuit repeatedly compute
+                     * them once.
+                     */
+                    tbcs_variable_assignment get_all_wires(const circuit_levels &levels,
+                                                           const tbcs_primary_input &primary_input,
+                                                           const tbcs_auxiliary_input &auxiliary_input) const {
+                        const std::vector<std::uint8_t> wires = evaluate_wires(levels, primary_input, auxiliary_input);
+                        return tbcs_variable_assignment(wires.begin() + 1, wires.end());
                     }
 
                     tbcs_variable_assignment get_all_outputs(const tbcs_primary_input &primary_input,
@@ -267,6 +306,33 @@ namespace nil {
                         return (this->primary_input_size == other.primary_input_size &&
                                 this->auxiliary_input_size == other.auxiliary_input_size && this->gates == other.gates);
                     }
+
+                private:
+                    /**
+                     * Values of all wires indexed by wire, the constant wire included, one byte per wire:
+                     * gates of one level write their outputs concurrently, which a packed
+                     * tbcs_variable_assignment does not allow.
+                     */
+                    std::vector<std::uint8_t> evaluate_wires(const circuit_levels &levels,
+                                                             const tbcs_primary_input &primary_input,
+                                                             const tbcs_auxiliary_input &auxiliary_input) const {
+                        assert(primary_input.size() == primary_input_size);
+                        assert(auxiliary_input.size() == auxiliary_input_size);
+                        assert(levels.num_gates() == num_gates());
+
+                        std::vector<std::uint8_t> wires(1 + num_wires());
+                        wires[0] = 1;
+                        std::copy(primary_input.begin(), primary_input.end(), wires.begin() + 1);
+                        std::copy(auxiliary_input.begin(), auxiliary_input.end(),
+                                  wires.begin() + 1 + primary_input_size);
+
+                        levels.for_each_gate([&](std::size_t i) {
+                            const tbcs_gate &g = gates[i];
+                            wires[g.output] = g.evaluate(wires[g.left_wire] != 0, wires[g.right_wire] != 0);
+                        });
+
+                        return wires;
+                    }
                 };
 
             }    // namespace snark
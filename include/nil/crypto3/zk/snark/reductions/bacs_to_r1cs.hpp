@@ -34,6 +34,12 @@
 #ifndef CRYPTO3_ZK_BACS_TO_R1CS_BASIC_POLICY_HPP
 #define CRYPTO3_ZK_BACS_TO_R1CS_BASIC_POLICY_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <vector>
+
 #include <nil/crypto3/zk/snark/arithmetization/circuit_satisfaction_problems/bacs.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/constraint_satisfaction_problems/r1cs.hpp>
 
@@ -57,13 +63,26 @@ namespace nil {
                             result.primary_input_size = circuit.primary_input_size;
                             result.auxiliary_input_size = circuit.auxiliary_input_size + circuit.gates.size();
 
-                            for (auto &g : circuit.gates) {
-                                result.constraints.emplace_back(r1cs_constraint<FieldType>(g.lhs, g.rhs, g.output));
+                            /* one constraint per gate, followed by one constraint per circuit output */
+                            std::vector<std::size_t> outputs;
+                            for (std::size_t i = 0; i < circuit.gates.size(); ++i) {
+                                if (circuit.gates[i].is_circuit_output) {
+                                    outputs.emplace_back(i);
+                                }
                             }
 
-                            for (auto &g : circuit.gates) {
-                                if (g.is_circuit_output) {
-                                    result.constraints.emplace_back(r1cs_constraint<FieldType>(1, g.output, 0));
+                            const std::size_t num_gates = circuit.gates.size();
+                            result.constraints.resize(num_gates + outputs.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < num_gates + outputs.size(); ++i) {
+                                if (i < num_gates) {
+                                    const bacs_gate<FieldType> &g = circuit.gates[i];
+                                    result.constraints[i] = r1cs_constraint<FieldType>(g.lhs, g.rhs, g.output);
+                                } else {
+                                    const bacs_gate<FieldType> &g = circuit.gates[outputs[i - num_gates]];
+                                    result.constraints[i] = r1cs_constraint<FieldType>(1, g.output, 0);
                                 }
                             }
 
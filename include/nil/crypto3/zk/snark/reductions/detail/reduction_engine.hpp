@@ -0,0 +1,181 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Shared building blocks of the QAP, SAP and SSP witness maps.
+//
+// All three witness maps evaluate the constraints over the domain S, interpolate,
+// move the polynomials to a coset T of S, combine them pointwise there and divide
+// by the vanishing polynomial of S. The engine runs the constraint evaluation in
+// parallel, runs independent FFT chains concurrently and recycles the domain-sized
+// buffers between calls. Domains and coset powers come from the process-wide
+// evaluation_domain_registry.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_REDUCTIONS_REDUCTION_ENGINE_HPP
+#define CRYPTO3_ZK_REDUCTIONS_REDUCTION_ENGINE_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+
+#include <nil/crypto3/algebra/fields/params.hpp>
+
+#include <nil/crypto3/zk/detail/buffer_pool.hpp>
+#include <nil/crypto3/zk/detail/evaluation_domain_registry.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace reductions {
+                    namespace detail {
+
+                        template<typename FieldType>
+                        struct reduction_engine {
+                            typedef typename FieldType::value_type value_type;
+                            typedef std::vector<value_type> buffer_type;
+                            typedef std::shared_ptr<math::evaluation_domain<FieldType>> domain_type;
+                            typedef zk::detail::evaluation_domain_registry<FieldType> registry_type;
+
+                            /// Shared domain of at least the given size.
+                            static domain_type domain(std::size_t size) {
+                                return registry_type::domain(size);
+                            }
+
+                            /// Number of buffers of one size kept by the scratch pool between calls.
+                            constexpr static const std::size_t scratch_buffers = 4;
+
+                            /// Bound on the number of elements kept by the scratch pool before any buffer is taken.
+                            constexpr static const std::size_t min_scratch_elements = std::size_t(1) << 22;
+
+                            /**
+                             * Process-wide pool of scratch buffers, shared by all witness maps over FieldType.
+                             * Consecutive proofs over the same domain reuse the evaluation buffers. The pool keeps
+                             * at most scratch_buffers buffers of one size. Its bound on the total number of
+                             * elements grows to hold scratch_buffers buffers of the largest size taken, so large
+                             * domains are pooled as well, and release_scratch() returns everything it holds and
+                             * restores the initial bound.
+                             */
+                            static zk::detail::buffer_pool<value_type> &scratch() {
+                                static zk::detail::buffer_pool<value_type> pool(scratch_buffers, min_scratch_elements);
+                                return pool;
+                            }
+
+                            /// Frees all buffers cached by the scratch pool.
+                            static void release_scratch() {
+                                scratch().clear();
+                                scratch().set_max_cached_size(min_scratch_elements);
+                            }
+
+                            /// Zero-filled buffer of the given size taken from the scratch pool.
+                            static buffer_type acquire(std::size_t size) {
+                                zk::detail::buffer_pool<value_type> &pool = scratch();
+                                if (size <= std::numeric_limits<std::size_t>::max() / scratch_buffers &&
+                                    pool.max_cached_size() < scratch_buffers * size) {
+                                    pool.set_max_cached_size(scratch_buffers * size);
+                                }
+                                return pool.acquire(size, value_type::zero());
+                            }
+
+                            static void release(buffer_type &&buffer) {
+                                scratch().release(std::move(buffer));
+                            }
+
+                            /// Calls f(i) for every i < count. Calls with distinct i must not conflict.
+                            template<typename Function>
+                            static void for_each_row(std::size_t count, Function f) {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    f(i);
+                                }
+                            }
+
+                            /// Replaces evaluations over S by the coefficients.
+                            static void interpolate(const domain_type &domain,
+                                                    std::initializer_list<buffer_type *> buffers) {
+                                for_each_buffer(buffers,
+                                                [&domain](buffer_type &buffer) { domain->inverse_fft(buffer); });
+                            }
+
+                            /// Replaces coefficients by the evaluations over the coset T = g * S.
+                            static void evaluate_on_coset(const domain_type &domain,
+                                                          std::initializer_list<buffer_type *> buffers) {
+                                const std::shared_ptr<const typename registry_type::coset_type> coset =
+                                    registry_type::coset(domain->m, generator());
+                                for_each_row(domain->m, [&](std::size_t i) {
+                                    for (buffer_type *buffer : buffers) {
+                                        (*buffer)[i] *= coset->powers[i];
+                                    }
+                                });
+                                for_each_buffer(buffers, [&domain](buffer_type &buffer) { domain->fft(buffer); });
+                            }
+
+                            /**
+                             * Divides the evaluations over T by Z, interpolates the quotient and adds its
+                             * coefficients to coefficients_for_H. H_tmp is consumed.
+                             */
+                            static void add_quotient(const domain_type &domain, buffer_type &H_tmp,
+                                                     std::vector<value_type> &coefficients_for_H) {
+                                const std::shared_ptr<const typename registry_type::coset_type> coset =
+                                    registry_type::coset(domain->m, generator());
+
+                                domain->divide_by_z_on_coset(H_tmp);
+                                domain->inverse_fft(H_tmp);
+
+                                for_each_row(domain->m, [&](std::size_t i) {
+                                    coefficients_for_H[i] += H_tmp[i] * coset->inverse_powers[i];
+                                });
+                            }
+
+                        private:
+                            static value_type generator() {
+                                return value_type(
+                                    algebra::fields::arithmetic_params<FieldType>::multiplicative_generator);
+                            }
+
+                            /*
+                             * Transforms run one after another. Each of them is parallel internally, and running
+                             * them inside an outer parallel region would pin every transform to a single thread.
+                             */
+                            template<typename Function>
+                            static void for_each_buffer(std::initializer_list<buffer_type *> buffers, Function f) {
+                                for (buffer_type *buffer : buffers) {
+                                    f(*buffer);
+                                }
+                            }
+                        };
+                    }    // namespace detail
+                }        // namespace reductions
+            }            // namespace snark
+        }                // namespace zk
+    }                    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_REDUCTIONS_REDUCTION_ENGINE_HPP
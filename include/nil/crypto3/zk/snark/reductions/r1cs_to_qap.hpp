@@ -48,11 +48,10 @@
 #ifndef CRYPTO3_ZK_R1CS_TO_QAP_BASIC_POLICY_HPP
 #define CRYPTO3_ZK_R1CS_TO_QAP_BASIC_POLICY_HPP
 
-#include <nil/crypto3/math/coset.hpp>
-#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 
 #include <nil/crypto3/zk/snark/arithmetization/arithmetic_programs/qap.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/constraint_satisfaction_problems/r1cs.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/reduction_engine.hpp>
 
 #include <nil/crypto3/algebra/fields/params.hpp>
 
@@ -80,7 +79,7 @@ namespace nil {
                         static qap_instance<FieldType> instance_map(const r1cs_constraint_system<FieldType> &cs) {
 
                             const std::shared_ptr<math::evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints() + cs.num_inputs() + 1);
+                                detail::reduction_engine<FieldType>::domain(cs.num_constraints() + cs.num_inputs() + 1);
 
                             std::vector<std::map<std::size_t, typename FieldType::value_type>> A_in_Lagrange_basis(
                                 cs.num_variables() + 1);
@@ -139,7 +138,7 @@ namespace nil {
                             instance_map_with_evaluation(const r1cs_constraint_system<FieldType> &cs,
                                                          const typename FieldType::value_type &t) {
                             const std::shared_ptr<math::evaluation_domain<FieldType>> domain = 
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints() + cs.num_inputs() + 1);
+                                detail::reduction_engine<FieldType>::domain(cs.num_constraints() + cs.num_inputs() + 1);
 
                             std::vector<typename FieldType::value_type> At, Bt, Ct, Ht;
 
@@ -213,8 +212,8 @@ namespace nil {
                          *  (6) patch H to account for d1,d2,d3 (i.e., add coefficients of the polynomial (A d2 + B d1 -
                          * d3) + d1*d2*Z )
                          *
-                         * The code below is not as simple as the above high-level description due to
-                         * some reshuffling to save space.
+                         * Constraints are evaluated in parallel and the transforms of A, B and C run
+                         * concurrently, see detail::reduction_engine.
                          */
                         static qap_witness<FieldType>
                             witness_map(const r1cs_constraint_system<FieldType> &cs,
@@ -227,14 +226,17 @@ namespace nil {
                             assert(cs.is_satisfied(primary_input, auxiliary_input));
 
                             const std::shared_ptr<math::evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints() + cs.num_inputs() + 1);
+                                detail::reduction_engine<FieldType>::domain(cs.num_constraints() + cs.num_inputs() + 1);
 
                             r1cs_variable_assignment<FieldType> full_variable_assignment = primary_input;
                             full_variable_assignment.insert(full_variable_assignment.end(), auxiliary_input.begin(),
                                                             auxiliary_input.end());
 
-                            std::vector<typename FieldType::value_type> aA(domain->m, FieldType::value_type::zero()),
-                                aB(domain->m, FieldType::value_type::zero());
+                            typedef detail::reduction_engine<FieldType> engine;
+
+                            std::vector<typename FieldType::value_type> aA = engine::acquire(domain->m),
+                                                                        aB = engine::acquire(domain->m),
+                                                                        aC = engine::acquire(domain->m);
 
                             /* account for the additional constraints input_i * 0 = 0 */
                             for (std::size_t i = 0; i <= cs.num_inputs(); ++i) {
@@ -242,83 +244,33 @@ namespace nil {
                                     (i > 0 ? full_variable_assignment[i - 1] : FieldType::value_type::one());
                             }
                             /* account for all other constraints */
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aA[i] += cs.constraints[i].a.evaluate(full_variable_assignment);
-                                aB[i] += cs.constraints[i].b.evaluate(full_variable_assignment);
-                            }
+                            engine::for_each_row(cs.num_constraints(), [&](std::size_t i) {
+                                aA[i] = cs.constraints[i].a.evaluate(full_variable_assignment);
+                                aB[i] = cs.constraints[i].b.evaluate(full_variable_assignment);
+                                aC[i] = cs.constraints[i].c.evaluate(full_variable_assignment);
+                            });
 
-                            domain->inverse_fft(aA);
-
-                            domain->inverse_fft(aB);
+                            engine::interpolate(domain, {&aA, &aB, &aC});
 
                             std::vector<typename FieldType::value_type> coefficients_for_H(
                                 domain->m + 1, FieldType::value_type::zero());
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
                             /* add coefficients of the polynomial (d2*A + d1*B - d3) + d1*d2*Z */
-                            for (std::size_t i = 0; i < domain->m; ++i) {
+                            engine::for_each_row(domain->m, [&](std::size_t i) {
                                 coefficients_for_H[i] = d2 * aA[i] + d1 * aB[i];
-                            }
+                            });
                             coefficients_for_H[0] -= d3;
                             domain->add_poly_z(d1 * d2, coefficients_for_H);
 
-                            math::multiply_by_coset(
-                                aA,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aA);
-
-                            math::multiply_by_coset(
-                                aB,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aB);
+                            engine::evaluate_on_coset(domain, {&aA, &aB, &aC});
 
                             std::vector<typename FieldType::value_type> &H_tmp = aA;
                             // can overwrite aA because it is not used later
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = aA[i] * aB[i];
-                            }
-                            std::vector<typename FieldType::value_type>().swap(aB);    // destroy aB
+                            engine::for_each_row(domain->m, [&](std::size_t i) { H_tmp[i] = aA[i] * aB[i] - aC[i]; });
+                            engine::release(std::move(aB));
+                            engine::release(std::move(aC));
 
-                            std::vector<typename FieldType::value_type> aC(domain->m, FieldType::value_type::zero());
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aC[i] += cs.constraints[i].c.evaluate(full_variable_assignment);
-                            }
-
-                            domain->inverse_fft(aC);
-
-                            math::multiply_by_coset(
-                                aC,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aC);
-
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = (H_tmp[i] - aC[i]);
-                            }
-
-                            domain->divide_by_z_on_coset(H_tmp);
-
-                            domain->inverse_fft(H_tmp);
-
-                            multiply_by_coset(H_tmp,
-                                              typename FieldType::value_type(
-                                                  fields::arithmetic_params<FieldType>::multiplicative_generator)
-                                                  .inversed());
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                coefficients_for_H[i] += H_tmp[i];
-                            }
+                            engine::add_quotient(domain, H_tmp, coefficients_for_H);
+                            engine::release(std::move(H_tmp));
 
                             return qap_witness<FieldType>(cs.num_variables(), domain->m, cs.num_inputs(), d1, d2, d3,
                                                           full_variable_assignment, std::move(coefficients_for_H));
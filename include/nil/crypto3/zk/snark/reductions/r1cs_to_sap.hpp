@@ -49,12 +49,11 @@
 #ifndef CRYPTO3_ZK_R1CS_TO_SAP_BASIC_POLICY_HPP
 #define CRYPTO3_ZK_R1CS_TO_SAP_BASIC_POLICY_HPP
 
-#include <nil/crypto3/math/coset.hpp>
-#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 
 #include <nil/crypto3/zk/snark/arithmetization/arithmetic_programs/sap.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/constraint_satisfaction_problems/r1cs.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/reduction_engine.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -88,8 +87,8 @@ namespace nil {
                              * see comments in instance_map for details on where these
                              * constraints come from.
                              */
-                            return math::make_evaluation_domain<FieldType>(2 * cs.num_constraints() +
-                                                                           2 * cs.num_inputs() + 1);
+                            return detail::reduction_engine<FieldType>::domain(2 * cs.num_constraints() +
+                                                                               2 * cs.num_inputs() + 1);
                         }
 
                         /**
@@ -307,8 +306,8 @@ namespace nil {
                          *  (6) patch H to account for d1,d2
                                 (i.e., add coefficients of the polynomial (2*d1*A - d2 + d1^2 * Z))
                          *
-                         * The code below is not as simple as the above high-level description due to
-                         * some reshuffling to save space.
+                         * Constraints are evaluated in parallel and the transforms of A and C run
+                         * concurrently, see detail::reduction_engine.
                          */
                         static sap_witness<FieldType>
                         witness_map(const r1cs_constraint_system<FieldType> &cs,
@@ -326,27 +325,55 @@ namespace nil {
                             r1cs_variable_assignment<FieldType> full_variable_assignment = primary_input;
                             full_variable_assignment.insert(
                                     full_variable_assignment.end(), auxiliary_input.begin(), auxiliary_input.end());
+
+                            typedef detail::reduction_engine<FieldType> engine;
+
+                            std::size_t extra_var_offset = cs.num_variables() + 1;
+                            std::size_t extra_var_offset2 = cs.num_variables() + cs.num_constraints();
+                            std::size_t extra_constr_offset = 2 * cs.num_constraints();
+
                             /**
                              * we need to generate values of all the extra variables that we added
-                             * during the reduction
+                             * during the reduction. They are placed after the input, so the
+                             * assignment is resized first and filled in row by row.
                              *
                              * note: below, we pass full_variable_assignment into the .evaluate()
                              * method of the R1CS constraints. however, these extra variables shouldn't
                              * be a problem, because .evaluate() only accesses the variables that are
                              * actually used in the constraint.
                              */
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                            full_variable_assignment.resize(sap_num_variables);
+
+                            std::vector<typename FieldType::value_type> aA = engine::acquire(domain->m),
+                                                                        aC = engine::acquire(domain->m);
+
+                            /* account for all constraints, as in instance_map */
+                            engine::for_each_row(cs.num_constraints(), [&](std::size_t i) {
+                                const typename FieldType::value_type a =
+                                    cs.constraints[i].a.evaluate(full_variable_assignment);
+                                const typename FieldType::value_type b =
+                                    cs.constraints[i].b.evaluate(full_variable_assignment);
+
                                 /**
                                  * this is variable (extra_var_offset + i), an extra variable
                                  * we introduced that is not present in the input.
                                  * its value is (a - b)^2
                                  */
-                                typename FieldType::value_type extra_var =
-                                        cs.constraints[i].a.evaluate(full_variable_assignment) -
-                                        cs.constraints[i].b.evaluate(full_variable_assignment);
+                                typename FieldType::value_type extra_var = a - b;
                                 extra_var = extra_var * extra_var;
-                                full_variable_assignment.push_back(extra_var);
-                            }
+                                full_variable_assignment[extra_var_offset + i - 1] = extra_var;
+
+                                aA[2 * i] = a + b;
+                                aA[2 * i + 1] = a - b;
+
+                                aC[2 * i] =
+                                    times_four(cs.constraints[i].c.evaluate(full_variable_assignment)) + extra_var;
+                                aC[2 * i + 1] = extra_var;
+                            });
+
+                            aA[extra_constr_offset] += FieldType::value_type::one();
+                            aC[extra_constr_offset] += FieldType::value_type::one();
+
                             for (std::size_t i = 1; i <= cs.num_inputs(); ++i) {
                                 /**
                                  * this is variable (extra_var_offset2 + i), an extra variable
@@ -356,111 +383,40 @@ namespace nil {
                                 typename FieldType::value_type extra_var =
                                         full_variable_assignment[i - 1] - FieldType::value_type::one();
                                 extra_var = extra_var * extra_var;
-                                full_variable_assignment.push_back(extra_var);
-                            }
-
-                            std::vector<typename FieldType::value_type> aA(domain->m, FieldType::value_type::zero());
-
-                            /* account for all constraints, as in instance_map */
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aA[2 * i] += cs.constraints[i].a.evaluate(full_variable_assignment);
-                                aA[2 * i] += cs.constraints[i].b.evaluate(full_variable_assignment);
-
-                                aA[2 * i + 1] += cs.constraints[i].a.evaluate(full_variable_assignment);
-                                aA[2 * i + 1] -= cs.constraints[i].b.evaluate(full_variable_assignment);
-                            }
-
-                            std::size_t extra_constr_offset = 2 * cs.num_constraints();
+                                full_variable_assignment[extra_var_offset2 + i - 1] = extra_var;
 
-                            aA[extra_constr_offset] += FieldType::value_type::one();
-
-                            for (std::size_t i = 1; i <= cs.num_inputs(); ++i) {
                                 aA[extra_constr_offset + 2 * i - 1] += full_variable_assignment[i - 1];
                                 aA[extra_constr_offset + 2 * i - 1] += FieldType::value_type::one();
 
                                 aA[extra_constr_offset + 2 * i] += full_variable_assignment[i - 1];
                                 aA[extra_constr_offset + 2 * i] -= FieldType::value_type::one();
+
+                                aC[extra_constr_offset + 2 * i - 1] += times_four(full_variable_assignment[i - 1]);
+
+                                aC[extra_constr_offset + 2 * i - 1] += extra_var;
+                                aC[extra_constr_offset + 2 * i] += extra_var;
                             }
 
-                            domain->inverse_fft(aA);
+                            engine::interpolate(domain, {&aA, &aC});
 
                             std::vector<typename FieldType::value_type> coefficients_for_H(
                                     domain->m + 1, FieldType::value_type::zero());
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
                             /* add coefficients of the polynomial (2*d1*A - d2) + d1*d1*Z */
-                            for (std::size_t i = 0; i < domain->m; ++i) {
+                            engine::for_each_row(domain->m, [&](std::size_t i) {
                                 coefficients_for_H[i] = (d1 * aA[i]) + (d1 * aA[i]);
-                            }
+                            });
                             coefficients_for_H[0] -= d2;
                             domain->add_poly_z(d1 * d1, coefficients_for_H);
 
-                            math::multiply_by_coset(
-                                    aA,
-                                    typename FieldType::value_type(
-                                            algebra::fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aA);
+                            engine::evaluate_on_coset(domain, {&aA, &aC});
 
                             std::vector<typename FieldType::value_type> &H_tmp =
                                     aA;    // can overwrite aA because it is not used later
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = aA[i] * aA[i];
-                            }
-
-                            std::vector<typename FieldType::value_type> aC(domain->m, FieldType::value_type::zero());
-                            /* again, accounting for all constraints */
-                            std::size_t extra_var_offset = cs.num_variables() + 1;
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aC[2 * i] += times_four(cs.constraints[i].c.evaluate(full_variable_assignment));
-
-                                aC[2 * i] += full_variable_assignment[extra_var_offset + i - 1];
-                                aC[2 * i + 1] += full_variable_assignment[extra_var_offset + i - 1];
-                            }
-
-                            std::size_t extra_var_offset2 = cs.num_variables() + cs.num_constraints();
-                            aC[extra_constr_offset] += FieldType::value_type::one();
-
-                            for (std::size_t i = 1; i <= cs.num_inputs(); ++i) {
-                                aC[extra_constr_offset + 2 * i - 1] += times_four(full_variable_assignment[i - 1]);
-
-                                aC[extra_constr_offset + 2 * i - 1] +=
-                                        full_variable_assignment[extra_var_offset2 + i - 1];
-                                aC[extra_constr_offset + 2 * i] += full_variable_assignment[extra_var_offset2 + i - 1];
-                            }
+                            engine::for_each_row(domain->m, [&](std::size_t i) { H_tmp[i] = aA[i] * aA[i] - aC[i]; });
+                            engine::release(std::move(aC));
 
-                            domain->inverse_fft(aC);
-
-                            math::multiply_by_coset(
-                                    aC,
-                                    typename FieldType::value_type(
-                                            algebra::fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aC);
-
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = (H_tmp[i] - aC[i]);
-                            }
-
-                            domain->divide_by_z_on_coset(H_tmp);
-
-                            domain->inverse_fft(H_tmp);
-                            multiply_by_coset(H_tmp,
-                                              typename FieldType::value_type(
-                                                      algebra::fields::arithmetic_params<FieldType>::multiplicative_generator)
-                                                      .inversed());
-
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                coefficients_for_H[i] += H_tmp[i];
-                            }
+                            engine::add_quotient(domain, H_tmp, coefficients_for_H);
+                            engine::release(std::move(H_tmp));
 
                             return sap_witness<FieldType>(sap_num_variables,
                                                           domain->m,
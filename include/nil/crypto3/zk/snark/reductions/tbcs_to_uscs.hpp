@@ -45,6 +45,12 @@
 #ifndef CRYPTO3_ZK_TBCS_TO_USCS_BASIC_POLICY_HPP
 #define CRYPTO3_ZK_TBCS_TO_USCS_BASIC_POLICY_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <vector>
+
 #include <nil/crypto3/zk/snark/arithmetization/circuit_satisfaction_problems/tbcs.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/constraint_satisfaction_problems/uscs.hpp>
 
@@ -67,109 +73,32 @@ namespace nil {
                             result.primary_input_size = circuit.primary_input_size;
                             result.auxiliary_input_size = circuit.auxiliary_input_size + circuit.gates.size();
 
-                            for (auto &g : circuit.gates) {
-                                const variable<FieldType> x(g.left_wire);
-                                const variable<FieldType> y(g.right_wire);
-                                const variable<FieldType> z(g.output);
-
-                                switch (g.type) {
-                                    case TBCS_GATE_CONSTANT_0:
-                                        /* Truth table (00, 01, 10, 11): (0, 0, 0, 0)
-                                           0 * x + 0 * y + 1 * z + 1 \in {-1, 1} */
-                                        result.add_constraint(0 * x + 0 * y + 1 * z + 1);
-                                        break;
-                                    case TBCS_GATE_AND:
-                                        /* Truth table (00, 01, 10, 11): (0, 0, 0, 1)
-                                           -2 * x + -2 * y + 4 * z + 1 \in {-1, 1} */
-                                        result.add_constraint(-2 * x + -2 * y + 4 * z + 1);
-                                        break;
-                                    case TBCS_GATE_X_AND_NOT_Y:
-                                        /* Truth table (00, 01, 10, 11): (0, 0, 1, 0)
-                                           -2 * x + 2 * y + 4 * z + -1 \in {-1, 1} */
-                                        result.add_constraint(-2 * x + 2 * y + 4 * z + -1);
-                                        break;
-                                    case TBCS_GATE_X:
-                                        /* Truth table (00, 01, 10, 11): (0, 0, 1, 1)
-                                           -1 * x + 0 * y + 1 * z + 1 \in {-1, 1} */
-                                        result.add_constraint(-1 * x + 0 * y + 1 * z + 1);
-                                        break;
-                                    case TBCS_GATE_NOT_X_AND_Y:
-                                        /* Truth table (00, 01, 10, 11): (0, 1, 0, 0)
-                                           2 * x + -2 * y + 4 * z + -1 \in {-1, 1} */
-                                        result.add_constraint(2 * x + -2 * y + 4 * z + -1);
-                                        break;
-                                    case TBCS_GATE_Y:
-                                        /* Truth table (00, 01, 10, 11): (0, 1, 0, 1)
-                                           0 * x + 1 * y + 1 * z + -1 \in {-1, 1} */
-                                        result.add_constraint(0 * x + 1 * y + 1 * z + -1);
-                                        break;
-                                    case TBCS_GATE_XOR:
-                                        /* Truth table (00, 01, 10, 11): (0, 1, 1, 0)
-                                           1 * x + 1 * y + 1 * z + -1 \in {-1, 1} */
-                                        result.add_constraint(1 * x + 1 * y + 1 * z + -1);
-                                        break;
-                                    case TBCS_GATE_OR:
-                                        /* Truth table (00, 01, 10, 11): (0, 1, 1, 1)
-                                           -2 * x + -2 * y + 4 * z + -1 \in {-1, 1} */
-                                        result.add_constraint(-2 * x + -2 * y + 4 * z + -1);
-                                        break;
-                                    case TBCS_GATE_NOR:
-                                        /* Truth table (00, 01, 10, 11): (1, 0, 0, 0)
-                                           2 * x + 2 * y + 4 * z + -3 \in {-1, 1} */
-                                        result.add_constraint(2 * x + 2 * y + 4 * z + -3);
-                                        break;
-                                    case TBCS_GATE_EQUIVALENCE:
-                                        /* Truth table (00, 01, 10, 11): (1, 0, 0, 1)
-                                           1 * x + 1 * y + 1 * z + -2 \in {-1, 1} */
-                                        result.add_constraint(1 * x + 1 * y + 1 * z + -2);
-                                        break;
-                                    case TBCS_GATE_NOT_Y:
-                                        /* Truth table (00, 01, 10, 11): (1, 0, 1, 0)
-                                           0 * x + -1 * y + 1 * z + 0 \in {-1, 1} */
-                                        result.add_constraint(0 * x + -1 * y + 1 * z + 0);
-                                        break;
-                                    case TBCS_GATE_IF_Y_THEN_X:
-                                        /* Truth table (00, 01, 10, 11): (1, 0, 1, 1)
-                                           -2 * x + 2 * y + 4 * z + -3 \in {-1, 1} */
-                                        result.add_constraint(-2 * x + 2 * y + 4 * z + -3);
-                                        break;
-                                    case TBCS_GATE_NOT_X:
-                                        /* Truth table (00, 01, 10, 11): (1, 1, 0, 0)
-                                           -1 * x + 0 * y + 1 * z + 0 \in {-1, 1} */
-                                        result.add_constraint(-1 * x + 0 * y + 1 * z + 0);
-                                        break;
-                                    case TBCS_GATE_IF_X_THEN_Y:
-                                        /* Truth table (00, 01, 10, 11): (1, 1, 0, 1)
-                                           2 * x + -2 * y + 4 * z + -3 \in {-1, 1} */
-                                        result.add_constraint(2 * x + -2 * y + 4 * z + -3);
-                                        break;
-                                    case TBCS_GATE_NAND:
-                                        /* Truth table (00, 01, 10, 11): (1, 1, 1, 0)
-                                           2 * x + 2 * y + 4 * z + -5 \in {-1, 1} */
-                                        result.add_constraint(2 * x + 2 * y + 4 * z + -5);
-                                        break;
-                                    case TBCS_GATE_CONSTANT_1:
-                                        /* Truth table (00, 01, 10, 11): (1, 1, 1, 1)
-                                           0 * x + 0 * y + 1 * z + 0 \in {-1, 1} */
-                                        result.add_constraint(0 * x + 0 * y + 1 * z + 0);
-                                        break;
-                                    default:
-                                        assert(0);
-                                }
-                            }
+                            const std::size_t num_gates = circuit.gates.size();
+                            const std::size_t num_wires = circuit.num_wires();
 
-                            for (std::size_t i = 0;
-                                 i < circuit.primary_input_size + circuit.auxiliary_input_size + circuit.gates.size();
-                                 ++i) {
-                                /* require that 2 * wire - 1 \in {-1,1}, that is wire \in {0,1} */
-                                result.add_constraint(2 * variable<FieldType>(i) - 1);
+                            /* one constraint per gate, one per wire (see below) and one per circuit output */
+                            std::vector<std::size_t> outputs;
+                            for (std::size_t i = 0; i < num_gates; ++i) {
+                                if (circuit.gates[i].is_circuit_output) {
+                                    outputs.emplace_back(i);
+                                }
                             }
 
-                            for (auto &g : circuit.gates) {
-                                if (g.is_circuit_output) {
+                            result.constraints.resize(num_gates + num_wires + outputs.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < result.constraints.size(); ++i) {
+                                if (i < num_gates) {
+                                    result.constraints[i] = gate_constraint(circuit.gates[i]);
+                                } else if (i < num_gates + num_wires) {
+                                    /* require that 2 * wire - 1 \in {-1,1}, that is wire \in {0,1} */
+                                    result.constraints[i] = 2 * variable<FieldType>(i - num_gates) - 1;
+                                } else {
                                     /* require that output + 1 \in {-1,1}, this together with output binary (above)
                                      * enforces output = 0 */
-                                    result.add_constraint(variable<FieldType>(g.output) + 1);
+                                    const tbcs_gate &g = circuit.gates[outputs[i - num_gates - num_wires]];
+                                    result.constraints[i] = variable<FieldType>(g.output) + 1;
                                 }
                             }
 
@@ -186,10 +115,96 @@ namespace nil {
 
                             const tbcs_variable_assignment all_wires =
                                 circuit.get_all_wires(primary_input, auxiliary_input);
-                            const uscs_variable_assignment<FieldType> result =
-                                algebra::convert_bit_vector_to_field_element_vector<FieldType>(all_wires);
+
+                            uscs_variable_assignment<FieldType> result(all_wires.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < all_wires.size(); ++i) {
+                                result[i] = all_wires[i] ? FieldType::value_type::one() : FieldType::value_type::zero();
+                            }
                             return result;
                         }
+
+                    private:
+                        /**
+                         * The USCS constraint enforcing the computation of gate g.
+                         */
+                        static uscs_constraint<FieldType> gate_constraint(const tbcs_gate &g) {
+                            const variable<FieldType> x(g.left_wire);
+                            const variable<FieldType> y(g.right_wire);
+                            const variable<FieldType> z(g.output);
+
+                            switch (g.type) {
+                                case TBCS_GATE_CONSTANT_0:
+                                    /* Truth table (00, 01, 10, 11): (0, 0, 0, 0)
+                                       0 * x + 0 * y + 1 * z + 1 \in {-1, 1} */
+                                    return 0 * x + 0 * y + 1 * z + 1;
+                                case TBCS_GATE_AND:
+                                    /* Truth table (00, 01, 10, 11): (0, 0, 0, 1)
+                                       -2 * x + -2 * y + 4 * z + 1 \in {-1, 1} */
+                                    return -2 * x + -2 * y + 4 * z + 1;
+                                case TBCS_GATE_X_AND_NOT_Y:
+                                    /* Truth table (00, 01, 10, 11): (0, 0, 1, 0)
+                                       -2 * x + 2 * y + 4 * z + -1 \in {-1, 1} */
+                                    return -2 * x + 2 * y + 4 * z + -1;
+                                case TBCS_GATE_X:
+                                    /* Truth table (00, 01, 10, 11): (0, 0, 1, 1)
+                                       -1 * x + 0 * y + 1 * z + 1 \in {-1, 1} */
+                                    return -1 * x + 0 * y + 1 * z + 1;
+                                case TBCS_GATE_NOT_X_AND_Y:
+                                    /* Truth table (00, 01, 10, 11): (0, 1, 0, 0)
+                                       2 * x + -2 * y + 4 * z + -1 \in {-1, 1} */
+                                    return 2 * x + -2 * y + 4 * z + -1;
+                                case TBCS_GATE_Y:
+                                    /* Truth table (00, 01, 10, 11): (0, 1, 0, 1)
+                                       0 * x + 1 * y + 1 * z + -1 \in {-1, 1} */
+                                    return 0 * x + 1 * y + 1 * z + -1;
+                                case TBCS_GATE_XOR:
+                                    /* Truth table (00, 01, 10, 11): (0, 1, 1, 0)
+                                       1 * x + 1 * y + 1 * z + -1 \in {-1, 1} */
+                                    return 1 * x + 1 * y + 1 * z + -1;
+                                case TBCS_GATE_OR:
+                                    /* Truth table (00, 01, 10, 11): (0, 1, 1, 1)
+                                       -2 * x + -2 * y + 4 * z + -1 \in {-1, 1} */
+                                    return -2 * x + -2 * y + 4 * z + -1;
+                                case TBCS_GATE_NOR:
+                                    /* Truth table (00, 01, 10, 11): (1, 0, 0, 0)
+                                       2 * x + 2 * y + 4 * z + -3 \in {-1, 1} */
+                                    return 2 * x + 2 * y + 4 * z + -3;
+                                case TBCS_GATE_EQUIVALENCE:
+                                    /* Truth table (00, 01, 10, 11): (1, 0, 0, 1)
+                                       1 * x + 1 * y + 1 * z + -2 \in {-1, 1} */
+                                    return 1 * x + 1 * y + 1 * z + -2;
+                                case TBCS_GATE_NOT_Y:
+                                    /* Truth table (00, 01, 10, 11): (1, 0, 1, 0)
+                                       0 * x + -1 * y + 1 * z + 0 \in {-1, 1} */
+                                    return 0 * x + -1 * y + 1 * z + 0;
+                                case TBCS_GATE_IF_Y_THEN_X:
+                                    /* Truth table (00, 01, 10, 11): (1, 0, 1, 1)
+                                       -2 * x + 2 * y + 4 * z + -3 \in {-1, 1} */
+                                    return -2 * x + 2 * y + 4 * z + -3;
+                                case TBCS_GATE_NOT_X:
+                                    /* Truth table (00, 01, 10, 11): (1, 1, 0, 0)
+                                       -1 * x + 0 * y + 1 * z + 0 \in {-1, 1} */
+                                    return -1 * x + 0 * y + 1 * z + 0;
+                                case TBCS_GATE_IF_X_THEN_Y:
+                                    /* Truth table (00, 01, 10, 11): (1, 1, 0, 1)
+                                       2 * x + -2 * y + 4 * z + -3 \in {-1, 1} */
+                                    return 2 * x + -2 * y + 4 * z + -3;
+                                case TBCS_GATE_NAND:
+                                    /* Truth table (00, 01, 10, 11): (1, 1, 1, 0)
+                                       2 * x + 2 * y + 4 * z + -5 \in {-1, 1} */
+                                    return 2 * x + 2 * y + 4 * z + -5;
+                                case TBCS_GATE_CONSTANT_1:
+                                    /* Truth table (00, 01, 10, 11): (1, 1, 1, 1)
+                                       0 * x + 0 * y + 1 * z + 0 \in {-1, 1} */
+                                    return 0 * x + 0 * y + 1 * z + 0;
+                                default:
+                                    assert(0);
+                                    return uscs_constraint<FieldType>();
+                            }
+                        }
                     };
                 }    // namespace reductions
             }        // namespace snark
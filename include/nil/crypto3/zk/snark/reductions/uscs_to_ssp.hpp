@@ -48,12 +48,11 @@
 #ifndef CRYPTO3_ZK_USCS_TO_SSP_REDUCTION_HPP
 #define CRYPTO3_ZK_USCS_TO_SSP_REDUCTION_HPP
 
-#include <nil/crypto3/math/coset.hpp>
-#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 
 #include <nil/crypto3/zk/snark/arithmetization/arithmetic_programs/ssp.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/constraint_satisfaction_problems/uscs.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/reduction_engine.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -76,7 +75,7 @@ namespace nil {
                          */
                         static ssp_instance<FieldType> instance_map(const uscs_constraint_system<FieldType> &cs) {
                             const std::shared_ptr<evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints());
+                                detail::reduction_engine<FieldType>::domain(cs.num_constraints());
                             std::vector<std::map<std::size_t, typename FieldType::value_type>> V_in_Lagrange_basis(
                                 cs.num_variables() + 1);
                             for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
@@ -110,7 +109,7 @@ namespace nil {
                             instance_map_with_evaluation(const uscs_constraint_system<FieldType> &cs,
                                                          const typename FieldType::value_type &t) {
                             const std::shared_ptr<evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints());
+                                detail::reduction_engine<FieldType>::domain(cs.num_constraints());
 
                             std::vector<typename FieldType::value_type> Vt(cs.num_variables() + 1,
                                                                            FieldType::value_type::zero());
@@ -168,8 +167,7 @@ namespace nil {
                          *  (5) compute coefficients of H
                          *  (6) patch H to account for d (i.e., add coefficients of the polynomial 2*d*V(z) + d*d*Z(z) )
                          *
-                         * The code below is not as simple as the above high-level description due to
-                         * some reshuffling to save space.
+                         * Constraints are evaluated in parallel, see detail::reduction_engine.
                          */
                         static ssp_witness<FieldType>
                             witness_map(const uscs_constraint_system<FieldType> &cs,
@@ -185,59 +183,38 @@ namespace nil {
                                 full_variable_assignment.end(), auxiliary_input.begin(), auxiliary_input.end());
 
                             const std::shared_ptr<evaluation_domain<FieldType>> domain =
-                                make_evaluation_domain<FieldType>(cs.num_constraints());
+                                detail::reduction_engine<FieldType>::domain(cs.num_constraints());
 
-                            std::vector<typename FieldType::value_type> aA(domain->m, FieldType::value_type::zero());
+                            typedef detail::reduction_engine<FieldType> engine;
+
+                            std::vector<typename FieldType::value_type> aA = engine::acquire(domain->m);
                             assert(domain->m >= cs.num_constraints());
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aA[i] += cs.constraints[i].evaluate(full_variable_assignment);
-                            }
-                            for (std::size_t i = cs.num_constraints(); i < domain->m; ++i) {
-                                aA[i] += FieldType::value_type::one();
-                            }
+                            engine::for_each_row(domain->m, [&](std::size_t i) {
+                                aA[i] = i < cs.num_constraints() ?
+                                            cs.constraints[i].evaluate(full_variable_assignment) :
+                                            FieldType::value_type::one();
+                            });
 
-                            domain->inverse_fft(aA);
+                            engine::interpolate(domain, {&aA});
 
                             std::vector<typename FieldType::value_type> coefficients_for_H(
                                 domain->m + 1, FieldType::value_type::zero());
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
                             /* add coefficients of the polynomial 2*d*V(z) + d*d*Z(z) */
-                            for (std::size_t i = 0; i < domain->m; ++i) {
+                            engine::for_each_row(domain->m, [&](std::size_t i) {
                                 coefficients_for_H[i] = typename FieldType::value_type(2) * d * aA[i];
-                            }
+                            });
                             domain->add_poly_z(d.squared(), coefficients_for_H);
 
-                            math::multiply_by_coset(
-                                aA,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aA);
+                            engine::evaluate_on_coset(domain, {&aA});
 
                             std::vector<typename FieldType::value_type> &H_tmp =
                                 aA;    // can overwrite aA because it is not used later
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
+                            engine::for_each_row(domain->m, [&](std::size_t i) {
                                 H_tmp[i] = aA[i].squared() - FieldType::value_type::one();
-                            }
-
-                            domain->divide_by_z_on_coset(H_tmp);
+                            });
 
-                            domain->inverse_fft(H_tmp);
-                            multiply_by_coset(H_tmp,
-                                              typename FieldType::value_type(
-                                                  fields::arithmetic_params<FieldType>::multiplicative_generator)
-                                                  .inversed());
-
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                coefficients_for_H[i] += H_tmp[i];
-                            }
+                            engine::add_quotient(domain, H_tmp, coefficients_for_H);
+                            engine::release(std::move(H_tmp));
 
                             return ssp_witness<FieldType>(cs.num_variables(),
                                                           domain->m,
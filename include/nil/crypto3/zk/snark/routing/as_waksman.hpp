@@ -56,9 +56,15 @@
 
 #include <cstddef>
 #include <map>
+#include <utility>
 #include <vector>
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
 #include <nil/crypto3/zk/math/integer_permutation.hpp>
+#include <nil/crypto3/zk/snark/routing/routing_bit_matrix.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -117,6 +123,13 @@ namespace nil {
                  */
                 typedef std::vector<std::map<std::size_t, bool>> as_waksman_routing;
 
+                /**
+                 * The same routing stored as a bit matrix: routing.get(column_idx, packet_idx) is set
+                 * iff the switch with canonical position (column_idx, packet_idx) is in "cross" setting.
+                 * Bits of positions which are not canonical positions of a switch are always cleared.
+                 */
+                typedef routing_bit_matrix as_waksman_flat_routing;
+
                 /**
                  * Return the number of (switch) columns in a AS-Waksman network for a given number of packets.
                  *
@@ -140,12 +153,34 @@ namespace nil {
                  */
                 as_waksman_routing get_as_waksman_routing(const math::integer_permutation &permutation);
 
+                /**
+                 * Route the given permutation on an AS-Waksman network of suitable size,
+                 * returning the routing as a bit matrix.
+                 */
+                as_waksman_flat_routing get_as_waksman_flat_routing(const math::integer_permutation &permutation);
+
                 /**
                  * Check if a routing "implements" the given permutation.
                  */
                 bool valid_as_waksman_routing(const math::integer_permutation &permutation,
                                               const as_waksman_routing &routing);
 
+                bool valid_as_waksman_routing(const math::integer_permutation &permutation,
+                                              const as_waksman_flat_routing &routing);
+
+                /**
+                 * Check if a routing "implements" the given permutation on a topology
+                 * previously returned by generate_as_waksman_topology, so that callers checking
+                 * many routings of the same size construct the topology only once.
+                 */
+                bool valid_as_waksman_routing(const math::integer_permutation &permutation,
+                                              const as_waksman_routing &routing,
+                                              const as_waksman_topology &neighbors);
+
+                bool valid_as_waksman_routing(const math::integer_permutation &permutation,
+                                              const as_waksman_flat_routing &routing,
+                                              const as_waksman_topology &neighbors);
+
                 /**
                  * Return the height of the AS-Waksman network's top sub-network.
                  */
@@ -198,19 +233,21 @@ namespace nil {
                  * Note that rhs_dests is *not* a permutation of [lo, lo+1, ... hi].
                  *
                  * This function fills out neighbors[left] and neighbors[right-1].
+                 *
+                 * rhs_dests points to hi-lo+1 destinations; the halves of the next level
+                 * are passed as pointers into one buffer instead of being copied.
                  */
                 void construct_as_waksman_inner(size_t left,
                                                 std::size_t right,
                                                 std::size_t lo,
                                                 std::size_t hi,
-                                                const std::vector<std::size_t> &rhs_dests,
+                                                const std::size_t *rhs_dests,
                                                 as_waksman_topology &neighbors) {
                     if (left > right) {
                         return;
                     }
 
                     const std::size_t subnetwork_size = (hi - lo + 1);
-                    assert(rhs_dests.size() == subnetwork_size);
                     const std::size_t subnetwork_width = as_waksman_num_columns(subnetwork_size);
                     assert(right - left + 1 >= subnetwork_width);
 
@@ -230,7 +267,7 @@ namespace nil {
                             new_rhs_dests[packet_idx - lo] = packet_idx;
                         }
 
-                        construct_as_waksman_inner(left + 1, right - 1, lo, hi, new_rhs_dests, neighbors);
+                        construct_as_waksman_inner(left + 1, right - 1, lo, hi, new_rhs_dests.data(), neighbors);
                     } else if (subnetwork_size == 2) {
                         /* Non-trivial base case: routing a 2-element permutation. */
                         neighbors[left][lo].first = neighbors[left][hi].second = rhs_dests[0];
@@ -286,16 +323,24 @@ namespace nil {
                         }
 
                         const std::size_t d = as_waksman_top_height(subnetwork_size);
-                        const std::vector<std::size_t> new_rhs_dests_top(new_rhs_dests.begin(),
-                                                                         new_rhs_dests.begin() + d);
-                        const std::vector<std::size_t> new_rhs_dests_bottom(new_rhs_dests.begin() + d,
-                                                                            new_rhs_dests.end());
 
-                        construct_as_waksman_inner(left + 1, right - 1, lo, lo + d - 1, new_rhs_dests_top, neighbors);
-                        construct_as_waksman_inner(left + 1, right - 1, lo + d, hi, new_rhs_dests_bottom, neighbors);
+                        construct_as_waksman_inner(left + 1, right - 1, lo, lo + d - 1, new_rhs_dests.data(),
+                                                   neighbors);
+                        construct_as_waksman_inner(left + 1, right - 1, lo + d, hi, new_rhs_dests.data() + d,
+                                                   neighbors);
                     }
                 }
 
+                void construct_as_waksman_inner(size_t left,
+                                                std::size_t right,
+                                                std::size_t lo,
+                                                std::size_t hi,
+                                                const std::vector<std::size_t> &rhs_dests,
+                                                as_waksman_topology &neighbors) {
+                    assert(rhs_dests.size() == hi - lo + 1);
+                    construct_as_waksman_inner(left, right, lo, hi, rhs_dests.data(), neighbors);
+                }
+
                 as_waksman_topology generate_as_waksman_topology(size_t num_packets) {
                     assert(num_packets > 1);
                     const std::size_t width = as_waksman_num_columns(num_packets);
@@ -309,7 +354,7 @@ namespace nil {
                         rhs_dests[packet_idx] = packet_idx;
                     }
 
-                    construct_as_waksman_inner(0, width - 1, 0, num_packets - 1, rhs_dests, neighbors);
+                    construct_as_waksman_inner(0, width - 1, 0, num_packets - 1, rhs_dests.data(), neighbors);
 
                     return neighbors;
                 }
@@ -619,11 +664,242 @@ namespace nil {
                     return routing;
                 }
 
+                /**
+                 * Auxiliary function used in get_as_waksman_flat_routing (see below).
+                 *
+                 * Routes the switch columns left and right of the subnetwork [lo, hi] exactly as
+                 * as_waksman_route_inner does, but without recursion: permutation and permutation_inv hold
+                 * the permutations of all subnetworks of the current level, the permutations of the
+                 * sub-networks are written to the same rows of new_permutation and new_permutation_inv,
+                 * and the sub-networks still to be routed are returned in children (empty ones have lo > hi).
+                 *
+                 * Switch states are kept per row in lhs_state and rhs_state (0 - not set, 1 - straight,
+                 * 2 - cross). Subnetworks of one level touch disjoint rows of every buffer, so they may be
+                 * routed concurrently.
+                 */
+                void as_waksman_route_subnetwork(size_t left,
+                                                 std::size_t right,
+                                                 std::size_t lo,
+                                                 std::size_t hi,
+                                                 const std::vector<std::size_t> &permutation,
+                                                 const std::vector<std::size_t> &permutation_inv,
+                                                 std::vector<std::size_t> &new_permutation,
+                                                 std::vector<std::size_t> &new_permutation_inv,
+                                                 std::vector<char> &lhs_routed,
+                                                 std::vector<char> &lhs_state,
+                                                 std::vector<char> &rhs_state,
+                                                 as_waksman_flat_routing &routing,
+                                                 std::pair<std::size_t, std::size_t> *children) {
+                    const std::size_t subnetwork_size = (hi - lo + 1);
+                    const std::size_t subnetwork_width = as_waksman_num_columns(subnetwork_size);
+                    assert(right - left + 1 >= subnetwork_width);
+
+                    if (right - left + 1 > subnetwork_width) {
+                        /* straight edges along the sides, the permutation is passed unchanged */
+                        std::copy(permutation.begin() + lo, permutation.begin() + hi + 1, new_permutation.begin() + lo);
+                        std::copy(permutation_inv.begin() + lo, permutation_inv.begin() + hi + 1,
+                                  new_permutation_inv.begin() + lo);
+                        children[0] = std::make_pair(lo, hi);
+                        return;
+                    }
+
+                    if (subnetwork_size == 2) {
+                        assert(permutation[lo] == lo || permutation[lo] == lo + 1);
+                        if (permutation[lo] != lo) {
+                            routing.set_shared(left, lo);
+                        }
+                        return;
+                    }
+
+                    for (std::size_t packet_idx = lo; packet_idx <= hi; ++packet_idx) {
+                        new_permutation[packet_idx] = packet_idx;
+                        new_permutation_inv[packet_idx] = packet_idx;
+                        lhs_routed[packet_idx] = false;
+                        lhs_state[packet_idx] = rhs_state[packet_idx] = 0;
+                    }
+
+                    const auto state = [](bool switch_setting) -> char { return switch_setting ? 2 : 1; };
+
+                    std::size_t to_route;
+                    std::size_t max_unrouted;
+                    bool route_left;
+
+                    if (subnetwork_size % 2 == 1) {
+                        /* ODD CASE: the bottom-most straight wire goes to the lower subnetwork */
+                        if (permutation[hi] == hi) {
+                            new_permutation[hi] = hi;
+                            new_permutation_inv[hi] = hi;
+                            to_route = hi - 1;
+                            route_left = true;
+                        } else {
+                            const std::size_t rhs_switch = as_waksman_get_canonical_row_idx(lo, permutation[hi]);
+                            rhs_state[rhs_switch] =
+                                state(as_waksman_get_switch_setting_from_top_bottom_decision(lo, permutation[hi], false));
+                            const std::size_t tprime = as_waksman_switch_input(subnetwork_size, lo, rhs_switch, false);
+                            new_permutation[hi] = tprime;
+                            new_permutation_inv[tprime] = hi;
+
+                            to_route = as_waksman_other_output_position(lo, permutation[hi]);
+                            route_left = false;
+                        }
+
+                        lhs_routed[hi] = true;
+                        max_unrouted = hi - 1;
+                    } else {
+                        /* EVEN CASE: the bottom-most switch is fixed to a constant straight setting */
+                        lhs_state[hi - 1] = state(false);
+                        to_route = hi;
+                        route_left = true;
+                        max_unrouted = hi;
+                    }
+
+                    while (true) {
+                        if (route_left) {
+                            const std::size_t lhs_switch = as_waksman_get_canonical_row_idx(lo, to_route);
+                            if (lhs_state[lhs_switch] == 0) {
+                                lhs_state[lhs_switch] = state(false);
+                            }
+                            const bool lhs_switch_setting = (lhs_state[lhs_switch] == 2);
+                            const bool use_top =
+                                as_waksman_get_top_bottom_decision_from_switch_setting(lo, to_route, lhs_switch_setting);
+                            const std::size_t t = as_waksman_switch_output(subnetwork_size, lo, lhs_switch, use_top);
+                            if (permutation[to_route] == hi) {
+                                /* routed to the straight wire of the odd case, back-route from it */
+                                new_permutation[t] = hi;
+                                new_permutation_inv[hi] = t;
+                                lhs_routed[to_route] = true;
+                                to_route = max_unrouted;
+                                route_left = true;
+                            } else {
+                                const std::size_t rhs_switch =
+                                    as_waksman_get_canonical_row_idx(lo, permutation[to_route]);
+                                assert(rhs_state[rhs_switch] == 0);
+                                rhs_state[rhs_switch] = state(
+                                    as_waksman_get_switch_setting_from_top_bottom_decision(lo, permutation[to_route],
+                                                                                           use_top));
+                                const std::size_t tprime =
+                                    as_waksman_switch_input(subnetwork_size, lo, rhs_switch, use_top);
+                                new_permutation[t] = tprime;
+                                new_permutation_inv[tprime] = t;
+
+                                lhs_routed[to_route] = true;
+                                to_route = as_waksman_other_output_position(lo, permutation[to_route]);
+                                route_left = false;
+                            }
+                        } else {
+                            /* arrived on the right-hand side, back route from here */
+                            const std::size_t rhs_switch = as_waksman_get_canonical_row_idx(lo, to_route);
+                            const std::size_t lhs_switch =
+                                as_waksman_get_canonical_row_idx(lo, permutation_inv[to_route]);
+                            assert(rhs_state[rhs_switch] != 0);
+                            const bool rhs_switch_setting = (rhs_state[rhs_switch] == 2);
+                            const bool use_top =
+                                as_waksman_get_top_bottom_decision_from_switch_setting(lo, to_route, rhs_switch_setting);
+                            const bool lhs_switch_setting = as_waksman_get_switch_setting_from_top_bottom_decision(
+                                lo, permutation_inv[to_route], use_top);
+
+                            assert(lhs_state[lhs_switch] == 0 || lhs_state[lhs_switch] == state(lhs_switch_setting));
+                            lhs_state[lhs_switch] = state(lhs_switch_setting);
+
+                            const std::size_t t = as_waksman_switch_input(subnetwork_size, lo, rhs_switch, use_top);
+                            const std::size_t tprime =
+                                as_waksman_switch_output(subnetwork_size, lo, lhs_switch, use_top);
+                            new_permutation[tprime] = t;
+                            new_permutation_inv[t] = tprime;
+
+                            lhs_routed[permutation_inv[to_route]] = true;
+                            to_route = as_waksman_other_input_position(lo, permutation_inv[to_route]);
+                            route_left = true;
+                        }
+
+                        if (!route_left || !lhs_routed[to_route]) {
+                            continue;
+                        }
+
+                        while (max_unrouted > lo && lhs_routed[max_unrouted]) {
+                            --max_unrouted;
+                        }
+
+                        if (max_unrouted < lo || (max_unrouted == lo && lhs_routed[lo])) {
+                            break;
+                        } else {
+                            to_route = max_unrouted;
+                            route_left = true;
+                        }
+                    }
+
+                    /* only cross settings are stored; the fixed switch of the even case stays straight */
+                    for (std::size_t packet_idx = lo; packet_idx <= hi; ++packet_idx) {
+                        if (lhs_state[packet_idx] == 2) {
+                            routing.set_shared(left, packet_idx);
+                        }
+                        if (rhs_state[packet_idx] == 2) {
+                            routing.set_shared(right, packet_idx);
+                        }
+                    }
+
+                    const std::size_t d = as_waksman_top_height(subnetwork_size);
+                    children[0] = std::make_pair(lo, lo + d - 1);
+                    children[1] = std::make_pair(lo + d, hi);
+                }
+
+                as_waksman_flat_routing get_as_waksman_flat_routing(const math::integer_permutation &permutation) {
+                    const std::size_t num_packets = permutation.size();
+                    const std::size_t width = as_waksman_num_columns(num_packets);
+                    assert(permutation.min_element == 0);
+
+                    as_waksman_flat_routing routing(width, num_packets);
+                    if (width == 0) {
+                        return routing;
+                    }
+
+                    std::vector<std::size_t> current = permutation.data();
+                    std::vector<std::size_t> current_inv = permutation.inverse().data();
+                    std::vector<std::size_t> next(num_packets);
+                    std::vector<std::size_t> next_inv(num_packets);
+                    std::vector<char> lhs_routed(num_packets);
+                    std::vector<char> lhs_state(num_packets);
+                    std::vector<char> rhs_state(num_packets);
+
+                    /* after the outer columns of a subnetwork are routed its sub-networks are independent,
+                     * so the network is routed level by level with all subnetworks of a level in parallel */
+                    const std::pair<std::size_t, std::size_t> empty(1, 0);
+                    std::vector<std::pair<std::size_t, std::size_t>> subnetworks = {std::make_pair(0, num_packets - 1)};
+                    for (std::size_t left = 0; 2 * left < width && !subnetworks.empty(); ++left) {
+                        const std::size_t right = width - 1 - left;
+                        std::vector<std::pair<std::size_t, std::size_t>> children(2 * subnetworks.size(), empty);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t i = 0; i < subnetworks.size(); ++i) {
+                            as_waksman_route_subnetwork(left, right, subnetworks[i].first, subnetworks[i].second,
+                                                        current, current_inv, next, next_inv, lhs_routed, lhs_state,
+                                                        rhs_state, routing, &children[2 * i]);
+                        }
+
+                        std::swap(current, next);
+                        std::swap(current_inv, next_inv);
+
+                        subnetworks.clear();
+                        for (const auto &child : children) {
+                            if (child.first <= child.second) {
+                                subnetworks.push_back(child);
+                            }
+                        }
+                    }
+
+                    return routing;
+                }
+
                 bool valid_as_waksman_routing(const math::integer_permutation &permutation,
-                                              const as_waksman_routing &routing) {
+                                              const as_waksman_routing &routing,
+                                              const as_waksman_topology &neighbors) {
                     const std::size_t num_packets = permutation.size();
                     const std::size_t width = as_waksman_num_columns(num_packets);
-                    as_waksman_topology neighbors = generate_as_waksman_topology(num_packets);
+                    if (neighbors.size() != width) {
+                        return false;
+                    }
 
                     math::integer_permutation curperm(num_packets);
 
@@ -652,6 +928,71 @@ namespace nil {
 
                     return (curperm == permutation.inverse());
                 }
+
+                bool valid_as_waksman_routing(const math::integer_permutation &permutation,
+                                              const as_waksman_flat_routing &routing,
+                                              const as_waksman_topology &neighbors) {
+                    const std::size_t num_packets = permutation.size();
+                    const std::size_t width = as_waksman_num_columns(num_packets);
+                    if (routing.columns() != width || routing.rows() != num_packets || neighbors.size() != width) {
+                        return false;
+                    }
+                    if (width == 0) {
+                        return true;
+                    }
+
+                    /* packets[row_idx] is the input packet currently at row_idx */
+                    std::vector<std::size_t> packets(num_packets);
+                    std::vector<std::size_t> next_packets(num_packets);
+                    for (std::size_t packet_idx = 0; packet_idx < num_packets; ++packet_idx) {
+                        packets[packet_idx] = packet_idx;
+                    }
+
+                    for (std::size_t column_idx = 0; column_idx < width; ++column_idx) {
+                        for (std::size_t packet_idx = 0; packet_idx < num_packets; ++packet_idx) {
+                            std::size_t routed_packet_idx;
+                            if (neighbors[column_idx][packet_idx].first == neighbors[column_idx][packet_idx].second) {
+                                routed_packet_idx = neighbors[column_idx][packet_idx].first;
+                            } else {
+                                /* the switch has its canonical position either here or one row above,
+                                 * and the bit of the other (non-canonical) position is cleared */
+                                const bool switch_setting =
+                                    routing.get(column_idx, packet_idx) ||
+                                    (packet_idx > 0 && routing.get(column_idx, packet_idx - 1));
+
+                                routed_packet_idx = (switch_setting ? neighbors[column_idx][packet_idx].second :
+                                                                      neighbors[column_idx][packet_idx].first);
+                            }
+
+                            next_packets[routed_packet_idx] = packets[packet_idx];
+                        }
+
+                        std::swap(packets, next_packets);
+                    }
+
+                    for (std::size_t packet_idx = 0; packet_idx < num_packets; ++packet_idx) {
+                        if (packets[permutation.get(packet_idx)] != packet_idx) {
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+
+                bool valid_as_waksman_routing(const math::integer_permutation &permutation,
+                                              const as_waksman_routing &routing) {
+                    return valid_as_waksman_routing(permutation, routing,
+                                                    generate_as_waksman_topology(permutation.size()));
+                }
+
+                bool valid_as_waksman_routing(const math::integer_permutation &permutation,
+                                              const as_waksman_flat_routing &routing) {
+                    const std::size_t num_packets = permutation.size();
+                    if (num_packets <= 1) {
+                        return valid_as_waksman_routing(permutation, routing, as_waksman_topology());
+                    }
+                    return valid_as_waksman_routing(permutation, routing, generate_as_waksman_topology(num_packets));
+                }
             }    // namespace snark
         }        // namespace zk
     }            // namespace crypto3
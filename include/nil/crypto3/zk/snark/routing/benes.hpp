@@ -41,9 +41,15 @@
 #ifndef CRYPTO3_ZK_BENES_ROUTING_ALGORITHM_HPP
 #define CRYPTO3_ZK_BENES_ROUTING_ALGORITHM_HPP
 
+#include <utility>
 #include <vector>
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
 #include <nil/crypto3/zk/math/integer_permutation.hpp>
+#include <nil/crypto3/zk/snark/routing/routing_bit_matrix.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -76,6 +82,12 @@ namespace nil {
                  */
                 typedef std::vector<std::vector<bool>> benes_routing;
 
+                /**
+                 * The same routing stored as a bit matrix: routing.get(column_idx, packet_idx)
+                 * is the bit of the switch handling the packet_idx-th packet in the column_idx-th column.
+                 */
+                typedef routing_bit_matrix benes_flat_routing;
+
                 /**
                  * Return the number of (switch) columns in a Benes network for a given number of packets.
                  *
@@ -99,11 +111,20 @@ namespace nil {
                  */
                 benes_routing get_benes_routing(const math::integer_permutation &permutation);
 
+                /**
+                 * Route the given permutation on a Benes network of suitable size,
+                 * returning the routing as a bit matrix.
+                 */
+                benes_flat_routing get_benes_flat_routing(const math::integer_permutation &permutation);
+
                 /**
                  * Check if a routing "implements" the given permutation.
                  */
                 bool valid_benes_routing(const math::integer_permutation &permutation, const benes_routing &routing);
 
+                bool valid_benes_routing(const math::integer_permutation &permutation,
+                                         const benes_flat_routing &routing);
+
                 /**
                  * Compute the mask for all the cross edges originating at a
                  * particular column.
@@ -247,7 +268,7 @@ namespace nil {
                                        benes_routing &routing) {
                     assert(permutation.size() == subnetwork_size);
                     assert(permutation.is_valid());
-                    assert(permutation.inversed() == permutation_inv);
+                    assert(permutation.inverse() == permutation_inv);
 
                     if (column_idx_start == column_idx_end) {
                         /* nothing to route */
@@ -354,6 +375,131 @@ namespace nil {
                     return routing;
                 }
 
+                /**
+                 * Auxiliary function used in get_benes_flat_routing (see below).
+                 *
+                 * Routes the columns column_idx_start and column_idx_end - 1 of one subnetwork exactly as
+                 * route_benes_inner does, but without recursion: permutation and permutation_inv hold the
+                 * permutations of all subnetworks of the current level in absolute indices, and the
+                 * permutations of the two halves are written to the same rows of new_permutation and
+                 * new_permutation_inv. Subnetworks of one level touch disjoint rows of every buffer,
+                 * so they may be routed concurrently.
+                 */
+                void route_benes_subnetwork(size_t dimension,
+                                            const std::vector<std::size_t> &permutation,
+                                            const std::vector<std::size_t> &permutation_inv,
+                                            std::size_t column_idx_start,
+                                            std::size_t column_idx_end,
+                                            std::size_t subnetwork_offset,
+                                            std::size_t subnetwork_size,
+                                            std::vector<std::size_t> &new_permutation,
+                                            std::vector<std::size_t> &new_permutation_inv,
+                                            std::vector<char> &lhs_routed,
+                                            benes_flat_routing &routing) {
+                    const std::size_t subnetwork_end = subnetwork_offset + subnetwork_size;
+                    for (std::size_t packet_idx = subnetwork_offset; packet_idx < subnetwork_end; ++packet_idx) {
+                        lhs_routed[packet_idx] = false;
+                    }
+
+                    const auto set_switch = [&routing](std::size_t column_idx, std::size_t packet_idx, bool value) {
+                        if (value) {
+                            routing.set_shared(column_idx, packet_idx);
+                        }
+                    };
+
+                    std::size_t w = subnetwork_offset; /* left-hand-side vertex to be routed. */
+                    std::size_t last_unrouted = subnetwork_offset;
+
+                    while (true) {
+                        /* route w to its target on RHS, wprime = pi[w], using upper network */
+                        const std::size_t wprime = permutation[w];
+                        const std::size_t w_dest = benes_lhs_packet_destination(dimension, column_idx_start, w, true);
+                        const std::size_t wprime_source =
+                            benes_rhs_packet_source(dimension, column_idx_end, wprime, true);
+
+                        set_switch(column_idx_start, w,
+                                   benes_get_switch_setting_from_subnetwork(dimension, column_idx_start, w, true));
+                        new_permutation[w_dest] = wprime_source;
+                        lhs_routed[w] = true;
+
+                        set_switch(
+                            column_idx_end - 1, wprime_source,
+                            benes_get_switch_setting_from_subnetwork(dimension, column_idx_end - 1, wprime, true));
+                        new_permutation_inv[wprime_source] = w_dest;
+
+                        /* the other neighbor of wprime is back-routed via the lower network */
+                        const std::size_t vprime = benes_packet_cross_source(dimension, column_idx_end, wprime);
+                        const std::size_t v = permutation_inv[vprime];
+                        assert(!lhs_routed[v]);
+                        const std::size_t v_dest = benes_lhs_packet_destination(dimension, column_idx_start, v, false);
+                        const std::size_t vprime_source =
+                            benes_rhs_packet_source(dimension, column_idx_end, vprime, false);
+
+                        set_switch(
+                            column_idx_end - 1, vprime_source,
+                            benes_get_switch_setting_from_subnetwork(dimension, column_idx_end - 1, vprime, false));
+                        new_permutation_inv[vprime_source] = v_dest;
+
+                        set_switch(column_idx_start, v,
+                                   benes_get_switch_setting_from_subnetwork(dimension, column_idx_start, v, false));
+                        new_permutation[v_dest] = vprime_source;
+                        lhs_routed[v] = true;
+
+                        /* if the other neighbor of v is not routed, route it; otherwise, find the next unrouted node */
+                        const std::size_t v_neighbor = benes_packet_cross_destination(dimension, column_idx_start, v);
+                        if (!lhs_routed[v_neighbor]) {
+                            w = v_neighbor;
+                        } else {
+                            while (last_unrouted < subnetwork_end && lhs_routed[last_unrouted]) {
+                                ++last_unrouted;
+                            }
+
+                            if (last_unrouted == subnetwork_end) {
+                                break; /* all routed! */
+                            } else {
+                                w = last_unrouted;
+                            }
+                        }
+                    }
+                }
+
+                benes_flat_routing get_benes_flat_routing(const math::integer_permutation &permutation) {
+                    const std::size_t num_packets = permutation.size();
+                    const std::size_t num_columns = benes_num_columns(num_packets);
+                    const std::size_t dimension = static_cast<std::size_t>(std::ceil(std::log2(num_packets)));
+                    assert(permutation.min_element == 0);
+
+                    benes_flat_routing routing(num_columns, num_packets);
+
+                    std::vector<std::size_t> current = permutation.data();
+                    std::vector<std::size_t> current_inv = permutation.inverse().data();
+                    std::vector<std::size_t> next(num_packets);
+                    std::vector<std::size_t> next_inv(num_packets);
+                    std::vector<char> lhs_routed(num_packets);
+
+                    /* all subnetworks of one level have the same size and are independent */
+                    std::size_t subnetwork_size = num_packets;
+                    for (std::size_t column_idx_start = 0; 2 * column_idx_start < num_columns; ++column_idx_start) {
+                        const std::size_t column_idx_end = num_columns - column_idx_start;
+                        const std::size_t subnetworks_amount = num_packets / subnetwork_size;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t subnetwork_idx = 0; subnetwork_idx < subnetworks_amount; ++subnetwork_idx) {
+                            route_benes_subnetwork(dimension, current, current_inv, column_idx_start, column_idx_end,
+                                                   subnetwork_idx * subnetwork_size, subnetwork_size, next,
+                                                   next_inv, lhs_routed, routing);
+                        }
+
+                        std::swap(current, next);
+                        std::swap(current_inv, next_inv);
+                        subnetwork_size /= 2;
+                    }
+
+                    return routing;
+                }
+
                 /* auxiliary function that is used in valid_benes_routing below */
                 template<typename T>
                 std::vector<std::vector<T>> route_by_benes(const benes_routing &routing, const std::vector<T> &start) {
@@ -397,6 +543,43 @@ namespace nil {
                     return true;
                 }
 
+                bool valid_benes_routing(const math::integer_permutation &permutation,
+                                         const benes_flat_routing &routing) {
+                    const std::size_t num_packets = permutation.size();
+                    const std::size_t num_columns = benes_num_columns(num_packets);
+                    const std::size_t dimension = static_cast<std::size_t>(std::ceil(std::log2(num_packets)));
+
+                    if (routing.columns() != num_columns || routing.rows() != num_packets) {
+                        return false;
+                    }
+
+                    /* only the current and the next column of packets are kept */
+                    std::vector<std::size_t> packets(num_packets);
+                    std::vector<std::size_t> next_packets(num_packets);
+                    for (std::size_t packet_idx = 0; packet_idx < num_packets; ++packet_idx) {
+                        packets[packet_idx] = packet_idx;
+                    }
+
+                    for (std::size_t column_idx = 0; column_idx < num_columns; ++column_idx) {
+                        const std::size_t mask = benes_cross_edge_mask(dimension, column_idx);
+
+                        for (std::size_t packet_idx = 0; packet_idx < num_packets; ++packet_idx) {
+                            std::size_t next_packet_idx =
+                                !routing.get(column_idx, packet_idx) ? packet_idx : packet_idx ^ mask;
+                            next_packets[next_packet_idx] = packets[packet_idx];
+                        }
+                        std::swap(packets, next_packets);
+                    }
+
+                    for (std::size_t packet_idx = 0; packet_idx < num_packets; ++packet_idx) {
+                        if (packets[permutation.get(packet_idx)] != packet_idx) {
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+
             }    // namespace snark
         }        // namespace zk
     }            // namespace crypto3
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Bit-packed switch settings of a routing network.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_ROUTING_BIT_MATRIX_HPP
+#define CRYPTO3_ZK_ROUTING_BIT_MATRIX_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+
+                /**
+                 * Switch settings of a routing network stored as one bit per (column, row),
+                 * column-major, each column padded to whole 64-bit words.
+                 *
+                 * All bits start cleared. set_shared may be called concurrently for distinct
+                 * positions, including positions sharing a word, which lets independent
+                 * subnetworks of one column be routed in parallel.
+                 */
+                class routing_bit_matrix {
+                public:
+                    routing_bit_matrix(std::size_t num_columns = 0, std::size_t num_rows = 0) :
+                        num_columns(num_columns), num_rows(num_rows), words_per_column((num_rows + 63) / 64),
+                        words(num_columns * words_per_column, 0) {
+                    }
+
+                    std::size_t columns() const {
+                        return num_columns;
+                    }
+
+                    std::size_t rows() const {
+                        return num_rows;
+                    }
+
+                    bool get(std::size_t column_idx, std::size_t row_idx) const {
+                        assert(column_idx < num_columns && row_idx < num_rows);
+                        return (words[word_index(column_idx, row_idx)] >> (row_idx % 64)) & 1;
+                    }
+
+                    void set(std::size_t column_idx, std::size_t row_idx, bool value) {
+                        assert(column_idx < num_columns && row_idx < num_rows);
+                        const std::uint64_t mask = std::uint64_t(1) << (row_idx % 64);
+                        std::uint64_t &word = words[word_index(column_idx, row_idx)];
+                        word = value ? (word | mask) : (word & ~mask);
+                    }
+
+                    /**
+                     * Set the bit to one. Safe to call from several threads at once.
+                     */
+                    void set_shared(std::size_t column_idx, std::size_t row_idx) {
+                        assert(column_idx < num_columns && row_idx < num_rows);
+                        const std::uint64_t mask = std::uint64_t(1) << (row_idx % 64);
+                        std::uint64_t &word = words[word_index(column_idx, row_idx)];
+#ifdef MULTICORE
+#pragma omp atomic
+#endif
+                        word |= mask;
+                    }
+
+                    bool operator==(const routing_bit_matrix &other) const {
+                        return num_columns == other.num_columns && num_rows == other.num_rows &&
+                               words == other.words;
+                    }
+
+                    bool operator!=(const routing_bit_matrix &other) const {
+                        return !(*this == other);
+                    }
+
+                private:
+                    std::size_t word_index(std::size_t column_idx, std::size_t row_idx) const {
+                        return column_idx * words_per_column + row_idx / 64;
+                    }
+
+                    std::size_t num_columns;
+                    std::size_t num_rows;
+                    std::size_t words_per_column;
+                    std::vector<std::uint64_t> words;
+                };
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_ROUTING_BIT_MATRIX_HPP
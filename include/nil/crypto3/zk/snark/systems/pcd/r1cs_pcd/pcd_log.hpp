@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Progress log of the PCD generator, prover and verifier.
+//
+// Messages go to a process-wide sink, standard output by default. Applications
+// proving many PCD nodes install their own thread-safe sink or silence it with an
+// empty one.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_PCD_LOG_HPP
+#define CRYPTO3_ZK_PCD_LOG_HPP
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+
+                typedef std::function<void(const std::string &)> pcd_log_sink;
+
+                namespace detail {
+                    inline void pcd_log_to_stdout(const std::string &message) {
+                        static std::mutex mutex;
+                        std::lock_guard<std::mutex> lock(mutex);
+                        std::cout << message << std::endl;
+                    }
+
+                    struct pcd_log_state {
+                        std::mutex mutex;
+                        std::shared_ptr<const pcd_log_sink> sink =
+                            std::make_shared<const pcd_log_sink>(pcd_log_to_stdout);
+                    };
+
+                    inline pcd_log_state &get_pcd_log_state() {
+                        static pcd_log_state state;
+                        return state;
+                    }
+                }    // namespace detail
+
+                /**
+                 * Replaces the sink receiving the PCD log. An empty sink discards the messages.
+                 * Concurrently running provers call the sink from several threads at once, so it
+                 * must be thread-safe; the default sink serializes its writes to standard output.
+                 */
+                inline void set_pcd_log_sink(pcd_log_sink sink) {
+                    std::shared_ptr<const pcd_log_sink> new_sink =
+                        sink ? std::make_shared<const pcd_log_sink>(std::move(sink)) : nullptr;
+                    detail::pcd_log_state &state = detail::get_pcd_log_state();
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    state.sink = std::move(new_sink);
+                }
+
+                /**
+                 * Passes the message to the sink. The sink is called without holding the lock guarding it,
+                 * so a slow sink does not stall other provers and a sink may itself log or replace the sink.
+                 */
+                inline void pcd_log(const std::string &message) {
+                    detail::pcd_log_state &state = detail::get_pcd_log_state();
+                    std::shared_ptr<const pcd_log_sink> sink;
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        sink = state.sink;
+                    }
+                    if (sink) {
+                        (*sink)(message);
+                    }
+                }
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_PCD_LOG_HPP
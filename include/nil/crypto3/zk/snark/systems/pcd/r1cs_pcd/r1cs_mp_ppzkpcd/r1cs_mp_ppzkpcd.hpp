@@ -55,10 +55,12 @@
 #define CRYPTO3_R1CS_MP_PPZKPCD_HPP
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <nil/crypto3/zk/snark/set_commitment.hpp>
 
+#include <nil/crypto3/zk/snark/systems/pcd/r1cs_pcd/pcd_log.hpp>
 #include <nil/crypto3/zk/snark/systems/pcd/r1cs_pcd/ppzkpcd_compliance_predicate.hpp>
 #include <nil/crypto3/zk/snark/systems/pcd/r1cs_pcd/r1cs_mp_ppzkpcd/r1cs_mp_ppzkpcd_params.hpp>
 
@@ -280,6 +282,35 @@ namespace nil {
                                            const r1cs_mp_ppzkpcd_auxiliary_input<PCD_ppT> &auxiliary_input,
                                            const std::vector<r1cs_mp_ppzkpcd_proof<PCD_ppT>> &incoming_proofs);
 
+                /**
+                 * Output of the first step of the prover: a curve A proof for the compliance step
+                 * circuit of the chosen compliance predicate.
+                 */
+                template<typename PCD_ppT>
+                struct r1cs_mp_ppzkpcd_compliance_step_proof {
+                    std::size_t compliance_predicate_idx;
+                    typename r1cs_ppzksnark<typename PCD_ppT::curve_A_pp>::proof_type r1cs_proof;
+                };
+
+                /**
+                 * The two steps of r1cs_mp_ppzkpcd_prover. The compliance step depends on the incoming
+                 * proofs, the translation step only on the compliance step of the same message, so
+                 * the steps of independent messages may run concurrently.
+                 */
+                template<typename PCD_ppT>
+                r1cs_mp_ppzkpcd_compliance_step_proof<PCD_ppT> r1cs_mp_ppzkpcd_prove_compliance_step(
+                    const r1cs_mp_ppzkpcd_proving_key<PCD_ppT> &pk,
+                    const std::size_t compliance_predicate_name,
+                    const r1cs_mp_ppzkpcd_primary_input<PCD_ppT> &primary_input,
+                    const r1cs_mp_ppzkpcd_auxiliary_input<PCD_ppT> &auxiliary_input,
+                    const std::vector<r1cs_mp_ppzkpcd_proof<PCD_ppT>> &incoming_proofs);
+
+                template<typename PCD_ppT>
+                r1cs_mp_ppzkpcd_proof<PCD_ppT> r1cs_mp_ppzkpcd_prove_translation_step(
+                    const r1cs_mp_ppzkpcd_proving_key<PCD_ppT> &pk,
+                    const r1cs_mp_ppzkpcd_primary_input<PCD_ppT> &primary_input,
+                    const r1cs_mp_ppzkpcd_compliance_step_proof<PCD_ppT> &compliance_step_proof);
+
                 /*
                   Below are two variants of verifier algorithm for the R1CS (multi-predicate) ppzkPCD.
 
@@ -426,19 +457,19 @@ namespace nil {
                     typedef typename curve_A_pp::scalar_field_type FieldT_A;
                     typedef typename curve_B_pp::scalar_field_type FieldT_B;
 
-                    std::cout << "Call to r1cs_mp_ppzkpcd_generator" << std::endl;
+                    pcd_log("Call to r1cs_mp_ppzkpcd_generator");
 
                     r1cs_mp_ppzkpcd_keypair<PCD_ppT> keypair;
                     const std::size_t translation_input_size =
                         mp_translation_step_pcd_circuit_maker<curve_B_pp>::input_size_in_elts();
                     const std::size_t vk_size_in_bits =
                         r1cs_ppzksnark_verification_key_variable<curve_A_pp>::size_in_bits(translation_input_size);
-                    printf("%zu %zu\n", translation_input_size, vk_size_in_bits);
+                    pcd_log(std::to_string(translation_input_size) + " " + std::to_string(vk_size_in_bits));
 
                     set_commitment_accumulator<crh_with_bit_out_component<FieldT_A>> all_translation_vks(
                         compliance_predicates.size(), vk_size_in_bits);
 
-                    std::cout << "Perform type checks" << std::endl;
+                    pcd_log("Perform type checks");
                     std::map<std::size_t, std::size_t> type_counts;
 
                     for (auto &cp : compliance_predicates) {
@@ -456,43 +487,40 @@ namespace nil {
                     }
 
                     for (std::size_t i = 0; i < compliance_predicates.size(); ++i) {
-                        std::cout << FMT("",
-                                         "Process predicate %zu (with name %zu and type %zu)",
-                                         i,
-                                         compliance_predicates[i].name,
-                                         compliance_predicates[i].type)
-                                  << std::endl;
+                        pcd_log("Process predicate " + std::to_string(i) + " (with name " +
+                                std::to_string(compliance_predicates[i].name) + " and type " +
+                                std::to_string(compliance_predicates[i].type) + ")");
                         assert(compliance_predicates[i].is_well_formed());
 
-                        std::cout << "Construct compliance step PCD circuit" << std::endl;
+                        pcd_log("Construct compliance step PCD circuit");
                         mp_compliance_step_pcd_circuit_maker<curve_A_pp> mp_compliance_step_pcd_circuit(
                             compliance_predicates[i], compliance_predicates.size());
                         mp_compliance_step_pcd_circuit.generate_r1cs_constraints();
                         r1cs_constraint_system<FieldT_A> mp_compliance_step_pcd_circuit_cs =
                             mp_compliance_step_pcd_circuit.get_circuit();
 
-                        std::cout << "Generate key pair for compliance step PCD circuit" << std::endl;
+                        pcd_log("Generate key pair for compliance step PCD circuit");
                         typename r1cs_ppzksnark<curve_A_pp>::keypair_type mp_compliance_step_keypair =
                             r1cs_ppzksnark<curve_A_pp>::generator(mp_compliance_step_pcd_circuit_cs);
 
-                        std::cout << "Construct translation step PCD circuit" << std::endl;
+                        pcd_log("Construct translation step PCD circuit");
                         mp_translation_step_pcd_circuit_maker<curve_B_pp> mp_translation_step_pcd_circuit(
                             mp_compliance_step_keypair.vk);
                         mp_translation_step_pcd_circuit.generate_r1cs_constraints();
                         r1cs_constraint_system<FieldT_B> mp_translation_step_pcd_circuit_cs =
                             mp_translation_step_pcd_circuit.get_circuit();
 
-                        std::cout << "Generate key pair for translation step PCD circuit" << std::endl;
+                        pcd_log("Generate key pair for translation step PCD circuit");
                         typename r1cs_ppzksnark<curve_B_pp>::keypair_type mp_translation_step_keypair =
                             r1cs_ppzksnark<curve_B_pp>::generator(mp_translation_step_pcd_circuit_cs);
 
-                        std::cout << "Augment set of translation step verification keys" << std::endl;
+                        pcd_log("Augment set of translation step verification keys");
                         const std::vector<bool> vk_bits =
                             r1cs_ppzksnark_verification_key_variable<curve_A_pp>::get_verification_key_bits(
                                 mp_translation_step_keypair.vk);
                         all_translation_vks.add(vk_bits);
 
-                        std::cout << "Update r1cs_mp_ppzkpcd keypair" << std::endl;
+                        pcd_log("Update r1cs_mp_ppzkpcd keypair");
                         keypair.pk.compliance_predicates.emplace_back(compliance_predicates[i]);
                         keypair.pk.compliance_step_r1cs_pks.emplace_back(mp_compliance_step_keypair.pk);
                         keypair.pk.translation_step_r1cs_pks.emplace_back(mp_translation_step_keypair.pk);
@@ -507,7 +535,7 @@ namespace nil {
                         keypair.vk.translation_step_r1cs_vks.emplace_back(mp_translation_step_keypair.vk);
                     }
 
-                    std::cout << "Compute set commitment and corresponding membership proofs" << std::endl;
+                    pcd_log("Compute set commitment and corresponding membership proofs");
                     const set_commitment cm = all_translation_vks.get_commitment();
                     keypair.pk.commitment_to_translation_step_r1cs_vks = cm;
                     keypair.vk.commitment_to_translation_step_r1cs_vks = cm;
@@ -530,19 +558,33 @@ namespace nil {
                                            const r1cs_mp_ppzkpcd_primary_input<PCD_ppT> &primary_input,
                                            const r1cs_mp_ppzkpcd_auxiliary_input<PCD_ppT> &auxiliary_input,
                                            const std::vector<r1cs_mp_ppzkpcd_proof<PCD_ppT>> &prev_proofs) {
+                    pcd_log("Call to r1cs_mp_ppzkpcd_prover");
+
+                    return r1cs_mp_ppzkpcd_prove_translation_step(
+                        pk,
+                        primary_input,
+                        r1cs_mp_ppzkpcd_prove_compliance_step(
+                            pk, compliance_predicate_name, primary_input, auxiliary_input, prev_proofs));
+                }
+
+                template<typename PCD_ppT>
+                r1cs_mp_ppzkpcd_compliance_step_proof<PCD_ppT> r1cs_mp_ppzkpcd_prove_compliance_step(
+                    const r1cs_mp_ppzkpcd_proving_key<PCD_ppT> &pk,
+                    const std::size_t compliance_predicate_name,
+                    const r1cs_mp_ppzkpcd_primary_input<PCD_ppT> &primary_input,
+                    const r1cs_mp_ppzkpcd_auxiliary_input<PCD_ppT> &auxiliary_input,
+                    const std::vector<r1cs_mp_ppzkpcd_proof<PCD_ppT>> &prev_proofs) {
                     typedef typename PCD_ppT::curve_A_pp curve_A_pp;
                     typedef typename PCD_ppT::curve_B_pp curve_B_pp;
 
                     typedef typename curve_A_pp::scalar_field_type FieldT_A;
                     typedef typename curve_B_pp::scalar_field_type FieldT_B;
 
-                    std::cout << "Call to r1cs_mp_ppzkpcd_prover" << std::endl;
-
                     auto it = pk.compliance_predicate_name_to_idx.find(compliance_predicate_name);
                     assert(it != pk.compliance_predicate_name_to_idx.end());
                     const std::size_t compliance_predicate_idx = it->second;
 
-                    std::cout << "Prove compliance step" << std::endl;
+                    pcd_log("Prove compliance step");
                     assert(compliance_predicate_idx < pk.compliance_predicates.size());
                     assert(prev_proofs.size() <= pk.compliance_predicates[compliance_predicate_idx].max_arity);
 
@@ -572,7 +614,7 @@ namespace nil {
 
 #ifdef DEBUG
                         if (auxiliary_input.incoming_messages[i]->type != 0) {
-                            printf("check proof for message %zu\n", i);
+                            pcd_log("check proof for message " + std::to_string(i));
                             const r1cs_primary_input<FieldT_B> translated_msg =
                                 get_mp_translation_step_pcd_circuit_input<curve_B_pp>(
                                     pk.commitment_to_translation_step_r1cs_vks, auxiliary_input.incoming_messages[i]);
@@ -580,14 +622,14 @@ namespace nil {
                                 translation_step_vks[i], translated_msg, padded_proofs[i]);
                             assert(bit);
                         } else {
-                            printf("message %zu is base case\n", i);
+                            pcd_log("message " + std::to_string(i) + " is base case");
                         }
 #endif
                     }
 
                     /* pad with dummy vks/membership proofs */
                     for (std::size_t i = arity; i < max_arity; ++i) {
-                        printf("proof %zu will be a dummy\n", arity);
+                        pcd_log("proof " + std::to_string(i) + " will be a dummy");
                         translation_step_vks.emplace_back(pk.translation_step_r1cs_vks[0]);
                         membership_proofs.emplace_back(pk.compliance_step_r1cs_vk_membership_proofs[0]);
                     }
@@ -622,7 +664,26 @@ namespace nil {
                     assert(compliance_step_ok);
 #endif
 
-                    std::cout << "Prove translation step" << std::endl;
+                    r1cs_mp_ppzkpcd_compliance_step_proof<PCD_ppT> result;
+                    result.compliance_predicate_idx = compliance_predicate_idx;
+                    result.r1cs_proof = compliance_step_proof;
+                    return result;
+                }
+
+                template<typename PCD_ppT>
+                r1cs_mp_ppzkpcd_proof<PCD_ppT> r1cs_mp_ppzkpcd_prove_translation_step(
+                    const r1cs_mp_ppzkpcd_proving_key<PCD_ppT> &pk,
+                    const r1cs_mp_ppzkpcd_primary_input<PCD_ppT> &primary_input,
+                    const r1cs_mp_ppzkpcd_compliance_step_proof<PCD_ppT> &compliance_step) {
+                    typedef typename PCD_ppT::curve_B_pp curve_B_pp;
+
+                    typedef typename curve_B_pp::scalar_field_type FieldT_B;
+
+                    const std::size_t compliance_predicate_idx = compliance_step.compliance_predicate_idx;
+                    const typename r1cs_ppzksnark<typename PCD_ppT::curve_A_pp>::proof_type &compliance_step_proof =
+                        compliance_step.r1cs_proof;
+
+                    pcd_log("Prove translation step");
                     mp_translation_step_pcd_circuit_maker<curve_B_pp> mp_translation_step_pcd_circuit(
                         pk.compliance_step_r1cs_vks[compliance_predicate_idx]);
 
@@ -659,7 +720,7 @@ namespace nil {
                                                      const r1cs_mp_ppzkpcd_proof<PCD_ppT> &proof) {
                     typedef typename PCD_ppT::curve_B_pp curve_B_pp;
 
-                    std::cout << "Call to r1cs_mp_ppzkpcd_online_verifier" << std::endl;
+                    pcd_log("Call to r1cs_mp_ppzkpcd_online_verifier");
                     const r1cs_primary_input<typename curve_B_pp::scalar_field_type> r1cs_input =
                         get_mp_translation_step_pcd_circuit_input<curve_B_pp>(
                             pvk.commitment_to_translation_step_r1cs_vks, primary_input);
@@ -675,7 +736,7 @@ namespace nil {
                     typedef typename PCD_ppT::curve_A_pp curve_A_pp;
                     typedef typename PCD_ppT::curve_B_pp curve_B_pp;
 
-                    std::cout << "Call to r1cs_mp_ppzkpcd_processed_verification_key" << std::endl;
+                    pcd_log("Call to r1cs_mp_ppzkpcd_processed_verification_key");
 
                     r1cs_mp_ppzkpcd_processed_verification_key<PCD_ppT> result;
                     result.commitment_to_translation_step_r1cs_vks = vk.commitment_to_translation_step_r1cs_vks;
@@ -699,7 +760,7 @@ namespace nil {
                 bool r1cs_mp_ppzkpcd_verifier(const r1cs_mp_ppzkpcd_verification_key<PCD_ppT> &vk,
                                               const r1cs_mp_ppzkpcd_primary_input<PCD_ppT> &primary_input,
                                               const r1cs_mp_ppzkpcd_proof<PCD_ppT> &proof) {
-                    std::cout << "Call to r1cs_mp_ppzkpcd_verifier" << std::endl;
+                    pcd_log("Call to r1cs_mp_ppzkpcd_verifier");
                     r1cs_mp_ppzkpcd_processed_verification_key<PCD_ppT> pvk = r1cs_mp_ppzkpcd_process_vk(vk);
                     const bool result = r1cs_mp_ppzkpcd_online_verifier(pvk, primary_input, proof);
 
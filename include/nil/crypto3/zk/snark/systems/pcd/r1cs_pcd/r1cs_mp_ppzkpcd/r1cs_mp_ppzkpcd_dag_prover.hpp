@@ -0,0 +1,258 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Prover for a whole DAG of messages of the (multi-predicate) ppzkPCD for R1CS.
+//
+// Proving a message takes a compliance step proof over curve A followed by a
+// translation step proof over curve B. The compliance step of a message needs the
+// finished proofs of its incoming messages, its translation step only its own
+// compliance step. The DAG prover runs both steps as separate tasks on a pool of
+// worker threads, so that independent messages are proven concurrently and the
+// translation step of one message overlaps the compliance steps of others.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_R1CS_MP_PPZKPCD_DAG_PROVER_HPP
+#define CRYPTO3_R1CS_MP_PPZKPCD_DAG_PROVER_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nil/crypto3/zk/snark/systems/pcd/r1cs_pcd/r1cs_mp_ppzkpcd/r1cs_mp_ppzkpcd.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+
+                /**
+                 * Proves all messages of a PCD DAG with r1cs_mp_ppzkpcd.
+                 *
+                 * Messages are given in any order; each one lists the indices of its incoming
+                 * messages in the order expected by its compliance predicate, with base_case_input
+                 * standing for a base case message which comes with a dummy proof. The result holds
+                 * the proof of every message at the index of the message, computed by the same
+                 * steps as r1cs_mp_ppzkpcd_prover on each message in a topological order.
+                 *
+                 * prove() throws std::invalid_argument if an incoming index is out of range or the
+                 * messages do not form a DAG; this is checked before any step is run.
+                 */
+                template<typename PCD_ppT>
+                class r1cs_mp_ppzkpcd_dag_prover {
+                public:
+                    typedef r1cs_mp_ppzkpcd_proving_key<PCD_ppT> proving_key_type;
+                    typedef r1cs_mp_ppzkpcd_proof<PCD_ppT> proof_type;
+                    typedef r1cs_mp_ppzkpcd_compliance_step_proof<PCD_ppT> compliance_step_proof_type;
+
+                    constexpr static const std::size_t base_case_input = std::numeric_limits<std::size_t>::max();
+
+                    struct node_type {
+                        std::size_t compliance_predicate_name;
+                        r1cs_mp_ppzkpcd_primary_input<PCD_ppT> primary_input;
+                        r1cs_mp_ppzkpcd_auxiliary_input<PCD_ppT> auxiliary_input;
+                        std::vector<std::size_t> incoming;
+                    };
+
+                    r1cs_mp_ppzkpcd_dag_prover(const proving_key_type &pk,
+                                               std::size_t workers = std::thread::hardware_concurrency()) :
+                        pk(pk),
+                        workers(std::max<std::size_t>(1, workers)) {
+                    }
+
+                    std::vector<proof_type> prove(const std::vector<node_type> &nodes) {
+                        run_state state(nodes);
+
+                        for (std::size_t i = 0; i < nodes.size(); ++i) {
+                            for (std::size_t parent : nodes[i].incoming) {
+                                if (parent == base_case_input) {
+                                    continue;
+                                }
+                                if (parent >= nodes.size()) {
+                                    throw std::invalid_argument("r1cs_mp_ppzkpcd_dag_prover: incoming message " +
+                                                                std::to_string(parent) + " of message " +
+                                                                std::to_string(i) + " does not exist");
+                                }
+                                state.children[parent].push_back(i);
+                                ++state.missing_inputs[i];
+                            }
+                        }
+                        check_acyclic(state);
+
+                        for (std::size_t i = 0; i < nodes.size(); ++i) {
+                            if (state.missing_inputs[i] == 0) {
+                                state.ready.push_back({i, stage::compliance});
+                            }
+                        }
+
+                        const std::size_t thread_count = std::min(workers, std::max<std::size_t>(1, nodes.size()));
+                        std::vector<std::thread> threads;
+                        threads.reserve(thread_count - 1);
+                        for (std::size_t i = 1; i < thread_count; ++i) {
+                            threads.emplace_back([this, &state]() { work(state); });
+                        }
+                        work(state);
+                        for (std::thread &t : threads) {
+                            t.join();
+                        }
+
+                        if (state.error) {
+                            std::rethrow_exception(state.error);
+                        }
+                        assert(state.finished == nodes.size());
+
+                        return std::move(state.proofs);
+                    }
+
+                private:
+                    enum class stage { compliance, translation };
+
+                    struct task_type {
+                        std::size_t node;
+                        stage step;
+                    };
+
+                    struct run_state {
+                        explicit run_state(const std::vector<node_type> &nodes) :
+                            nodes(nodes), children(nodes.size()), missing_inputs(nodes.size()),
+                            compliance_steps(nodes.size()), proofs(nodes.size()) {
+                        }
+
+                        const std::vector<node_type> &nodes;
+                        std::vector<std::vector<std::size_t>> children;
+                        std::vector<std::size_t> missing_inputs;
+                        std::vector<compliance_step_proof_type> compliance_steps;
+                        std::vector<proof_type> proofs;
+
+                        std::mutex mutex;
+                        std::condition_variable changed;
+                        std::deque<task_type> ready;
+                        std::size_t running = 0;
+                        std::size_t finished = 0;
+                        std::exception_ptr error;
+                    };
+
+                    static void check_acyclic(const run_state &state) {
+                        std::vector<std::size_t> missing_inputs = state.missing_inputs;
+                        std::vector<std::size_t> ready;
+                        for (std::size_t i = 0; i < missing_inputs.size(); ++i) {
+                            if (missing_inputs[i] == 0) {
+                                ready.push_back(i);
+                            }
+                        }
+
+                        std::size_t visited = 0;
+                        while (!ready.empty()) {
+                            const std::size_t node = ready.back();
+                            ready.pop_back();
+                            ++visited;
+                            for (std::size_t child : state.children[node]) {
+                                if (--missing_inputs[child] == 0) {
+                                    ready.push_back(child);
+                                }
+                            }
+                        }
+
+                        if (visited != missing_inputs.size()) {
+                            throw std::invalid_argument("r1cs_mp_ppzkpcd_dag_prover: the messages contain a cycle");
+                        }
+                    }
+
+                    void work(run_state &state) const {
+                        std::unique_lock<std::mutex> lock(state.mutex);
+                        while (true) {
+                            state.changed.wait(lock, [&state]() {
+                                return !state.ready.empty() || state.running == 0 || state.error;
+                            });
+                            if (state.ready.empty() || state.error) {
+                                // either everything is done, an error occurred, or the remaining
+                                // nodes wait on each other
+                                state.changed.notify_all();
+                                return;
+                            }
+
+                            const task_type task = state.ready.front();
+                            state.ready.pop_front();
+                            ++state.running;
+                            lock.unlock();
+
+                            std::exception_ptr error;
+                            try {
+                                run(state, task);
+                            } catch (...) {
+                                error = std::current_exception();
+                            }
+
+                            lock.lock();
+                            --state.running;
+                            if (error) {
+                                if (!state.error) {
+                                    state.error = error;
+                                }
+                            } else if (task.step == stage::compliance) {
+                                // translation steps unblock other messages, so they go first
+                                state.ready.push_front({task.node, stage::translation});
+                            } else {
+                                ++state.finished;
+                                for (std::size_t child : state.children[task.node]) {
+                                    if (--state.missing_inputs[child] == 0) {
+                                        state.ready.push_back({child, stage::compliance});
+                                    }
+                                }
+                            }
+                            state.changed.notify_all();
+                        }
+                    }
+
+                    void run(run_state &state, const task_type &task) const {
+                        const node_type &node = state.nodes[task.node];
+                        if (task.step == stage::compliance) {
+                            std::vector<proof_type> incoming_proofs;
+                            incoming_proofs.reserve(node.incoming.size());
+                            for (std::size_t parent : node.incoming) {
+                                incoming_proofs.push_back(parent == base_case_input ? proof_type() :
+                                                                                      state.proofs[parent]);
+                            }
+                            state.compliance_steps[task.node] = r1cs_mp_ppzkpcd_prove_compliance_step<PCD_ppT>(
+                                pk, node.compliance_predicate_name, node.primary_input, node.auxiliary_input,
+                                incoming_proofs);
+                        } else {
+                            state.proofs[task.node] = r1cs_mp_ppzkpcd_prove_translation_step<PCD_ppT>(
+                                pk, node.primary_input, state.compliance_steps[task.node]);
+                        }
+                    }
+
+                    const proving_key_type &pk;
+                    std::size_t workers;
+                };
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_R1CS_MP_PPZKPCD_DAG_PROVER_HPP
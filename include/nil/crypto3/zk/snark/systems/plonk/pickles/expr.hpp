@@ -5,14 +5,16 @@
 #include <nil/crypto3/zk/snark/systems/plonk/pickles/detail.hpp>
 #include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 namespace nil {
     namespace crypto3 {
         namespace zk {
             namespace snark {
                 template <typename FieldType>
-                typename FieldType::value_type unnormalized_lagrange_basis(math::basic_radix2_domain<FieldType> domain, int i, 
+                typename FieldType::value_type unnormalized_lagrange_basis(math::basic_radix2_domain<FieldType> &domain, int i, 
                                                                     typename FieldType::value_type pt){
                     typename FieldType::value_type omega_i = i < 0 ? domain.omega.pow(-i).inversed() : domain.omega.pow(i);
 
@@ -73,8 +75,8 @@ namespace nil {
                 };
 
                 template<typename FieldType>
-                typename FieldType::value_type variable_evaluate(Variable& var, std::vector<proof_evaluation_type<typename FieldType::value_type>> &evals){
-                    proof_evaluation_type<typename FieldType::value_type> temp_eval = evals[var.row];
+                typename FieldType::value_type variable_evaluate(const Variable& var, const std::vector<proof_evaluation_type<typename FieldType::value_type>> &evals){
+                    const proof_evaluation_type<typename FieldType::value_type> &temp_eval = evals[var.row];
 
                     if(var.col.column == column_type::Witness){
                         return temp_eval.w[var.col.witness_value];
@@ -232,6 +234,308 @@ namespace nil {
                         return stack.front();
                     }
                 };
+
+                /// Register program compiled once from a PolishToken stream.
+                ///
+                /// Every stack slot of the token stream is mapped to a fixed register,
+                /// leaves (challenges, Mds entries, literals, cells, vanishing and Lagrange
+                /// basis values) are assigned input registers which are filled once per
+                /// evaluation, and Store/Load become copies from/to cache registers.
+                /// Evaluation then runs the straight-line instruction list without
+                /// touching the token stream or allocating.
+                template<typename FieldType>
+                class PolishProgram {
+                    typedef typename FieldType::value_type value_type;
+
+                    enum opcode { Copy, Add, Sub, Mul, Pow };
+
+                    struct instruction {
+                        opcode op;
+                        std::size_t dst;
+                        std::size_t lhs;
+                        std::size_t rhs;
+                        std::size_t pow;
+                    };
+
+                    // Input registers: alpha, beta, gamma, joint_combiner, endo_coefficient,
+                    // mds[3][3] and the vanishing polynomial of the last 4 rows come first.
+                    constexpr static const std::size_t mds_register = 5;
+                    constexpr static const std::size_t vanishing_register = mds_register + 9;
+                    constexpr static const std::size_t fixed_registers = vanishing_register + 1;
+
+                public:
+                    PolishProgram() = default;
+
+                    explicit PolishProgram(const std::vector<PolishToken<FieldType>> &toks) {
+                        // Cells and Lagrange basis values are deduplicated, literals keep their own register
+                        std::vector<std::pair<std::size_t, std::size_t>> cell_refs;    // (token, position in cells)
+                        std::vector<std::pair<std::size_t, std::size_t>> literal_refs;
+                        std::vector<std::pair<std::size_t, std::size_t>> lagrange_refs;
+
+                        for (std::size_t i = 0; i < toks.size(); ++i) {
+                            const PolishToken<FieldType> &t = toks[i];
+                            if (t.token == token_type::Cell) {
+                                std::size_t j = 0;
+                                while (j < cells.size() && !same_variable(cells[j], t.cell_value)) {
+                                    ++j;
+                                }
+                                if (j == cells.size()) {
+                                    cells.push_back(t.cell_value);
+                                }
+                                cell_refs.emplace_back(i, j);
+                            } else if (t.token == token_type::Literal) {
+                                literal_refs.emplace_back(i, literals.size());
+                                literals.push_back(t.literal_value);
+                            } else if (t.token == token_type::UnnormalizedLagrangeBasis) {
+                                std::size_t j = std::find(lagrange_indices.begin(), lagrange_indices.end(),
+                                                          t.unnormalized_lagrange_basis_value) -
+                                                lagrange_indices.begin();
+                                if (j == lagrange_indices.size()) {
+                                    lagrange_indices.push_back(t.unnormalized_lagrange_basis_value);
+                                }
+                                lagrange_refs.emplace_back(i, j);
+                            } else if (t.token == token_type::VanishesOnLast4Rows) {
+                                uses_vanishing = true;
+                            }
+                        }
+
+                        lagrange_base = fixed_registers;
+                        cell_base = lagrange_base + lagrange_indices.size();
+                        literal_base = cell_base + cells.size();
+                        const std::size_t stack_base = literal_base + literals.size();
+
+                        // Stack simulation: every stack entry holds the register of its value
+                        std::vector<std::size_t> stack;
+                        std::size_t cache_size = 0;
+                        std::size_t max_depth = 0;
+                        auto cell_it = cell_refs.begin();
+                        auto literal_it = literal_refs.begin();
+                        auto lagrange_it = lagrange_refs.begin();
+
+                        for (std::size_t i = 0; i < toks.size(); ++i) {
+                            const PolishToken<FieldType> &t = toks[i];
+                            switch (t.token) {
+                                case token_type::Alpha:
+                                    stack.push_back(0);
+                                    break;
+                                case token_type::Beta:
+                                    stack.push_back(1);
+                                    break;
+                                case token_type::Gamma:
+                                    stack.push_back(2);
+                                    break;
+                                case token_type::JointCombiner:
+                                    stack.push_back(3);
+                                    break;
+                                case token_type::EndoCoefficient:
+                                    stack.push_back(4);
+                                    break;
+                                case token_type::Mds:
+                                    stack.push_back(mds_register + 3 * t.mds_value.first + t.mds_value.second);
+                                    break;
+                                case token_type::VanishesOnLast4Rows:
+                                    stack.push_back(vanishing_register);
+                                    break;
+                                case token_type::UnnormalizedLagrangeBasis:
+                                    stack.push_back(lagrange_base + (lagrange_it++)->second);
+                                    break;
+                                case token_type::Literal:
+                                    stack.push_back(literal_base + (literal_it++)->second);
+                                    break;
+                                case token_type::Cell:
+                                    stack.push_back(cell_base + (cell_it++)->second);
+                                    break;
+                                case token_type::Dup:
+                                    assert(!stack.empty());
+                                    stack.push_back(stack.back());
+                                    break;
+                                case token_type::Pow:
+                                    assert(!stack.empty());
+                                    program.push_back({opcode::Pow, stack_base + stack.size() - 1, stack.back(), 0,
+                                                       t.pow_value});
+                                    stack.back() = stack_base + stack.size() - 1;
+                                    break;
+                                case token_type::Add:
+                                case token_type::Mul:
+                                case token_type::Sub: {
+                                    assert(stack.size() > 1);
+                                    std::size_t y = stack.back();
+                                    stack.pop_back();
+                                    std::size_t x = stack.back();
+                                    opcode op = t.token == token_type::Add ?
+                                                    opcode::Add :
+                                                    (t.token == token_type::Mul ? opcode::Mul : opcode::Sub);
+                                    program.push_back({op, stack_base + stack.size() - 1, x, y, 0});
+                                    stack.back() = stack_base + stack.size() - 1;
+                                    break;
+                                }
+                                case token_type::Store:
+                                    assert(!stack.empty());
+                                    // The cache register index is only known once the stack depth is, see below
+                                    program.push_back({opcode::Copy, cache_size++, stack.back(), 0, 0});
+                                    cache_copies.push_back(program.size() - 1);
+                                    break;
+                                case token_type::Load:
+                                    assert(t.load_value < cache_size);
+                                    stack.push_back(cache_marker + t.load_value);
+                                    break;
+                            }
+                            max_depth = std::max(max_depth, stack.size());
+                        }
+
+                        assert(stack.size() == 1);
+                        result_register = stack.front();
+
+                        // Cache registers follow the stack registers
+                        const std::size_t cache_base = stack_base + max_depth;
+                        for (std::size_t i : cache_copies) {
+                            program[i].dst += cache_base;
+                        }
+                        for (instruction &instr : program) {
+                            relocate(instr.lhs, cache_base);
+                            relocate(instr.rhs, cache_base);
+                        }
+                        relocate(result_register, cache_base);
+                        registers_count = cache_base + cache_size;
+                    }
+
+                    std::size_t registers_size() const {
+                        return registers_count;
+                    }
+
+                    /// Evaluates the program. registers must hold at least registers_size() elements,
+                    /// it is used as scratch space and can be reused between calls.
+                    value_type evaluate(math::basic_radix2_domain<FieldType> &domain,
+                                        value_type pt,
+                                        const std::vector<proof_evaluation_type<value_type>> &evals,
+                                        const Constants<FieldType> &c,
+                                        std::vector<value_type> &registers) const {
+                        assert(registers.size() >= registers_count);
+
+                        registers[0] = c.alpha;
+                        registers[1] = c.beta;
+                        registers[2] = c.gamma;
+                        registers[3] = c.joint_combiner;
+                        registers[4] = c.endo_coefficient;
+                        for (std::size_t i = 0; i < 3; ++i) {
+                            for (std::size_t j = 0; j < 3; ++j) {
+                                registers[mds_register + 3 * i + j] = c.mds[i][j];
+                            }
+                        }
+                        if (uses_vanishing) {
+                            registers[vanishing_register] = eval_vanishes_on_last_4_rows(domain, pt);
+                        }
+                        for (std::size_t i = 0; i < lagrange_indices.size(); ++i) {
+                            registers[lagrange_base + i] =
+                                unnormalized_lagrange_basis<FieldType>(domain, lagrange_indices[i], pt);
+                        }
+                        for (std::size_t i = 0; i < cells.size(); ++i) {
+                            registers[cell_base + i] = variable_evaluate<FieldType>(cells[i], evals);
+                        }
+                        std::copy(literals.begin(), literals.end(), registers.begin() + literal_base);
+
+                        for (const instruction &instr : program) {
+                            switch (instr.op) {
+                                case opcode::Copy:
+                                    registers[instr.dst] = registers[instr.lhs];
+                                    break;
+                                case opcode::Add:
+                                    registers[instr.dst] = registers[instr.lhs] + registers[instr.rhs];
+                                    break;
+                                case opcode::Sub:
+                                    registers[instr.dst] = registers[instr.lhs] - registers[instr.rhs];
+                                    break;
+                                case opcode::Mul:
+                                    registers[instr.dst] = registers[instr.lhs] * registers[instr.rhs];
+                                    break;
+                                case opcode::Pow:
+                                    registers[instr.dst] = registers[instr.lhs].pow(instr.pow);
+                                    break;
+                            }
+                        }
+
+                        return registers[result_register];
+                    }
+
+                    value_type evaluate(math::basic_radix2_domain<FieldType> &domain,
+                                        value_type pt,
+                                        const std::vector<proof_evaluation_type<value_type>> &evals,
+                                        const Constants<FieldType> &c) const {
+                        std::vector<value_type> registers(registers_count);
+                        return evaluate(domain, pt, evals, c, registers);
+                    }
+
+                    /// Evaluates the program for several proofs sharing the domain, reusing one register file.
+                    std::vector<value_type>
+                        evaluate(math::basic_radix2_domain<FieldType> &domain,
+                                 const std::vector<value_type> &pts,
+                                 const std::vector<std::vector<proof_evaluation_type<value_type>>> &evals,
+                                 const std::vector<Constants<FieldType>> &c) const {
+                        assert(pts.size() == evals.size() && pts.size() == c.size());
+
+                        std::vector<value_type> registers(registers_count);
+                        std::vector<value_type> res;
+                        res.reserve(pts.size());
+                        for (std::size_t i = 0; i < pts.size(); ++i) {
+                            res.push_back(evaluate(domain, pts[i], evals[i], c[i], registers));
+                        }
+                        return res;
+                    }
+
+                private:
+                    // Registers of cached values are tagged until the cache base is known
+                    constexpr static const std::size_t cache_marker = std::size_t(1) << (8 * sizeof(std::size_t) - 1);
+
+                    static void relocate(std::size_t &reg, std::size_t cache_base) {
+                        if (reg >= cache_marker) {
+                            reg = cache_base + (reg - cache_marker);
+                        }
+                    }
+
+                    static bool same_variable(const Variable &a, const Variable &b) {
+                        if (a.row != b.row || a.col.column != b.col.column) {
+                            return false;
+                        }
+                        switch (a.col.column) {
+                            case column_type::Witness:
+                                return a.col.witness_value == b.col.witness_value;
+                            case column_type::LookupSorted:
+                                return a.col.lookup_sorted_value == b.col.lookup_sorted_value;
+                            case column_type::Index:
+                                return a.col.index_value == b.col.index_value;
+                            case column_type::Coefficient:
+                                return a.col.coefficient_value == b.col.coefficient_value;
+                            case column_type::LookupKindIndex:
+                                return a.col.lookup_kind_index_value == b.col.lookup_kind_index_value;
+                            default:
+                                return true;
+                        }
+                    }
+
+                    std::vector<instruction> program;
+                    std::vector<std::size_t> cache_copies;
+                    std::vector<Variable> cells;
+                    std::vector<value_type> literals;
+                    std::vector<int> lagrange_indices;
+                    bool uses_vanishing = false;
+
+                    std::size_t lagrange_base = fixed_registers;
+                    std::size_t cell_base = fixed_registers;
+                    std::size_t literal_base = fixed_registers;
+                    std::size_t result_register = 0;
+                    std::size_t registers_count = fixed_registers;
+                };
+
+                template<typename FieldType>
+                Linearization<PolishProgram<FieldType>>
+                    compile_linearization(const Linearization<std::vector<PolishToken<FieldType>>> &linearization) {
+                    Linearization<PolishProgram<FieldType>> res;
+                    res.constant_term = PolishProgram<FieldType>(linearization.constant_term);
+                    for (const auto &term : linearization.index_term) {
+                        res.index_term.emplace_back(std::get<0>(term), PolishProgram<FieldType>(std::get<1>(term)));
+                    }
+                    return res;
+                }
             }    // namespace snark
         }        // namespace zk
     }            // namespace crypto3
@@ -139,7 +139,7 @@ namespace nil {
                 /// This function runs the random oracle argument
                 template<typename CurveType, typename EFqSponge, typename EFrSponge, typename VerifierIndexType = verifier_index<CurveType>>
                 OraclesResult<CurveType, EFqSponge> oracles(proof_type<CurveType> proof,
-                            VerifierIndexType index,
+                            VerifierIndexType &index,
                             typename commitments::kimchi_pedersen<CurveType>::commitment_type p_comm) {
                     typedef commitments::kimchi_pedersen<CurveType> commitment_scheme;
                     typedef typename commitment_scheme::commitment_type commitment_type;
@@ -395,7 +395,7 @@ namespace nil {
                     Constants<scalar_field_type> cs{alpha, beta, gamma, std::get<1>(joint_combiner), index.endo, index.fr_sponge_params.mds};
 
                     ft_eval0 -=
-                        PolishToken<scalar_field_type>::evaluate(index.linearization.constant_term, index.domain, zeta, evals, cs);
+                        index.compiled_linearization().constant_term.evaluate(index.domain, zeta, evals, cs);
 
 
                     std::vector<std::tuple<evaluation_type, int>> es;
@@ -40,6 +40,7 @@
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 
+#include <algorithm>
 #include <vector>
 #include <tuple>
 
@@ -65,7 +66,43 @@ namespace nil {
                     constexpr static const std::size_t COLUMNS = kimchi_constant::COLUMNS;
                     constexpr static const std::size_t PERMUTES = kimchi_constant::PERMUTES;
 
-                    static batchproof_type to_batch(VerifierIndexType index, proof_type<CurveType> proof) {
+                    // Commitment to the negated public input polynomial, computed with one MSM per chunk over the
+                    // Lagrange basis of the domain. The basis is taken from (or added to) index.srs.
+                    static commitment_type
+                        public_comm(VerifierIndexType &index,
+                                    const std::vector<typename scalar_field_type::value_type> &public_input) {
+                        if (public_input.empty()) {
+                            return commitment_type();
+                        }
+
+                        const std::vector<typename group_type::value_type> &lgr_comm =
+                            index.srs.lagrange_basis(index.domain);
+                        const std::size_t n = index.domain.size();
+                        const std::size_t chunks = lgr_comm.size() / n;
+                        BOOST_ASSERT_MSG(public_input.size() <= n, "public input is larger than the domain");
+
+                        std::vector<typename scalar_field_type::value_type> elm;
+                        for (auto &i : public_input) {
+                            elm.push_back(-i);
+                        }
+
+                        commitment_type res;
+                        res.shifted = group_type::value_type::zero();
+                        std::vector<typename group_type::value_type> bases(public_input.size());
+                        for (std::size_t j = 0; j < chunks; ++j) {
+                            for (std::size_t i = 0; i < public_input.size(); ++i) {
+                                bases[i] = lgr_comm[i * chunks + j];
+                            }
+                            res.unshifted.push_back(
+                                algebra::multiexp_with_mixed_addition<typename commitment_scheme::multiexp_method>(
+                                    bases.begin(), bases.end(), elm.begin(), elm.end(),
+                                    commitment_scheme::multiexp_chunks()));
+                        }
+
+                        return res;
+                    }
+
+                    static batchproof_type to_batch(VerifierIndexType &index, proof_type<CurveType> proof) {
                         //~
                         //~ #### Partial verification
                         //~
@@ -75,23 +112,7 @@ namespace nil {
                         //~
 
                         //~ 1. Commit to the negated public input polynomial.
-                        BOOST_ASSERT_MSG(index.srs.lagrange_bases.find(index.domain.size()) != index.srs.lagrange_bases.end(), "pre-computed committed lagrange bases not found");
-                        std::vector<typename group_type::value_type> lgr_comm = index.srs.lagrange_bases[index.domain.size()];    // calculate lgr_comm
-                        BOOST_ASSERT(lgr_comm.size() == 512);                          // ??
-                        std::vector<commitment_type> com;
-
-                        for (size_t i = 0; i < proof.public_input.size(); ++i) {
-                            std::vector<typename group_type::value_type> unshifted = {lgr_comm[i]};
-                            typename group_type::value_type shifted;
-                            com.push_back(commitment_type(unshifted, shifted));
-                        }
-                        // std::vector<commitment_scheme> *com_ref = &com;
-                        std::vector<typename scalar_field_type::value_type> elm;
-                        for (auto &i : proof.public_input) {
-                            elm.push_back(-i);
-                        }
-
-                        commitment_type p_comm = commitment_type::multi_scalar_mul(com, elm);
+                        commitment_type p_comm = public_comm(index, proof.public_input);
 
                         //~ 2. Run the [Fiat-Shamir argument](#fiat-shamir-argument).
                         OraclesResult<CurveType, EFqSponge> oracles_res = oracles<CurveType, EFqSponge, EFrSponge, VerifierIndexType>(proof, index, p_comm);
@@ -152,13 +173,19 @@ namespace nil {
                                                 index.fr_sponge_params.mds
                                             };
 
-                            for (auto i : index.linearization.index_term) {
-                                auto col = std::get<0>(i);
-                                auto tokens = std::get<1>(i);
+                            const Linearization<PolishProgram<scalar_field_type>> &linearization =
+                                index.compiled_linearization();
+                            const auto &l = proof.commitments.lookup;
+                            // One register file is shared by all index terms
+                            std::vector<typename scalar_field_type::value_type> registers;
+
+                            for (const auto &i : linearization.index_term) {
+                                const Column &col = std::get<0>(i);
+                                const PolishProgram<scalar_field_type> &program = std::get<1>(i);
 
+                                registers.resize(std::max(registers.size(), program.registers_size()));
                                 auto scalar =
-                                    PolishToken<scalar_field_type>::evaluate(tokens, index.domain, oracles_res.oracles.zeta, evals, constants);
-                                auto l = proof.commitments.lookup;
+                                    program.evaluate(index.domain, oracles_res.oracles.zeta, evals, constants, registers);
                                 if (col.column == column_type::Witness) {
                                     scalars.push_back(scalar);
                                     commitments.push_back(proof.commitments.w_comm[col.witness_value]);
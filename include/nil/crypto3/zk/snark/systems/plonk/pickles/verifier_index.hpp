@@ -92,14 +92,30 @@ namespace nil {
 
                     lookup_verifier_index<CurveType> lookup_index;
                     bool lookup_index_is_used;
-                    Linearization<std::vector<PolishToken<scalar_field_type>>> linearization;
-                    //                    linearization;    // TODO:
-                    //                    Linearization<Vec<PolishToken<scalar_field_value_type<G>>>>
                     Alphas<scalar_field_type> powers_of_alpha;
                     PoseidonKimchiScalarConstants   fr_sponge_params;
                     PoseidonKimchiBaseConstants   fq_sponge_params;
 
                     verifier_index() : domain(2) {}
+
+                    // Sets the linearization token streams and compiles them into register programs, so
+                    // that verifiers sharing the index only read it
+                    void set_linearization(const Linearization<std::vector<PolishToken<scalar_field_type>>> &value) {
+                        linearization_tokens = value;
+                        linearization_program = compile_linearization<scalar_field_type>(value);
+                    }
+
+                    const Linearization<std::vector<PolishToken<scalar_field_type>>> &linearization() const {
+                        return linearization_tokens;
+                    }
+
+                    const Linearization<PolishProgram<scalar_field_type>> &compiled_linearization() const {
+                        return linearization_program;
+                    }
+
+                private:
+                    Linearization<std::vector<PolishToken<scalar_field_type>>> linearization_tokens;
+                    Linearization<PolishProgram<scalar_field_type>> linearization_program;
                 };
             }    // namespace snark
         }        // namespace zk
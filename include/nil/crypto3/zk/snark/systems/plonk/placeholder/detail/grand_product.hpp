@@ -0,0 +1,130 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_GRAND_PRODUCT_HPP
+#define CRYPTO3_ZK_PLONK_PLACEHOLDER_GRAND_PRODUCT_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace detail {
+                    /// Running product shared by the permutation and lookup arguments:
+                    /// V[0] = 1, V[j] = V[j - 1] * numerators[j - 1] / denominators[j - 1].
+                    ///
+                    /// Rows are split into chunks. Each chunk inverts its denominators with one field
+                    /// inversion (Montgomery's trick) and computes local prefix products; the chunk
+                    /// offsets are then chained and applied, so all passes over the rows run in parallel.
+                    template<typename FieldType>
+                    math::polynomial_dfs<typename FieldType::value_type>
+                        grand_product(const std::vector<typename FieldType::value_type> &numerators,
+                                      const std::vector<typename FieldType::value_type> &denominators) {
+                        typedef typename FieldType::value_type value_type;
+
+                        BOOST_ASSERT(numerators.size() == denominators.size());
+                        BOOST_ASSERT(numerators.size() > 0);
+
+                        const std::size_t size = numerators.size();
+                        math::polynomial_dfs<value_type> V(size - 1, size);
+
+                        // ratio[j] = numerators[j] / denominators[j] for j < size - 1, the last row is not used
+                        const std::size_t steps = size - 1;
+#ifdef MULTICORE
+                        const std::size_t chunks =
+                            std::max<std::size_t>(1, std::min<std::size_t>(omp_get_max_threads(), steps));
+#else
+                        const std::size_t chunks = 1;
+#endif
+                        const std::size_t chunk_size = steps == 0 ? 1 : (steps + chunks - 1) / chunks;
+                        std::vector<value_type> chunk_products(chunks, value_type::one());
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 0; c < chunks; ++c) {
+                            const std::size_t begin = c * chunk_size;
+                            const std::size_t end = std::min(steps, begin + chunk_size);
+                            if (begin >= end) {
+                                continue;
+                            }
+
+                            // V[j + 1] temporarily holds the prefix product of the denominators in the chunk
+                            value_type acc = value_type::one();
+                            for (std::size_t j = begin; j < end; ++j) {
+                                acc *= denominators[j];
+                                V[j + 1] = acc;
+                            }
+                            value_type inv = acc.inversed();
+                            for (std::size_t j = end - 1; j > begin; --j) {
+                                value_type den_inv = inv * V[j];
+                                inv *= denominators[j];
+                                V[j + 1] = numerators[j] * den_inv;
+                            }
+                            V[begin + 1] = numerators[begin] * inv;
+
+                            // Local prefix products of the ratios
+                            for (std::size_t j = begin + 1; j < end; ++j) {
+                                V[j + 1] *= V[j];
+                            }
+                            chunk_products[c] = V[end];
+                        }
+
+                        // Offsets of the chunks are the products of all preceding chunks
+                        value_type offset = value_type::one();
+                        for (std::size_t c = 0; c < chunks; ++c) {
+                            value_type chunk_product = chunk_products[c];
+                            chunk_products[c] = offset;
+                            offset *= chunk_product;
+                        }
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 1; c < chunks; ++c) {
+                            const std::size_t begin = c * chunk_size;
+                            const std::size_t end = std::min(steps, begin + chunk_size);
+                            for (std::size_t j = begin; j < end; ++j) {
+                                V[j + 1] *= chunk_products[c];
+                            }
+                        }
+
+                        V[0] = value_type::one();
+                        return V;
+                    }
+                }    // namespace detail
+            }        // namespace snark
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_PLONK_PLACEHOLDER_GRAND_PRODUCT_HPP
@@ -28,9 +28,12 @@
 #ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_GATES_ARGUMENT_HPP
 #define CRYPTO3_ZK_PLONK_PLACEHOLDER_GATES_ARGUMENT_HPP
 
+#include <algorithm>
 #include <unordered_map>
 #include <iostream>
 
+#include <boost/assert.hpp>
+
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/shift.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
@@ -40,6 +43,7 @@
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 
+#include <nil/crypto3/zk/detail/buffer_pool.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/gate.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint_system.hpp>
@@ -66,17 +70,41 @@ namespace nil {
                     using polynomial_dfs_type = math::polynomial_dfs<typename FieldType::value_type>;
                     using variable_type = plonk_variable<typename FieldType::value_type>;
                     using polynomial_dfs_variable_type = plonk_variable<polynomial_dfs_type>;
+                    typedef zk::detail::buffer_pool<typename FieldType::value_type, polynomial_dfs_type>
+                        polynomial_pool_type;
 
                     typedef detail::placeholder_policy<FieldType, ParamsType> policy_type;
 
                     constexpr static const std::size_t argument_size = 1;
 
+                    // Index of the smallest power of two which is not less than degree
+                    static inline std::size_t degree_bucket(std::size_t degree) {
+                        std::size_t bucket = 0;
+                        while ((std::size_t(1) << bucket) < degree) {
+                            ++bucket;
+                        }
+                        return bucket;
+                    }
+
                     static inline void build_variable_value_map(
                         const math::expression<polynomial_dfs_variable_type>& expr,
                         const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params> &assignments,
                         std::shared_ptr<math::evaluation_domain<FieldType>> domain,
                         std::size_t extended_domain_size,
                         std::unordered_map<polynomial_dfs_variable_type, polynomial_dfs_type>& variable_values_out) {
+                        polynomial_pool_type buffers;
+                        build_variable_value_map(expr, assignments, domain, extended_domain_size, variable_values_out,
+                                                 buffers);
+                    }
+
+                    /// Same as above with the unshifted column copies drawn from the buffer pool.
+                    static inline void build_variable_value_map(
+                        const math::expression<polynomial_dfs_variable_type>& expr,
+                        const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params> &assignments,
+                        std::shared_ptr<math::evaluation_domain<FieldType>> domain,
+                        std::size_t extended_domain_size,
+                        std::unordered_map<polynomial_dfs_variable_type, polynomial_dfs_type>& variable_values_out,
+                        polynomial_pool_type &buffers) {
 
                         std::unordered_map<polynomial_dfs_variable_type, size_t> variable_counts;
 
@@ -90,29 +118,30 @@ namespace nil {
                             // We may have variable values in required sizes in some cases.
                             if (variable_values_out.find(var) != variable_values_out.end())
                                 continue;
-                            polynomial_dfs_type assignment;
+                            const polynomial_dfs_type *column = nullptr;
                             switch (var.type) {
                                 case polynomial_dfs_variable_type::column_type::witness:
-                                    assignment = assignments.witness(var.index);
+                                    column = &assignments.witness(var.index);
                                     break;
                                 case polynomial_dfs_variable_type::column_type::public_input:
-                                    assignment = assignments.public_input(var.index);
+                                    column = &assignments.public_input(var.index);
                                     break;
                                 case polynomial_dfs_variable_type::column_type::constant:
-                                    assignment = assignments.constant(var.index);
+                                    column = &assignments.constant(var.index);
                                     break;
                                 case polynomial_dfs_variable_type::column_type::selector:
-                                    assignment = assignments.selector(var.index);
+                                    column = &assignments.selector(var.index);
                                     break;
                             }
+                            BOOST_ASSERT(column != nullptr);
 
-                            if (var.rotation != 0) {
-                                assignment = math::polynomial_shift(assignment, var.rotation, domain->m);
-                            }
+                            polynomial_dfs_type assignment = var.rotation != 0 ?
+                                math::polynomial_shift(*column, var.rotation, domain->m) :
+                                buffers.acquire_like(*column);
                             if (count > 1) {
                                 assignment.resize(extended_domain_size);
                             }
-                            variable_values_out[var] = assignment;
+                            variable_values_out[var] = std::move(assignment);
                         }
                     }
 
@@ -124,6 +153,22 @@ namespace nil {
                             std::shared_ptr<math::evaluation_domain<FieldType>> original_domain,
                             std::uint32_t max_gates_degree,
                             transcript_type& transcript) {
+                        polynomial_pool_type buffers;
+                        return prove_eval(constraint_system, column_polynomials, original_domain, max_gates_degree,
+                                          transcript, buffers);
+                    }
+
+                    /// Same as above with the column values of every degree bucket drawn from the prover's
+                    /// buffer pool and returned to it once the bucket is evaluated.
+                    static inline std::array<polynomial_dfs_type, argument_size>
+                        prove_eval(
+                            const typename policy_type::constraint_system_type &constraint_system,
+                            const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>
+                                &column_polynomials,
+                            std::shared_ptr<math::evaluation_domain<FieldType>> original_domain,
+                            std::uint32_t max_gates_degree,
+                            transcript_type& transcript,
+                            polynomial_pool_type &buffers) {
                         PROFILE_PLACEHOLDER_SCOPE("gate_argument_time");
 
                         // max_gates_degree that comes from the outside does not take into account multiplication
@@ -136,17 +181,14 @@ namespace nil {
                                 return polynomial_dfs_type(0, 1, coeff);
                             };
 
-                        std::vector<std::uint32_t> extended_domain_sizes;
-                        std::vector<std::uint32_t> degree_limits;
-                        std::uint32_t max_degree = std::pow(2, ceil(std::log2(max_gates_degree)));
-                        std::uint32_t max_domain_size = original_domain->m * max_degree;
+                        // Constraints are bucketed by the smallest power of two bounding their degree.
+                        // Bucket i is evaluated on the extended domain of size m * 2^i, so low-degree
+                        // gates do not pay for the highest-degree one.
+                        const std::size_t buckets = degree_bucket(max_gates_degree) + 1;
+                        const std::size_t max_domain_size = original_domain->m << (buckets - 1);
 
-                        degree_limits.push_back(max_degree);
-                        extended_domain_sizes.push_back(max_domain_size);
-                        degree_limits.push_back(max_degree / 2);
-                        extended_domain_sizes.push_back(max_domain_size / 2);
-
-                        std::vector<math::expression<polynomial_dfs_variable_type>> expressions(extended_domain_sizes.size()); 
+                        std::vector<math::expression<polynomial_dfs_variable_type>> expressions(buckets);
+                        std::vector<bool> bucket_used(buckets, false);
 
                         auto theta_acc = FieldType::value_type::one();
 
@@ -161,48 +203,62 @@ namespace nil {
                         const auto& gates = constraint_system.gates();
 
                         for (const auto& gate: gates) {
-                            std::vector<math::expression<polynomial_dfs_variable_type>> gate_results(extended_domain_sizes.size()); 
+                            std::vector<math::expression<polynomial_dfs_variable_type>> gate_results(buckets);
+                            std::vector<bool> gate_bucket_used(buckets, false);
 
                             for (const auto& constraint : gate.constraints) {
                                 auto next_term = converter.convert(constraint) * value_type_to_polynomial_dfs(theta_acc);
 
                                 theta_acc *= theta;
                                 // +1 stands for the selector multiplication.
-                                size_t constraint_degree = visitor.compute_max_degree(constraint) + 1;
-                                for (int i = extended_domain_sizes.size() - 1; i >= 0; --i) {
-                                    // Whatever the degree of term is, add it to the maximal degree expression.
-                                    if (degree_limits[i] >= constraint_degree || i == 0) {
-                                        gate_results[i] += next_term;
-                                        break;
-                                    }
-                                }
+                                std::size_t bucket = std::min(
+                                    degree_bucket(visitor.compute_max_degree(constraint) + 1), buckets - 1);
+                                gate_results[bucket] += next_term;
+                                gate_bucket_used[bucket] = true;
                             }
 
                             auto selector = polynomial_dfs_variable_type(
                                 gate.selector_index, 0, false, polynomial_dfs_variable_type::column_type::selector);
 
-                            for (size_t i = 0; i < extended_domain_sizes.size(); ++i) {
+                            for (std::size_t i = 0; i < buckets; ++i) {
+                                if (!gate_bucket_used[i]) {
+                                    continue;
+                                }
                                 gate_results[i] *= selector;
                                 expressions[i] += gate_results[i];
+                                bucket_used[i] = true;
                             }
                         }
 
-                        std::unordered_map<polynomial_dfs_variable_type, polynomial_dfs_type> variable_values;
                         std::array<polynomial_dfs_type, argument_size> F;
+                        F[0] = polynomial_dfs_type(0, original_domain->m, FieldType::value_type::zero());
 
-                        for (size_t i = 0; i < extended_domain_sizes.size(); ++i) {
-                            if (i != 0 && extended_domain_sizes[i] != extended_domain_sizes[i-1]) {
-                                variable_values.clear();
+                        for (std::size_t i = 0; i < buckets; ++i) {
+                            if (!bucket_used[i]) {
+                                continue;
                             }
+                            const std::size_t extended_domain_size = original_domain->m << i;
+
+                            // Column values are cached per bucket, their sizes differ between buckets
+                            std::unordered_map<polynomial_dfs_variable_type, polynomial_dfs_type> variable_values;
                             build_variable_value_map(expressions[i], column_polynomials, original_domain,
-                                extended_domain_sizes[i], variable_values);
+                                extended_domain_size, variable_values, buffers);
 
                             math::cached_expression_evaluator<polynomial_dfs_variable_type> evaluator(
-                                expressions[i], [&assignments=variable_values, domain_size=extended_domain_sizes[i]](const polynomial_dfs_variable_type &var) {
+                                expressions[i], [&assignments=variable_values](const polynomial_dfs_variable_type &var) {
                                 return assignments[var];
                             });
-                            
-                            F[0] += evaluator.evaluate();
+
+                            // Interpolate the bucket up to the largest domain once
+                            polynomial_dfs_type bucket_result = evaluator.evaluate();
+                            if (bucket_result.size() < max_domain_size) {
+                                bucket_result.resize(max_domain_size);
+                            }
+                            F[0] += bucket_result;
+
+                            for (auto &[var, values] : variable_values) {
+                                buffers.release(std::move(values));
+                            }
                         }
 
                         return F;
@@ -28,321 +28,563 @@
 #ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_LOOKUP_ARGUMENT_HPP
 #define CRYPTO3_ZK_PLONK_PLACEHOLDER_LOOKUP_ARGUMENT_HPP
 
-#include <nil/crypto3/math/polynomial/polynomial.hpp>
-#include <nil/crypto3/math/polynomial/shift.hpp>
-#include <nil/crypto3/math/domains/evaluation_domain.hpp>
-#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
 
-#include <nil/crypto3/hash/sha2.hpp>
+#include <boost/assert.hpp>
 
-#include <nil/crypto3/container/merkle/tree.hpp>
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+#include <nil/crypto3/math/polynomial/shift.hpp>
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
 
-#include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+#include <nil/crypto3/zk/detail/buffer_pool.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/gate.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/lookup_constraint.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/grand_product.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_scoped_profiler.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
 
 namespace nil {
     namespace crypto3 {
         namespace zk {
             namespace snark {
-                template<typename FieldType, typename CommitmentSchemeTypePermutation, typename ParamsType>
+                /// Plookup-style argument over tuples.
+                ///
+                /// Every lookup constraint is a separate lookup: on each usable row the tuple of its inputs,
+                /// multiplied by the gate selector, must equal some row of the table formed by its
+                /// lookup_value columns. The table must therefore contain the zero tuple, which unused
+                /// (zero-padded) table rows provide.
+                ///
+                /// The prover sorts the tuples before theta is known and commits the sorted columns
+                /// A'_k, S'_k together with the witness. Compression by theta is linear, so the verifier
+                /// compresses the openings of the sorted columns itself. The grand products V_L use the
+                /// permutation argument's beta and gamma and are committed in one batch with V_P.
+                template<typename FieldType, typename ParamsType>
                 class placeholder_lookup_argument {
-                    using transcript_hash_type = typename ParamsType::transcript_hash_type;
-                    using transcript_type = transcript::fiat_shamir_heuristic_sequential<transcript_hash_type>;
                     using VariableType = plonk_variable<typename FieldType::value_type>;
-
-                    static constexpr std::size_t argument_size = 5;
+                    using value_type = typename FieldType::value_type;
+                    using integral_type = typename FieldType::integral_type;
+                    using polynomial_dfs_type = math::polynomial_dfs<value_type>;
+                    using polynomial_table_type =
+                        plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>;
+                    using preprocessed_data_type =
+                        typename placeholder_public_preprocessor<FieldType, ParamsType>::preprocessed_data_type;
 
                     typedef detail::placeholder_policy<FieldType, ParamsType> policy_type;
 
                 public:
-                    struct prover_lookup_result {
-                        std::array<math::polynomial<typename FieldType::value_type>, argument_size> F;
-                        math::polynomial<typename FieldType::value_type> input_polynomial;
-                        typename CommitmentSchemeTypePermutation::precommitment_type input_precommitment;
-                        math::polynomial<typename FieldType::value_type> value_polynomial;
-                        typename CommitmentSchemeTypePermutation::precommitment_type value_precommitment;
-                        math::polynomial<typename FieldType::value_type> V_L_polynomial;
-                        typename CommitmentSchemeTypePermutation::precommitment_type V_L_precommitment;
+                    typedef zk::detail::buffer_pool<value_type, polynomial_dfs_type> polynomial_pool_type;
+
+                    static constexpr std::size_t argument_size = 5;
+
+                    struct lookup_type {
+                        std::size_t selector_index;
+                        plonk_lookup_constraint<FieldType> constraint;
+
+                        std::size_t width() const {
+                            return constraint.lookup_input.size();
+                        }
                     };
-                    static inline prover_lookup_result prove_eval(
-                        plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params>
-                            &constraint_system,
-                        const typename placeholder_public_preprocessor<FieldType, ParamsType>::preprocessed_data_type
-                            &preprocessed_data,
-                        const plonk_assignment_table<FieldType, typename ParamsType::arithmetization_params>
-                            &plonk_columns,
-                        typename CommitmentSchemeTypePermutation::params_type fri_params,
-                        transcript_type &transcript) {
-
-                        // $/theta = \challenge$
-                        typename FieldType::value_type theta = transcript.template challenge<FieldType>();
-                        // Construct lookup gates
-                        const std::vector<plonk_gate<FieldType, plonk_lookup_constraint<FieldType>>> lookup_gates =
-                            constraint_system.lookup_gates();
+
+                    static inline std::vector<lookup_type> lookups(
+                        const std::vector<plonk_gate<FieldType, plonk_lookup_constraint<FieldType>>> &lookup_gates) {
+                        std::vector<lookup_type> result;
+                        for (const auto &gate : lookup_gates) {
+                            for (const auto &constraint : gate.constraints) {
+                                BOOST_ASSERT(constraint.lookup_input.size() == constraint.lookup_value.size());
+                                result.push_back({gate.selector_index, constraint});
+                            }
+                        }
+                        return result;
+                    }
+
+                    /// Number of sorted columns: for each lookup A'_0, ..., A'_{w-1}, then S'_0, ..., S'_{w-1}
+                    static inline std::size_t sorted_columns_amount(const std::vector<lookup_type> &lookups) {
+                        std::size_t result = 0;
+                        for (const lookup_type &lookup : lookups) {
+                            result += 2 * lookup.width();
+                        }
+                        return result;
+                    }
+
+                    /// Produces A'_k and S'_k of every lookup on the basic domain.
+                    ///
+                    /// Table tuples are sorted once and deduplicated. Inputs are then placed by a counting
+                    /// sort over their position in the deduplicated table, so equal inputs form runs ordered
+                    /// like the table. S' starts each run with the matching table tuple and fills the
+                    /// rest of the run with the table rows left over.
+                    static inline std::vector<polynomial_dfs_type>
+                        sorted_columns(const std::vector<lookup_type> &lookups,
+                                       const polynomial_table_type &column_polynomials,
+                                       std::size_t usable_rows) {
+                        PROFILE_PLACEHOLDER_SCOPE("lookup_sorted_columns_time");
+
+                        std::vector<polynomial_dfs_type> result;
+                        result.reserve(sorted_columns_amount(lookups));
+                        for (const lookup_type &lookup : lookups) {
+                            sort_lookup(lookup, column_polynomials, usable_rows, result);
+                        }
+                        return result;
+                    }
+
+                    /// V_L[0] = 1, V_L[j + 1] = V_L[j] * (a_j + beta)(t_j + gamma) / ((A'_j + beta)(S'_j + gamma))
+                    /// for the theta-compressed input a, table t and sorted columns A', S'.
+                    static inline std::vector<polynomial_dfs_type>
+                        grand_products(const std::vector<lookup_type> &lookups,
+                                       const polynomial_table_type &column_polynomials,
+                                       const std::vector<polynomial_dfs_type> &sorted_columns,
+                                       const value_type &theta,
+                                       const value_type &beta,
+                                       const value_type &gamma) {
+                        PROFILE_PLACEHOLDER_SCOPE("lookup_grand_products_time");
+
+                        std::vector<polynomial_dfs_type> V_L;
+                        std::size_t offset = 0;
+                        for (const lookup_type &lookup : lookups) {
+                            const std::size_t width = lookup.width();
+                            const std::size_t rows_amount = column_polynomials.selector(lookup.selector_index).size();
+                            std::vector<value_type> nom(rows_amount), denom(rows_amount);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t j = 0; j < rows_amount; j++) {
+                                value_type input = value_type::zero();
+                                value_type value = value_type::zero();
+                                value_type sorted_input = value_type::zero();
+                                value_type sorted_value = value_type::zero();
+                                value_type theta_acc = value_type::one();
+                                for (std::size_t k = 0; k < width; k++) {
+                                    input += theta_acc * term_value(column_polynomials, lookup.constraint.lookup_input[k], j);
+                                    value += theta_acc * cell(column_polynomials, lookup.constraint.lookup_value[k], j);
+                                    sorted_input += theta_acc * sorted_columns[offset + k][j];
+                                    sorted_value += theta_acc * sorted_columns[offset + width + k][j];
+                                    theta_acc *= theta;
+                                }
+                                input *= cell(column_polynomials, selector(lookup.selector_index), j);
+
+                                nom[j] = (input + beta) * (value + gamma);
+                                denom[j] = (sorted_input + beta) * (sorted_value + gamma);
+                            }
+
+                            V_L.push_back(detail::grand_product<FieldType>(nom, denom));
+                            offset += 2 * width;
+                        }
+                        return V_L;
+                    }
+
+                    /// Lookup parts of the quotient. Parts of different lookups are combined with powers of lambda.
+                    static inline std::array<polynomial_dfs_type, argument_size>
+                        prove_eval(const std::vector<lookup_type> &lookups,
+                                   const preprocessed_data_type &preprocessed_data,
+                                   const polynomial_table_type &column_polynomials,
+                                   const std::vector<polynomial_dfs_type> &sorted_columns,
+                                   const std::vector<polynomial_dfs_type> &V_L,
+                                   const value_type &theta,
+                                   const value_type &beta,
+                                   const value_type &gamma,
+                                   const value_type &lambda) {
+                        polynomial_pool_type buffers;
+                        return prove_eval(lookups, preprocessed_data, column_polynomials, sorted_columns, V_L, theta,
+                                          beta, gamma, lambda, buffers);
+                    }
+
+                    /// Same as above with the parts and the per-lookup compressed columns drawn from the
+                    /// prover's buffer pool. The compressed columns are returned to it after every lookup.
+                    static inline std::array<polynomial_dfs_type, argument_size>
+                        prove_eval(const std::vector<lookup_type> &lookups,
+                                   const preprocessed_data_type &preprocessed_data,
+                                   const polynomial_table_type &column_polynomials,
+                                   const std::vector<polynomial_dfs_type> &sorted_columns,
+                                   const std::vector<polynomial_dfs_type> &V_L,
+                                   const value_type &theta,
+                                   const value_type &beta,
+                                   const value_type &gamma,
+                                   const value_type &lambda,
+                                   polynomial_pool_type &buffers) {
+                        PROFILE_PLACEHOLDER_SCOPE("lookup_argument_prove_eval_time");
 
                         std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain =
                             preprocessed_data.common_data.basic_domain;
+                        const std::size_t rows_amount = basic_domain->size();
 
-                        std::array<math::polynomial<typename FieldType::value_type>, argument_size> F;
-
-                        math::polynomial_dfs<typename FieldType::value_type> F_compr_input(basic_domain->m - 1,
-                                                                                           basic_domain->m, 0);
-
-                        math::polynomial_dfs<typename FieldType::value_type> F_compr_value(basic_domain->m - 1,
-                                                                                           basic_domain->m, 0);
-
-                        typename FieldType::value_type theta_acc = FieldType::value_type::one();
-
-                        // Construct the input lookup compression and table compression values
-                        // TODO: change to new form
-                        for (std::size_t i = 0; i < lookup_gates.size(); i++) {
-                            for (std::size_t j = 0; j < lookup_gates[i].constraints.size(); j++) {
-                                for (const math::term<VariableType>& lookup :
-                                     lookup_gates[i].constraints[j].lookup_input) {
-                                    int k = 0;
-                                    std::vector<typename FieldType::value_type> input_assignment;
-                                    std::vector<typename FieldType::value_type> value_assignment;
-                                    switch (lookup.get_vars()[0].type) {
-                                        case VariableType::column_type::witness:
-                                            input_assignment = plonk_columns.witness(lookup.get_vars()[0].index);
-                                            break;
-                                        case VariableType::column_type::public_input:
-                                            input_assignment = plonk_columns.public_input(lookup.get_vars()[0].index);
-                                            break;
-                                        case VariableType::column_type::constant:
-                                            input_assignment = plonk_columns.constant(lookup.get_vars()[0].index);
-                                            break;
-                                        case VariableType::column_type::selector:
-                                            break;
-                                    }
-                                    switch (lookup_gates[i].constraints[j].lookup_value[k].type) {
-                                        case VariableType::column_type::witness:
-                                            value_assignment = plonk_columns.witness(
-                                                lookup_gates[i].constraints[j].lookup_value[k].index);
-                                            break;
-                                        case VariableType::column_type::public_input:
-                                            value_assignment = plonk_columns.public_input(
-                                                lookup_gates[i].constraints[j].lookup_value[k].index);
-                                            break;
-                                        case VariableType::column_type::constant:
-                                            value_assignment = plonk_columns.constant(
-                                                lookup_gates[i].constraints[j].lookup_value[k].index);
-                                            break;
-                                        case VariableType::column_type::selector:
-                                            break;
-                                    }
-                                    for (std::size_t t = 0; t < basic_domain->m; t++) {
-                                        F_compr_input[t] =
-                                            F_compr_input[t] +
-                                            theta_acc *
-                                                input_assignment[(j + lookup.get_vars()[0].rotation) %
-                                                                 input_assignment.size()] *
-                                                lookup.get_coeff() *
-                                                plonk_columns.selector(lookup_gates[i].selector_index)[t];
-                                        F_compr_value[t] =
-                                            F_compr_value[t] +
-                                            theta_acc * value_assignment[j] *
-                                                plonk_columns.selector(lookup_gates[i].selector_index)[t];
-                                    }
-                                    k++;
-                                    theta_acc = theta * theta_acc;
-                                }
+                        polynomial_dfs_type lagrange_first(rows_amount - 1, rows_amount, value_type::zero());
+                        lagrange_first[0] = value_type::one();
+                        polynomial_dfs_type one_polynomial(0, rows_amount, value_type::one());
+                        polynomial_dfs_type mask = one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind);
+
+                        const polynomial_dfs_type zero_polynomial(0, rows_amount, value_type::zero());
+                        std::array<polynomial_dfs_type, argument_size> F_dfs;
+                        for (std::size_t i = 0; i < argument_size; i++) {
+                            F_dfs[i] = buffers.acquire_like(zero_polynomial);
+                        }
+
+                        value_type lambda_acc = value_type::one();
+                        std::size_t offset = 0;
+                        for (std::size_t l = 0; l < lookups.size(); l++) {
+                            const lookup_type &lookup = lookups[l];
+                            const std::size_t width = lookup.width();
+
+                            polynomial_dfs_type input = buffers.acquire_like(zero_polynomial);
+                            polynomial_dfs_type value = buffers.acquire_like(zero_polynomial);
+                            polynomial_dfs_type sorted_input = buffers.acquire_like(zero_polynomial);
+                            polynomial_dfs_type sorted_value = buffers.acquire_like(zero_polynomial);
+                            value_type theta_acc = value_type::one();
+                            for (std::size_t k = 0; k < width; k++) {
+                                input += theta_acc * term_polynomial(column_polynomials, lookup.constraint.lookup_input[k],
+                                                                     rows_amount);
+                                value += theta_acc * column_polynomial(column_polynomials,
+                                                                       lookup.constraint.lookup_value[k], rows_amount);
+                                sorted_input += theta_acc * sorted_columns[offset + k];
+                                sorted_value += theta_acc * sorted_columns[offset + width + k];
+                                theta_acc *= theta;
                             }
+                            input = column_polynomials.selector(lookup.selector_index) * input;
+
+                            polynomial_dfs_type g = (input + beta) * (value + gamma);
+                            polynomial_dfs_type h = (sorted_input + beta) * (sorted_value + gamma);
+                            polynomial_dfs_type V_L_shifted = math::polynomial_shift(V_L[l], 1, rows_amount);
+                            polynomial_dfs_type sorted_input_shifted =
+                                math::polynomial_shift(sorted_input, -1, rows_amount);
+                            polynomial_dfs_type sorted_difference = sorted_input - sorted_value;
+
+                            F_dfs[0] += lambda_acc * (lagrange_first * (one_polynomial - V_L[l]));
+                            F_dfs[1] += lambda_acc * (mask * (V_L_shifted * h - V_L[l] * g));
+                            F_dfs[2] += lambda_acc * (preprocessed_data.q_last * (V_L[l] * V_L[l] - V_L[l]));
+                            F_dfs[3] += lambda_acc * (lagrange_first * sorted_difference);
+                            F_dfs[4] += lambda_acc * (mask * sorted_difference * (sorted_input - sorted_input_shifted));
+
+                            lambda_acc *= lambda;
+                            offset += 2 * width;
+
+                            buffers.release(std::move(input));
+                            buffers.release(std::move(value));
+                            buffers.release(std::move(sorted_input));
+                            buffers.release(std::move(sorted_value));
                         }
 
-                        // Produce the permutation polynomials $S_{\texttt{perm}}(X)$ and $A_{\texttt{perm}}(X)$
-                        math::polynomial_dfs<typename FieldType::value_type> F_perm_input = F_compr_input;
-                        std::sort(F_perm_input.begin(), F_perm_input.end());
-                        // to-do better sort for F_perm_value
-                        math::polynomial_dfs<typename FieldType::value_type> F_perm_value = F_compr_value;
-                        F_perm_value[0] = F_perm_input[0];
-                        for (std::size_t i = 1; i < basic_domain->m; i++) {
-                            if (F_perm_input[i] != F_perm_input[i - 1]) {
-                                if (F_perm_input[i] != F_perm_value[i]) {
-                                    auto index = std::distance(
-                                        F_perm_value.begin(),
-                                        std::find(F_perm_value.begin(), F_perm_value.end(), F_perm_input[i]));
-                                    auto tmp = F_perm_value[i];
-                                    F_perm_value[i] = F_perm_value[index];
-                                    F_perm_value[index] = tmp;
+                        return F_dfs;
+                    }
+
+                    static inline std::array<value_type, argument_size> verify_eval(
+                        const std::vector<lookup_type> &lookups,
+                        // Openings of the table columns, keyed like columns_at_y
+                        typename policy_type::evaluation_map &evaluations,
+                        // A'_k(y), A'_k(y * omega^{-1}), then S'_k(y) for each lookup, as in sorted_columns
+                        const std::vector<std::vector<value_type>> &sorted_values,
+                        // V_L(y), V_L(omega * y) for each lookup
+                        const std::vector<std::vector<value_type>> &V_L_values,
+                        // L_first(y), q_last(y), q_blind(y):
+                        const value_type &lagrange_first_value,
+                        const value_type &q_last_value,
+                        const value_type &q_blind_value,
+                        const value_type &theta,
+                        const value_type &beta,
+                        const value_type &gamma,
+                        const value_type &lambda) {
+
+                        BOOST_ASSERT(sorted_values.size() == sorted_columns_amount(lookups));
+                        BOOST_ASSERT(V_L_values.size() == lookups.size());
+
+                        const value_type one = value_type::one();
+                        const value_type mask = one - q_last_value - q_blind_value;
+
+                        std::array<value_type, argument_size> F;
+                        F.fill(value_type::zero());
+
+                        value_type lambda_acc = one;
+                        std::size_t offset = 0;
+                        for (std::size_t l = 0; l < lookups.size(); l++) {
+                            const lookup_type &lookup = lookups[l];
+                            const std::size_t width = lookup.width();
+
+                            value_type input = value_type::zero();
+                            value_type value = value_type::zero();
+                            value_type sorted_input = value_type::zero();
+                            value_type sorted_input_shifted = value_type::zero();
+                            value_type sorted_value = value_type::zero();
+                            value_type theta_acc = one;
+                            for (std::size_t k = 0; k < width; k++) {
+                                const math::term<VariableType> &term = lookup.constraint.lookup_input[k];
+                                value_type term_at_y = term.get_coeff();
+                                for (const VariableType &var : term.get_vars()) {
+                                    term_at_y *= evaluations[std::make_tuple(var.index, var.rotation, var.type)];
                                 }
+                                const VariableType &var = lookup.constraint.lookup_value[k];
+
+                                input += theta_acc * term_at_y;
+                                value += theta_acc * evaluations[std::make_tuple(var.index, var.rotation, var.type)];
+                                sorted_input += theta_acc * sorted_values[offset + k][0];
+                                sorted_input_shifted += theta_acc * sorted_values[offset + k][1];
+                                sorted_value += theta_acc * sorted_values[offset + width + k][0];
+                                theta_acc *= theta;
                             }
+                            const VariableType q = selector(lookup.selector_index);
+                            input *= evaluations[std::make_tuple(q.index, q.rotation, q.type)];
+
+                            const value_type g = (input + beta) * (value + gamma);
+                            const value_type h = (sorted_input + beta) * (sorted_value + gamma);
+                            const value_type &V_L_value = V_L_values[l][0];
+                            const value_type &V_L_shifted_value = V_L_values[l][1];
+
+                            F[0] += lambda_acc * lagrange_first_value * (one - V_L_value);
+                            F[1] += lambda_acc * mask * (V_L_shifted_value * h - V_L_value * g);
+                            F[2] += lambda_acc * q_last_value * (V_L_value.squared() - V_L_value);
+                            F[3] += lambda_acc * lagrange_first_value * (sorted_input - sorted_value);
+                            F[4] += lambda_acc * mask * (sorted_input - sorted_value) *
+                                    (sorted_input - sorted_input_shifted);
+
+                            lambda_acc *= lambda;
+                            offset += 2 * width;
+                        }
+
+                        return F;
+                    }
+
+                private:
+                    static inline VariableType selector(std::size_t index) {
+                        return VariableType(index, 0, false, VariableType::column_type::selector);
+                    }
+
+                    static inline const polynomial_dfs_type &column(const polynomial_table_type &column_polynomials,
+                                                                    const VariableType &var) {
+                        switch (var.type) {
+                            case VariableType::column_type::witness:
+                                return column_polynomials.witness(var.index);
+                            case VariableType::column_type::public_input:
+                                return column_polynomials.public_input(var.index);
+                            case VariableType::column_type::constant:
+                                return column_polynomials.constant(var.index);
+                            default:
+                                BOOST_ASSERT(var.type == VariableType::column_type::selector);
+                                return column_polynomials.selector(var.index);
                         }
+                    }
+
+                    // Value of the variable on the given row, rotations wrap around the basic domain
+                    static inline value_type cell(const polynomial_table_type &column_polynomials,
+                                                  const VariableType &var,
+                                                  std::size_t row) {
+                        const polynomial_dfs_type &values = column(column_polynomials, var);
+                        const int size = static_cast<int>(values.size());
+                        const std::size_t shift = static_cast<std::size_t>(((var.rotation % size) + size) % size);
+                        return values[(row + shift) % values.size()];
+                    }
 
-                        math::polynomial<typename FieldType::value_type> F_perm_input_normal =
-                            math::polynomial<typename FieldType::value_type>(F_perm_input.coefficients());
-                        math::polynomial<typename FieldType::value_type> F_perm_value_normal =
-                            math::polynomial<typename FieldType::value_type>(F_perm_value.coefficients());
-
-                        typename CommitmentSchemeTypePermutation::precommitment_type F_perm_input_tree =
-                            algorithms::precommit<CommitmentSchemeTypePermutation>(F_perm_input, fri_params.D[0],
-                                                                                   fri_params.step_list.front());
-                        typename CommitmentSchemeTypePermutation::commitment_type F_perm_input_commitment =
-                            algorithms::commit<CommitmentSchemeTypePermutation>(F_perm_input_tree);
-                        transcript(F_perm_input_commitment);
-
-                        typename CommitmentSchemeTypePermutation::precommitment_type F_perm_value_tree =
-                            algorithms::precommit<CommitmentSchemeTypePermutation>(F_perm_value, fri_params.D[0],
-                                                                                   fri_params.step_list.front());
-                        typename CommitmentSchemeTypePermutation::commitment_type F_perm_value_commitment =
-                            algorithms::commit<CommitmentSchemeTypePermutation>(F_perm_value_tree);
-                        transcript(F_perm_value_commitment);
-
-                        // Compute $V_L(X)$
-                        typename FieldType::value_type beta = transcript.template challenge<FieldType>();
-                        typename FieldType::value_type gamma = transcript.template challenge<FieldType>();
-
-                        math::polynomial_dfs<typename FieldType::value_type> V_L(basic_domain->m - 1, basic_domain->m);
-
-                        V_L[0] = FieldType::value_type::one();
-                        for (std::size_t j = 1; j < basic_domain->m; j++) {
-                            V_L[j] = (V_L[j - 1] * (F_compr_input[j - 1] + beta) * (F_compr_value[j - 1] + gamma)) *
-                                     ((F_perm_input[j - 1] + beta) * (F_perm_value[j - 1] + gamma)).inversed();
+                    static inline value_type term_value(const polynomial_table_type &column_polynomials,
+                                                        const math::term<VariableType> &term,
+                                                        std::size_t row) {
+                        value_type result = term.get_coeff();
+                        for (const VariableType &var : term.get_vars()) {
+                            result *= cell(column_polynomials, var, row);
                         }
+                        return result;
+                    }
 
-                        math::polynomial<typename FieldType::value_type> V_L_normal =
-                            math::polynomial<typename FieldType::value_type>(V_L.coefficients());
-
-                        typename CommitmentSchemeTypePermutation::precommitment_type V_L_tree =
-                            algorithms::precommit<CommitmentSchemeTypePermutation>(V_L, fri_params.D[0],
-                                                                                   fri_params.step_list.front());
-                        typename CommitmentSchemeTypePermutation::commitment_type V_L_commitment =
-                            algorithms::commit<CommitmentSchemeTypePermutation>(V_L_tree);
-                        transcript(V_L_commitment);
-
-                        // Calculate lookup-related numerators of the quotinent polynomial
-                        math::polynomial_dfs<typename FieldType::value_type> g =
-                            (F_compr_input + beta) * (F_compr_value + gamma);
-                        math::polynomial_dfs<typename FieldType::value_type> h =
-                            (F_perm_input + beta) * (F_perm_value + gamma);
-                        math::polynomial_dfs<typename FieldType::value_type> one_polynomial(
-                            basic_domain->m - 1, basic_domain->m, FieldType::value_type::one());
-
-                        math::polynomial_dfs<typename FieldType::value_type> V_L_shifted =
-                            math::polynomial_shift(V_L, 1, basic_domain->m);
-
-                        math::polynomial_dfs<typename FieldType::value_type> F_perm_input_shifted =
-                            math::polynomial_shift(F_perm_input, -1, basic_domain->m);
-
-                        F[0] = math::polynomial<typename FieldType::value_type>(
-                            (preprocessed_data.common_data.lagrange_0 * (one_polynomial - V_L)).coefficients());
-                        F[1] = math::polynomial<typename FieldType::value_type>(
-                            ((one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) *
-                             (V_L_shifted * h - V_L * g))
-                                .coefficients());
-                        F[2] = math::polynomial<typename FieldType::value_type>(
-                            (preprocessed_data.q_last * (V_L * V_L - V_L)).coefficients());
-                        F[3] = math::polynomial<typename FieldType::value_type>(
-                            (preprocessed_data.common_data.lagrange_0 * (F_perm_input - F_perm_value)).coefficients());
-                        F[4] = math::polynomial<typename FieldType::value_type>(
-                            ((one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) *
-                             (F_perm_input - F_perm_value) * (F_perm_input - F_perm_input_shifted))
-                                .coefficients());
-
-                        return {F,
-                                F_perm_input_normal,
-                                F_perm_input_tree,
-                                F_perm_value_normal,
-                                F_perm_value_tree,
-                                V_L_normal,
-                                V_L_tree};
+                    static inline polynomial_dfs_type column_polynomial(const polynomial_table_type &column_polynomials,
+                                                                        const VariableType &var,
+                                                                        std::size_t rows_amount) {
+                        if (var.rotation == 0) {
+                            return column(column_polynomials, var);
+                        }
+                        return math::polynomial_shift(column(column_polynomials, var), var.rotation, rows_amount);
                     }
 
-                    static inline std::array<typename FieldType::value_type, argument_size> verify_eval(
-                        const typename placeholder_public_preprocessor<FieldType, ParamsType>::preprocessed_data_type
-                            &preprocessed_data,
-                        const std::vector<plonk_gate<FieldType, plonk_lookup_constraint<FieldType>>> &lookup_gates,
-                        // y
-                        const typename FieldType::value_type &challenge,
-                        typename policy_type::evaluation_map &evaluations,
-                        // A_perm(y):
-                        const typename FieldType::value_type &F_perm_input_polynomial_value,
-                        // A_perm(y * omega ^ {-1}):
-                        const typename FieldType::value_type &F_perm_input_shifted_polynomial_value,
-                        // S_perm(y):
-                        const typename FieldType::value_type &F_perm_value_polynomial_value,
-                        // V_L(y):
-                        const typename FieldType::value_type &V_L_polynomial_value,
-                        // V_P(omega * y):
-                        const typename FieldType::value_type &V_L_polynomial_shifted_value,
-                        const typename CommitmentSchemeTypePermutation::commitment_type &F_perm_input_commitment,
-                        const typename CommitmentSchemeTypePermutation::commitment_type &F_perm_value_commitment,
-                        const typename CommitmentSchemeTypePermutation::commitment_type &V_L_commitment,
-                        transcript_type& transcript) {
-                        // 1. Get theta
-                        typename FieldType::value_type theta = transcript.template challenge<FieldType>();
-                        // 2. Add commitments to transcript
-                        transcript(F_perm_input_commitment);
-                        transcript(F_perm_value_commitment);
-
-                        // 3. Calculate input_lookup and value_lookup compression at challenge point
-                        typename FieldType::value_type F_input_compr = FieldType::value_type::zero();
-                        typename FieldType::value_type F_value_compr = FieldType::value_type::zero();
-
-                        typename FieldType::value_type theta_acc = FieldType::value_type::one();
-
-                        for (std::size_t i = 0; i < lookup_gates.size(); i++) {
-                            for (std::size_t j = 0; j < lookup_gates[i].constraints.size(); j++) {
-                                for (math::term<VariableType> lookup :
-                                     lookup_gates[i].constraints[j].lookup_input) {
-                                    int k = 0;
-                                    std::tuple<std::size_t, int, typename VariableType::column_type> input_key =
-                                        std::make_tuple(lookup.get_vars()[0].index, lookup.get_vars()[0].rotation,
-                                                        lookup.get_vars()[0].type);
-                                    std::tuple<std::size_t, int, typename VariableType::column_type> value_key =
-                                        std::make_tuple(lookup_gates[i].constraints[j].lookup_value[k].index,
-                                                        lookup_gates[i].constraints[j].lookup_value[k].rotation,
-                                                        lookup_gates[i].constraints[j].lookup_value[k].type);
-
-                                    std::tuple<std::size_t, int, typename plonk_variable<typename FieldType::value_type>::column_type>
-                                        selector_key =
-                                            std::make_tuple(lookup_gates[i].selector_index, 0,
-                                                            plonk_variable<typename FieldType::value_type>::column_type::selector);
-
-                                    F_input_compr = F_input_compr + theta_acc * evaluations[input_key] * lookup.get_coeff() *
-                                                                        evaluations[selector_key];
-
-                                    F_value_compr =
-                                        F_value_compr + theta_acc * evaluations[value_key] * evaluations[selector_key];
-                                    k++;
-                                    theta_acc = theta * theta_acc;
+                    static inline polynomial_dfs_type term_polynomial(const polynomial_table_type &column_polynomials,
+                                                                      const math::term<VariableType> &term,
+                                                                      std::size_t rows_amount) {
+                        polynomial_dfs_type result(0, rows_amount, term.get_coeff());
+                        for (const VariableType &var : term.get_vars()) {
+                            result = result * column_polynomial(column_polynomials, var, rows_amount);
+                        }
+                        return result;
+                    }
+
+                    // Sorts row indices by their keys: chunks are sorted in parallel, then merged pairwise.
+                    template<typename Compare>
+                    static void sort_rows(std::vector<std::size_t> &rows, Compare comp) {
+                        const std::size_t size = rows.size();
+#ifdef MULTICORE
+                        const std::size_t chunks =
+                            std::max<std::size_t>(1, std::min<std::size_t>(omp_get_max_threads(), size));
+#else
+                        const std::size_t chunks = 1;
+#endif
+                        const std::size_t chunk_size = size == 0 ? 1 : (size + chunks - 1) / chunks;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 0; c < chunks; ++c) {
+                            const std::size_t begin = std::min(size, c * chunk_size);
+                            const std::size_t end = std::min(size, begin + chunk_size);
+                            std::sort(rows.begin() + begin, rows.begin() + end, comp);
+                        }
+
+                        for (std::size_t width = chunk_size; width < size; width *= 2) {
+                            const std::size_t pairs = (size + 2 * width - 1) / (2 * width);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t p = 0; p < pairs; ++p) {
+                                const std::size_t begin = p * 2 * width;
+                                const std::size_t middle = std::min(size, begin + width);
+                                const std::size_t end = std::min(size, begin + 2 * width);
+                                std::inplace_merge(rows.begin() + begin, rows.begin() + middle, rows.begin() + end,
+                                                   comp);
+                            }
+                        }
+                    }
+
+                    static void sort_lookup(const lookup_type &lookup,
+                                            const polynomial_table_type &column_polynomials,
+                                            std::size_t usable_rows,
+                                            std::vector<polynomial_dfs_type> &out) {
+                        const std::size_t width = lookup.width();
+                        const std::size_t rows_amount = column_polynomials.selector(lookup.selector_index).size();
+                        BOOST_ASSERT(usable_rows > 0 && usable_rows <= rows_amount);
+
+                        // 1. Masked input tuples and table tuples of the usable rows, with canonical integral
+                        // keys so that tuples compare by value
+                        std::vector<value_type> table(usable_rows * width);
+                        std::vector<integral_type> input_keys(usable_rows * width);
+                        std::vector<integral_type> table_keys(usable_rows * width);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t j = 0; j < usable_rows; j++) {
+                            const value_type q = cell(column_polynomials, selector(lookup.selector_index), j);
+                            for (std::size_t k = 0; k < width; k++) {
+                                const value_type input =
+                                    q * term_value(column_polynomials, lookup.constraint.lookup_input[k], j);
+                                table[j * width + k] = cell(column_polynomials, lookup.constraint.lookup_value[k], j);
+                                input_keys[j * width + k] = integral_type(input.data);
+                                table_keys[j * width + k] = integral_type(table[j * width + k].data);
+                            }
+                        }
+
+                        auto compare = [width](const std::vector<integral_type> &lhs_keys, std::size_t lhs,
+                                               const std::vector<integral_type> &rhs_keys, std::size_t rhs) {
+                            for (std::size_t k = 0; k < width; k++) {
+                                if (lhs_keys[lhs * width + k] != rhs_keys[rhs * width + k]) {
+                                    return lhs_keys[lhs * width + k] < rhs_keys[rhs * width + k] ? -1 : 1;
                                 }
                             }
+                            return 0;
+                        };
+
+                        // 2. Sort and deduplicate the table
+                        std::vector<std::size_t> table_order(usable_rows);
+                        for (std::size_t j = 0; j < usable_rows; j++) {
+                            table_order[j] = j;
+                        }
+                        sort_rows(table_order, [&table_keys, &compare](std::size_t lhs, std::size_t rhs) {
+                            return compare(table_keys, lhs, table_keys, rhs) < 0;
+                        });
+
+                        // distinct[p] is the first row of the p-th distinct table tuple,
+                        // distinct_index[i] is the distinct tuple at table_order[i]
+                        std::vector<std::size_t> distinct;
+                        std::vector<std::size_t> distinct_index(usable_rows);
+                        for (std::size_t i = 0; i < usable_rows; i++) {
+                            if (i == 0 || compare(table_keys, table_order[i - 1], table_keys, table_order[i]) != 0) {
+                                distinct.push_back(table_order[i]);
+                            }
+                            distinct_index[i] = distinct.size() - 1;
                         }
 
-                        // 4. Denote g and h
-                        typename FieldType::value_type beta = transcript.template challenge<FieldType>();
-                        typename FieldType::value_type gamma = transcript.template challenge<FieldType>();
-                        transcript(V_L_commitment);
-                        typename FieldType::value_type g = (F_input_compr + beta) * (F_value_compr + gamma);
-                        typename FieldType::value_type h =
-                            (F_perm_input_polynomial_value + beta) * (F_perm_value_polynomial_value + gamma);
-                        std::array<typename FieldType::value_type, argument_size> F;
-                        typename FieldType::value_type one = FieldType::value_type::one();
-                        F[0] =
-                            preprocessed_data.common_data.lagrange_0.evaluate(challenge) * (one - V_L_polynomial_value);
-                        F[1] = (one - preprocessed_data.q_last.evaluate(challenge) -
-                                preprocessed_data.q_blind.evaluate(challenge)) *
-                               (V_L_polynomial_shifted_value * h - V_L_polynomial_value * g);
-                        F[2] = preprocessed_data.q_last.evaluate(challenge) *
-                               (V_L_polynomial_value * V_L_polynomial_value - V_L_polynomial_value);
-                        F[3] = preprocessed_data.common_data.lagrange_0.evaluate(challenge) *
-                               (F_perm_input_polynomial_value - F_perm_value_polynomial_value);
-                        F[4] = (one - preprocessed_data.q_last.evaluate(challenge) -
-                                preprocessed_data.q_blind.evaluate(challenge)) *
-                               (F_perm_input_polynomial_value - F_perm_value_polynomial_value) *
-                               (F_perm_input_polynomial_value - F_perm_input_shifted_polynomial_value);
+                        // 3. Position of every input in the deduplicated table and its histogram
+#ifdef MULTICORE
+                        const std::size_t chunks =
+                            std::max<std::size_t>(1, std::min<std::size_t>(omp_get_max_threads(), usable_rows));
+#else
+                        const std::size_t chunks = 1;
+#endif
+                        const std::size_t chunk_size = (usable_rows + chunks - 1) / chunks;
+                        std::vector<std::vector<std::size_t>> chunk_counts(chunks,
+                                                                           std::vector<std::size_t>(distinct.size(), 0));
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 0; c < chunks; ++c) {
+                            const std::size_t end = std::min(usable_rows, (c + 1) * chunk_size);
+                            for (std::size_t j = c * chunk_size; j < end; j++) {
+                                std::size_t first = 0, last = distinct.size();
+                                while (first < last) {
+                                    std::size_t middle = first + (last - first) / 2;
+                                    if (compare(table_keys, distinct[middle], input_keys, j) < 0) {
+                                        first = middle + 1;
+                                    } else {
+                                        last = middle;
+                                    }
+                                }
+                                // The input is not in the table, the proof will not verify
+                                BOOST_ASSERT(first < distinct.size() &&
+                                             compare(table_keys, distinct[first], input_keys, j) == 0);
+                                chunk_counts[c][std::min(first, distinct.size() - 1)]++;
+                            }
+                        }
 
-                        return F;
+                        std::vector<std::size_t> counts(distinct.size(), 0);
+                        for (std::size_t c = 0; c < chunks; ++c) {
+                            for (std::size_t p = 0; p < distinct.size(); p++) {
+                                counts[p] += chunk_counts[c][p];
+                            }
+                        }
+
+                        // 4. Inputs grouped by table position: slot_index[s] is the distinct tuple of A'[s].
+                        // S' starts each run with that tuple, the other slots take the leftover table rows.
+                        std::vector<std::size_t> slot_index(usable_rows);
+                        std::vector<std::size_t> sorted_table_rows(usable_rows);
+                        std::vector<bool> run_start(usable_rows, false);
+                        for (std::size_t p = 0, s = 0; p < distinct.size(); p++) {
+                            if (counts[p] > 0) {
+                                run_start[s] = true;
+                                sorted_table_rows[s] = distinct[p];
+                            }
+                            for (std::size_t i = 0; i < counts[p]; i++, s++) {
+                                slot_index[s] = p;
+                            }
+                        }
+                        for (std::size_t i = 0, s = 0; i < usable_rows; i++) {
+                            const bool is_first = i == 0 || distinct_index[i] != distinct_index[i - 1];
+                            if (is_first && counts[distinct_index[i]] > 0) {
+                                continue;
+                            }
+                            while (run_start[s]) {
+                                s++;
+                            }
+                            sorted_table_rows[s++] = table_order[i];
+                        }
+
+                        // 5. Sorted columns, rows after the usable ones are zero
+                        const std::size_t first_column = out.size();
+                        for (std::size_t k = 0; k < 2 * width; k++) {
+                            out.emplace_back(rows_amount - 1, rows_amount, value_type::zero());
+                        }
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t s = 0; s < usable_rows; s++) {
+                            for (std::size_t k = 0; k < width; k++) {
+                                out[first_column + k][s] = table[distinct[slot_index[s]] * width + k];
+                                out[first_column + width + k][s] = table[sorted_table_rows[s] * width + k];
+                            }
+                        }
                     }
                 };
-
             }    // namespace snark
         }        // namespace zk
     }            // namespace crypto3
 }    // namespace nil
 
-#endif    // #ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_PERMUTATION_ARGUMENT_HPP
+#endif    // CRYPTO3_ZK_PLONK_PLACEHOLDER_LOOKUP_ARGUMENT_HPP
@@ -27,6 +27,10 @@
 #ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_PERMUTATION_ARGUMENT_HPP
 #define CRYPTO3_ZK_PLONK_PLACEHOLDER_PERMUTATION_ARGUMENT_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
 #include <algorithm>
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
@@ -39,8 +43,10 @@
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 
+#include <nil/crypto3/zk/detail/buffer_pool.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/grand_product.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_scoped_profiler.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
@@ -60,6 +66,16 @@ namespace nil {
                     using permutation_commitment_scheme_type = typename ParamsType::runtime_size_commitment_scheme_type;
 
                 public:
+                    typedef zk::detail::buffer_pool<typename FieldType::value_type,
+                                                    math::polynomial_dfs<typename FieldType::value_type>>
+                        polynomial_pool_type;
+
+                    struct prover_polynomials_type {
+                        std::array<math::polynomial_dfs<typename FieldType::value_type>, argument_size> F_dfs;
+
+                        math::polynomial_dfs<typename FieldType::value_type> permutation_polynomial_dfs;
+                    };
+
                     struct prover_result_type {
                         std::array<math::polynomial_dfs<typename FieldType::value_type>, argument_size> F_dfs;
 
@@ -88,7 +104,7 @@ namespace nil {
                         const plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params>
                             &constraint_system,
                         const typename placeholder_public_preprocessor<FieldType, ParamsType>::preprocessed_data_type
-                            preprocessed_data,
+                            &preprocessed_data,
                         const plonk_table_description<FieldType, typename ParamsType::arithmetization_params>
                             &table_description,
                         const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>
@@ -96,6 +112,54 @@ namespace nil {
                         const typename ParamsType::commitment_params_type& fri_params,
                         transcript_type& transcript) {
 
+                        // 1. $\beta_1, \gamma_1 = \challenge$
+                        typename FieldType::value_type beta = transcript.template challenge<FieldType>();
+                        typename FieldType::value_type gamma = transcript.template challenge<FieldType>();
+
+                        prover_polynomials_type polynomials =
+                            prove_eval(preprocessed_data, column_polynomials, fri_params, beta, gamma);
+
+                        // 4. Compute and add commitment to $V_P$ to $\text{transcript}$.
+                        typename permutation_commitment_scheme_type::precommitment_type V_P_tree =
+                            algorithms::precommit<permutation_commitment_scheme_type>(
+                                polynomials.permutation_polynomial_dfs, fri_params.D[0], fri_params.step_list.front());
+                        typename permutation_commitment_scheme_type::commitment_type V_P_commitment =
+                            algorithms::commit<permutation_commitment_scheme_type>(V_P_tree);
+                        transcript(V_P_commitment);
+
+                        prover_result_type res = {std::move(polynomials.F_dfs),
+                                                  std::move(polynomials.permutation_polynomial_dfs), V_P_tree};
+
+                        return res;
+                    }
+
+                    /// Computes V_P and the permutation parts of the quotient for given beta and gamma,
+                    /// leaving the commitment to the caller. The prover uses it to commit V_P in one
+                    /// batch with the lookup grand products, which share the same challenges.
+                    static inline prover_polynomials_type prove_eval(
+                        const typename placeholder_public_preprocessor<FieldType, ParamsType>::preprocessed_data_type
+                            &preprocessed_data,
+                        const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>
+                            &column_polynomials,
+                        const typename ParamsType::commitment_params_type& fri_params,
+                        const typename FieldType::value_type &beta,
+                        const typename FieldType::value_type &gamma) {
+                        polynomial_pool_type buffers;
+                        return prove_eval(preprocessed_data, column_polynomials, fri_params, beta, gamma, buffers);
+                    }
+
+                    /// Same as above with the id and sigma bindings drawn from the prover's buffer pool
+                    /// and returned to it once their products are computed.
+                    static inline prover_polynomials_type prove_eval(
+                        const typename placeholder_public_preprocessor<FieldType, ParamsType>::preprocessed_data_type
+                            &preprocessed_data,
+                        const plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>
+                            &column_polynomials,
+                        const typename ParamsType::commitment_params_type& fri_params,
+                        const typename FieldType::value_type &beta,
+                        const typename FieldType::value_type &gamma,
+                        polynomial_pool_type &buffers) {
+
                         PROFILE_PLACEHOLDER_SCOPE("permutation_argument_prove_eval_time");
 
                         const std::vector<math::polynomial_dfs<typename FieldType::value_type>> &S_sigma =
@@ -104,49 +168,54 @@ namespace nil {
                             preprocessed_data.identity_polynomials;
                         std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain =
                             preprocessed_data.common_data.basic_domain;
-                        // 1. $\beta_1, \gamma_1 = \challenge$
-                        typename FieldType::value_type beta = transcript.template challenge<FieldType>();
-                        typename FieldType::value_type gamma = transcript.template challenge<FieldType>();
 
                         // 2. Calculate id_binding, sigma_binding for j from 1 to N_rows
-                        // 3. Calculate $V_P$
-                        math::polynomial_dfs<typename FieldType::value_type> V_P(basic_domain->size() - 1,
-                                                                                 basic_domain->size());
-
+                        // A binding has the size and degree of the higher-degree one of its summands
                         std::vector<math::polynomial_dfs<typename FieldType::value_type>> g_v;
                         std::vector<math::polynomial_dfs<typename FieldType::value_type>> h_v;
                         for (std::size_t i = 0; i < S_id.size(); i++) {
-                            BOOST_ASSERT(column_polynomials[i].size() == basic_domain->size());
+                            const math::polynomial_dfs<typename FieldType::value_type> &column = column_polynomials[i];
+                            BOOST_ASSERT(column.size() == basic_domain->size());
                             BOOST_ASSERT(S_id[i].size() == basic_domain->size());
                             BOOST_ASSERT(S_sigma[i].size() == basic_domain->size());
 
-                            g_v.push_back(column_polynomials[i] + beta * S_id[i] + gamma);
-                            h_v.push_back(column_polynomials[i] + beta * S_sigma[i] + gamma);
+                            g_v.push_back(buffers.acquire_like(column.degree() >= S_id[i].degree() ? column : S_id[i]));
+                            h_v.push_back(
+                                buffers.acquire_like(column.degree() >= S_sigma[i].degree() ? column : S_sigma[i]));
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t j = 0; j < basic_domain->size(); j++) {
+                                g_v[i][j] = column[j] + beta * S_id[i][j] + gamma;
+                                h_v[i][j] = column[j] + beta * S_sigma[i][j] + gamma;
+                            }
                         }
 
-                        V_P[0] = FieldType::value_type::one();
-                        for (std::size_t j = 1; j < basic_domain->size(); j++) {
-                            typename FieldType::value_type nom = FieldType::value_type::one();
-                            typename FieldType::value_type denom = FieldType::value_type::one();
-
+                        // 3. Calculate $V_P$
+                        std::vector<typename FieldType::value_type> nom(basic_domain->size(),
+                                                                        FieldType::value_type::one());
+                        std::vector<typename FieldType::value_type> denom(basic_domain->size(),
+                                                                          FieldType::value_type::one());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t j = 0; j < basic_domain->size(); j++) {
                             for (std::size_t i = 0; i < S_id.size(); i++) {
-                                nom *= g_v[i][j - 1];
-                                denom *= h_v[i][j - 1];
+                                nom[j] *= g_v[i][j];
+                                denom[j] *= h_v[i][j];
                             }
-                            V_P[j] = V_P[j - 1] * nom / denom;
                         }
+                        math::polynomial_dfs<typename FieldType::value_type> V_P =
+                            detail::grand_product<FieldType>(nom, denom);
                         V_P.resize(fri_params.D[0]->m);
 
-                        // 4. Compute and add commitment to $V_P$ to $\text{transcript}$.
-                        typename permutation_commitment_scheme_type::precommitment_type V_P_tree =
-                            algorithms::precommit<permutation_commitment_scheme_type>(
-                                V_P, fri_params.D[0], fri_params.step_list.front());
-                        typename permutation_commitment_scheme_type::commitment_type V_P_commitment =
-                            algorithms::commit<permutation_commitment_scheme_type>(V_P_tree);
-                        transcript(V_P_commitment);
                         // 5. Calculate g_perm, h_perm
                         math::polynomial_dfs<typename FieldType::value_type> g = polynomial_product(g_v);
                         math::polynomial_dfs<typename FieldType::value_type> h = polynomial_product(h_v);
+                        for (std::size_t i = 0; i < S_id.size(); i++) {
+                            buffers.release(std::move(g_v[i]));
+                            buffers.release(std::move(h_v[i]));
+                        }
 
                         math::polynomial_dfs<typename FieldType::value_type> one_polynomial(
                             0, V_P.size(), FieldType::value_type::one());
@@ -158,7 +227,7 @@ namespace nil {
                         F_dfs[1] = (one_polynomial - (preprocessed_data.q_last + preprocessed_data.q_blind)) * (V_P_shifted * h - V_P * g);
                         F_dfs[2] = preprocessed_data.q_last * V_P * (V_P - one_polynomial);
 
-                        prover_result_type res = {F_dfs, V_P, V_P_tree};
+                        prover_polynomials_type res = {F_dfs, V_P};
 
                         return res;
                     }
@@ -179,8 +248,39 @@ namespace nil {
 
                         const std::vector<math::polynomial_dfs<typename FieldType::value_type>> &S_sigma =
                             preprocessed_data.permutation_polynomials;
-                        const std::vector<math::polynomial_dfs<typename FieldType::value_type>> &S_id =
-                            preprocessed_data.identity_polynomials;
+
+                        std::vector<typename FieldType::value_type> S_sigma_values(column_polynomials_values.size());
+                        for (std::size_t i = 0; i < column_polynomials_values.size(); i++) {
+                            S_sigma_values[i] = S_sigma[i].evaluate(challenge);
+                        }
+
+                        return verify_eval(challenge, column_polynomials_values, S_sigma_values,
+                                           preprocessed_data.common_data.lagrange_0.evaluate(challenge),
+                                           preprocessed_data.q_last.evaluate(challenge),
+                                           preprocessed_data.q_blind.evaluate(challenge), perm_polynomial_value,
+                                           perm_polynomial_shifted_value, V_P_commitment, transcript);
+                    }
+
+                    /// Succinct form: works on openings of the preprocessed polynomials at y only.
+                    /// S_id[i](y) = delta^i * y is computed in closed form, so the cost is constant per column
+                    /// and no full-size polynomial is needed.
+                    static inline std::array<typename FieldType::value_type, argument_size> verify_eval(
+                        // y
+                        const typename FieldType::value_type &challenge,
+                        // f(y):
+                        const std::vector<typename FieldType::value_type> &column_polynomials_values,
+                        // S_sigma(y):
+                        const std::vector<typename FieldType::value_type> &permutation_polynomials_values,
+                        // L_0(y), q_last(y), q_blind(y):
+                        const typename FieldType::value_type &lagrange_0_value,
+                        const typename FieldType::value_type &q_last_value,
+                        const typename FieldType::value_type &q_blind_value,
+                        // V_P(y):
+                        const typename FieldType::value_type &perm_polynomial_value,
+                        // V_P(omega * y):
+                        const typename FieldType::value_type &perm_polynomial_shifted_value,
+                        const typename permutation_commitment_scheme_type::commitment_type &V_P_commitment,
+                        transcript_type& transcript) {
 
                         // 1. Get beta, gamma
                         typename FieldType::value_type beta = transcript.template challenge<FieldType>();
@@ -189,30 +289,53 @@ namespace nil {
                         // 2. Add commitment to V_P to transcript
                         transcript(V_P_commitment);
 
+                        return verify_eval(challenge, column_polynomials_values, permutation_polynomials_values,
+                                           lagrange_0_value, q_last_value, q_blind_value, perm_polynomial_value,
+                                           perm_polynomial_shifted_value, beta, gamma);
+                    }
+
+                    /// Same as above for beta and gamma drawn by the caller.
+                    static inline std::array<typename FieldType::value_type, argument_size> verify_eval(
+                        // y
+                        const typename FieldType::value_type &challenge,
+                        // f(y):
+                        const std::vector<typename FieldType::value_type> &column_polynomials_values,
+                        // S_sigma(y):
+                        const std::vector<typename FieldType::value_type> &permutation_polynomials_values,
+                        // L_0(y), q_last(y), q_blind(y):
+                        const typename FieldType::value_type &lagrange_0_value,
+                        const typename FieldType::value_type &q_last_value,
+                        const typename FieldType::value_type &q_blind_value,
+                        // V_P(y):
+                        const typename FieldType::value_type &perm_polynomial_value,
+                        // V_P(omega * y):
+                        const typename FieldType::value_type &perm_polynomial_shifted_value,
+                        const typename FieldType::value_type &beta,
+                        const typename FieldType::value_type &gamma) {
+
+                        BOOST_ASSERT(permutation_polynomials_values.size() == column_polynomials_values.size());
+
                         // 3. Calculate h_perm, g_perm at challenge point
-                        math::polynomial_dfs<typename FieldType::value_type> g_poly(
-                            0, preprocessed_data.common_data.basic_domain->size(), FieldType::value_type::one()
-                        );
-                        math::polynomial_dfs<typename FieldType::value_type> h_poly(
-                            0, preprocessed_data.common_data.basic_domain->size(), FieldType::value_type::one()
-                        );
+                        typename FieldType::value_type one = FieldType::value_type::one();
+                        typename FieldType::value_type g = one;
+                        typename FieldType::value_type h = one;
+                        // beta * S_id[i](y) = beta * delta^i * y
+                        typename FieldType::value_type beta_id = beta * challenge;
 
                         for (std::size_t i = 0; i < column_polynomials_values.size(); i++) {
                             typename FieldType::value_type pp = column_polynomials_values[i] + gamma;
 
-                            g_poly = g_poly * (S_id[i] * beta + pp);
-                            h_poly = h_poly * (S_sigma[i] * beta  + pp);
-
+                            g *= beta_id + pp;
+                            h *= beta * permutation_polynomials_values[i] + pp;
+                            beta_id *= ParamsType::delta;
                         }
+
                         std::array<typename FieldType::value_type, argument_size> F;
-                        typename FieldType::value_type one = FieldType::value_type::one();
 
-                        F[0] = preprocessed_data.common_data.lagrange_0.evaluate(challenge) *
-                               (one - perm_polynomial_value);
-                        F[1] = ((one - preprocessed_data.q_last - preprocessed_data.q_blind) *
-                               (perm_polynomial_shifted_value * h_poly - perm_polynomial_value * g_poly)).evaluate(challenge);
-                        F[2] = preprocessed_data.q_last.evaluate(challenge) *
-                               (perm_polynomial_value.squared() - perm_polynomial_value);
+                        F[0] = lagrange_0_value * (one - perm_polynomial_value);
+                        F[1] = (one - q_last_value - q_blind_value) *
+                               (perm_polynomial_shifted_value * h - perm_polynomial_value * g);
+                        F[2] = q_last_value * (perm_polynomial_value.squared() - perm_polynomial_value);
 
                         return F;
                     }
@@ -28,6 +28,12 @@
 #ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_PREPROCESSOR_HPP
 #define CRYPTO3_ZK_PLONK_PLACEHOLDER_PREPROCESSOR_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <memory>
 #include <set>
 
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
@@ -38,6 +44,8 @@
 #include <nil/crypto3/zk/math/expression.hpp>
 #include <nil/crypto3/zk/math/expression_visitors.hpp>
 #include <nil/crypto3/zk/math/permutation.hpp>
+#include <nil/crypto3/zk/detail/evaluation_domain_registry.hpp>
+#include <nil/crypto3/zk/detail/field_powers.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_scoped_profiler.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/copy_constraint.hpp>
@@ -60,6 +68,14 @@ namespace nil {
                     typedef typename math::polynomial_dfs<typename FieldType::value_type> polynomial_dfs_type;
 
                 public:
+                    // Powers of omega (one per row) and of delta (one per permuted column) shared by
+                    // the identity and permutation polynomials: S_id[i][j] = delta^i * omega^j and
+                    // S_sigma[i][j] = delta^{sigma(i, j).first} * omega^{sigma(i, j).second}.
+                    struct twiddles_type {
+                        std::vector<typename FieldType::value_type> omega_powers;
+                        std::vector<typename FieldType::value_type> delta_powers;
+                    };
+
                     struct preprocessed_data_type {
 
                         struct public_precommitments_type {
@@ -97,6 +113,8 @@ namespace nil {
                             polynomial_type Z;
                             std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain;
                             std::uint32_t max_gates_degree;
+                            // Filled by the preprocessor, empty for marshalled data
+                            std::shared_ptr<twiddles_type> twiddles;
 
 
                             // Constructor with pregenerated domain
@@ -142,7 +160,7 @@ namespace nil {
                                 // lagrange_0:  0,0,...,1,0,0,...,0
                                 lagrange_0[usable_rows] = FieldType::value_type::one();
 
-                                basic_domain = math::make_evaluation_domain<FieldType>(rows);
+                                basic_domain = zk::detail::evaluation_domain_registry<FieldType>::domain(rows);
                             }
 
                             // These operators are useful for marshalling
@@ -279,6 +297,16 @@ namespace nil {
                         }
                     };
 
+                    // Number of delta powers needed for permutation polynomials: sigma may map a cell to any column
+                    // taking part in the mapping
+                    static std::size_t permutation_columns(const cycle_representation &permutation) {
+                        std::size_t columns = 0;
+                        for (const auto &entry : permutation._mapping) {
+                            columns = std::max(columns, entry.second.first + 1);
+                        }
+                        return columns;
+                    }
+
                 public:
                     static inline std::array<std::set<int>, ParamsType::arithmetization_params::total_columns>
                         columns_rotations(
@@ -310,12 +338,27 @@ namespace nil {
                                 for (const auto& expr: constraint.lookup_input) {
                                	    visitor.visit(expr);
                                 } 
+                                for (const auto& var: constraint.lookup_value) {
+                                    result[table_description.global_index(var)].insert(var.rotation);
+                                }
                             }
                         }
 
                         return result;
                     }
 
+                    /// Fills omega^j for j < rows and delta^i for i < columns. Both tables are
+                    /// computed in parallel chunks, each chunk starting from a single exponentiation.
+                    static inline std::shared_ptr<twiddles_type> twiddles(std::size_t rows,
+                                                                          std::size_t columns,
+                                                                          const typename FieldType::value_type &omega,
+                                                                          const typename FieldType::value_type &delta) {
+                        std::shared_ptr<twiddles_type> res = std::make_shared<twiddles_type>();
+                        zk::detail::fill_powers(res->omega_powers, omega, rows);
+                        zk::detail::fill_powers(res->delta_powers, delta, columns);
+                        return res;
+                    }
+
                     static inline std::vector<polynomial_dfs_type>
                         identity_polynomials(std::size_t permutation_size,
                                              const typename FieldType::value_type &omega,
@@ -324,17 +367,34 @@ namespace nil {
                                                  domain,
                                              const typename ParamsType::commitment_params_type &commitment_params) {
 
+                        return identity_polynomials(permutation_size,
+                                                    *twiddles(domain->size(), permutation_size, omega, delta),
+                                                    domain, commitment_params);
+                    }
+
+                    static inline std::vector<polynomial_dfs_type>
+                        identity_polynomials(std::size_t permutation_size,
+                                             const twiddles_type &twiddles,
+                                             std::shared_ptr<math::evaluation_domain<FieldType>>
+                                                 domain,
+                                             const typename ParamsType::commitment_params_type &commitment_params) {
+                        const std::size_t rows = domain->size();
+                        assert(twiddles.omega_powers.size() >= rows);
+                        assert(twiddles.delta_powers.size() >= permutation_size);
+
                         std::vector<polynomial_dfs_type> S_id(permutation_size);
 
                         for (std::size_t i = 0; i < permutation_size; i++) {
-                            S_id[i] = polynomial_dfs_type(
-                                domain->size() - 1, domain->size(), FieldType::value_type::zero());
+                            S_id[i] = polynomial_dfs_type(rows - 1, rows, FieldType::value_type::zero());
+                        }
 
-                            for (std::size_t j = 0; j < domain->size(); j++) {
-                                S_id[i][j] = delta.pow(i) * omega.pow(j);
+#ifdef MULTICORE
+#pragma omp parallel for collapse(2)
+#endif
+                        for (std::size_t i = 0; i < permutation_size; i++) {
+                            for (std::size_t j = 0; j < rows; j++) {
+                                S_id[i][j] = twiddles.delta_powers[i] * twiddles.omega_powers[j];
                             }
-
-                            // S_id[i].resize(commitment_params.D[0]->size());
                         }
 
                         return S_id;
@@ -349,14 +409,54 @@ namespace nil {
                                                     domain,
                                                 const typename ParamsType::commitment_params_type &commitment_params) {
 
+                        return permutation_polynomials(
+                            permutation_size,
+                            *twiddles(domain->size(), permutation_columns(permutation), omega, delta), permutation,
+                            domain, commitment_params);
+                    }
+
+                    static inline std::vector<polynomial_dfs_type>
+                        permutation_polynomials(std::size_t permutation_size,
+                                                const twiddles_type &twiddles,
+                                                cycle_representation &permutation,
+                                                std::shared_ptr<math::evaluation_domain<FieldType>>
+                                                    domain,
+                                                const typename ParamsType::commitment_params_type &commitment_params) {
+                        typedef typename cycle_representation::key_type key_type;
+
+                        const std::size_t rows = domain->size();
+                        assert(twiddles.omega_powers.size() >= rows);
+
+                        // Flatten sigma for the permuted columns once: the mapping is ordered by (column, row),
+                        // so a single walk replaces a map lookup per cell.
+                        std::vector<key_type> sigma(permutation_size * rows);
+                        for (std::size_t i = 0; i < permutation_size; i++) {
+                            for (std::size_t j = 0; j < rows; j++) {
+                                sigma[i * rows + j] = key_type(i, j);
+                            }
+                        }
+                        for (auto it = permutation._mapping.begin();
+                             it != permutation._mapping.end() && it->first.first < permutation_size;
+                             ++it) {
+                            if (it->first.second < rows) {
+                                sigma[it->first.first * rows + it->first.second] = it->second;
+                            }
+                        }
+
                         std::vector<polynomial_dfs_type> S_perm(permutation_size);
                         for (std::size_t i = 0; i < permutation_size; i++) {
-                            S_perm[i] = polynomial_dfs_type(
-                                domain->size() - 1, domain->size(), FieldType::value_type::zero());
+                            S_perm[i] = polynomial_dfs_type(rows - 1, rows, FieldType::value_type::zero());
+                        }
 
-                            for (std::size_t j = 0; j < domain->size(); j++) {
-                                auto key = std::make_pair(i, j);
-                                S_perm[i][j] = delta.pow(permutation[key].first) * omega.pow(permutation[key].second);
+#ifdef MULTICORE
+#pragma omp parallel for collapse(2)
+#endif
+                        for (std::size_t i = 0; i < permutation_size; i++) {
+                            for (std::size_t j = 0; j < rows; j++) {
+                                const key_type &key = sigma[i * rows + j];
+                                assert(key.first < twiddles.delta_powers.size());
+                                assert(key.second < twiddles.omega_powers.size());
+                                S_perm[i][j] = twiddles.delta_powers[key.first] * twiddles.omega_powers[key.second];
                             }
                         }
 
@@ -448,18 +548,22 @@ namespace nil {
                         assert(max_gates_degree > 0);
 
                         std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain =
-                            math::make_evaluation_domain<FieldType>(N_rows);
+                            zk::detail::evaluation_domain_registry<FieldType>::domain(N_rows);
 
                         // TODO: add std::vector<std::size_t> columns_with_copy_constraints;
                         cycle_representation permutation(constraint_system, table_description);
 
-                        std::vector<polynomial_dfs_type> id_perm_polys =
-                            identity_polynomials(columns_with_copy_constraints, basic_domain->get_domain_element(1),
-                                                 ParamsType::delta, basic_domain, commitment_params);
+                        std::shared_ptr<twiddles_type> permutation_twiddles =
+                            twiddles(basic_domain->size(),
+                                     std::max(columns_with_copy_constraints, permutation_columns(permutation)),
+                                     basic_domain->get_domain_element(1), ParamsType::delta);
+
+                        std::vector<polynomial_dfs_type> id_perm_polys = identity_polynomials(
+                            columns_with_copy_constraints, *permutation_twiddles, basic_domain, commitment_params);
 
                         std::vector<polynomial_dfs_type> sigma_perm_polys =
-                            permutation_polynomials(columns_with_copy_constraints, basic_domain->get_domain_element(1),
-                                                    ParamsType::delta, permutation, basic_domain, commitment_params);
+                            permutation_polynomials(columns_with_copy_constraints, *permutation_twiddles, permutation,
+                                                    basic_domain, commitment_params);
 
                         polynomial_dfs_type lagrange_0 =
                             lagrange_polynomial(basic_domain, 0, commitment_params);
@@ -493,6 +597,7 @@ namespace nil {
                         typename preprocessed_data_type::common_data_type common_data (
                             public_commitments, c_rotations,  N_rows, table_description.usable_rows_amount,
                             max_gates_degree);
+                        common_data.twiddles = permutation_twiddles;
 
                         preprocessed_data_type preprocessed_data({public_polynomial_table, sigma_perm_polys,
                                                                   id_perm_polys, q_last_q_blind[0], q_last_q_blind[1],
@@ -525,7 +630,7 @@ namespace nil {
                         std::size_t N_rows = table_description.rows_amount;
 
                         std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain =
-                            math::make_evaluation_domain<FieldType>(N_rows);
+                            zk::detail::evaluation_domain_registry<FieldType>::domain(N_rows);
 
                         plonk_private_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params>
                             private_polynomial_table(detail::column_range_polynomial_dfs<FieldType>(
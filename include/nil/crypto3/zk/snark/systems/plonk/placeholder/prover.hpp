@@ -30,12 +30,20 @@
 
 #include <chrono>
 #include <set>
+#include <string>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 
 #include <nil/crypto3/container/merkle/tree.hpp>
 
 #include <nil/crypto3/zk/commitments/polynomial/lpc.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/column_storage.hpp>
+#include <nil/crypto3/zk/detail/buffer_pool.hpp>
+#include <nil/crypto3/zk/detail/temporary_file.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
@@ -69,6 +77,22 @@ namespace nil {
                     }
                 }    // namespace detail
 
+                /// File-backed commitment leaves. When directory is set, the committed batches are
+                /// extended one column at a time into uniquely named temporary files under it and their
+                /// Merkle trees are built from row chunks, keeping about leaf_memory_budget bytes of
+                /// extended column data resident while a batch is committed. The budget applies to the
+                /// commitment leaves only and does not bound the prover's memory: the basic-size table,
+                /// the extended-domain argument and quotient polynomials and the opening phase stay in
+                /// memory. Proofs are identical to the in-memory mode.
+                struct placeholder_commitment_storage_params {
+                    std::string directory;
+                    std::size_t leaf_memory_budget = std::size_t(1) << 26;
+
+                    bool enabled() const {
+                        return !directory.empty();
+                    }
+                };
+
                 template<typename FieldType, typename ParamsType>
                 class placeholder_prover {
 
@@ -94,6 +118,7 @@ namespace nil {
 
                     using public_preprocessor_type = placeholder_public_preprocessor<FieldType, ParamsType>;
                     using private_preprocessor_type = placeholder_private_preprocessor<FieldType, ParamsType>;
+                    using lookup_argument_type = placeholder_lookup_argument<FieldType, ParamsType>;
 
                     constexpr static const std::size_t gate_parts = 1;
                     constexpr static const std::size_t permutation_parts = 3;
@@ -109,11 +134,13 @@ namespace nil {
                         const plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params>
                             &constraint_system,
                         const typename policy_type::variable_assignment_type &assignments,
-                        const typename ParamsType::commitment_params_type &fri_params) { 
+                        const typename ParamsType::commitment_params_type &fri_params,
+                        const placeholder_commitment_storage_params &commitment_storage =
+                            placeholder_commitment_storage_params()) {
 
                         auto prover = placeholder_prover<FieldType, ParamsType>(
                             preprocessed_public_data, preprocessed_private_data, table_description,
-                            constraint_system, assignments, fri_params);
+                            constraint_system, assignments, fri_params, commitment_storage);
                         return prover.process();
                     }
 
@@ -123,13 +150,16 @@ namespace nil {
                         const plonk_table_description<FieldType, typename ParamsType::arithmetization_params> &table_description,
                         const plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params> &constraint_system,
                         const typename policy_type::variable_assignment_type &assignments,
-                        const typename ParamsType::commitment_params_type &fri_params) 
+                        const typename ParamsType::commitment_params_type &fri_params,
+                        const placeholder_commitment_storage_params &commitment_storage =
+                            placeholder_commitment_storage_params())
                             : preprocessed_public_data(preprocessed_public_data)
                             , preprocessed_private_data(preprocessed_private_data)
                             , table_description(table_description)
                             , constraint_system(constraint_system)
                             , assignments(assignments)
                             , fri_params(fri_params)
+                            , _commitment_storage(commitment_storage)
                             , _polynomial_table(preprocessed_private_data.private_polynomial_table,
                                                 preprocessed_public_data.public_polynomial_table) 
                             , _is_lookup_enabled(constraint_system.lookup_gates().size() > 0)
@@ -153,36 +183,64 @@ namespace nil {
                             _combined_poly[0].push_back(_polynomial_table.public_input(i));
                         }
 
+                        // Sorted lookup columns are committed together with the witness
+                        if (_is_lookup_enabled) {
+                            _lookups = lookup_argument_type::lookups(constraint_system.lookup_gates());
+                            _lookup_sorted_columns = lookup_argument_type::sorted_columns(
+                                _lookups, _polynomial_table, preprocessed_public_data.common_data.usable_rows_amount);
+                            _combined_poly[0].insert(std::end(_combined_poly[0]), std::begin(_lookup_sorted_columns),
+                                                     std::end(_lookup_sorted_columns));
+                        }
+
                         auto variable_values_precommitment = precommit_witness();
 
                         _proof.variable_values_commitment =
                             algorithms::commit<commitment_scheme_type>(variable_values_precommitment);
                         transcript(_proof.variable_values_commitment);
 
+                        // 3. theta compresses lookup tuples
+                        if (_is_lookup_enabled) {
+                            _lookup_theta = transcript.template challenge<FieldType>();
+                        }
+
                         // 4. permutation_argument
+                        typename FieldType::value_type beta = transcript.template challenge<FieldType>();
+                        typename FieldType::value_type gamma = transcript.template challenge<FieldType>();
+
                         auto permutation_argument = placeholder_permutation_argument<FieldType, ParamsType>::prove_eval(
-                            constraint_system,
                             preprocessed_public_data,
-                            table_description,
                             _polynomial_table,
                             fri_params,
-                            transcript);
-
-                        _proof.v_perm_commitment = permutation_argument.permutation_poly_precommitment.root();
+                            beta, gamma, _buffers);
 
                         _F_dfs[0] = std::move(permutation_argument.F_dfs[0]);
                         _F_dfs[1] = std::move(permutation_argument.F_dfs[1]);
                         _F_dfs[2] = std::move(permutation_argument.F_dfs[2]);
 
+                        // V_P and the lookup grand products V_L share beta, gamma and one commitment
+                        _combined_poly[1].push_back(std::move(permutation_argument.permutation_polynomial_dfs));
+                        if (_is_lookup_enabled) {
+                            _lookup_V_L = lookup_argument_type::grand_products(
+                                _lookups, _polynomial_table, _lookup_sorted_columns, _lookup_theta, beta, gamma);
+                            _combined_poly[1].insert(std::end(_combined_poly[1]), std::begin(_lookup_V_L),
+                                                     std::end(_lookup_V_L));
+                        }
+
+                        auto permutation_poly_precommitment = precommit_permutation();
+
+                        _proof.v_perm_commitment =
+                            algorithms::commit<commitment_scheme_type>(permutation_poly_precommitment);
+                        transcript(_proof.v_perm_commitment);
+
                         // 5. lookup_argument
-                        auto lookup_argument_result = lookup_argument();
+                        lookup_argument(beta, gamma);
 
                         // 6. circuit-satisfability
                         _F_dfs[8] = placeholder_gates_argument<FieldType, ParamsType>::prove_eval(
                             constraint_system, _polynomial_table,
                             preprocessed_public_data.common_data.basic_domain,
                             preprocessed_public_data.common_data.max_gates_degree,
-                            transcript)[0];
+                            transcript, _buffers)[0];
 
                         /////TEST
 #ifdef ZK_PLACEHOLDER_DEBUG_ENABLED
@@ -200,14 +258,10 @@ namespace nil {
                         // 8. Run evaluation proofs
                         auto variable_values_evaluation_points = run_evaluation_proofs();
 
-                        // permutation polynomial evaluation 
-                        std::vector<std::vector<typename FieldType::value_type>> evaluation_points_v_p = 
-                            {{_proof.eval_proof.challenge, _proof.eval_proof.challenge * _omega}};
-
-                        _combined_poly[1].push_back(std::move(permutation_argument.permutation_polynomial_dfs));
-
-                        // lookup polynomials evaluation
-                        run_lookup_polynomials_eval();
+                        // permutation and lookup grand products evaluation
+                        std::vector<std::vector<typename FieldType::value_type>> evaluation_points_v_p(
+                            _combined_poly[1].size(),
+                            {_proof.eval_proof.challenge, _proof.eval_proof.challenge * _omega});
 
                         // quotient
                         _challenge_point = {_proof.eval_proof.challenge};
@@ -225,7 +279,7 @@ namespace nil {
                             std::move(variable_values_precommitment),
                             std::move(T_precommitment),
                             std::move(evaluation_points_v_p),
-                            std::move(permutation_argument.permutation_poly_precommitment));
+                            std::move(permutation_poly_precommitment));
 
                         _proof.fixed_values_commitment = preprocessed_public_data.common_data.commitments.fixed_values;
                         return std::move(_proof);
@@ -234,8 +288,42 @@ namespace nil {
                 private:
                     typename commitment_scheme_type::precommitment_type precommit_witness() {
                         PROFILE_PLACEHOLDER_SCOPE("witness_precommit_time");
-                        return algorithms::precommit<commitment_scheme_type>(
-                            _combined_poly[0], fri_params.D[0], fri_params.step_list.front());
+                        return precommit_columns(_combined_poly[0], 0);
+                    }
+
+                    typename commitment_scheme_type::precommitment_type precommit_permutation() {
+                        PROFILE_PLACEHOLDER_SCOPE("permutation_precommit_time");
+                        return precommit_columns(_combined_poly[1], 1);
+                    }
+
+                    typename commitment_scheme_type::precommitment_type
+                        precommit_columns(const std::vector<polynomial_dfs_type> &columns, std::size_t batch) {
+                        if (!_commitment_storage.enabled()) {
+                            return algorithms::precommit<commitment_scheme_type>(
+                                columns, fri_params.D[0], fri_params.step_list.front());
+                        }
+
+                        const std::size_t fri_step = fri_params.step_list.front();
+                        const std::size_t value_bytes = commitment_scheme_type::field_element_type::length();
+                        commitments::detail::file_column_storage<FieldType> storage(
+                            zk::detail::create_temporary_file(_commitment_storage.directory,
+                                                              "placeholder_batch_" + std::to_string(batch) + "_"),
+                            columns.size(), fri_params.D[0]->size());
+
+                        // Only one extended column is resident while the storage is filled
+                        const std::size_t leaf_memory_budget = _commitment_storage.leaf_memory_budget;
+                        const std::size_t chunk_rows = std::max<std::size_t>(
+                            1, leaf_memory_budget / (value_bytes + sizeof(typename FieldType::value_type)));
+                        for (std::size_t i = 0; i < columns.size(); i++) {
+                            algorithms::store_column<commitment_scheme_type>(storage, i, columns[i], fri_params.D[0],
+                                                                             chunk_rows);
+                        }
+
+                        const std::size_t leaf_bytes = columns.size() * (std::size_t(1) << fri_step) * value_bytes;
+                        return algorithms::precommit_storage<commitment_scheme_type>(
+                            storage, fri_params.D[0], fri_step,
+                            std::max<std::size_t>(
+                                1, leaf_memory_budget / (leaf_bytes + sizeof(typename FieldType::value_type))));
                     }
 
                     std::vector<polynomial_dfs_type> quotient_polynomial_split_dfs() {
@@ -245,9 +333,11 @@ namespace nil {
 
                         PROFILE_PLACEHOLDER_SCOPE("split_polynomial_dfs_conversion_time");
 
-                        std::vector<polynomial_dfs_type> T_splitted_dfs(
-                            T_splitted.size(), polynomial_dfs_type(0, fri_params.D[0]->size()));
+                        const polynomial_dfs_type shape(0, fri_params.D[0]->size());
+                        std::vector<polynomial_dfs_type> T_splitted_dfs;
+                        T_splitted_dfs.reserve(T_splitted.size());
                         for (std::size_t k = 0; k < T_splitted.size(); k++) {
+                            T_splitted_dfs.push_back(_buffers.acquire_like(shape));
                             T_splitted_dfs[k].from_coefficients(T_splitted[k]);
                             if (T_splitted_dfs[k].size() != fri_params.D[0]->size())
                                 T_splitted_dfs[k].resize(fri_params.D[0]->size());
@@ -262,70 +352,93 @@ namespace nil {
                         std::array<typename FieldType::value_type, f_parts> alphas =
                             transcript.template challenges<FieldType, f_parts>();
 
-                        // 7.2. Compute F_consolidated
-                        polynomial_dfs_type F_consolidated_dfs(
-                            0, _F_dfs[0].size(), FieldType::value_type::zero());
+                        // 7.2. Compute F_consolidated, accumulating the parts in place row by row
+                        // into the part of the largest degree and releasing every other part to the pool
+                        std::size_t max_size = _F_dfs[0].size();
+                        std::size_t max_degree = 0;
+                        std::size_t base = f_parts;
                         for (std::size_t i = 0; i < f_parts; i++) {
                             if (_F_dfs[i].is_zero()) {
                                 continue;
                             }
-                            F_consolidated_dfs += alphas[i] * _F_dfs[i];
+                            max_size = std::max(max_size, _F_dfs[i].size());
+                            if (base == f_parts || _F_dfs[i].degree() > max_degree) {
+                                base = i;
+                                max_degree = _F_dfs[i].degree();
+                            }
+                        }
+
+                        polynomial_dfs_type F_consolidated_dfs;
+                        if (base == f_parts) {
+                            F_consolidated_dfs = polynomial_dfs_type(0, max_size, FieldType::value_type::zero());
+                        } else {
+                            F_consolidated_dfs = std::move(_F_dfs[base]);
+                            _F_dfs[base] = polynomial_dfs_type();
+                            if (F_consolidated_dfs.size() != max_size) {
+                                F_consolidated_dfs.resize(max_size);
+                            }
+                            const typename FieldType::value_type alpha = alphas[base];
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t j = 0; j < max_size; j++) {
+                                F_consolidated_dfs[j] *= alpha;
+                            }
+                        }
+                        for (std::size_t i = 0; i < f_parts; i++) {
+                            if (i == base || _F_dfs[i].is_zero()) {
+                                continue;
+                            }
+                            if (_F_dfs[i].size() != max_size) {
+                                _F_dfs[i].resize(max_size);
+                            }
+
+                            const polynomial_dfs_type &F_i = _F_dfs[i];
+                            const typename FieldType::value_type alpha = alphas[i];
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t j = 0; j < max_size; j++) {
+                                F_consolidated_dfs[j] += alpha * F_i[j];
+                            }
+                            _buffers.release(std::move(_F_dfs[i]));
+                            _F_dfs[i] = polynomial_dfs_type();
                         }
 
                         polynomial_type F_consolidated_normal(F_consolidated_dfs.coefficients());
+                        _buffers.release(std::move(F_consolidated_dfs));
                         polynomial_type T_consolidated =
                             F_consolidated_normal / preprocessed_public_data.common_data.Z;
 
                         return T_consolidated;
                     }
                     
-                    typename placeholder_lookup_argument<
-                        FieldType, commitment_scheme_type, ParamsType>::prover_lookup_result 
-                    lookup_argument() {
-
+                    void lookup_argument(const typename FieldType::value_type &beta,
+                                         const typename FieldType::value_type &gamma) {
                         PROFILE_PLACEHOLDER_SCOPE("lookup_argument_time");
 
-                        typename placeholder_lookup_argument<
-                            FieldType,
-                            commitment_scheme_type,
-                            ParamsType>::prover_lookup_result lookup_argument_result;
-
-                        if (_is_lookup_enabled) {
-                            for (std::size_t i = 0; i < lookup_argument_result.F.size(); i++) {
-                                lookup_argument_result.F[i] = {0};
-                            }
-                            // lookup_argument_result =
-                            //     placeholder_lookup_argument<FieldType, permutation_commitment_scheme_type,
-                            //                                 ParamsType>::prove_eval(constraint_system,
-                            //                                                         preprocessed_public_data,
-                            //                                                         assignments,
-                            //                                                         fri_params,
-                            //                                                         transcript);
-                        } else {
-                            for (std::size_t i = 0; i < lookup_argument_result.F.size(); i++) {
-                                lookup_argument_result.F[i] = {0};
-                            }
+                        if (!_is_lookup_enabled) {
+                            _F_dfs[3] = _F_dfs[4] = _F_dfs[5] = _F_dfs[6] = _F_dfs[7] =
+                                polynomial_dfs_type(0, _F_dfs[0].size(), FieldType::value_type::zero());
+                            return;
                         }
-                        // TODO: remove when lookups will be implemented
-                        _F_dfs[3] = _F_dfs[4]  = _F_dfs[5] = _F_dfs[6] = _F_dfs[7] =
-                            polynomial_dfs_type(0,_F_dfs[0].size(),FieldType::value_type::zero());
-                        
-                        if (_is_lookup_enabled) {
-                            // _proof.input_perm_commitment = lookup_argument_result.input_precommitment.root();
-                            // _proof.value_perm_commitment = lookup_argument_result.value_precommitment.root();
-                            // _proof.v_l_perm_commitment = lookup_argument_result.V_L_precommitment.root();
+
+                        // lambda combines the parts of different lookups
+                        typename FieldType::value_type lambda = transcript.template challenge<FieldType>();
+                        std::array<polynomial_dfs_type, lookup_argument_type::argument_size> F_dfs =
+                            lookup_argument_type::prove_eval(_lookups, preprocessed_public_data, _polynomial_table,
+                                                             _lookup_sorted_columns, _lookup_V_L, _lookup_theta,
+                                                             beta, gamma, lambda, _buffers);
+                        for (std::size_t i = 0; i < lookup_argument_type::argument_size; i++) {
+                            _F_dfs[3 + i] = std::move(F_dfs[i]);
                         }
-                        return lookup_argument_result;
                     }
 
                     typename commitment_scheme_type::precommitment_type 
                     T_precommit(const std::vector<polynomial_dfs_type>& T_splitted_dfs) {
                         PROFILE_PLACEHOLDER_SCOPE("T_splitted_precommit_time");
 
-                        return algorithms::precommit<commitment_scheme_type>(
-                            T_splitted_dfs,
-                            fri_params.D[0],
-                            fri_params.step_list.front());
+                        return precommit_columns(T_splitted_dfs, 2);
                     }
                 
                     void commit_T(const typename commitment_scheme_type::precommitment_type& T_precommitment) {
@@ -388,65 +501,18 @@ namespace nil {
                                 evaluation_points.push_back(_proof.eval_proof.challenge * _omega.pow(rotation));
                             }
                         }
-                        return variable_values_evaluation_points;
-                    }
 
-                    void run_lookup_polynomials_eval() {
-                        if (_is_lookup_enabled) {
-//                             std::vector<typename FieldType::value_type> evaluation_points_v_l = {_proof.eval_proof.challenge,
-//                                                                                                  _proof.eval_proof.challenge * _omega};
-//                             typename permutation_commitment_scheme_type::proof_type v_l_evaluation =
-//                                 algorithms::proof_eval<permutation_commitment_scheme_type>(
-//                                     evaluation_points_v_l,
-//                                     lookup_argument_result.V_L_precommitment,
-//                                     lookup_argument_result.V_L_polynomial,
-//                                     fri_params,
-//                                     transcript);
-//                             _proof.eval_proof.lookups.push_back(v_l_evaluation);
-
-// #ifdef ZK_PLACEHOLDER_PROFILING_ENABLED
-//                             elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
-//                                 std::chrono::high_resolution_clock::now() - last);
-//                             std::cout << "v_l_evaluation proof_eval, time: " << std::fixed << std::setprecision(3)
-//                                       << elapsed.count() * 1e-6 << "ms" << std::endl;
-//                             last = std::chrono::high_resolution_clock::now();
-// #endif
-//                             std::vector<typename FieldType::value_type> evaluation_points_input = {
-//                                 _proof.eval_proof.challenge, _proof.eval_proof.challenge * _omega.inversed()};
-//                             typename permutation_commitment_scheme_type::proof_type input_evaluation =
-//                                 algorithms::proof_eval<permutation_commitment_scheme_type>(
-//                                     evaluation_points_input,
-//                                     lookup_argument_result.input_precommitment,
-//                                     lookup_argument_result.input_polynomial,
-//                                     fri_params,
-//                                     transcript);
-//                             _proof.eval_proof.lookups.push_back(input_evaluation);
-
-// #ifdef ZK_PLACEHOLDER_PROFILING_ENABLED
-//                             elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
-//                                 std::chrono::high_resolution_clock::now() - last);
-//                             std::cout << "input_evaluation proof_eval, time: " << std::fixed << std::setprecision(3)
-//                                       << elapsed.count() * 1e-6 << "ms" << std::endl;
-//                             last = std::chrono::high_resolution_clock::now();
-// #endif
-//                             std::vector<typename FieldType::value_type> evaluation_points_value = {_proof.eval_proof.challenge};
-//                             typename permutation_commitment_scheme_type::proof_type value_evaluation =
-//                                 algorithms::proof_eval<permutation_commitment_scheme_type>(
-//                                     evaluation_points_value,
-//                                     lookup_argument_result.value_precommitment,
-//                                     lookup_argument_result.value_polynomial,
-//                                     fri_params,
-//                                     transcript);
-//                             _proof.eval_proof.lookups.push_back(value_evaluation);
-
-// #ifdef ZK_PLACEHOLDER_PROFILING_ENABLED
-//                             elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
-//                                 std::chrono::high_resolution_clock::now() - last);
-//                             std::cout << "value_evaluation proof_eval, time: " << std::fixed << std::setprecision(3)
-//                                       << elapsed.count() * 1e-6 << "ms" << std::endl;
-//                             last = std::chrono::high_resolution_clock::now();
-// #endif
+                        // sorted lookup columns: A' at y and y * omega^{-1}, S' at y
+                        for (const auto &lookup : _lookups) {
+                            for (std::size_t k = 0; k < lookup.width(); k++) {
+                                variable_values_evaluation_points.push_back(
+                                    {_proof.eval_proof.challenge, _proof.eval_proof.challenge * _omega.inversed()});
+                            }
+                            for (std::size_t k = 0; k < lookup.width(); k++) {
+                                variable_values_evaluation_points.push_back({_proof.eval_proof.challenge});
+                            }
                         }
+                        return variable_values_evaluation_points;
                     }
 
                     std::vector<std::vector<typename FieldType::value_type>> compute_evaluation_points_public() {
@@ -533,7 +599,7 @@ namespace nil {
                         return algorithms::proof_eval<commitment_scheme_type>(
                              evaluations_points,
                              precommitments,
-                             _combined_poly, fri_params, transcript);
+                             _combined_poly, fri_params, transcript, _buffers);
                     }
 
                 private:
@@ -544,14 +610,21 @@ namespace nil {
                     const plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params> &constraint_system;
                     const typename policy_type::variable_assignment_type &assignments;
                     const typename ParamsType::commitment_params_type &fri_params;
-                    
+                    const placeholder_commitment_storage_params _commitment_storage;
+
                     // Members created during proof generation.
                     plonk_polynomial_dfs_table<FieldType, typename ParamsType::arithmetization_params> _polynomial_table;
                     placeholder_proof<FieldType, ParamsType> _proof;
                     std::array<std::vector<polynomial_dfs_type>, 4> _combined_poly;
                     std::array<polynomial_dfs_type, f_parts> _F_dfs;
+                    // Per-round polynomial scratch shared by the arguments, the quotient and the LPC proof.
+                    zk::detail::buffer_pool<typename FieldType::value_type, polynomial_dfs_type> _buffers;
                     transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript;
                     bool _is_lookup_enabled;
+                    std::vector<typename lookup_argument_type::lookup_type> _lookups;
+                    std::vector<polynomial_dfs_type> _lookup_sorted_columns;
+                    std::vector<polynomial_dfs_type> _lookup_V_L;
+                    typename FieldType::value_type _lookup_theta;
                     typename FieldType::value_type _omega;
                     std::vector<typename FieldType::value_type> _challenge_point;
 
@@ -0,0 +1,261 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_PLONK_PLACEHOLDER_VERIFICATION_KEY_HPP
+#define CRYPTO3_ZK_PLONK_PLACEHOLDER_VERIFICATION_KEY_HPP
+
+#include <array>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/math/algorithms/unity_root.hpp>
+
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                /// Verifier-only part of the Placeholder public preprocessed data.
+                ///
+                /// Holds the fixed values commitment, the table shape and columns rotations.
+                /// Everything the verifier needs from the preprocessed polynomials is opened
+                /// from the commitment or computed in closed form, so the size of the key
+                /// does not depend on the number of rows.
+                template<typename FieldType, typename ParamsType>
+                struct placeholder_verification_key {
+                    typedef FieldType field_type;
+                    typedef ParamsType params_type;
+
+                    typedef placeholder_public_preprocessor<FieldType, ParamsType> public_preprocessor_type;
+                    typedef typename public_preprocessor_type::preprocessed_data_type preprocessed_data_type;
+                    typedef typename preprocessed_data_type::common_data_type::columns_rotations_type
+                        columns_rotations_type;
+                    typedef typename ParamsType::runtime_size_commitment_scheme_type commitment_scheme_type;
+                    typedef typename commitment_scheme_type::commitment_type commitment_type;
+
+                    commitment_type fixed_values_commitment;
+                    columns_rotations_type columns_rotations;
+
+                    std::size_t rows_amount;
+                    std::size_t usable_rows_amount;
+                    std::uint32_t max_gates_degree;
+                    // Number of columns with copy constraints
+                    std::size_t permutation_size;
+
+                    // not serialized, derived from rows_amount
+                    typename FieldType::value_type omega;
+
+                    placeholder_verification_key() :
+                        rows_amount(0), usable_rows_amount(0), max_gates_degree(0), permutation_size(0) {
+                    }
+
+                    placeholder_verification_key(const commitment_type &fixed_values_commitment,
+                                                 const columns_rotations_type &columns_rotations,
+                                                 std::size_t rows_amount,
+                                                 std::size_t usable_rows_amount,
+                                                 std::uint32_t max_gates_degree,
+                                                 std::size_t permutation_size) :
+                        fixed_values_commitment(fixed_values_commitment),
+                        columns_rotations(columns_rotations), rows_amount(rows_amount),
+                        usable_rows_amount(usable_rows_amount), max_gates_degree(max_gates_degree),
+                        permutation_size(permutation_size), omega(math::unity_root<FieldType>(rows_amount)) {
+                    }
+
+                    explicit placeholder_verification_key(const preprocessed_data_type &preprocessed_data) :
+                        fixed_values_commitment(preprocessed_data.common_data.commitments.fixed_values),
+                        columns_rotations(preprocessed_data.common_data.columns_rotations),
+                        rows_amount(preprocessed_data.common_data.rows_amount),
+                        usable_rows_amount(preprocessed_data.common_data.usable_rows_amount),
+                        max_gates_degree(preprocessed_data.common_data.max_gates_degree),
+                        permutation_size(preprocessed_data.identity_polynomials.size()),
+                        omega(preprocessed_data.common_data.basic_domain->get_domain_element(1)) {
+                    }
+
+                    // Z(y) = y^n - 1
+                    typename FieldType::value_type Z(const typename FieldType::value_type &y) const {
+                        return y.pow(rows_amount) - FieldType::value_type::one();
+                    }
+
+                    // The Lagrange polynomial which is 1 at omega^{usable_rows} (common_data.lagrange_0):
+                    // L(y) = omega^k * (y^n - 1) / (n * (y - omega^k))
+                    typename FieldType::value_type lagrange_0(const typename FieldType::value_type &y) const {
+                        typename FieldType::value_type omega_k = omega.pow(usable_rows_amount);
+                        typename FieldType::value_type n = typename FieldType::value_type(rows_amount);
+
+                        return omega_k * Z(y) * (n * (y - omega_k)).inversed();
+                    }
+
+                    // The Lagrange polynomial which is 1 at the first row, used by the lookup argument:
+                    // L(y) = (y^n - 1) / (n * (y - 1))
+                    typename FieldType::value_type lagrange_first(const typename FieldType::value_type &y) const {
+                        typename FieldType::value_type n = typename FieldType::value_type(rows_amount);
+
+                        return Z(y) * (n * (y - FieldType::value_type::one())).inversed();
+                    }
+
+                    bool operator==(const placeholder_verification_key &rhs) const {
+                        return fixed_values_commitment == rhs.fixed_values_commitment &&
+                               columns_rotations == rhs.columns_rotations && rows_amount == rhs.rows_amount &&
+                               usable_rows_amount == rhs.usable_rows_amount &&
+                               max_gates_degree == rhs.max_gates_degree && permutation_size == rhs.permutation_size;
+                    }
+                    bool operator!=(const placeholder_verification_key &rhs) const {
+                        return !(rhs == *this);
+                    }
+
+                    /// Serialized form: little-endian 64-bit rows_amount, usable_rows_amount, max_gates_degree
+                    /// and permutation_size, then the fixed values commitment (its bytes, or the marshalled
+                    /// field element for a field-native Merkle tree), then for each column the number of
+                    /// rotations followed by the rotations as 32-bit two's complement values.
+                    std::vector<std::uint8_t> serialize() const {
+                        std::vector<std::uint8_t> blob;
+
+                        write_integral(blob, rows_amount, 8);
+                        write_integral(blob, usable_rows_amount, 8);
+                        write_integral(blob, max_gates_degree, 8);
+                        write_integral(blob, permutation_size, 8);
+                        write_commitment(blob, fixed_values_commitment);
+                        for (const std::set<int> &rotations : columns_rotations) {
+                            write_integral(blob, rotations.size(), 4);
+                            for (int rotation : rotations) {
+                                write_integral(blob, static_cast<std::uint32_t>(rotation), 4);
+                            }
+                        }
+
+                        return blob;
+                    }
+
+                    /// Returns false if the blob is truncated, has trailing data or describes an invalid domain.
+                    template<typename InputIterator>
+                    static bool deserialize(InputIterator first, InputIterator last,
+                                            placeholder_verification_key &vk) {
+                        std::uint64_t rows, usable_rows, max_degree, permutation_size;
+                        if (!read_integral(first, last, rows, 8) || !read_integral(first, last, usable_rows, 8) ||
+                            !read_integral(first, last, max_degree, 8) ||
+                            !read_integral(first, last, permutation_size, 8)) {
+                            return false;
+                        }
+                        if (rows == 0 || (rows & (rows - 1)) != 0 || usable_rows >= rows) {
+                            return false;
+                        }
+
+                        commitment_type commitment;
+                        if (!read_commitment(first, last, commitment)) {
+                            return false;
+                        }
+
+                        columns_rotations_type rotations;
+                        for (std::set<int> &column_rotations : rotations) {
+                            std::uint64_t size;
+                            if (!read_integral(first, last, size, 4)) {
+                                return false;
+                            }
+                            for (std::size_t i = 0; i < size; ++i) {
+                                std::uint64_t rotation;
+                                if (!read_integral(first, last, rotation, 4)) {
+                                    return false;
+                                }
+                                column_rotations.insert(static_cast<int>(static_cast<std::uint32_t>(rotation)));
+                            }
+                        }
+                        if (first != last) {
+                            return false;
+                        }
+
+                        vk = placeholder_verification_key(commitment, rotations, rows, usable_rows, max_degree,
+                                                          permutation_size);
+                        return true;
+                    }
+
+                private:
+                    static void write_integral(std::vector<std::uint8_t> &blob, std::uint64_t value,
+                                               std::size_t bytes) {
+                        for (std::size_t i = 0; i < bytes; ++i) {
+                            blob.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+                        }
+                    }
+
+                    static void write_commitment(std::vector<std::uint8_t> &blob, const commitment_type &commitment) {
+                        if constexpr (commitment_scheme_type::field_native_merkle_tree) {
+                            typedef typename commitment_scheme_type::field_element_type field_element_type;
+                            const std::size_t length = field_element_type::length();
+                            blob.resize(blob.size() + length);
+                            auto write_iter = blob.end() - length;
+                            field_element_type(commitment).write(write_iter, length);
+                        } else {
+                            blob.insert(blob.end(), commitment.begin(), commitment.end());
+                        }
+                    }
+
+                    template<typename InputIterator>
+                    static bool read_commitment(InputIterator &first, InputIterator last, commitment_type &commitment) {
+                        if constexpr (commitment_scheme_type::field_native_merkle_tree) {
+                            typedef typename commitment_scheme_type::field_element_type field_element_type;
+                            std::vector<std::uint8_t> bytes(field_element_type::length());
+                            for (std::uint8_t &byte : bytes) {
+                                if (first == last) {
+                                    return false;
+                                }
+                                byte = static_cast<std::uint8_t>(*first++);
+                            }
+
+                            field_element_type element;
+                            auto read_iter = bytes.cbegin();
+                            if (element.read(read_iter, bytes.size()) != nil::marshalling::status_type::success) {
+                                return false;
+                            }
+                            commitment = element.value();
+                        } else {
+                            for (auto it = commitment.begin(); it != commitment.end(); ++it, ++first) {
+                                if (first == last) {
+                                    return false;
+                                }
+                                *it = *first;
+                            }
+                        }
+                        return true;
+                    }
+
+                    template<typename InputIterator>
+                    static bool read_integral(InputIterator &first, InputIterator last, std::uint64_t &value,
+                                              std::size_t bytes) {
+                        value = 0;
+                        for (std::size_t i = 0; i < bytes; ++i, ++first) {
+                            if (first == last) {
+                                return false;
+                            }
+                            value |= std::uint64_t(static_cast<std::uint8_t>(*first)) << (8 * i);
+                        }
+                        return true;
+                    }
+                };
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_PLONK_PLACEHOLDER_VERIFICATION_KEY_HPP
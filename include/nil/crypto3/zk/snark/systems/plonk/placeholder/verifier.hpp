@@ -34,8 +34,10 @@
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint_system.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/permutation_argument.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/lookup_argument.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
+#include <nil/crypto3/zk/snark/systems/plonk/placeholder/verification_key.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -60,6 +62,7 @@ namespace nil {
 
                     using commitment_scheme_type = typename ParamsType::runtime_size_commitment_scheme_type;
                     using public_preprocessor_type = placeholder_public_preprocessor<FieldType, ParamsType>;
+                    using lookup_argument_type = placeholder_lookup_argument<FieldType, ParamsType>;
 
                     constexpr static const std::size_t gate_parts = 1;
                     constexpr static const std::size_t permutation_parts = 3;
@@ -67,12 +70,25 @@ namespace nil {
                     constexpr static const std::size_t f_parts = 9;
 
                 public:
+                    using verification_key_type = placeholder_verification_key<FieldType, ParamsType>;
+
                     static inline bool process(
                         const typename public_preprocessor_type::preprocessed_data_type &preprocessed_public_data,
                         const placeholder_proof<FieldType, ParamsType> &proof,
                         const plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params>
                             &constraint_system,
                         const typename ParamsType::commitment_params_type &fri_params) {
+
+                        return process(verification_key_type(preprocessed_public_data), proof, constraint_system,
+                                       fri_params);
+                    }
+
+                    static inline bool process(
+                        const verification_key_type &verification_key,
+                        const placeholder_proof<FieldType, ParamsType> &proof,
+                        const plonk_constraint_system<FieldType, typename ParamsType::arithmetization_params>
+                            &constraint_system,
+                        const typename ParamsType::commitment_params_type &fri_params) {
                         
                         // 1. Add circuit definition to transcript
                         // transcript(short_description);
@@ -82,13 +98,32 @@ namespace nil {
                         // 3. append witness commitments to transcript
                         transcript(proof.variable_values_commitment);
 
+                        bool use_lookup = constraint_system.lookup_gates().size() > 0;
+                        std::vector<typename lookup_argument_type::lookup_type> lookups;
+                        typename FieldType::value_type theta;
+                        if (use_lookup) {
+                            lookups = lookup_argument_type::lookups(constraint_system.lookup_gates());
+                            theta = transcript.template challenge<FieldType>();
+                        }
+                        // sorted lookup columns follow the witness, lookup grand products follow V_P
+                        if (proof.eval_proof.combined_value.z[0].size() !=
+                                witness_columns + public_input_columns +
+                                    lookup_argument_type::sorted_columns_amount(lookups) ||
+                            proof.eval_proof.combined_value.z[1].size() != 1 + lookups.size()) {
+                            return false;
+                        }
+
                         // 4. prepare evaluaitons of the polynomials that are copy-constrained
-                        std::size_t permutation_size = (proof.eval_proof.combined_value.z[3].size() - 2 - constant_columns - selector_columns) / 2;
+                        std::size_t permutation_size = verification_key.permutation_size;
+                        if (proof.eval_proof.combined_value.z[3].size() !=
+                            2 * permutation_size + constant_columns + selector_columns + 2) {
+                            return false;
+                        }
                         std::vector<typename FieldType::value_type> f(permutation_size);
 
                         for (std::size_t i = 0; i < permutation_size; i++) {
                             std::size_t zero_index = 0;
-                            for (int v: preprocessed_public_data.common_data.columns_rotations[i]) {
+                            for (int v: verification_key.columns_rotations[i]) {
                                 if (v == 0)
                                     break;
                                 ++zero_index;
@@ -102,21 +137,34 @@ namespace nil {
                         }
 
                         // 5. permutation argument
-                        if (preprocessed_public_data.common_data.lagrange_0.evaluate(proof.eval_proof.challenge) !=
+                        if (verification_key.lagrange_0(proof.eval_proof.challenge) !=
                             proof.eval_proof.lagrange_0) {
                             return false;
                         }
+                        // S_sigma, q_last and q_blind are opened together with the other fixed values
+                        const auto &fixed_values = proof.eval_proof.combined_value.z[3];
+                        std::vector<typename FieldType::value_type> S_sigma_at_y(permutation_size);
+                        for (std::size_t i = 0; i < permutation_size; i++) {
+                            S_sigma_at_y[i] = fixed_values[permutation_size + i][0];
+                        }
+
+                        // V_P and the lookup grand products share beta, gamma and one commitment
+                        typename FieldType::value_type beta = transcript.template challenge<FieldType>();
+                        typename FieldType::value_type gamma = transcript.template challenge<FieldType>();
+                        transcript(proof.v_perm_commitment);
+
                         std::array<typename FieldType::value_type, permutation_parts> permutation_argument =
                             placeholder_permutation_argument<FieldType, ParamsType>::verify_eval(
-                                preprocessed_public_data, proof.eval_proof.challenge, f,
+                                proof.eval_proof.challenge, f, S_sigma_at_y, proof.eval_proof.lagrange_0,
+                                fixed_values[fixed_values.size() - 2][0], fixed_values[fixed_values.size() - 1][0],
                                 proof.eval_proof.combined_value.z[1][0][0], proof.eval_proof.combined_value.z[1][0][1],
-                                proof.v_perm_commitment, transcript);
+                                beta, gamma);
 
                         typename policy_type::evaluation_map columns_at_y;
                         for (std::size_t i = 0; i < witness_columns; i++) {
                             std::size_t i_global_index = i;
                             std::size_t j = 0;
-                            for (int rotation: preprocessed_public_data.common_data.columns_rotations[i_global_index]) {
+                            for (int rotation: verification_key.columns_rotations[i_global_index]) {
                                 auto key = std::make_tuple(
                                     i,
                                     rotation,
@@ -130,7 +178,7 @@ namespace nil {
                             std::size_t i_global_index = witness_columns + i;
 
                             std::size_t j = 0;
-                            for (int rotation: preprocessed_public_data.common_data.columns_rotations[i_global_index]) {
+                            for (int rotation: verification_key.columns_rotations[i_global_index]) {
                                 auto key = std::make_tuple(
                                     i,
                                     rotation,
@@ -143,7 +191,7 @@ namespace nil {
                         for (std::size_t i = 0; i < 0 + constant_columns; i++) {
                             std::size_t i_global_index = witness_columns + public_input_columns + i;
                             std::size_t j = 0;
-                            for (int rotation: preprocessed_public_data.common_data.columns_rotations[i_global_index]) {
+                            for (int rotation: verification_key.columns_rotations[i_global_index]) {
                                 auto key = std::make_tuple(
                                     i,
                                     rotation,
@@ -156,7 +204,7 @@ namespace nil {
                         for (std::size_t i = 0; i < selector_columns; i++) {
                             std::size_t i_global_index = witness_columns + constant_columns + public_input_columns + i;
                             std::size_t j = 0;
-                            for (int rotation: preprocessed_public_data.common_data.columns_rotations[i_global_index]) {
+                            for (int rotation: verification_key.columns_rotations[i_global_index]) {
                                 auto key = std::make_tuple(
                                     i,
                                     rotation,
@@ -167,23 +215,24 @@ namespace nil {
                         }
 
                         // 6. lookup argument
-                        bool use_lookup = constraint_system.lookup_gates().size() > 0;
                         std::array<typename FieldType::value_type, lookup_parts> lookup_argument;
                         if (use_lookup) {
-                            for (std::size_t i = 0; i < lookup_parts; i++) {
-                                lookup_argument[i] = 0;
-                            }
-                            // lookup_argument = placeholder_lookup_argument<
-                            //     FieldType, permutation_commitment_scheme_type,
-                            //     ParamsType>::verify_eval(preprocessed_public_data, constraint_system.lookup_gates(),
-                            //                              proof.eval_proof.challenge, columns_at_y,
-                            //                              proof.eval_proof.lookups[1].z[0][0],
-                            //                              proof.eval_proof.lookups[1].z[0][1],
-                            //                              proof.eval_proof.lookups[2].z[0][0],
-                            //                              proof.eval_proof.lookups[0].z[0][0],
-                            //                              proof.eval_proof.lookups[0].z[0][1],
-                            //                              proof.input_perm_commitment, proof.value_perm_commitment,
-                            //                              proof.v_l_perm_commitment, transcript);
+                            // lambda combines the parts of different lookups
+                            typename FieldType::value_type lambda = transcript.template challenge<FieldType>();
+
+                            const auto &variable_values = proof.eval_proof.combined_value.z[0];
+                            const auto &permutation_values = proof.eval_proof.combined_value.z[1];
+                            std::vector<std::vector<typename FieldType::value_type>> sorted_values(
+                                variable_values.begin() + witness_columns + public_input_columns,
+                                variable_values.end());
+                            std::vector<std::vector<typename FieldType::value_type>> V_L_values(
+                                permutation_values.begin() + 1, permutation_values.end());
+
+                            lookup_argument = lookup_argument_type::verify_eval(
+                                lookups, columns_at_y, sorted_values, V_L_values,
+                                verification_key.lagrange_first(proof.eval_proof.challenge),
+                                fixed_values[fixed_values.size() - 2][0], fixed_values[fixed_values.size() - 1][0],
+                                theta, beta, gamma, lambda);
                         } else {
                             for (std::size_t i = 0; i < lookup_parts; i++) {
                                 lookup_argument[i] = 0;
@@ -208,8 +257,7 @@ namespace nil {
                             return false;
                         }
 
-                        typename FieldType::value_type omega =
-                            preprocessed_public_data.common_data.basic_domain->get_domain_element(1);
+                        typename FieldType::value_type omega = verification_key.omega;
 
                         std::vector<std::vector<typename FieldType::value_type>>
                             variable_values_evaluation_points(witness_columns + public_input_columns);
@@ -217,54 +265,27 @@ namespace nil {
                         // variable_values polynomials (table columns)
                         for (std::size_t variable_values_index = 0; variable_values_index < witness_columns + public_input_columns; variable_values_index++) {
                             std::set<int> variable_values_rotation =
-                                preprocessed_public_data.common_data.columns_rotations[variable_values_index];
+                                verification_key.columns_rotations[variable_values_index];
 
                             for (int rotation: variable_values_rotation) {
                                 variable_values_evaluation_points[variable_values_index].push_back(
                                     challenge * omega.pow(rotation));
                             }
                         }
-                        // permutation
-                        std::vector<std::vector<typename FieldType::value_type>> evaluation_points_permutation = {{challenge,
-                                                                                                     challenge * omega}};
-                        // lookup
-                        if (use_lookup) {
-                            // TODO: Check if commitments roots are used correctly.
-                            //      test crypto3_zk_systems_plonk_placeholder_placeholder_test calls it only with
-                            //      use_lookup == false
-                            // std::vector<typename FieldType::value_type> evaluation_points_v_l = {challenge,
-                            //                                                                      challenge * omega};
-                            // if (!algorithms::verify_eval<permutation_commitment_scheme_type>(
-                            //         evaluation_points_v_l,
-                            //         proof.eval_proof.lookups[0],
-                            //         proof.v_l_perm_commitment,
-                            //         fri_params,
-                            //         transcript)) {
-                            //     return false;
-                            // }
-
-                            // std::vector<typename FieldType::value_type> evaluation_points_input = {
-                            //     challenge, challenge * omega.inversed()};
-                            // if (!algorithms::verify_eval<permutation_commitment_scheme_type>(
-                            //         evaluation_points_input,
-                            //         proof.eval_proof.lookups[1],
-                            //         proof.input_perm_commitment,
-                            //         fri_params,
-                            //         transcript)) {
-                            //     return false;
-                            // }
-
-                            // std::vector<typename FieldType::value_type> evaluation_points_value = {challenge};
-                            // if (!algorithms::verify_eval<permutation_commitment_scheme_type>(
-                            //         evaluation_points_value,
-                            //         proof.eval_proof.lookups[2],
-                            //         proof.value_perm_commitment,
-                            //         fri_params,
-                            //         transcript)) {
-                            //     return false;
-                            // }
+                        // sorted lookup columns: A' at y and y * omega^{-1}, S' at y
+                        for (const auto &lookup : lookups) {
+                            for (std::size_t k = 0; k < lookup.width(); k++) {
+                                variable_values_evaluation_points.push_back({challenge, challenge * omega.inversed()});
+                            }
+                            for (std::size_t k = 0; k < lookup.width(); k++) {
+                                variable_values_evaluation_points.push_back({challenge});
+                            }
                         }
 
+                        // permutation and lookup grand products
+                        std::vector<std::vector<typename FieldType::value_type>> evaluation_points_permutation(
+                            1 + lookups.size(), {challenge, challenge * omega});
+
                         std::vector<typename FieldType::value_type> challenge_point = {challenge};
 
                         // quotient
@@ -273,18 +294,18 @@ namespace nil {
                         // public data
                         std::vector<std::vector<typename FieldType::value_type>> evaluation_points_public;
 
-                        for (std::size_t k = 0; k < preprocessed_public_data.identity_polynomials.size(); k++) {
+                        for (std::size_t k = 0; k < permutation_size; k++) {
                             evaluation_points_public.push_back(challenge_point);
                         }
                         
-                        for (std::size_t k = 0; k < preprocessed_public_data.identity_polynomials.size(); k++) {
+                        for (std::size_t k = 0; k < permutation_size; k++) {
                             evaluation_points_public.push_back(challenge_point);
                         }
 
                         // constant columns may be rotated
                         for (std::size_t k = 0; k < constant_columns; k ++){
                             std::set<int> rotations =
-                                preprocessed_public_data.common_data.columns_rotations[witness_columns + public_input_columns + k];
+                                verification_key.columns_rotations[witness_columns + public_input_columns + k];
                             std::vector<typename FieldType::value_type> point;
 
                             for (int rotation: rotations) {
@@ -296,7 +317,7 @@ namespace nil {
                         // selector columns may be rotated
                         for (std::size_t k = 0; k < selector_columns; k ++){
                             std::set<int> rotations =
-                                preprocessed_public_data.common_data.columns_rotations[witness_columns + public_input_columns + constant_columns + k];
+                                verification_key.columns_rotations[witness_columns + public_input_columns + constant_columns + k];
                             std::vector<typename FieldType::value_type> point;
 
                             for (int rotation: rotations) {
@@ -315,10 +336,10 @@ namespace nil {
                         {proof.variable_values_commitment, 
                          proof.v_perm_commitment,
                          proof.T_commitment, 
-                         preprocessed_public_data.common_data.commitments.fixed_values
+                         verification_key.fixed_values_commitment
                         };
                         
-                        if( proof.fixed_values_commitment != preprocessed_public_data.common_data.commitments.fixed_values )
+                        if( proof.fixed_values_commitment != verification_key.fixed_values_commitment )
                             return false;
 
                         if (!algorithms::verify_eval<commitment_scheme_type>(
@@ -354,7 +375,7 @@ namespace nil {
                         }
 
                         // Z is polynomial -1, 0 ...., 0, 1
-                        typename FieldType::value_type Z_at_challenge = preprocessed_public_data.common_data.Z.evaluate(challenge);                     
+                        typename FieldType::value_type Z_at_challenge = verification_key.Z(challenge);                     
                         if (F_consolidated != Z_at_challenge * T_consolidated) {
                             return false;
                         }
@@ -59,7 +59,14 @@
 #ifndef CRYPTO3_R1CS_PPZKADSNARK_BASIC_POLICY_HPP
 #define CRYPTO3_R1CS_PPZKADSNARK_BASIC_POLICY_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <nil/crypto3/zk/commitments/polynomial/knowledge_commitment.hpp>
 #include <nil/crypto3/zk/snark/commitments/knowledge_commitment_multiexp.hpp>
@@ -73,6 +80,7 @@
 #include <nil/crypto3/algebra/multiexp/multiexp.hpp>
 #include <nil/crypto3/algebra/multiexp/policies.hpp>
 #include <nil/crypto3/algebra/algorithms/pair.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -594,6 +602,109 @@ namespace nil {
                             return res;
                         }
 
+                        /**
+                         * Batched R1CS ppZKADSNARK authentication.
+                         *
+                         * Produces the same authenticated data as auth_sign. PRF values and signatures are
+                         * computed in parallel, so prfCompute and sigSign must be safe to call concurrently,
+                         * and all Lambda = lambda * G2 are computed from one fixed-base window table.
+                         */
+                        static std::vector<auth_data<CurveType>>
+                            batch_auth_sign(const std::vector<typename CurveType::scalar_field_type::value_type> &ins,
+                                            const sec_auth_key<CurveType> &sk,
+                                            const std::vector<label_type> &labels) {
+                            assert(labels.size() == ins.size());
+
+                            const std::vector<typename CurveType::scalar_field_type::value_type> lambdas =
+                                compute_lambdas(sk.S, labels);
+                            std::vector<typename CurveType::template g2_type<>::value_type> Lambdas =
+                                fixed_base_g2_exp(lambdas);
+
+                            std::vector<auth_data<CurveType>> res(ins.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < ins.size(); i++) {
+                                signature<CurveType> sig = sigSign<CurveType>(sk.skp, labels[i], Lambdas[i]);
+                                res[i] = auth_data<CurveType>(lambdas[i] + sk.i * ins[i], std::move(Lambdas[i]),
+                                                              std::move(sig));
+                            }
+                            return res;
+                        }
+
+                        /**
+                         * Batched R1CS ppZKADSNARK authentication verification algorithms. They accept exactly
+                         * the inputs accepted by auth_verify, the public one up to a negligible soundness error.
+                         */
+                        // symmetric
+                        static bool batch_auth_verify(
+                            const std::vector<typename CurveType::scalar_field_type::value_type> &data,
+                            const std::vector<auth_data<CurveType>> &auth_data,
+                            const sec_auth_key<CurveType> &sak,
+                            const std::vector<label_type> &labels) {
+                            assert((data.size() == labels.size()) && (auth_data.size() == labels.size()));
+
+                            const std::vector<typename CurveType::scalar_field_type::value_type> lambdas =
+                                compute_lambdas(sak.S, labels);
+
+                            bool res = true;
+#ifdef MULTICORE
+#pragma omp parallel for reduction(&& : res)
+#endif
+                            for (std::size_t i = 0; i < data.size(); i++) {
+                                res = res && (auth_data[i].mu == lambdas[i] + sak.i * data[i]);
+                            }
+                            return res;
+                        }
+
+                        // public
+                        static bool batch_auth_verify(
+                            const std::vector<typename CurveType::scalar_field_type::value_type> &data,
+                            const std::vector<auth_data<CurveType>> &auth_data,
+                            const pub_auth_key<CurveType> &pak,
+                            const std::vector<label_type> &labels) {
+                            typedef typename CurveType::scalar_field_type scalar_field_type;
+                            typedef typename CurveType::template g2_type<> g2_type;
+
+                            assert((data.size() == labels.size()) && (data.size() == auth_data.size()));
+
+                            /*
+                             * Instead of mu_i * G2 == Lambda_i - data_i * minusI2 for every i, check one random
+                             * linear combination of these equations:
+                             * (sum r_i mu_i) * G2 + (sum r_i data_i) * minusI2 == sum r_i Lambda_i.
+                             */
+                            std::vector<typename scalar_field_type::value_type> r(data.size());
+                            std::vector<typename g2_type::value_type> Lambdas(data.size());
+                            std::vector<signature<CurveType>> sigmas(data.size());
+                            for (std::size_t i = 0; i < data.size(); i++) {
+                                r[i] = algebra::random_element<scalar_field_type>();
+                                Lambdas[i] = auth_data[i].Lambda;
+                                sigmas[i] = auth_data[i].sigma;
+                            }
+
+                            typename scalar_field_type::value_type mu_sum = scalar_field_type::value_type::zero();
+                            typename scalar_field_type::value_type data_sum = scalar_field_type::value_type::zero();
+                            for (std::size_t i = 0; i < data.size(); i++) {
+                                mu_sum += r[i] * auth_data[i].mu;
+                                data_sum += r[i] * data[i];
+                            }
+
+#ifdef MULTICORE
+                            const std::size_t chunks = omp_get_max_threads();
+#else
+                            const std::size_t chunks = 1;
+#endif
+                            const typename g2_type::value_type Lambda_sum = algebra::multiexp<
+                                g2_type, scalar_field_type,
+                                algebra::policies::multiexp_method_BDLO12<g2_type, scalar_field_type>>(
+                                Lambdas.begin(), Lambdas.end(), r.begin(), r.end(), chunks);
+
+                            if (!(mu_sum * g2_type::value_type::one() + data_sum * pak.minusI2 == Lambda_sum)) {
+                                return false;
+                            }
+                            return sigBatchVerif<CurveType>(pak.vkp, labels, Lambdas, sigmas);
+                        }
+
                         /**
                          * A generator algorithm for the R1CS ppzkADSNARK.
                          *
@@ -979,11 +1090,8 @@ namespace nil {
                                 result = false;
                             }
 
-                            std::vector<typename CurveType::scalar_field_type::value_type> lambdas;
-                            lambdas.reserve(labels.size());
-                            for (std::size_t i = 0; i < labels.size(); i++) {
-                                lambdas.emplace_back(prfCompute<CurveType>(sak.S, labels[i]));
-                            }
+                            const std::vector<typename CurveType::scalar_field_type::value_type> lambdas =
+                                compute_lambdas(sak.S, labels);
                             typename CurveType::template g1_type<>::value_type prodA = sak.i * proof.g_Aau.g;
                             prodA =
                                 prodA + algebra::multiexp<
@@ -1272,6 +1380,53 @@ namespace nil {
                             bool result = online_verifier<CurveType>(pvk, auth_data, proof, pak, labels);
                             return result;
                         }
+
+                    private:
+                        /**
+                         * lambda_i = PRF_S(label_i) for all labels, evaluated in parallel.
+                         */
+                        static std::vector<typename CurveType::scalar_field_type::value_type>
+                            compute_lambdas(const prf_key<CurveType> &S, const std::vector<label_type> &labels) {
+                            std::vector<typename CurveType::scalar_field_type::value_type> lambdas(labels.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < labels.size(); i++) {
+                                lambdas[i] = prfCompute<CurveType>(S, labels[i]);
+                            }
+                            return lambdas;
+                        }
+
+                        /**
+                         * lambda_i * G2 for all lambdas. Window tables of the G2 generator are built once per
+                         * window size and shared by all later batches.
+                         */
+                        static std::vector<typename CurveType::template g2_type<>::value_type> fixed_base_g2_exp(
+                            const std::vector<typename CurveType::scalar_field_type::value_type> &lambdas) {
+                            typedef typename CurveType::scalar_field_type scalar_field_type;
+                            typedef typename CurveType::template g2_type<> g2_type;
+
+                            const std::size_t window = algebra::get_exp_window_size<g2_type>(lambdas.size());
+
+                            static std::mutex tables_mutex;
+                            static std::map<std::size_t, std::shared_ptr<const algebra::window_table<g2_type>>>
+                                tables;
+
+                            std::shared_ptr<const algebra::window_table<g2_type>> table;
+                            {
+                                std::lock_guard<std::mutex> lock(tables_mutex);
+                                std::shared_ptr<const algebra::window_table<g2_type>> &cached = tables[window];
+                                if (!cached) {
+                                    cached = std::make_shared<const algebra::window_table<g2_type>>(
+                                        algebra::get_window_table<g2_type>(scalar_field_type::value_bits, window,
+                                                                           g2_type::value_type::one()));
+                                }
+                                table = cached;
+                            }
+
+                            return algebra::batch_exp<g2_type, scalar_field_type>(scalar_field_type::value_bits,
+                                                                                  window, *table, lambdas);
+                        }
                     };
                 }    // namespace detail
             }        // namespace snark
@@ -68,6 +68,8 @@ namespace nil {
                     using policy_type::auth_generator;
                     using policy_type::auth_sign;
                     using policy_type::auth_verify;
+                    using policy_type::batch_auth_sign;
+                    using policy_type::batch_auth_verify;
                 };
 
             }    // namespace snark
@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Fiat-Shamir transcript over the field-native Poseidon sponge.
+//
+// Specializes fiat_shamir_heuristic_sequential for poseidon_hash, so protocols
+// parameterized by the transcript hash, FRI and Placeholder among them, absorb
+// commitments and evaluations as field elements once the hash is Poseidon.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_TRANSCRIPT_POSEIDON_TRANSCRIPT_HPP
+#define CRYPTO3_ZK_TRANSCRIPT_POSEIDON_TRANSCRIPT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+#include <nil/crypto3/zk/detail/poseidon_hash.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace transcript {
+
+                /*!
+                 * @brief Fiat–Shamir heuristic over a Poseidon duplex sponge.
+                 *
+                 * Field elements are absorbed as they are. Byte ranges are absorbed as their length
+                 * followed by big-endian chunks of (modulus_bits - 1) / 8 bytes. Before every squeeze
+                 * the pending input is padded with a single one and absorbed, then state[1] is the
+                 * challenge.
+                 */
+                template<typename FieldType, std::size_t Width, std::size_t FullRounds, std::size_t PartialRounds,
+                         std::size_t Alpha>
+                struct fiat_shamir_heuristic_sequential<
+                    zk::detail::poseidon_hash<FieldType, Width, FullRounds, PartialRounds, Alpha>> {
+                    typedef zk::detail::poseidon_hash<FieldType, Width, FullRounds, PartialRounds, Alpha> hash_type;
+                    typedef typename FieldType::value_type value_type;
+
+                    fiat_shamir_heuristic_sequential() {
+                        state.fill(value_type::zero());
+                    }
+
+                    template<typename InputRange>
+                    fiat_shamir_heuristic_sequential(const InputRange &r) : fiat_shamir_heuristic_sequential() {
+                        absorb(std::begin(r), std::end(r));
+                    }
+
+                    template<typename InputIterator>
+                    fiat_shamir_heuristic_sequential(InputIterator first, InputIterator last) :
+                        fiat_shamir_heuristic_sequential() {
+                        absorb(first, last);
+                    }
+
+                    void operator()(const value_type &x) {
+                        pending.push_back(x);
+                    }
+
+                    template<typename InputRange>
+                    void operator()(const InputRange &r) {
+                        absorb(std::begin(r), std::end(r));
+                    }
+
+                    template<typename InputIterator>
+                    void operator()(InputIterator first, InputIterator last) {
+                        absorb(first, last);
+                    }
+
+                    template<typename Field>
+                    typename Field::value_type challenge() {
+                        static_assert(std::is_same<typename Field::value_type, value_type>::value,
+                                      "challenges are elements of the sponge field");
+                        return squeeze();
+                    }
+
+                    template<typename Integral>
+                    Integral int_challenge() {
+                        typedef typename FieldType::integral_type integral_type;
+                        const integral_type mask(std::numeric_limits<Integral>::max());
+                        return static_cast<Integral>(integral_type(squeeze().data) & mask);
+                    }
+
+                    template<typename Field, std::size_t N>
+                    std::array<typename Field::value_type, N> challenges() {
+                        std::array<typename Field::value_type, N> result;
+                        for (auto &ch : result) {
+                            ch = challenge<Field>();
+                        }
+                        return result;
+                    }
+
+                private:
+                    template<typename InputIterator>
+                    void absorb(InputIterator first, InputIterator last) {
+                        typedef typename std::iterator_traits<InputIterator>::value_type element_type;
+
+                        if constexpr (std::is_same<element_type, value_type>::value) {
+                            pending.insert(pending.end(), first, last);
+                        } else {
+                            static_assert(std::is_integral<element_type>::value && sizeof(element_type) == 1,
+                                          "the transcript absorbs field elements or bytes");
+                            typedef typename FieldType::integral_type integral_type;
+                            const std::size_t chunk_bytes = (FieldType::modulus_bits - 1) / 8;
+
+                            const std::vector<std::uint8_t> bytes(first, last);
+                            pending.push_back(value_type(bytes.size()));
+                            for (std::size_t offset = 0; offset < bytes.size(); offset += chunk_bytes) {
+                                integral_type chunk = 0;
+                                for (std::size_t i = offset; i < std::min(offset + chunk_bytes, bytes.size()); ++i) {
+                                    chunk <<= 8;
+                                    chunk |= integral_type(bytes[i]);
+                                }
+                                pending.push_back(value_type(chunk));
+                            }
+                        }
+                    }
+
+                    value_type squeeze() {
+                        pending.push_back(value_type::one());
+                        for (std::size_t offset = 0; offset < pending.size(); offset += hash_type::rate) {
+                            for (std::size_t i = 0; i < hash_type::rate && offset + i < pending.size(); ++i) {
+                                state[i + 1] += pending[offset + i];
+                            }
+                            hash_type::permute(state);
+                        }
+                        pending.clear();
+                        return state[1];
+                    }
+
+                    typename hash_type::state_type state;
+                    std::vector<value_type> pending;
+                };
+            }    // namespace transcript
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_TRANSCRIPT_POSEIDON_TRANSCRIPT_HPP
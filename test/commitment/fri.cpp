@@ -28,8 +28,10 @@
 
 #define BOOST_TEST_MODULE fri_test
 
+#include <stdexcept>
 #include <string>
 #include <random>
+#include <type_traits>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -39,6 +41,8 @@
 #include <nil/crypto3/algebra/fields/arithmetic_params/mnt4.hpp>
 #include <nil/crypto3/algebra/curves/pallas.hpp>
 #include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+#include <nil/crypto3/algebra/curves/alt_bn128.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/alt_bn128.hpp>
 #include <nil/crypto3/algebra/random_element.hpp>
 
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
@@ -51,6 +55,7 @@
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/fri.hpp>
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
+#include <nil/crypto3/zk/detail/poseidon_hash.hpp>
 
 #include <nil/crypto3/random/algebraic_random_device.hpp>
 
@@ -143,4 +148,126 @@ BOOST_AUTO_TEST_CASE(fri_basic_test) {
     typename FieldType::value_type prover_next_challenge = transcript.template challenge<FieldType>();
     BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
 }
+
+BOOST_AUTO_TEST_CASE(fri_grinding_test) {
+
+    // setup
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+
+    typedef hashes::sha2<256> merkle_hash_type;
+    typedef hashes::sha2<256> transcript_hash_type;
+
+    constexpr static const std::size_t d = 16;
+
+    constexpr static const std::size_t r = boost::static_log2<d>::value;
+    constexpr static const std::size_t m = 2;
+    constexpr static const std::size_t lambda = 32;
+    constexpr static const std::size_t batches_num = 1;
+
+    typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, lambda, m, batches_num> fri_type;
+
+    typedef typename fri_type::proof_type proof_type;
+    typedef typename fri_type::params_type params_type;
+
+    params_type params(8);
+
+    std::size_t extended_log = boost::static_log2<d>::value;
+    params.r = r;
+    params.D = math::calculate_domain_set<FieldType>(extended_log, r);
+    params.max_degree = d - 1;
+    params.step_list = generate_random_step_list(r, 1);
+    BOOST_CHECK_EQUAL(params.grinding_bits, 8u);
+
+    // commit
+    math::polynomial<typename FieldType::value_type> f = {1, 3, 4, 1, 5, 6, 7, 2, 8, 7, 5, 6, 1, 2, 1, 1};
+    std::array<std::vector<math::polynomial<typename FieldType::value_type>>, 1> fs;
+    fs[0].resize(1); fs[0][0] = f;
+    typename fri_type::merkle_tree_type tree = zk::algorithms::precommit<fri_type>(fs[0], params.D[0], params.step_list[0]);
+    auto root = zk::algorithms::commit<fri_type>(tree);
+
+    // eval
+    std::vector<std::uint8_t> init_blob {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript(init_blob);
+
+    proof_type proof = zk::algorithms::proof_eval<fri_type>(f, tree, params, transcript);
+
+    // verify
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_verifier(init_blob);
+    BOOST_CHECK(zk::algorithms::verify_eval<fri_type>(proof, root, params, transcript_verifier));
+
+    // a different nonce moves the queries or fails the proof of work
+    proof.proof_of_work++;
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_tampered(init_blob);
+    BOOST_CHECK(!zk::algorithms::verify_eval<fri_type>(proof, root, params, transcript_tampered));
+
+    // no nonce gives 64 leading zero bits of a 64-bit challenge, so such parameters are rejected
+    BOOST_CHECK_THROW(params_type(64), std::invalid_argument);
+    params.grinding_bits = 64;
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_unbounded(init_blob);
+    BOOST_CHECK_THROW(zk::algorithms::proof_eval<fri_type>(f, tree, params, transcript_unbounded),
+                      std::invalid_argument);
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_unbounded_verifier(init_blob);
+    BOOST_CHECK(!zk::algorithms::verify_eval<fri_type>(proof, root, params, transcript_unbounded_verifier));
+}
+
+BOOST_AUTO_TEST_CASE(fri_poseidon_test) {
+
+    // setup
+    using FieldType = typename algebra::curves::alt_bn128_254::scalar_field_type;
+
+    typedef zk::detail::poseidon_hash<FieldType> merkle_hash_type;
+    typedef zk::detail::poseidon_hash<FieldType> transcript_hash_type;
+
+    constexpr static const std::size_t d = 16;
+
+    constexpr static const std::size_t r = boost::static_log2<d>::value;
+    constexpr static const std::size_t m = 2;
+    constexpr static const std::size_t lambda = 40;
+    constexpr static const std::size_t batches_num = 1;
+
+    typedef zk::commitments::fri<FieldType, merkle_hash_type, transcript_hash_type, lambda, m, batches_num> fri_type;
+
+    static_assert(fri_type::field_native_merkle_tree);
+    static_assert(std::is_same<typename fri_type::merkle_tree_type,
+                               zk::detail::field_merkle_tree<merkle_hash_type, 2>>::value);
+    static_assert(std::is_same<typename fri_type::commitment_type, typename FieldType::value_type>::value);
+
+    typedef typename fri_type::proof_type proof_type;
+    typedef typename fri_type::params_type params_type;
+
+    params_type params;
+
+    std::size_t extended_log = boost::static_log2<d>::value;
+    params.r = r;
+    params.D = math::calculate_domain_set<FieldType>(extended_log, r);
+    params.max_degree = d - 1;
+    params.step_list = generate_random_step_list(r, 1);
+
+    // commit
+    math::polynomial<typename FieldType::value_type> f = {1, 3, 4, 1, 5, 6, 7, 2, 8, 7, 5, 6, 1, 2, 1, 1};
+    std::array<std::vector<math::polynomial<typename FieldType::value_type>>, 1> fs;
+    fs[0].resize(1); fs[0][0] = f;
+    typename fri_type::merkle_tree_type tree = zk::algorithms::precommit<fri_type>(fs[0], params.D[0], params.step_list[0]);
+    auto root = zk::algorithms::commit<fri_type>(tree);
+
+    // eval
+    std::vector<std::uint8_t> init_blob {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript(init_blob);
+
+    proof_type proof = zk::algorithms::proof_eval<fri_type>(f, tree, params, transcript);
+
+    // verify
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_verifier(init_blob);
+    BOOST_CHECK(zk::algorithms::verify_eval<fri_type>(proof, root, params, transcript_verifier));
+
+    typename FieldType::value_type verifier_next_challenge = transcript_verifier.template challenge<FieldType>();
+    typename FieldType::value_type prover_next_challenge = transcript.template challenge<FieldType>();
+    BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
+
+    // a value of the initial proof no longer matches the Merkle root
+    proof.query_proofs[0].initial_proof[0].values[0][0][0] += FieldType::value_type::one();
+    zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_tampered(init_blob);
+    BOOST_CHECK(!zk::algorithms::verify_eval<fri_type>(proof, root, params, transcript_tampered));
+}
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
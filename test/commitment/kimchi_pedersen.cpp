@@ -5,6 +5,7 @@
 #include <cassert>
 #include <chrono>
 #include <cstdlib>
+#include <sstream>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -246,4 +247,50 @@ BOOST_AUTO_TEST_CASE(kimchi_commitment_test_case) {
     BOOST_CHECK(kimchi_pedersen::verify_eval(params, g_map, batch));
 }
 
+BOOST_AUTO_TEST_CASE(kimchi_commitment_lagrange_basis_test) {
+    params_type params = kimchi_pedersen::setup(1 << 3);
+
+    // sum_i L_i = 1, so the basis commitments of every chunk sum up to the commitment of that chunk of 1
+    for (std::size_t n : {std::size_t(4), std::size_t(8), std::size_t(32)}) {
+        math::basic_radix2_domain<scalar_field_type> domain(n);
+        const auto &basis = params.lagrange_basis(domain);
+        const std::size_t chunks = basis.size() / n;
+        BOOST_CHECK_EQUAL(chunks, std::max<std::size_t>(1, n / params.g.size()));
+
+        for (std::size_t j = 0; j < chunks; ++j) {
+            group_type::value_type sum = group_type::value_type::zero();
+            for (std::size_t i = 0; i < n; ++i) {
+                sum = sum + basis[i * chunks + j];
+            }
+            BOOST_CHECK(sum == (j == 0 ? params.g[0] : group_type::value_type::zero()));
+        }
+        BOOST_CHECK(&params.lagrange_basis(domain) == &basis);
+    }
+
+    std::stringstream stream;
+    params.save_lagrange_bases(stream);
+    const std::string saved = stream.str();
+
+    params_type loaded_params = kimchi_pedersen::setup(1 << 3);
+    std::istringstream in(saved);
+    BOOST_CHECK(loaded_params.load_lagrange_bases(in));
+    BOOST_CHECK(loaded_params.lagrange_bases == params.lagrange_bases);
+
+    // loading again keeps the bases already present, so references to them stay valid
+    math::basic_radix2_domain<scalar_field_type> domain(8);
+    const auto &basis = loaded_params.lagrange_basis(domain);
+    const auto expected = basis;
+    params.lagrange_bases[8].front() = params.lagrange_bases[8].front() + params.g[0];
+    std::stringstream modified;
+    params.save_lagrange_bases(modified);
+    BOOST_CHECK(loaded_params.load_lagrange_bases(modified));
+    BOOST_CHECK(&loaded_params.lagrange_basis(domain) == &basis);
+    BOOST_CHECK(basis == expected);
+
+    params_type truncated_params = kimchi_pedersen::setup(1 << 3);
+    std::istringstream truncated(saved.substr(0, saved.size() - 1));
+    BOOST_CHECK(!truncated_params.load_lagrange_bases(truncated));
+    BOOST_CHECK(truncated_params.lagrange_bases.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
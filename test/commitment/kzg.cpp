@@ -52,7 +52,7 @@ BOOST_AUTO_TEST_CASE(kzg_basic_test) {
 
     typedef algebra::curves::mnt4<298> curve_type;
     typedef typename curve_type::base_field_type::value_type base_field_value_type;
-    typedef zk::snark::kzg_commitment<curve_type> kzg_type;
+    typedef zk::commitments::kzg<curve_type> kzg_type;
 
     typename kzg_type::params_type kzg_params;
     kzg_params.a = 2;
@@ -61,9 +61,50 @@ BOOST_AUTO_TEST_CASE(kzg_basic_test) {
 
     auto kzg_keys = kzg_type::setup(298, kzg_params);
     auto commit = kzg_type::commit(std::get<0>(kzg_keys), f);
+    // f(a) * G1 with f(a) = 1 + a: the constant coefficient is counted once
+    BOOST_CHECK(commit == (1 + kzg_params.a) * curve_type::template g1_type<>::value_type::one());
+
     auto proof = kzg_type::proof_eval(std::get<0>(kzg_keys), 1, 2, f);
 
     BOOST_CHECK(kzg_type::verify_eval(std::get<1>(kzg_keys), commit, 1, 2, proof));
 }
 
+BOOST_AUTO_TEST_CASE(kzg_batched_test) {
+
+    typedef algebra::curves::mnt4<298> curve_type;
+    typedef typename curve_type::scalar_field_type::value_type scalar_value_type;
+    typedef zk::commitments::kzg<curve_type> kzg_type;
+
+    typename kzg_type::params_type kzg_params;
+    kzg_params.a = 3;
+
+    auto kzg_keys = kzg_type::setup(16, kzg_params);
+
+    const std::vector<scalar_value_type> points = {2, 5};
+    const std::vector<std::vector<polynomial<scalar_value_type>>> polynomials = {
+        {{1, 2, 3}, {4, 0, 0, 7}, {5}},
+        {{1, 1}, {2, 3, 4, 5, 6}},
+    };
+
+    std::vector<std::vector<typename kzg_type::commitment_type>> commitments;
+    std::vector<std::vector<scalar_value_type>> evaluations;
+    for (std::size_t j = 0; j < points.size(); ++j) {
+        commitments.emplace_back(kzg_type::batch_commit(std::get<0>(kzg_keys), polynomials[j]));
+        evaluations.emplace_back();
+        for (const auto &f : polynomials[j]) {
+            evaluations.back().emplace_back(f.evaluate(points[j]));
+        }
+    }
+
+    const scalar_value_type gamma = algebra::random_element<typename curve_type::scalar_field_type>();
+    auto proof = kzg_type::batch_proof_eval(std::get<0>(kzg_keys), polynomials, points, gamma);
+
+    BOOST_CHECK(
+        kzg_type::batch_verify_eval(std::get<1>(kzg_keys), commitments, points, evaluations, proof, gamma));
+
+    evaluations[1][0] += scalar_value_type::one();
+    BOOST_CHECK(
+        !kzg_type::batch_verify_eval(std::get<1>(kzg_keys), commitments, points, evaluations, proof, gamma));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -49,6 +49,8 @@
 #include <nil/crypto3/zk/commitments/polynomial/lpc.hpp>
 #include <nil/crypto3/zk/commitments/polynomial/fri.hpp>
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/column_storage.hpp>
+#include <nil/crypto3/zk/detail/temporary_file.hpp>
 
 #include <nil/crypto3/random/algebraic_random_device.hpp>
 #include <nil/crypto3/random/algebraic_engine.hpp>
@@ -447,6 +449,56 @@ BOOST_FIXTURE_TEST_CASE(lpc_dfs_basic_test, test_fixture) {
     typename FieldType::value_type prover_next_challenge = transcript.template challenge<FieldType>();
     BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
 }
+
+BOOST_FIXTURE_TEST_CASE(lpc_storage_precommit_test, test_fixture) {
+
+    // Setup types
+    typedef algebra::curves::bls12<381> curve_type;
+    typedef typename curve_type::scalar_field_type FieldType;
+
+    typedef hashes::sha2<256> merkle_hash_type;
+    typedef hashes::sha2<256> transcript_hash_type;
+
+    constexpr static const std::size_t lambda = 10;
+    constexpr static const std::size_t r = 3;
+    constexpr static const std::size_t m = 2;
+
+    typedef zk::commitments::
+        list_polynomial_commitment_params<merkle_hash_type, transcript_hash_type, lambda, r, m, 4>
+            lpc_params_type;
+    typedef zk::commitments::list_polynomial_commitment<FieldType, lpc_params_type> lpc_type;
+
+    constexpr static const std::size_t d = 16;
+    std::shared_ptr<math::evaluation_domain<FieldType>> D = math::make_evaluation_domain<FieldType>(4 * d);
+
+    std::vector<math::polynomial_dfs<typename FieldType::value_type>> f =
+        generate_random_polynomial_dfs_batch<FieldType>(3, d, test_global_alg_rnd_engine<FieldType>);
+
+    // Streamed precommit must give the same tree for any chunking and storage
+    for (std::size_t fri_step = 1; fri_step <= r; fri_step++) {
+        auto expected = zk::algorithms::precommit<lpc_type>(f, D, fri_step);
+
+        zk::commitments::detail::memory_column_storage<FieldType> memory_storage(f.size(), D->size());
+        zk::commitments::detail::file_column_storage<FieldType> file_storage(
+            zk::detail::create_temporary_file(zk::detail::temporary_directory(), "lpc_storage_precommit_test_"),
+            f.size(), D->size());
+        for (std::size_t i = 0; i < f.size(); i++) {
+            zk::algorithms::store_column<lpc_type>(memory_storage, i, f[i], D, 5);
+            zk::algorithms::store_column<lpc_type>(file_storage, i, f[i], D, 7);
+        }
+
+        for (std::size_t chunk_leaves : {1, 3, 64}) {
+            BOOST_CHECK(zk::algorithms::commit<lpc_type>(zk::algorithms::precommit_storage<lpc_type>(
+                            memory_storage, D, fri_step, chunk_leaves)) == zk::algorithms::commit<lpc_type>(expected));
+            BOOST_CHECK(zk::algorithms::commit<lpc_type>(zk::algorithms::precommit_storage<lpc_type>(
+                            file_storage, D, fri_step, chunk_leaves)) == zk::algorithms::commit<lpc_type>(expected));
+        }
+    }
+
+    BOOST_CHECK_THROW(zk::commitments::detail::file_column_storage<FieldType>(
+                          zk::detail::temporary_directory() + "/missing_directory/lpc_storage.bin", 1, D->size()),
+                      std::runtime_error);
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,227 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE multi_buffer_hash_test
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/hash/algorithm/hash.hpp>
+#include <nil/crypto3/hash/keccak.hpp>
+
+#include <nil/crypto3/container/merkle/tree.hpp>
+#include <nil/crypto3/container/merkle/proof.hpp>
+
+#include <nil/crypto3/zk/detail/keccak_multi_buffer.hpp>
+#include <nil/crypto3/zk/detail/multi_buffer_hash.hpp>
+#include <nil/crypto3/zk/detail/batched_merkle_tree.hpp>
+
+using namespace nil::crypto3;
+
+namespace keccak_impl = nil::crypto3::zk::detail::keccak_multi_buffer_impl;
+
+typedef void (*sponge_function)(std::size_t, std::size_t, const std::uint8_t *const *, std::size_t,
+                                std::uint8_t *const *);
+
+std::vector<std::vector<std::uint8_t>> make_messages(std::size_t count, std::size_t length) {
+    std::vector<std::vector<std::uint8_t>> messages(count, std::vector<std::uint8_t>(length));
+    for (std::size_t l = 0; l < count; ++l) {
+        for (std::size_t i = 0; i < length; ++i) {
+            messages[l][i] = std::uint8_t(97 * l + 13 * i + length);
+        }
+    }
+    return messages;
+}
+
+std::string to_hex(const std::uint8_t *data, std::size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    std::string result;
+    for (std::size_t i = 0; i < size; ++i) {
+        result.push_back(digits[data[i] >> 4]);
+        result.push_back(digits[data[i] & 0xF]);
+    }
+    return result;
+}
+
+/// Message lengths around the first two rate boundaries of the sponge.
+std::vector<std::size_t> boundary_lengths(std::size_t rate) {
+    return {0, 1, 7, 8, rate - 1, rate, rate + 1, 2 * rate - 1, 2 * rate, 2 * rate + 3};
+}
+
+/// Hashes lanes messages per call with sponge and compares every digest with crypto3's Keccak.
+template<std::size_t DigestBits>
+void check_sponge(sponge_function sponge, std::size_t lanes) {
+    typedef hashes::keccak_1600<DigestBits> hash_type;
+    constexpr std::size_t digest_bytes = DigestBits / 8;
+    const std::size_t rate = 200 - 2 * digest_bytes;
+
+    for (std::size_t length : boundary_lengths(rate)) {
+        const std::vector<std::vector<std::uint8_t>> messages = make_messages(lanes, length);
+        std::vector<std::vector<std::uint8_t>> digests(lanes, std::vector<std::uint8_t>(digest_bytes));
+        std::vector<const std::uint8_t *> message_ptrs(lanes);
+        std::vector<std::uint8_t *> digest_ptrs(lanes);
+        for (std::size_t l = 0; l < lanes; ++l) {
+            message_ptrs[l] = messages[l].data();
+            digest_ptrs[l] = digests[l].data();
+        }
+        sponge(rate, digest_bytes, message_ptrs.data(), length, digest_ptrs.data());
+
+        for (std::size_t l = 0; l < lanes; ++l) {
+            const typename hash_type::digest_type expected =
+                hash<hash_type>(messages[l].begin(), messages[l].end());
+            BOOST_CHECK_MESSAGE(std::equal(expected.begin(), expected.end(), digests[l].begin()),
+                                "lanes " << lanes << ", length " << length << ", lane " << l);
+        }
+    }
+}
+
+template<std::size_t DigestBits>
+void check_multi_buffer_hash() {
+    typedef hashes::keccak_1600<DigestBits> hash_type;
+    typedef zk::detail::multi_buffer_hash<hash_type> multi_buffer_type;
+    const std::size_t rate = 200 - 2 * multi_buffer_type::digest_bytes;
+
+    for (std::size_t count : {1u, 3u, 4u, 5u, 8u, 9u, 17u}) {
+        for (std::size_t length : boundary_lengths(rate)) {
+            const std::vector<std::vector<std::uint8_t>> messages = make_messages(count, length);
+            std::vector<const std::uint8_t *> message_ptrs(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                message_ptrs[i] = messages[i].data();
+            }
+            std::vector<typename hash_type::digest_type> digests(count);
+            multi_buffer_type::hash(message_ptrs.data(), count, length, digests.data());
+
+            for (std::size_t i = 0; i < count; ++i) {
+                BOOST_CHECK_MESSAGE(digests[i] == hash<hash_type>(messages[i].begin(), messages[i].end()),
+                                    "count " << count << ", length " << length << ", message " << i);
+            }
+        }
+    }
+}
+
+template<typename Hash>
+void check_batched_merkle_tree(std::size_t leaves_number, std::size_t leaf_size) {
+    const std::vector<std::vector<std::uint8_t>> leaves = make_messages(leaves_number, leaf_size);
+
+    const containers::merkle_tree<Hash, 2> expected =
+        containers::make_merkle_tree<Hash, 2>(leaves.begin(), leaves.end());
+    const containers::merkle_tree<Hash, 2> batched =
+        zk::detail::make_batched_merkle_tree<Hash, 2>(leaves.begin(), leaves.end());
+
+    BOOST_CHECK(batched.root() == expected.root());
+    BOOST_CHECK(batched == expected);
+}
+
+BOOST_AUTO_TEST_SUITE(multi_buffer_hash_test_suite)
+
+BOOST_AUTO_TEST_CASE(keccak_multi_buffer_known_answer_test) {
+    const std::string abc = "abc";
+    const std::uint8_t *messages[] = {reinterpret_cast<const std::uint8_t *>(abc.data())};
+    std::uint8_t digest[64];
+    std::uint8_t *digests[] = {digest};
+
+    keccak_impl::sponge_x1(136, 32, messages, 0, digests);
+    BOOST_CHECK_EQUAL(to_hex(digest, 32), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    keccak_impl::sponge_x1(136, 32, messages, 3, digests);
+    BOOST_CHECK_EQUAL(to_hex(digest, 32), "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+    keccak_impl::sponge_x1(72, 64, messages, 0, digests);
+    BOOST_CHECK_EQUAL(to_hex(digest, 64),
+                      "0eab42de4c3ceb9235fc91acffe746b29c29a8c366b7c60e4e67c466f36a4304"
+                      "c00fa9caf9d87976ba469bcbe06713b435f091ef2769fb160cdab33d3670680e");
+}
+
+BOOST_AUTO_TEST_CASE(keccak_multi_buffer_lanes_test) {
+    check_sponge<256>(keccak_impl::sponge_x1, 1);
+    check_sponge<512>(keccak_impl::sponge_x1, 1);
+
+#ifdef CRYPTO3_ZK_KECCAK_MULTI_BUFFER_X86
+    if (__builtin_cpu_supports("avx2")) {
+        check_sponge<256>(keccak_impl::sponge_x4, 4);
+        check_sponge<512>(keccak_impl::sponge_x4, 4);
+    } else {
+        BOOST_TEST_MESSAGE("AVX2 is not supported, 4 lanes not tested");
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        check_sponge<256>(keccak_impl::sponge_x8, 8);
+        check_sponge<512>(keccak_impl::sponge_x8, 8);
+    } else {
+        BOOST_TEST_MESSAGE("AVX-512F is not supported, 8 lanes not tested");
+    }
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(multi_buffer_hash_test) {
+    check_multi_buffer_hash<256>();
+    check_multi_buffer_hash<512>();
+}
+
+BOOST_AUTO_TEST_CASE(batched_merkle_tree_test) {
+    check_batched_merkle_tree<hashes::keccak_1600<256>>(2, 64);
+    check_batched_merkle_tree<hashes::keccak_1600<256>>(16, 200);
+    // more leaves than are hashed in one batch
+    check_batched_merkle_tree<hashes::keccak_1600<256>>(8192, 96);
+    check_batched_merkle_tree<hashes::keccak_1600<512>>(64, 136);
+}
+
+BOOST_AUTO_TEST_CASE(batch_validate_merkle_proofs_test) {
+    typedef hashes::keccak_1600<256> hash_type;
+    typedef containers::merkle_tree<hash_type, 2> merkle_tree_type;
+    typedef containers::merkle_proof<hash_type, 2> merkle_proof_type;
+
+    // two trees of different depths and leaf sizes, as the initial and round proofs of FRI
+    const std::vector<std::vector<std::uint8_t>> big_leaves = make_messages(32, 160);
+    const std::vector<std::vector<std::uint8_t>> small_leaves = make_messages(4, 64);
+    const merkle_tree_type big_tree =
+        zk::detail::make_batched_merkle_tree<hash_type, 2>(big_leaves.begin(), big_leaves.end());
+    const merkle_tree_type small_tree =
+        zk::detail::make_batched_merkle_tree<hash_type, 2>(small_leaves.begin(), small_leaves.end());
+
+    std::vector<merkle_proof_type> proofs;
+    std::vector<std::vector<std::uint8_t>> leaves;
+    for (std::size_t i = 0; i < big_leaves.size(); i += 3) {
+        proofs.emplace_back(big_tree, i);
+        leaves.emplace_back(big_leaves[i]);
+        proofs.emplace_back(small_tree, i % small_leaves.size());
+        leaves.emplace_back(small_leaves[i % small_leaves.size()]);
+    }
+    std::vector<const merkle_proof_type *> proof_ptrs;
+    for (const merkle_proof_type &p : proofs) {
+        proof_ptrs.emplace_back(&p);
+    }
+
+    BOOST_CHECK((zk::detail::batch_validate_merkle_proofs<hash_type, 2>(proof_ptrs, leaves)));
+
+    std::vector<std::vector<std::uint8_t>> tampered = leaves;
+    tampered[5][17] ^= 1;
+    BOOST_CHECK((!zk::detail::batch_validate_merkle_proofs<hash_type, 2>(proof_ptrs, tampered)));
+
+    // a leaf authenticated by the proof of its neighbour
+    tampered = leaves;
+    std::swap(tampered[0], tampered[2]);
+    BOOST_CHECK((!zk::detail::batch_validate_merkle_proofs<hash_type, 2>(proof_ptrs, tampered)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -7,8 +7,11 @@
 #include <nil/crypto3/algebra/fields/bls12/base_field.hpp>
 #include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
 #include <nil/crypto3/algebra/pairing/bls12.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
 
 #include <nil/crypto3/zk/commitments/polynomial/powers_of_tau.hpp>
+#include <nil/crypto3/zk/commitments/detail/polynomial/group_fft.hpp>
+#include <nil/crypto3/zk/detail/temporary_file.hpp>
 
 using namespace nil::crypto3::algebra;
 using namespace nil::crypto3::zk::commitments;
@@ -159,6 +162,173 @@ BOOST_AUTO_TEST_CASE(powers_of_tau_basic_test) {
     auto result = scheme_type::result_type::from_accumulator(acc3, 32);
 }
 
+BOOST_AUTO_TEST_CASE(powers_of_tau_chunked_test) {
+    using curve_type = curves::bls12<381>;
+    using scheme_type = powers_of_tau<curve_type, 32>;
+    constexpr const std::size_t chunk_size = 5;
+
+    auto acc1 = scheme_type::accumulator_type();
+    auto acc2 = acc1;
+    auto acc3 = acc1;
+    auto sk = scheme_type::generate_private_key();
+    auto pubkey = scheme_type::proof_eval(sk, acc1);
+
+    acc2.transform(sk);
+    auto storage = detail::make_powers_of_tau_memory_storage(acc3);
+    scheme_type::transform(sk, storage, chunk_size);
+
+    BOOST_CHECK(acc2.tau_powers_g1 == acc3.tau_powers_g1);
+    BOOST_CHECK(acc2.tau_powers_g2 == acc3.tau_powers_g2);
+    BOOST_CHECK(acc2.alpha_tau_powers_g1 == acc3.alpha_tau_powers_g1);
+    BOOST_CHECK(acc2.beta_tau_powers_g1 == acc3.beta_tau_powers_g1);
+    BOOST_CHECK(acc2.beta_g2 == acc3.beta_g2);
+
+    BOOST_CHECK(scheme_type::verify_eval(pubkey, scheme_type::compute_transcript(acc1),
+                                         detail::make_powers_of_tau_memory_storage(acc1),
+                                         detail::make_powers_of_tau_memory_storage(acc3), chunk_size));
+
+    acc3.tau_powers_g1[17] = acc3.tau_powers_g1[17] + acc3.tau_powers_g1[1];
+    BOOST_CHECK(!scheme_type::verify_eval(pubkey, scheme_type::compute_transcript(acc1),
+                                          detail::make_powers_of_tau_memory_storage(acc1),
+                                          detail::make_powers_of_tau_memory_storage(acc3), chunk_size));
+}
+
+BOOST_AUTO_TEST_CASE(powers_of_tau_file_storage_test) {
+    using curve_type = curves::bls12<381>;
+    using scheme_type = powers_of_tau<curve_type, 32>;
+    using storage_type = detail::powers_of_tau_file_storage<scheme_type::accumulator_type>;
+    constexpr const std::size_t chunk_size = 7;
+
+    nil::crypto3::zk::detail::temporary_file before_file(nil::crypto3::zk::detail::temporary_directory(),
+                                                         "powers_of_tau_before_");
+    nil::crypto3::zk::detail::temporary_file after_file(nil::crypto3::zk::detail::temporary_directory(),
+                                                        "powers_of_tau_after_");
+
+    auto acc1 = scheme_type::accumulator_type();
+    auto sk = scheme_type::generate_private_key();
+    auto pubkey = scheme_type::proof_eval(sk, acc1);
+    auto acc2 = scheme_type::accumulator_type();
+    acc2.transform(sk);
+
+    storage_type::create(before_file.path(), chunk_size);
+    storage_type before(before_file.path());
+    BOOST_CHECK(before.read_beta_g2() == acc1.beta_g2);
+
+    storage_type::create(after_file.path(), chunk_size);
+    storage_type after(after_file.path());
+    scheme_type::transform(sk, after, chunk_size);
+
+    auto acc3 = scheme_type::accumulator_type();
+    auto acc3_storage = detail::make_powers_of_tau_memory_storage(acc3);
+    scheme_type::chunked_accumulator_type::copy(after, acc3_storage, chunk_size);
+    BOOST_CHECK(acc2.tau_powers_g1 == acc3.tau_powers_g1);
+    BOOST_CHECK(acc2.tau_powers_g2 == acc3.tau_powers_g2);
+    BOOST_CHECK(acc2.alpha_tau_powers_g1 == acc3.alpha_tau_powers_g1);
+    BOOST_CHECK(acc2.beta_tau_powers_g1 == acc3.beta_tau_powers_g1);
+    BOOST_CHECK(acc2.beta_g2 == acc3.beta_g2);
+
+    BOOST_CHECK(scheme_type::verify_eval(pubkey, scheme_type::compute_transcript(acc1), before, after, chunk_size));
+
+    // the transcript is hashed chunk by chunk and matches the one of the accumulator in memory
+    BOOST_CHECK(scheme_type::compute_transcript(before, chunk_size) == scheme_type::compute_transcript(acc1));
+    BOOST_CHECK(scheme_type::compute_transcript(after, 3) == scheme_type::compute_transcript(acc2));
+    BOOST_CHECK(scheme_type::verify_eval(pubkey, before, after, chunk_size));
+    auto file_pubkey = scheme_type::proof_eval(sk, before, chunk_size);
+    BOOST_CHECK(scheme_type::verify_eval(file_pubkey, before, after, chunk_size));
+    BOOST_CHECK(scheme_type::verify_eval(file_pubkey, acc1, acc2));
+
+    std::vector<typename scheme_type::accumulator_type::g1_value_type> point(1);
+    after.read(detail::powers_of_tau_vector::alpha_tau_g1, 9, point);
+    point[0] = point[0] + acc2.alpha_tau_powers_g1[1];
+    after.write(detail::powers_of_tau_vector::alpha_tau_g1, 9, point);
+    BOOST_CHECK(!scheme_type::verify_eval(pubkey, scheme_type::compute_transcript(acc1), before, after, chunk_size));
+    BOOST_CHECK(scheme_type::compute_transcript(after, chunk_size) != scheme_type::compute_transcript(acc2));
+
+    BOOST_CHECK_THROW(storage_type(before_file.path() + ".missing"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(powers_of_tau_windowed_mul_test) {
+    using curve_type = curves::bls12<381>;
+    using accumulator_type = powers_of_tau<curve_type, 32>::accumulator_type;
+    using scalar_field_type = curve_type::scalar_field_type;
+
+    auto g1 = random_element<curve_type::g1_type<>>();
+    auto g2 = random_element<curve_type::g2_type<>>();
+    for (std::size_t i = 0; i < 8; ++i) {
+        auto scalar = random_element<scalar_field_type>();
+        BOOST_CHECK(accumulator_type::windowed_mul(g1, scalar) == scalar * g1);
+        BOOST_CHECK(accumulator_type::windowed_mul(g2, scalar) == scalar * g2);
+    }
+    BOOST_CHECK(accumulator_type::windowed_mul(g1, scalar_field_type::value_type::zero()) ==
+                curve_type::g1_type<>::value_type::zero());
+    BOOST_CHECK(accumulator_type::windowed_mul(g1, -scalar_field_type::value_type::one()) == -g1);
+}
+
+BOOST_AUTO_TEST_CASE(group_fft_test) {
+    using curve_type = curves::bls12<381>;
+    using g1_value_type = curve_type::g1_type<>::value_type;
+    using g2_value_type = curve_type::g2_type<>::value_type;
+    using scalar_field_type = curve_type::scalar_field_type;
+    namespace fft_detail = nil::crypto3::zk::commitments::detail;
+
+    for (std::size_t m : {2, 8, 32}) {
+        auto tau = random_element<scalar_field_type>();
+        std::vector<g1_value_type> powers_g1(m);
+        std::vector<g2_value_type> powers_g2(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            powers_g1[i] = tau.pow(i) * g1_value_type::one();
+            powers_g2[i] = tau.pow(i) * g2_value_type::one();
+        }
+
+        auto domain_g1 = nil::crypto3::math::make_evaluation_domain<scalar_field_type, g1_value_type>(m);
+        auto domain_g2 = nil::crypto3::math::make_evaluation_domain<scalar_field_type, g2_value_type>(m);
+        auto omega = domain_g1->get_domain_element(1);
+        BOOST_CHECK(fft_detail::is_group_fft_root<scalar_field_type>(m, omega));
+
+        std::vector<g1_value_type> expected_g1 =
+            domain_g1->evaluate_all_lagrange_polynomials(powers_g1.begin(), powers_g1.end());
+        std::vector<g2_value_type> expected_g2 =
+            domain_g2->evaluate_all_lagrange_polynomials(powers_g2.begin(), powers_g2.end());
+
+        std::vector<g1_value_type> coeffs_g1 = powers_g1;
+        std::vector<g2_value_type> coeffs_g2 = powers_g2;
+        fft_detail::group_inverse_fft<scalar_field_type>(coeffs_g1, omega);
+        fft_detail::group_inverse_fft<scalar_field_type>(coeffs_g2, omega);
+        BOOST_CHECK(coeffs_g1 == expected_g1);
+        BOOST_CHECK(coeffs_g2 == expected_g2);
+
+        fft_detail::group_fft<scalar_field_type>(coeffs_g1, omega);
+        BOOST_CHECK(coeffs_g1 == powers_g1);
+    }
+
+    BOOST_CHECK(!fft_detail::is_group_fft_root<scalar_field_type>(12, scalar_field_type::value_type::one()));
+    BOOST_CHECK(!fft_detail::is_group_fft_root<scalar_field_type>(8, scalar_field_type::value_type::one()));
+}
+
+BOOST_AUTO_TEST_CASE(merge_pairs_accumulator_test) {
+    using curve_type = curves::bls12<381>;
+    using g1_value_type = curve_type::g1_type<>::value_type;
+    using scalar_field_type = curve_type::scalar_field_type;
+
+    auto s = random_element<scalar_field_type>();
+    std::vector<g1_value_type> v1, v2;
+    for (std::size_t i = 0; i < 100; ++i) {
+        v1.emplace_back(random_element<curve_type::g1_type<>>());
+        v2.emplace_back(s * v1.back());
+    }
+
+    detail::merge_pairs_accumulator<scalar_field_type, g1_value_type> acc;
+    for (std::size_t offset = 0; offset < v1.size(); offset += 30) {
+        std::size_t end = std::min(v1.size(), offset + 30);
+        acc.update(v1.begin() + offset, v1.begin() + end, v2.begin() + offset, v2.begin() + end);
+    }
+    BOOST_CHECK(s * acc.result().first == acc.result().second);
+
+    v2[42] = v2[42] + v1[0];
+    auto merged = detail::merge_pairs<scalar_field_type>(v1.begin(), v1.end(), v2.begin(), v2.end());
+    BOOST_CHECK(s * merged.first != merged.second);
+}
+
 BOOST_AUTO_TEST_CASE(keypair_generation_basic_test) {
     using curve_type = curves::bls12<381>;
     using scheme_type = powers_of_tau<curve_type, 32>;
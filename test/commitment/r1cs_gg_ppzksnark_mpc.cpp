@@ -161,4 +161,48 @@ BOOST_AUTO_TEST_CASE(mpc_generator_proof_verification_with_delta_contribution_te
     BOOST_CHECK(verification_result);
 }
 
+BOOST_AUTO_TEST_CASE(mpc_ceremony_verifier_test) {
+
+    using curve_type = curves::bls12<381>;
+    using powers_of_tau_scheme_type = powers_of_tau<curve_type, 32>;
+    using proving_scheme_type = r1cs_gg_ppzksnark<curve_type>;
+    using crs_mpc_type = r1cs_gg_ppzksnark_mpc<curve_type>;
+    using public_key_type = crs_mpc_type::public_key_type;
+
+    auto acc = powers_of_tau_scheme_type::accumulator_type();
+    auto pot_sk = powers_of_tau_scheme_type::generate_private_key();
+    acc.transform(pot_sk);
+    auto result = powers_of_tau_scheme_type::result_type::from_accumulator(acc, 32);
+
+    auto r1cs_example = generate_r1cs_example_with_field_input<curve_type::scalar_field_type>(20, 5);
+
+    crs_mpc_type::ceremony_verifier verifier(r1cs_example.constraint_system, result);
+    auto mpc_kp = verifier.keypair();
+
+    std::vector<public_key_type> pks;
+    for (std::size_t i = 0; i < 2; ++i) {
+        auto mpc_sk = crs_mpc_type::generate_private_key();
+        pks.emplace_back(crs_mpc_type::proof_eval(
+            mpc_sk, pks.empty() ? boost::none : boost::optional<public_key_type>(pks.back()), mpc_kp));
+        commitments::detail::transform_keypair(mpc_kp, mpc_sk);
+
+        // a contribution which changed one element of H is rejected and leaves the state as is
+        auto tampered_kp = mpc_kp;
+        tampered_kp.first.H_query[0] = tampered_kp.first.H_query[0] + tampered_kp.first.H_query[0];
+        BOOST_CHECK(!verifier.verify_contribution(tampered_kp, pks.back()));
+        BOOST_CHECK_EQUAL(verifier.contributions(), i);
+
+        BOOST_CHECK(verifier.verify_contribution(mpc_kp, pks.back()));
+        BOOST_CHECK_EQUAL(verifier.contributions(), i + 1);
+    }
+
+    // replaying an accepted contribution fails, the transcript has moved on
+    BOOST_CHECK(!verifier.verify_contribution(mpc_kp, pks.back()));
+
+    BOOST_CHECK(crs_mpc_type::verify_eval(mpc_kp, pks, r1cs_example.constraint_system, result));
+
+    auto proof = proving_scheme_type::prove(mpc_kp.first, r1cs_example.primary_input, r1cs_example.auxiliary_input);
+    BOOST_CHECK(proving_scheme_type::verify(mpc_kp.second, r1cs_example.primary_input, proof));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE evaluation_domain_registry_test
+
+#include <memory>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+
+#include <nil/crypto3/math/algorithms/calculate_domain_set.hpp>
+
+#include <nil/crypto3/zk/detail/evaluation_domain_registry.hpp>
+
+using namespace nil::crypto3;
+
+using FieldType = typename algebra::curves::pallas::base_field_type;
+using registry_type = zk::detail::evaluation_domain_registry<FieldType>;
+
+BOOST_AUTO_TEST_SUITE(evaluation_domain_registry_test_suite)
+
+BOOST_AUTO_TEST_CASE(evaluation_domain_registry_identity_test) {
+    registry_type::clear();
+
+    std::shared_ptr<math::evaluation_domain<FieldType>> domain = registry_type::domain(16);
+    BOOST_CHECK_EQUAL(domain->m, 16u);
+    BOOST_CHECK(registry_type::domain(16) == domain);
+    BOOST_CHECK(registry_type::domain(32) != domain);
+
+    std::vector<std::shared_ptr<math::evaluation_domain<FieldType>>> domain_set = registry_type::domain_set(5, 3);
+    std::vector<std::shared_ptr<math::evaluation_domain<FieldType>>> expected =
+        math::calculate_domain_set<FieldType>(5, 3);
+    BOOST_CHECK_EQUAL(domain_set.size(), 3u);
+    for (std::size_t i = 0; i < domain_set.size(); ++i) {
+        BOOST_CHECK_EQUAL(domain_set[i]->m, expected[i]->m);
+        BOOST_CHECK(domain_set[i]->get_domain_element(1) == expected[i]->get_domain_element(1));
+    }
+    BOOST_CHECK(domain_set[1] == domain);
+    BOOST_CHECK(registry_type::domain_set(5, 3) == domain_set);
+
+    const typename FieldType::value_type shift = 7;
+    auto coset = registry_type::coset(16, shift);
+    BOOST_CHECK(registry_type::coset(16, shift) == coset);
+    BOOST_CHECK(coset->powers[3] == shift.pow(3));
+    BOOST_CHECK(coset->powers[3] * coset->inverse_powers[3] == FieldType::value_type::one());
+
+    registry_type::clear();
+    std::shared_ptr<math::evaluation_domain<FieldType>> rebuilt = registry_type::domain(16);
+    BOOST_CHECK(rebuilt != domain);
+    BOOST_CHECK_EQUAL(domain->m, 16u);
+    BOOST_CHECK(registry_type::domain(16) == rebuilt);
+    BOOST_CHECK(registry_type::coset(16, shift) != coset);
+
+    registry_type::clear();
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_domain_registry_capacity_test) {
+    registry_type::clear();
+    const std::size_t capacity = registry_type::capacity();
+    registry_type::set_capacity(2);
+
+    auto d4 = registry_type::domain(4);
+    auto d8 = registry_type::domain(8);
+    BOOST_CHECK(registry_type::domain(4) == d4);
+
+    /* 8 is now the least recently requested domain and is dropped */
+    auto d16 = registry_type::domain(16);
+    BOOST_CHECK(registry_type::domain(4) == d4);
+    BOOST_CHECK(registry_type::domain(16) == d16);
+    BOOST_CHECK(registry_type::domain(8) != d8);
+
+    registry_type::set_capacity(capacity);
+    registry_type::clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,185 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE circuit_levels_test
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/zk/snark/arithmetization/circuit_satisfaction_problems/circuit_levels.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/circuit_satisfaction_problems/tbcs.hpp>
+
+using namespace nil::crypto3::zk::snark;
+
+/**
+ * A random valid TBCS circuit whose output gates evaluate to 0 on the returned inputs. Gates read
+ * uniformly random earlier wires, so most levels are wide enough to be evaluated in parallel.
+ */
+tbcs_circuit random_tbcs_circuit(std::mt19937 &rng, std::size_t primary_input_size, std::size_t auxiliary_input_size,
+                                 std::size_t num_gates, std::size_t num_outputs, tbcs_primary_input &primary_input,
+                                 tbcs_auxiliary_input &auxiliary_input) {
+    tbcs_circuit circuit;
+    circuit.primary_input_size = primary_input_size;
+    circuit.auxiliary_input_size = auxiliary_input_size;
+
+    primary_input.clear();
+    auxiliary_input.clear();
+    for (std::size_t i = 0; i < primary_input_size; ++i) {
+        primary_input.push_back(rng() % 2 != 0);
+    }
+    for (std::size_t i = 0; i < auxiliary_input_size; ++i) {
+        auxiliary_input.push_back(rng() % 2 != 0);
+    }
+
+    tbcs_variable_assignment all_wires(primary_input);
+    all_wires.insert(all_wires.end(), auxiliary_input.begin(), auxiliary_input.end());
+
+    for (std::size_t i = 0; i < num_gates; ++i) {
+        const std::size_t num_variables = circuit.num_wires();
+        tbcs_gate gate;
+        gate.left_wire = rng() % (num_variables + 1);
+        gate.right_wire = rng() % (num_variables + 1);
+        gate.output = num_variables + 1;
+        gate.is_circuit_output = (i >= num_gates - num_outputs);
+        do {
+            gate.type = static_cast<tbcs_gate_type>(rng() % num_tbcs_gate_types);
+        } while (gate.is_circuit_output && gate.evaluate(all_wires));
+
+        circuit.add_gate(gate);
+        all_wires.push_back(gate.evaluate(all_wires));
+    }
+
+    return circuit;
+}
+
+/**
+ * The gate-by-gate evaluation get_all_wires did before circuits were evaluated level by level.
+ */
+tbcs_variable_assignment sequential_wires(const tbcs_circuit &circuit, const tbcs_primary_input &primary_input,
+                                          const tbcs_auxiliary_input &auxiliary_input) {
+    tbcs_variable_assignment result(primary_input);
+    result.insert(result.end(), auxiliary_input.begin(), auxiliary_input.end());
+    for (const tbcs_gate &g : circuit.gates) {
+        result.push_back(g.evaluate(result));
+    }
+    return result;
+}
+
+bool sequential_is_satisfied(const tbcs_circuit &circuit, const tbcs_primary_input &primary_input,
+                             const tbcs_auxiliary_input &auxiliary_input) {
+    const tbcs_variable_assignment wires = sequential_wires(circuit, primary_input, auxiliary_input);
+    for (const tbcs_gate &g : circuit.gates) {
+        if (g.is_circuit_output && wires[g.output - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BOOST_AUTO_TEST_SUITE(circuit_levels_test_suite)
+
+BOOST_AUTO_TEST_CASE(circuit_levels_grouping_test) {
+    const std::vector<std::size_t> gate_levels = {2, 0, 1, 0, 2, 0};
+    const circuit_levels levels(gate_levels);
+
+    BOOST_CHECK_EQUAL(levels.num_gates(), 6u);
+    BOOST_CHECK_EQUAL(levels.num_levels(), 3u);
+    BOOST_CHECK(levels.gates == std::vector<std::size_t>({1, 3, 5, 2, 0, 4}));
+    BOOST_CHECK(levels.level_offsets == std::vector<std::size_t>({0, 3, 4, 6}));
+
+    const circuit_levels empty(std::vector<std::size_t> {});
+    BOOST_CHECK_EQUAL(empty.num_levels(), 0u);
+    BOOST_CHECK(empty == circuit_levels());
+
+    /* for_each_gate visits each gate once and never before the levels below it */
+    std::vector<std::size_t> visited;
+    levels.for_each_gate([&](std::size_t i) { visited.push_back(i); });
+    BOOST_CHECK(visited == levels.gates);
+
+    /* a level wide enough to be run in parallel */
+    std::vector<std::size_t> visits(200, 0);
+    circuit_levels(std::vector<std::size_t>(visits.size(), 0)).for_each_gate([&](std::size_t i) { ++visits[i]; });
+    BOOST_CHECK(visits == std::vector<std::size_t>(visits.size(), 1));
+}
+
+BOOST_AUTO_TEST_CASE(tbcs_levels_test) {
+    std::mt19937 rng(0x7bc5);
+    tbcs_primary_input primary_input;
+    tbcs_auxiliary_input auxiliary_input;
+    const tbcs_circuit circuit = random_tbcs_circuit(rng, 16, 48, 1000, 40, primary_input, auxiliary_input);
+    BOOST_CHECK(circuit.is_valid());
+
+    const circuit_levels levels = circuit.levels();
+    BOOST_CHECK_EQUAL(levels.num_gates(), circuit.num_gates());
+
+    /* a gate reads only wires of lower levels, and at least one wire of the level right below */
+    std::vector<std::size_t> wire_levels(1 + circuit.num_wires(), 0);
+    for (std::size_t l = 0; l < levels.num_levels(); ++l) {
+        BOOST_CHECK(levels.level_offsets[l] < levels.level_offsets[l + 1]);
+        for (std::size_t k = levels.level_offsets[l]; k < levels.level_offsets[l + 1]; ++k) {
+            const tbcs_gate &g = circuit.gates[levels.gates[k]];
+            const std::size_t reads = std::max(wire_levels[g.left_wire], wire_levels[g.right_wire]);
+            BOOST_CHECK_EQUAL(reads, l);
+            wire_levels[g.output] = l + 1;
+        }
+    }
+
+    std::size_t widest = 0;
+    for (std::size_t l = 0; l < levels.num_levels(); ++l) {
+        widest = std::max(widest, levels.level_offsets[l + 1] - levels.level_offsets[l]);
+    }
+    BOOST_CHECK(widest > 64);
+}
+
+BOOST_AUTO_TEST_CASE(tbcs_level_evaluation_test) {
+    std::mt19937 rng(0x51ed);
+    for (std::size_t num_gates : {1u, 10u, 300u, 2000u}) {
+        tbcs_primary_input primary_input;
+        tbcs_auxiliary_input auxiliary_input;
+        tbcs_circuit circuit =
+            random_tbcs_circuit(rng, 8, 24, num_gates, std::min<std::size_t>(num_gates, 20), primary_input,
+                                auxiliary_input);
+        const circuit_levels levels = circuit.levels();
+
+        const tbcs_variable_assignment expected = sequential_wires(circuit, primary_input, auxiliary_input);
+        BOOST_CHECK(circuit.get_all_wires(primary_input, auxiliary_input) == expected);
+        BOOST_CHECK(circuit.get_all_wires(levels, primary_input, auxiliary_input) == expected);
+
+        BOOST_CHECK(sequential_is_satisfied(circuit, primary_input, auxiliary_input));
+        BOOST_CHECK(circuit.is_satisfied(primary_input, auxiliary_input));
+        BOOST_CHECK(circuit.is_satisfied(levels, primary_input, auxiliary_input));
+
+        /* complementing the truth table of the last output gate makes it evaluate to 1 */
+        tbcs_gate &last = circuit.gates.back();
+        last.type = static_cast<tbcs_gate_type>(num_tbcs_gate_types - 1 - last.type);
+        BOOST_CHECK(!sequential_is_satisfied(circuit, primary_input, auxiliary_input));
+        BOOST_CHECK(!circuit.is_satisfied(primary_input, auxiliary_input));
+        BOOST_CHECK(!circuit.is_satisfied(levels, primary_input, auxiliary_input));
+        BOOST_CHECK(circuit.get_all_wires(levels, primary_input, auxiliary_input) ==
+                    sequential_wires(circuit, primary_input, auxiliary_input));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE circuit_reductions_test
+
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
+
+#include <nil/crypto3/zk/snark/reductions/bacs_to_r1cs.hpp>
+#include <nil/crypto3/zk/snark/reductions/tbcs_to_uscs.hpp>
+
+using namespace nil::crypto3;
+using namespace nil::crypto3::zk::snark;
+
+using FieldType = typename algebra::curves::pallas::base_field_type;
+
+/**
+ * A random valid BACS circuit whose output gates evaluate to 0 on the returned inputs: the linear
+ * combinations of an output gate get a term cancelling them.
+ */
+bacs_circuit<FieldType> random_bacs_circuit(std::mt19937 &rng, std::size_t num_inputs, std::size_t num_gates,
+                                            std::size_t num_outputs, bacs_primary_input<FieldType> &primary_input) {
+    bacs_circuit<FieldType> circuit;
+    circuit.primary_input_size = num_inputs;
+
+    primary_input.clear();
+    for (std::size_t i = 0; i < num_inputs; ++i) {
+        primary_input.emplace_back(algebra::random_element<FieldType>());
+    }
+    bacs_variable_assignment<FieldType> all_wires(primary_input);
+
+    for (std::size_t i = 0; i < num_gates; ++i) {
+        const std::size_t num_variables = circuit.num_wires();
+        bacs_gate<FieldType> gate;
+        for (std::size_t j = 0; j < 2; ++j) {
+            gate.lhs = gate.lhs + algebra::random_element<FieldType>() * variable<FieldType>(rng() % num_variables + 1);
+            gate.rhs = gate.rhs + algebra::random_element<FieldType>() * variable<FieldType>(rng() % num_variables + 1);
+        }
+        gate.output = variable<FieldType>(num_variables + 1);
+        gate.is_circuit_output = (i >= num_gates - num_outputs);
+        if (gate.is_circuit_output) {
+            gate.lhs = gate.lhs + (-gate.lhs.evaluate(all_wires)) * variable<FieldType>(0);
+        }
+
+        circuit.add_gate(gate);
+        all_wires.emplace_back(gate.evaluate(all_wires));
+    }
+
+    return circuit;
+}
+
+BOOST_AUTO_TEST_SUITE(circuit_reductions_test_suite)
+
+BOOST_AUTO_TEST_CASE(bacs_level_evaluation_test) {
+    std::mt19937 rng(0xbac5);
+    bacs_primary_input<FieldType> primary_input;
+    bacs_circuit<FieldType> circuit = random_bacs_circuit(rng, 16, 400, 10, primary_input);
+    const circuit_levels levels = circuit.levels();
+
+    bacs_variable_assignment<FieldType> expected(primary_input);
+    for (const bacs_gate<FieldType> &g : circuit.gates) {
+        expected.emplace_back(g.evaluate(expected));
+    }
+    BOOST_CHECK(circuit.get_all_wires(primary_input, {}) == expected);
+    BOOST_CHECK(circuit.get_all_wires(levels, primary_input, {}) == expected);
+    BOOST_CHECK(circuit.is_satisfied(primary_input, {}));
+    BOOST_CHECK(circuit.is_satisfied(levels, primary_input, {}));
+
+    circuit.gates.back().lhs = circuit.gates.back().lhs + variable<FieldType>(0);
+    BOOST_CHECK(!circuit.is_satisfied(primary_input, {}));
+    BOOST_CHECK(!circuit.is_satisfied(levels, primary_input, {}));
+}
+
+BOOST_AUTO_TEST_CASE(bacs_to_r1cs_order_test) {
+    std::mt19937 rng(0x21c5);
+    bacs_primary_input<FieldType> primary_input;
+    const bacs_circuit<FieldType> circuit = random_bacs_circuit(rng, 16, 400, 10, primary_input);
+
+    /* the constraints the reduction emitted gate by gate: one per gate, then one per output */
+    r1cs_constraint_system<FieldType> expected;
+    for (const bacs_gate<FieldType> &g : circuit.gates) {
+        expected.add_constraint(r1cs_constraint<FieldType>(g.lhs, g.rhs, g.output));
+    }
+    for (const bacs_gate<FieldType> &g : circuit.gates) {
+        if (g.is_circuit_output) {
+            expected.add_constraint(r1cs_constraint<FieldType>(1, g.output, 0));
+        }
+    }
+
+    const r1cs_constraint_system<FieldType> result = reductions::bacs_to_r1cs<FieldType>::instance_map(circuit);
+    BOOST_CHECK(result.constraints == expected.constraints);
+
+    const r1cs_variable_assignment<FieldType> witness =
+        reductions::bacs_to_r1cs<FieldType>::witness_map(circuit, primary_input, {});
+    BOOST_CHECK(result.is_satisfied(primary_input, r1cs_auxiliary_input<FieldType>(
+                                                       witness.begin() + primary_input.size(), witness.end())));
+}
+
+BOOST_AUTO_TEST_CASE(tbcs_to_uscs_order_test) {
+    std::mt19937 rng(0x05c5);
+    tbcs_circuit circuit;
+    circuit.primary_input_size = 32;
+    for (std::size_t i = 0; i < 300; ++i) {
+        tbcs_gate gate;
+        gate.left_wire = rng() % (circuit.num_wires() + 1);
+        gate.right_wire = rng() % (circuit.num_wires() + 1);
+        gate.type = static_cast<tbcs_gate_type>(rng() % num_tbcs_gate_types);
+        gate.output = circuit.num_wires() + 1;
+        gate.is_circuit_output = (i % 7 == 0);
+        circuit.add_gate(gate);
+    }
+    tbcs_primary_input primary_input;
+    for (std::size_t i = 0; i < circuit.primary_input_size; ++i) {
+        primary_input.push_back(rng() % 2 != 0);
+    }
+
+    const uscs_constraint_system<FieldType> result = reductions::tbcs_to_uscs<FieldType>::instance_map(circuit);
+    const std::size_t num_gates = circuit.num_gates();
+    const std::size_t num_wires = circuit.num_wires();
+    BOOST_REQUIRE_EQUAL(result.constraints.size(), num_gates + num_wires + (num_gates + 6) / 7);
+
+    /* constraint i enforces gate i: it is +-1 on the wire values and is not once the output is flipped */
+    uscs_variable_assignment<FieldType> wires =
+        reductions::tbcs_to_uscs<FieldType>::witness_map(circuit, primary_input, {});
+    for (std::size_t i = 0; i < num_gates; ++i) {
+        typename FieldType::value_type &z = wires[circuit.gates[i].output - 1];
+        BOOST_CHECK(result.constraints[i].evaluate(wires).squared() == FieldType::value_type::one());
+        z = FieldType::value_type::one() - z;
+        BOOST_CHECK(result.constraints[i].evaluate(wires).squared() != FieldType::value_type::one());
+        z = FieldType::value_type::one() - z;
+    }
+
+    /* then one binarity constraint per wire and one constraint per output, in order */
+    for (std::size_t i = 0; i < num_wires; ++i) {
+        BOOST_CHECK(result.constraints[num_gates + i] == 2 * variable<FieldType>(i) - 1);
+    }
+    std::size_t next = num_gates + num_wires;
+    for (const tbcs_gate &g : circuit.gates) {
+        if (g.is_circuit_output) {
+            BOOST_CHECK(result.constraints[next++] == variable<FieldType>(g.output) + 1);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -51,7 +51,9 @@
 #include <nil/crypto3/algebra/curves/params/multiexp/mnt6.hpp>
 #include <nil/crypto3/algebra/curves/params/wnaf/mnt6.hpp>
 
-#include "../../schemes/ppzksnark/r1cs_examples.hpp"
+#include <nil/crypto3/zk/detail/buffer_pool.hpp>
+
+#include "../../systems/ppzksnark/r1cs_examples.hpp"
 
 using namespace nil::crypto3::zk::snark;
 using namespace nil::crypto3::algebra;
@@ -124,11 +126,77 @@ void test_qap(const std::size_t qap_degree, const std::size_t num_inputs, const
 
     BOOST_CHECK(qap_inst_1.is_satisfied(qap_wit));
     BOOST_CHECK(qap_inst_2.is_satisfied(qap_wit));
+
+    /* the second call runs on buffers recycled by the first one */
+    qap_witness<FieldType> qap_wit_again =
+        reductions::r1cs_to_qap<FieldType>::witness_map(example.constraint_system, example.primary_input, example.auxiliary_input, d1, d2, d3);
+    BOOST_CHECK(qap_wit_again.coefficients_for_H == qap_wit.coefficients_for_H);
 }
 
 BOOST_AUTO_TEST_SUITE(qap_test_suite)
 
-BOOST_AUTO_TEST_CASE(qap_test_case) {
+BOOST_AUTO_TEST_CASE(qap_small_domains_test_case) {
+    const std::size_t num_inputs = 10;
+
+    using basic_curve_type = curves::mnt6<298>;
+
+    const std::size_t basic_domain_size = 1ul << 10;
+    const std::size_t step_domain_size = (1ul << 10) + (1ul << 8);
+
+    test_qap<typename basic_curve_type::scalar_field_type>(basic_domain_size, num_inputs, true);
+    test_qap<typename basic_curve_type::scalar_field_type>(step_domain_size, num_inputs, true);
+
+    test_qap<typename basic_curve_type::scalar_field_type>(basic_domain_size, num_inputs, false);
+    test_qap<typename basic_curve_type::scalar_field_type>(step_domain_size, num_inputs, false);
+}
+
+BOOST_AUTO_TEST_CASE(reduction_scratch_pool_bound_test_case) {
+    nil::crypto3::zk::detail::buffer_pool<int> pool(2, 100);
+
+    pool.release(std::vector<int>(40));
+    pool.release(std::vector<int>(40));
+    pool.release(std::vector<int>(40));
+    BOOST_CHECK_EQUAL(pool.cached(), 2u);
+    BOOST_CHECK_EQUAL(pool.cached_size(), 80u);
+
+    /* a buffer of another size evicts cached ones until it fits */
+    pool.release(std::vector<int>(50));
+    BOOST_CHECK_EQUAL(pool.cached(), 2u);
+    BOOST_CHECK_EQUAL(pool.cached_size(), 90u);
+
+    /* buffers larger than the bound are never kept */
+    pool.release(std::vector<int>(101));
+    BOOST_CHECK_EQUAL(pool.cached_size(), 90u);
+
+    std::vector<int> buffer = pool.acquire(50, 7);
+    BOOST_CHECK(buffer == std::vector<int>(50, 7));
+    BOOST_CHECK_EQUAL(pool.cached_size(), 40u);
+
+    /* acquire_like reuses the storage of a cached buffer of the shape's size */
+    const int *cached_data = buffer.data();
+    pool.release(std::move(buffer));
+    const std::vector<int> shape(50, 3);
+    std::vector<int> like = pool.acquire_like(shape);
+    BOOST_CHECK(like == shape);
+    BOOST_CHECK(like.data() == cached_data);
+    BOOST_CHECK_EQUAL(pool.cached_size(), 40u);
+
+    /* lowering the bound evicts cached buffers, raising it lets larger buffers in */
+    pool.set_max_cached_size(30);
+    BOOST_CHECK_EQUAL(pool.cached(), 0u);
+    BOOST_CHECK_EQUAL(pool.cached_size(), 0u);
+    pool.set_max_cached_size(200);
+    BOOST_CHECK_EQUAL(pool.max_cached_size(), 200u);
+    pool.release(std::vector<int>(101));
+    BOOST_CHECK_EQUAL(pool.cached_size(), 101u);
+
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.cached(), 0u);
+    BOOST_CHECK_EQUAL(pool.cached_size(), 0u);
+}
+
+/* The basic and extended domains of the mnt6 scalar field hold 2^s elements, which is too large for regular runs. */
+BOOST_AUTO_TEST_CASE(qap_test_case, *boost::unit_test::disabled()) {
     const std::size_t num_inputs = 10;
 
     using basic_curve_type = curves::mnt6<298>;
@@ -45,6 +45,14 @@ void test_benes(const std::size_t N) {
     do {
         const benes_routing routing = get_benes_routing(permutation);
         assert(valid_benes_routing(permutation, routing));
+
+        const benes_flat_routing flat_routing = get_benes_flat_routing(permutation);
+        BOOST_CHECK(valid_benes_routing(permutation, flat_routing));
+        for (std::size_t column_idx = 0; column_idx < routing.size(); ++column_idx) {
+            for (std::size_t packet_idx = 0; packet_idx < routing[column_idx].size(); ++packet_idx) {
+                BOOST_CHECK(flat_routing.get(column_idx, packet_idx) == routing[column_idx][packet_idx]);
+            }
+        }
     } while (permutation.next_permutation());
 }
 
@@ -53,13 +61,40 @@ void test_benes(const std::size_t N) {
  */
 void test_as_waksman(const std::size_t N) {
     nil::crypto3::math::integer_permutation permutation(N);
+    const as_waksman_topology neighbors = generate_as_waksman_topology(N);
 
     do {
         const as_waksman_routing routing = get_as_waksman_routing(permutation);
-        assert(valid_as_waksman_routing(permutation, routing));
+        assert(valid_as_waksman_routing(permutation, routing, neighbors));
+
+        const as_waksman_flat_routing flat_routing = get_as_waksman_flat_routing(permutation);
+        BOOST_CHECK(valid_as_waksman_routing(permutation, flat_routing, neighbors));
+        BOOST_CHECK(valid_as_waksman_routing(permutation, flat_routing));
+        for (std::size_t column_idx = 0; column_idx < routing.size(); ++column_idx) {
+            for (const auto &switch_setting : routing[column_idx]) {
+                BOOST_CHECK(flat_routing.get(column_idx, switch_setting.first) == switch_setting.second);
+            }
+        }
     } while (permutation.next_permutation());
 }
 
+/**
+ * Test flat routings on random permutations of larger sizes.
+ */
+void test_flat_routings_random(const std::size_t N) {
+    nil::crypto3::math::integer_permutation permutation(N);
+    permutation.random_shuffle();
+
+    const as_waksman_flat_routing as_waksman = get_as_waksman_flat_routing(permutation);
+    BOOST_CHECK(valid_as_waksman_routing(permutation, as_waksman));
+    BOOST_CHECK(valid_as_waksman_routing(permutation, get_as_waksman_routing(permutation)));
+
+    const std::size_t benes_size = 1ul << static_cast<std::size_t>(std::ceil(std::log2(N)));
+    nil::crypto3::math::integer_permutation benes_permutation(benes_size);
+    benes_permutation.random_shuffle();
+    BOOST_CHECK(valid_benes_routing(benes_permutation, get_benes_flat_routing(benes_permutation)));
+}
+
 BOOST_AUTO_TEST_SUITE(routing_algorithms_test_suite)
 
 BOOST_AUTO_TEST_CASE(routing_algorithms_test) {
@@ -73,4 +108,10 @@ BOOST_AUTO_TEST_CASE(routing_algorithms_test) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(routing_algorithms_flat_random_test) {
+    for (std::size_t N : {65, 100, 127, 1000, 1024}) {
+        test_flat_routings_random(N);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -30,11 +30,14 @@
 #define CRYPTO3_RUN_R1CS_MP_PPZKPCD_HPP
 
 #include <cstddef>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "tally_cp.hpp"
 
 #include <nil/crypto3/zk/snark/systems/pcd/r1cs_pcd/r1cs_mp_ppzkpcd/r1cs_mp_ppzkpcd.hpp>
+#include <nil/crypto3/zk/snark/systems/pcd/r1cs_pcd/r1cs_mp_ppzkpcd/r1cs_mp_ppzkpcd_dag_prover.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -46,6 +49,9 @@ namespace nil {
                  * "tally compliance predicate", of a given wordsize, arity, and depth.
                  *
                  * Optionally, also test the case of compliance predicates with different types.
+                 *
+                 * The same tree is then proven again with r1cs_mp_ppzkpcd_dag_prover, and the
+                 * DAG prover is checked to reject cyclic and dangling inputs.
                  */
                 template<typename PCD_ppT>
                 bool run_r1cs_mp_ppzkpcd_tally_example(std::size_t wordsize,
@@ -95,6 +101,10 @@ namespace nil {
                     std::vector<r1cs_mp_ppzkpcd_proof<PCD_ppT>> tree_proofs(tree_size);
                     std::vector<std::shared_ptr<r1cs_pcd_message<FieldType>>> tree_messages(tree_size);
 
+                    typedef r1cs_mp_ppzkpcd_dag_prover<PCD_ppT> dag_prover_type;
+                    std::vector<typename dag_prover_type::node_type> dag_nodes;
+                    std::vector<std::size_t> dag_node_of(tree_size);
+
                     std::set<std::size_t> tally_1_accepted_types, tally_2_accepted_types;
                     if (test_same_type_optimization) {
                         if (!test_multi_type) {
@@ -156,6 +166,16 @@ namespace nil {
                             r1cs_mp_ppzkpcd_proof<PCD_ppT> proof = r1cs_mp_ppzkpcd_prover<PCD_ppT>(
                                 keypair.pk, cur_cp.name, tally_primary_input, tally_auxiliary_input, proofs);
 
+                            std::vector<std::size_t> incoming(msgs.size(), dag_prover_type::base_case_input);
+                            if (!base_case) {
+                                for (std::size_t k = 0; k < incoming.size(); ++k) {
+                                    incoming[k] = dag_node_of[max_arity * cur_idx + k + 1];
+                                }
+                            }
+                            dag_node_of[cur_idx] = dag_nodes.size();
+                            dag_nodes.push_back(
+                                {cur_cp.name, tally_primary_input, tally_auxiliary_input, std::move(incoming)});
+
                             tree_proofs[cur_idx] = proof;
                             tree_messages[cur_idx] = cur_tally.get_outgoing_message();
 
@@ -186,6 +206,25 @@ namespace nil {
                         }
                     }
 
+                    dag_prover_type dag_prover(keypair.pk, 4);
+                    const std::vector<r1cs_mp_ppzkpcd_proof<PCD_ppT>> dag_proofs = dag_prover.prove(dag_nodes);
+                    BOOST_CHECK_EQUAL(dag_proofs.size(), dag_nodes.size());
+                    for (std::size_t i = 0; i < dag_nodes.size(); ++i) {
+                        const bool ans =
+                            r1cs_mp_ppzkpcd_verifier<PCD_ppT>(keypair.vk, dag_nodes[i].primary_input, dag_proofs[i]);
+                        BOOST_CHECK_MESSAGE(ans, "DAG prover proof " + std::to_string(i) + " does not verify");
+                        all_accept = all_accept && ans;
+                    }
+
+                    /* a message which is its own input closes a cycle */
+                    std::vector<typename dag_prover_type::node_type> cyclic_nodes = dag_nodes;
+                    cyclic_nodes.back().incoming.push_back(dag_nodes.size() - 1);
+                    BOOST_CHECK_THROW(dag_prover.prove(cyclic_nodes), std::invalid_argument);
+
+                    std::vector<typename dag_prover_type::node_type> dangling_nodes = dag_nodes;
+                    dangling_nodes.back().incoming.push_back(dag_nodes.size());
+                    BOOST_CHECK_THROW(dag_prover.prove(dangling_nodes), std::invalid_argument);
+
                     return all_accept;
                 }
 
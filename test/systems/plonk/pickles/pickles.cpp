@@ -373,7 +373,8 @@ BOOST_AUTO_TEST_CASE(pickles_proof_struct_test_suite) {
     index.w = 0x3DFB4B65F2CDFB71DF8EAFB896CAE55375F24670939CE3BD5EBCB1BB6D3421E9_cppui256;
     index.endo = 0x2D33357CB532458ED3552A23A8554E5005270D29D19FC7D27B7FD22F0201B547_cppui256;
 
-    index.linearization.constant_term = {
+    Linearization<std::vector<PolishToken<scalar_field_type>>> linearization;
+    linearization.constant_term = {
         PolishToken<scalar_field_type>(Variable(Column(gate_type::Poseidon))), //
         PolishToken<scalar_field_type>(Variable(Column(column_type::Witness, 6))), //
         PolishToken<scalar_field_type>(std::make_pair(0, 0)), //
@@ -659,7 +660,7 @@ BOOST_AUTO_TEST_CASE(pickles_proof_struct_test_suite) {
         PolishToken<scalar_field_type>(token_type::Mul)
     };
 
-    index.linearization.index_term = {
+    linearization.index_term = {
         std::make_tuple(Column(column_type::Coefficient, 3), std::vector<PolishToken<scalar_field_type>>({
           PolishToken<scalar_field_type>(Variable(Column(gate_type::Poseidon))),
           PolishToken<scalar_field_type>(token_type::Alpha),
@@ -1930,9 +1931,31 @@ BOOST_AUTO_TEST_CASE(pickles_proof_struct_test_suite) {
           PolishToken<scalar_field_type>(token_type::Mul),
         })),
     };
+    index.set_linearization(linearization);
     index.powers_of_alpha.register_(argument_type::GateType, 21);
     index.powers_of_alpha.register_(argument_type::Permutation, 3);
 
+    // Compiled linearization must agree with the token interpreter
+    {
+        scalar_field_type::value_type zeta = 0x0B1E2C8F4A1D3E5F6A7B8C9D0E1F2A3B4C5D6E7F8091A2B3C4D5E6F708192A3B_cppui256;
+        scalar_field_type::value_type zeta_omega = zeta * index.domain.omega;
+        std::vector<proof_evaluation_type<scalar_field_type::value_type>> evals = {proof.evals[0].combine(zeta),
+                                                                                  proof.evals[1].combine(zeta_omega)};
+        Constants<scalar_field_type> constants = {zeta.pow(3), zeta.pow(5), zeta.pow(7), zeta.pow(11), index.endo,
+                                                  index.fr_sponge_params.mds};
+
+        const auto &compiled = index.compiled_linearization();
+        BOOST_CHECK(compiled.constant_term.evaluate(index.domain, zeta, evals, constants) ==
+                    PolishToken<scalar_field_type>::evaluate(index.linearization().constant_term, index.domain, zeta,
+                                                             evals, constants));
+        BOOST_CHECK(compiled.index_term.size() == index.linearization().index_term.size());
+        for (std::size_t i = 0; i < compiled.index_term.size(); ++i) {
+            BOOST_CHECK(std::get<1>(compiled.index_term[i]).evaluate(index.domain, zeta, evals, constants) ==
+                        PolishToken<scalar_field_type>::evaluate(std::get<1>(index.linearization().index_term[i]),
+                                                                 index.domain, zeta, evals, constants));
+        }
+    }
+
     group_map<curve_type> g_map;
     BOOST_CHECK(verifier<curve_type>::verify(g_map, index, proof));
 }
@@ -434,13 +434,17 @@ namespace nil {
                                                 plonk_variable<assigment_type>::column_type::constant);
 
 
+                    // (w0, w1, w2) must be a row of the XOR table (c0, c1, c2)
                     plonk_lookup_constraint<FieldType> lookup_constraint;
                     lookup_constraint.lookup_input.insert(
                         lookup_constraint.lookup_input.end(), 
-                        {w0, w1, w2, c0, c1, c2});
+                        {w0, w1, w2});
+                    lookup_constraint.lookup_value.insert(
+                        lookup_constraint.lookup_value.end(),
+                        {c0, c1, c2});
                     std::vector<plonk_lookup_constraint<FieldType>> lookup_constraints = {lookup_constraint};
                     plonk_gate<FieldType, plonk_lookup_constraint<FieldType>> lookup_gate(0, lookup_constraints);
-                    // test_circuit.lookup_gates.push_back(lookup_gate);
+                    test_circuit.lookup_gates.push_back(lookup_gate);
                     return test_circuit;
                 }
             }    // namespace snark
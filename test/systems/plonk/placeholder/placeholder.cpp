@@ -44,12 +44,12 @@
 
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
 #include <nil/crypto3/math/polynomial/lagrange_interpolation.hpp>
-#include <nil/crypto3/math/algorithms/calculate_domain_set.hpp>
 
 #include <nil/crypto3/hash/algorithm/hash.hpp>
 #include <nil/crypto3/hash/sha2.hpp>
 #include <nil/crypto3/hash/keccak.hpp>
 
+#include <nil/crypto3/zk/detail/evaluation_domain_registry.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/prover.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/verifier.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/permutation_argument.hpp>
@@ -100,7 +100,7 @@ typename fri_type::params_type create_fri_params(std::size_t degree_log, const i
     std::size_t r = degree_log - 1;
 
     std::vector<std::shared_ptr<math::evaluation_domain<FieldType>>> domain_set =
-        math::calculate_domain_set<FieldType>(degree_log + expand_factor, r);
+        zk::detail::evaluation_domain_registry<FieldType>::domain_set(degree_log + expand_factor, r);
 
     params.r = r;
     params.D = domain_set;
@@ -329,11 +329,25 @@ BOOST_AUTO_TEST_CASE(placeholder_permutation_argument_test) {
             preprocessed_public_data, y, f_at_y, v_p_at_y, v_p_at_y_shifted,
             prover_res.permutation_poly_precommitment.root(), verifier_transcript);
 
+    // Succinct verifier on openings of S_sigma, L_0, q_last and q_blind
+    transcript::fiat_shamir_heuristic_sequential<placeholder_test_params::transcript_hash_type> succinct_transcript(
+        init_blob);
+    std::vector<typename FieldType::value_type> S_sigma_at_y(permutation_size);
+    for (int i = 0; i < permutation_size; i++) {
+        S_sigma_at_y[i] = preprocessed_public_data.permutation_polynomials[i].evaluate(y);
+    }
+    std::array<typename FieldType::value_type, 3> succinct_verifier_res =
+        placeholder_permutation_argument<FieldType, circuit_2_params>::verify_eval(
+            y, f_at_y, S_sigma_at_y, preprocessed_public_data.common_data.lagrange_0.evaluate(y),
+            preprocessed_public_data.q_last.evaluate(y), preprocessed_public_data.q_blind.evaluate(y), v_p_at_y,
+            v_p_at_y_shifted, prover_res.permutation_poly_precommitment.root(), succinct_transcript);
+
     typename FieldType::value_type verifier_next_challenge = verifier_transcript.template challenge<FieldType>();
     typename FieldType::value_type prover_next_challenge = prover_transcript.template challenge<FieldType>();
     BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
 
     for (int i = 0; i < argument_size; i++) {
+        BOOST_CHECK(succinct_verifier_res[i] == verifier_res[i]);
         BOOST_CHECK(prover_res.F_dfs[i].evaluate(y) == verifier_res[i]);
         for (std::size_t j = 0; j < desc.rows_amount; j++) {
             BOOST_CHECK(prover_res.F_dfs[i].evaluate(preprocessed_public_data.common_data.basic_domain->get_domain_element(
@@ -342,17 +356,14 @@ BOOST_AUTO_TEST_CASE(placeholder_permutation_argument_test) {
     }
 }
 
-BOOST_AUTO_TEST_CASE(placeholder_lookup_argument_test, *boost::unit_test::disabled()) {
+BOOST_AUTO_TEST_CASE(placeholder_lookup_argument_test) {
 
     auto circuit = circuit_test_3<FieldType>();
 
     constexpr std::size_t argument_size = 5;
 
     using policy_type = zk::snark::detail::placeholder_policy<FieldType, circuit_3_params>;
-
-    typedef commitments::list_polynomial_commitment<FieldType,
-        circuit_3_params::batched_commitment_params_type> lpc_type;
-    //typedef commitments::lpc<FieldType, circuit_3_params::batched_commitment_params_type> lpc_type;
+    using lookup_argument_type = placeholder_lookup_argument<FieldType, circuit_3_params>;
 
     typename fri_type::params_type fri_params = create_fri_params<fri_type, FieldType>(table_rows_log);
 
@@ -377,21 +388,31 @@ BOOST_AUTO_TEST_CASE(placeholder_lookup_argument_test, *boost::unit_test::disabl
         plonk_polynomial_dfs_table<FieldType, typename placeholder_test_params_lookups::arithmetization_params>(
             preprocessed_private_data.private_polynomial_table, preprocessed_public_data.public_polynomial_table);
 
-    std::vector<std::uint8_t> init_blob {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
-    transcript::fiat_shamir_heuristic_sequential<placeholder_test_params_lookups::transcript_hash_type>
-        prover_transcript(init_blob);
-    transcript::fiat_shamir_heuristic_sequential<placeholder_test_params_lookups::transcript_hash_type>
-        verifier_transcript(init_blob);
+    auto lookups = lookup_argument_type::lookups(constraint_system.lookup_gates());
+    BOOST_CHECK(lookups.size() == 1);
 
-    typename placeholder_lookup_argument<FieldType, lpc_type, circuit_3_params>::prover_lookup_result prover_res =
-        placeholder_lookup_argument<FieldType, lpc_type, circuit_3_params>::prove_eval(
-            constraint_system, preprocessed_public_data, assignments, fri_params, prover_transcript
-    );
+    std::vector<math::polynomial_dfs<typename FieldType::value_type>> sorted_columns =
+        lookup_argument_type::sorted_columns(lookups, polynomial_table, desc.usable_rows_amount);
+    BOOST_CHECK(sorted_columns.size() == lookup_argument_type::sorted_columns_amount(lookups));
+
+    typename FieldType::value_type theta = algebra::random_element<FieldType>();
+    typename FieldType::value_type beta = algebra::random_element<FieldType>();
+    typename FieldType::value_type gamma = algebra::random_element<FieldType>();
+    typename FieldType::value_type lambda = algebra::random_element<FieldType>();
+
+    std::vector<math::polynomial_dfs<typename FieldType::value_type>> V_L =
+        lookup_argument_type::grand_products(lookups, polynomial_table, sorted_columns, theta, beta, gamma);
+    BOOST_CHECK(V_L[0][0] == FieldType::value_type::one());
+    BOOST_CHECK(V_L[0][desc.usable_rows_amount] == FieldType::value_type::one());
+
+    std::array<math::polynomial_dfs<typename FieldType::value_type>, argument_size> prover_res =
+        lookup_argument_type::prove_eval(lookups, preprocessed_public_data, polynomial_table, sorted_columns, V_L,
+                                         theta, beta, gamma, lambda);
 
     // Challenge phase
     typename FieldType::value_type y = algebra::random_element<FieldType>();
     typename policy_type::evaluation_map columns_at_y;
-    for (std::size_t i = 0; i < placeholder_test_params::witness_columns; i++) {
+    for (std::size_t i = 0; i < placeholder_test_params_lookups::witness_columns; i++) {
 
         std::size_t i_global_index = i;
 
@@ -424,29 +445,29 @@ BOOST_AUTO_TEST_CASE(placeholder_lookup_argument_test, *boost::unit_test::disabl
         }
     }
 
-    typename FieldType::value_type input_at_y = prover_res.input_polynomial.evaluate(y);
-    typename FieldType::value_type input_at_y_shifted =
-        prover_res.input_polynomial.evaluate(circuit.omega.inversed() * y);
-
-    typename FieldType::value_type value_at_y = prover_res.value_polynomial.evaluate(y);
-
-    typename FieldType::value_type v_l_at_y = prover_res.V_L_polynomial.evaluate(y);
-    typename FieldType::value_type v_l_at_y_shifted = prover_res.V_L_polynomial.evaluate(circuit.omega * y);
-
-    std::array<typename FieldType::value_type, 5> verifier_res =
-        placeholder_lookup_argument<FieldType, lpc_type, circuit_3_params>::verify_eval(
-            preprocessed_public_data, constraint_system.lookup_gates(), y, columns_at_y, input_at_y, input_at_y_shifted,
-            value_at_y, v_l_at_y, v_l_at_y_shifted, prover_res.input_precommitment.root(),
-            prover_res.value_precommitment.root(), prover_res.V_L_precommitment.root(), verifier_transcript);
+    // A' at y and y * omega^{-1}, S' at y
+    std::size_t width = lookups[0].width();
+    std::vector<std::vector<typename FieldType::value_type>> sorted_values;
+    for (std::size_t k = 0; k < width; k++) {
+        sorted_values.push_back({sorted_columns[k].evaluate(y),
+                                 sorted_columns[k].evaluate(circuit.omega.inversed() * y)});
+    }
+    for (std::size_t k = 0; k < width; k++) {
+        sorted_values.push_back({sorted_columns[width + k].evaluate(y)});
+    }
+    std::vector<std::vector<typename FieldType::value_type>> V_L_values = {
+        {V_L[0].evaluate(y), V_L[0].evaluate(circuit.omega * y)}};
 
-    typename FieldType::value_type verifier_next_challenge = verifier_transcript.template challenge<FieldType>();
-    typename FieldType::value_type prover_next_challenge = prover_transcript.template challenge<FieldType>();
-    BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
+    placeholder_verification_key<FieldType, circuit_3_params> vk(preprocessed_public_data);
+    std::array<typename FieldType::value_type, argument_size> verifier_res = lookup_argument_type::verify_eval(
+        lookups, columns_at_y, sorted_values, V_L_values, vk.lagrange_first(y),
+        preprocessed_public_data.q_last.evaluate(y), preprocessed_public_data.q_blind.evaluate(y),
+        theta, beta, gamma, lambda);
 
     for (int i = 0; i < argument_size; i++) {
-        BOOST_CHECK(prover_res.F[i].evaluate(y) == verifier_res[i]);
+        BOOST_CHECK(prover_res[i].evaluate(y) == verifier_res[i]);
         for (std::size_t j = 0; j < desc.rows_amount; j++) {
-            BOOST_CHECK(prover_res.F[i].evaluate(preprocessed_public_data.common_data.basic_domain->get_domain_element(
+            BOOST_CHECK(prover_res[i].evaluate(preprocessed_public_data.common_data.basic_domain->get_domain_element(
                             j)) == FieldType::value_type::zero());
         }
     }
@@ -594,9 +615,64 @@ BOOST_AUTO_TEST_CASE(placeholder_prover_basic_test) {
     bool verifier_res = placeholder_verifier<FieldType, circuit_2_params>::process(
         preprocessed_public_data, proof, constraint_system, fri_params);
     BOOST_CHECK(verifier_res);
+
+    // Verification with the compact key restored from its serialized form
+    using verification_key_type = placeholder_verification_key<FieldType, circuit_2_params>;
+    std::vector<std::uint8_t> vk_blob = verification_key_type(preprocessed_public_data).serialize();
+    verification_key_type vk;
+    BOOST_CHECK(verification_key_type::deserialize(vk_blob.begin(), vk_blob.end(), vk));
+    BOOST_CHECK(vk == verification_key_type(preprocessed_public_data));
+    BOOST_CHECK(vk.omega == preprocessed_public_data.common_data.basic_domain->get_domain_element(1));
+    BOOST_CHECK(!verification_key_type::deserialize(vk_blob.begin(), vk_blob.end() - 1, vk));
+
+    verifier_res = placeholder_verifier<FieldType, circuit_2_params>::process(vk, proof, constraint_system, fri_params);
+    BOOST_CHECK(verifier_res);
+}
+
+BOOST_AUTO_TEST_CASE(placeholder_prover_commitment_storage_test) {
+
+    auto circuit = circuit_test_2<FieldType>();
+
+    using policy_type = zk::snark::detail::placeholder_policy<FieldType, circuit_2_params>;
+
+    typename fri_type::params_type fri_params = create_fri_params<fri_type, FieldType>(table_rows_log);
+
+    plonk_table_description<FieldType, typename circuit_2_params::arithmetization_params> desc;
+
+    desc.rows_amount = table_rows;
+    desc.usable_rows_amount = usable_rows;
+
+    typename policy_type::constraint_system_type constraint_system(circuit.gates, circuit.copy_constraints,
+                                                                   circuit.lookup_gates);
+    typename policy_type::variable_assignment_type assignments = circuit.table;
+
+    std::vector<std::size_t> columns_with_copy_constraints = {0, 1, 2, 3};
+
+    typename placeholder_public_preprocessor<FieldType, circuit_2_params>::preprocessed_data_type
+        preprocessed_public_data = placeholder_public_preprocessor<FieldType, circuit_2_params>::process(
+            constraint_system, assignments.public_table(), desc, fri_params, columns_with_copy_constraints.size());
+
+    typename placeholder_private_preprocessor<FieldType, circuit_2_params>::preprocessed_data_type
+        preprocessed_private_data = placeholder_private_preprocessor<FieldType, circuit_2_params>::process(
+            constraint_system, assignments.private_table(), desc, fri_params);
+
+    auto proof = placeholder_prover<FieldType, circuit_2_params>::process(
+        preprocessed_public_data, preprocessed_private_data, desc, constraint_system, assignments, fri_params);
+
+    // A budget of a few rows forces every batch to be extended and hashed in many chunks
+    placeholder_commitment_storage_params commitment_storage;
+    commitment_storage.directory = zk::detail::temporary_directory();
+    commitment_storage.leaf_memory_budget = 1 << 10;
+    auto file_backed_proof = placeholder_prover<FieldType, circuit_2_params>::process(
+        preprocessed_public_data, preprocessed_private_data, desc, constraint_system, assignments, fri_params,
+        commitment_storage);
+
+    BOOST_CHECK(file_backed_proof == proof);
+    BOOST_CHECK(placeholder_verifier<FieldType, circuit_2_params>::process(preprocessed_public_data, file_backed_proof,
+                                                                           constraint_system, fri_params));
 }
 
-BOOST_AUTO_TEST_CASE(placeholder_prover_lookup_test, *boost::unit_test::disabled()) {
+BOOST_AUTO_TEST_CASE(placeholder_prover_lookup_test) {
     auto circuit = circuit_test_3<FieldType>();
 
     using policy_type = zk::snark::detail::placeholder_policy<FieldType, circuit_3_params>;
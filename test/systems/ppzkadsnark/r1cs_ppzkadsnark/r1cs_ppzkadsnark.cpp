@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE r1cs_ppzkadsnark_test
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <nil/crypto3/algebra/random_element.hpp>
+
+#include <nil/crypto3/zk/snark/systems/ppzkadsnark/r1cs_ppzkadsnark/r1cs_ppzkadsnark.hpp>
+
+#include "prf/aes_ctr_prf.hpp"
+#include "signature/ed25519_signature.hpp"
+
+using namespace nil::crypto3;
+using namespace nil::crypto3::zk::snark;
+
+template<typename CurveType>
+void test_batch_auth(std::size_t size) {
+    typedef r1cs_ppzkadsnark<CurveType> scheme_type;
+    typedef typename zk::snark::detail::r1cs_ppzkadsnark_basic_policy<CurveType>::label_type label_type;
+    typedef typename CurveType::scalar_field_type scalar_field_type;
+
+    auto auth_keys = scheme_type::auth_generator();
+
+    std::vector<typename scalar_field_type::value_type> data(size);
+    std::vector<label_type> labels(size);
+    for (std::size_t i = 0; i < size; i++) {
+        data[i] = algebra::random_element<scalar_field_type>();
+        for (std::size_t j = 0; j < sizeof(labels[i].label_bytes); j++) {
+            labels[i].label_bytes[j] = static_cast<unsigned char>(i >> (8 * (j % sizeof(std::size_t))));
+        }
+    }
+
+    const auto auth_data = scheme_type::auth_sign(data, auth_keys.sak, labels);
+    const auto batch_auth_data = scheme_type::batch_auth_sign(data, auth_keys.sak, labels);
+    BOOST_CHECK(batch_auth_data == auth_data);
+
+    BOOST_CHECK(scheme_type::auth_verify(data, auth_data, auth_keys.sak, labels));
+    BOOST_CHECK(scheme_type::auth_verify(data, auth_data, auth_keys.pak, labels));
+    BOOST_CHECK(scheme_type::batch_auth_verify(data, batch_auth_data, auth_keys.sak, labels));
+    BOOST_CHECK(scheme_type::batch_auth_verify(data, batch_auth_data, auth_keys.pak, labels));
+
+    if (size == 0) {
+        return;
+    }
+
+    // a label the data was not signed under
+    std::vector<label_type> tampered_labels = labels;
+    tampered_labels[size / 2].label_bytes[0] ^= 0x80;
+    BOOST_CHECK(!scheme_type::auth_verify(data, auth_data, auth_keys.sak, tampered_labels));
+    BOOST_CHECK(!scheme_type::batch_auth_verify(data, batch_auth_data, auth_keys.sak, tampered_labels));
+    BOOST_CHECK(!scheme_type::batch_auth_verify(data, batch_auth_data, auth_keys.pak, tampered_labels));
+
+    // data which does not match the authenticated values
+    std::vector<typename scalar_field_type::value_type> tampered_data = data;
+    tampered_data[size - 1] += scalar_field_type::value_type::one();
+    BOOST_CHECK(!scheme_type::batch_auth_verify(tampered_data, batch_auth_data, auth_keys.sak, labels));
+    BOOST_CHECK(!scheme_type::batch_auth_verify(tampered_data, batch_auth_data, auth_keys.pak, labels));
+}
+
+BOOST_AUTO_TEST_SUITE(r1cs_ppzkadsnark_test_suite)
+
+BOOST_AUTO_TEST_CASE(r1cs_ppzkadsnark_batch_auth_test) {
+    test_batch_auth<default_r1cs_ppzkadsnark_pp>(0);
+    test_batch_auth<default_r1cs_ppzkadsnark_pp>(1);
+    test_batch_auth<default_r1cs_ppzkadsnark_pp>(17);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -76,6 +76,16 @@ namespace nil {
                     bool auth_resp = r1cs_ppzkadsnark_auth_verify<CurveType>(data, auth_data, auth_keys.pak, labels);
                     assert(auth_res == auth_resp);
 
+                    std::vector<r1cs_ppzkadsnark_auth_data<CurveType>> batch_auth_data =
+                        r1cs_ppzkadsnark<CurveType>::batch_auth_sign(data, auth_keys.sak, labels);
+                    assert(batch_auth_data == auth_data);
+
+                    bool batch_auth_res =
+                        r1cs_ppzkadsnark<CurveType>::batch_auth_verify(data, auth_data, auth_keys.sak, labels);
+                    bool batch_auth_resp =
+                        r1cs_ppzkadsnark<CurveType>::batch_auth_verify(data, auth_data, auth_keys.pak, labels);
+                    assert(batch_auth_res == auth_res && batch_auth_resp == auth_resp);
+
                     r1cs_ppzkadsnark_proof<CurveType> proof = r1cs_ppzkadsnark_prover<CurveType>(
                         keypair.pk, example.primary_input, example.auxiliary_input, auth_data);
 
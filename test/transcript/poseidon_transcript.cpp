@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2021 Ilias Khairullin <ilias@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE zk_poseidon_transcript_test
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/alt_bn128.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/alt_bn128.hpp>
+
+#include <nil/crypto3/zk/detail/field_merkle_tree.hpp>
+#include <nil/crypto3/zk/detail/poseidon_hash.hpp>
+#include <nil/crypto3/zk/transcript/poseidon_transcript.hpp>
+
+using namespace nil::crypto3;
+using namespace nil::crypto3::zk;
+
+using field_type = algebra::curves::alt_bn128_254::scalar_field_type;
+using value_type = typename field_type::value_type;
+using hash_type = zk::detail::poseidon_hash<field_type>;
+
+BOOST_AUTO_TEST_SUITE(zk_poseidon_transcript_test_suite)
+
+// Test vector of the reference implementation, poseidonperm_x5_254_3
+BOOST_AUTO_TEST_CASE(zk_poseidon_permutation_reference_test) {
+    typename hash_type::state_type state = {value_type(0), value_type(1), value_type(2)};
+    const typename hash_type::state_type expected = {
+        value_type(typename field_type::integral_type(
+            "0x115cc0f5e7d690413df64c6b9662e9cf2a3617f2743245519e19607a4417189a")),
+        value_type(typename field_type::integral_type(
+            "0x0fca49b798923ab0239de1c9e7a4a9a2210312b6a2f616d18b5a87f9b628ae29")),
+        value_type(typename field_type::integral_type(
+            "0x0e7ae82e40091e63cbd4f16a6d16310b3729d4b6e138fcf54110e2867045a30c"))};
+
+    typename hash_type::state_type reference_state = state;
+    hash_type::permutation_type::instance().permute_reference(reference_state);
+    hash_type::permute(state);
+
+    BOOST_CHECK(reference_state == expected);
+    BOOST_CHECK(state == expected);
+}
+
+BOOST_AUTO_TEST_CASE(zk_poseidon_merkle_tree_test) {
+    std::vector<std::vector<value_type>> leaves(16);
+    for (std::size_t i = 0; i < leaves.size(); i++) {
+        for (std::size_t j = 0; j <= i % 5; j++) {
+            leaves[i].push_back(value_type(i * 7 + j));
+        }
+    }
+
+    zk::detail::field_merkle_tree<hash_type, 2> tree(leaves.begin(), leaves.end());
+    BOOST_CHECK_EQUAL(tree.size(), 2 * leaves.size() - 1);
+
+    for (std::size_t i = 0; i < leaves.size(); i++) {
+        zk::detail::field_merkle_proof<hash_type, 2> proof(tree, i);
+        BOOST_CHECK(proof.root() == tree.root());
+        BOOST_CHECK(proof.validate(leaves[i]));
+        BOOST_CHECK(!proof.validate(leaves[(i + 1) % leaves.size()]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(zk_poseidon_transcript_test) {
+    std::vector<std::uint8_t> init_blob {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    transcript::fiat_shamir_heuristic_sequential<hash_type> tr1(init_blob);
+    transcript::fiat_shamir_heuristic_sequential<hash_type> tr2(init_blob);
+
+    tr1(value_type(5));
+    tr2(value_type(5));
+    const value_type ch1 = tr1.challenge<field_type>();
+    BOOST_CHECK(ch1 == tr2.challenge<field_type>());
+    BOOST_CHECK(ch1 != tr1.challenge<field_type>());
+
+    tr2(value_type(6));
+    BOOST_CHECK(tr1.challenge<field_type>() != tr2.challenge<field_type>());
+
+    auto ch_n = tr1.challenges<field_type, 3>();
+    BOOST_CHECK(ch_n[0] != ch_n[1] && ch_n[1] != ch_n[2]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()